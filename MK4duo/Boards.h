@@ -86,6 +86,11 @@
 *
 * 1705 BOARD_ULTRATRONICS       - Ultratronics v1 ARM 32 bit board
 *
+*
+*   Host-native Linux
+*
+* 2000 BOARD_LINUX_SIMULATOR    - Simulated RAMPS board for the Linux HAL
+*
 ****************************************************************************************/
 
 
@@ -182,4 +187,9 @@
 
 #define BOARD_ULTRATRONICS    1705    // Ultratronics v1.0 ARM 32 bit board
 
+/**
+ * Host-native Linux
+ */
+#define BOARD_LINUX_SIMULATOR 2000    // Simulated RAMPS board for the Linux HAL (ARDUINO_ARCH_LINUX)
+
 #endif
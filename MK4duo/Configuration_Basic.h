@@ -61,6 +61,17 @@
  */
 #define BAUDRATE 115200
 
+/**
+ * Serial transmit buffer (Arduino Due only)
+ *
+ * Queue outgoing characters in a RAM ring buffer instead of writing them
+ * one at a time into the UART. The ring is drained from idle() as fast as
+ * the UART accepts bytes, so long reports (M503, M408, M48) don't stall
+ * the main loop. When the ring is full the writer waits (back-pressure).
+ * Size in bytes, must be a power of 2.
+ */
+//#define SERIAL_TX_BUFFER 1024
+
 /**
  * Enable the Bluetooth serial interface
  */
@@ -109,6 +120,25 @@
  */
 //#define FASTER_GCODE_PARSER
 
+/**
+ * Parse the commands when they are queued, from serial, SD or the LCD,
+ * and keep them parsed in the command queue. The values are converted
+ * once, so the handlers start at once when the planner needs a new block.
+ * Requires FASTER_GCODE_PARSER.
+ */
+//#define PREPARSED_COMMAND_QUEUE
+
+/**
+ * Binary motion protocol
+ *
+ * Accept CRC protected binary frames on the serial link along with the
+ * ASCII G-code. The parameters are sent in fixed point, so the frames are
+ * shorter than the text and the values need no parsing.
+ * scripts/binary_gcode.py encodes and streams a G-code file.
+ * Requires FASTER_GCODE_PARSER.
+ */
+//#define BINARY_PROTOCOL
+
 /**
  * Host Keepalive
  *
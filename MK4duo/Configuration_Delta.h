@@ -82,6 +82,14 @@
 // if you want use new function comment this (using // at the start of the line)
 #define DELTA_SEGMENTS_PER_SECOND 200
 
+// Uncomment to split the moves by chord error instead of segments per second.
+// Every segment is as long as possible while the carriages, moved linearly
+// between its ends, stay within DELTA_CHORD_ERROR mm from the exact path.
+// Long and fast moves in the center need much less segments, slow moves
+// near the edge get more. M666 E sets the error, 0 uses the segments per second.
+//#define DELTA_CHORD_SEGMENTATION
+#define DELTA_CHORD_ERROR 0.005  // (mm)
+
 // NOTE: All following values for DELTA_* MUST be floating point,
 // so always have a decimal point in them.
 //
@@ -53,6 +53,7 @@
  * - R/C Servo
  * - Late Z axis
  * - Ahead slowdown
+ * - S-Curve acceleration
  * - Quick home
  * - Home Y before X
  * - Force Home XY before Home Z
@@ -646,6 +647,24 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ************************ S-Curve acceleration *************************
+ ***********************************************************************
+ *                                                                     *
+ * The speed follows a smooth S-curve (6th order Bezier) in time       *
+ * instead of a straight ramp, so the acceleration starts and ends     *
+ * at zero at every change of speed. Less ringing at the ends of the   *
+ * ramps, so higher accelerations can be used.                         *
+ * The ramps take the same time and distance as before, the peak       *
+ * acceleration in the middle of them is 1.875 times the setting.      *
+ *                                                                     *
+ * This feature requires a 32 bit processor (Arduino DUE)              *
+ *                                                                     *
+ ***********************************************************************/
+//#define S_CURVE_ACCELERATION
+/***********************************************************************/
+
+
 /***********************************************************************
  *************************** Quick home ********************************
  ***********************************************************************
@@ -1071,6 +1090,31 @@
 //#define SD_CHECK_AND_RETRY  // Use CRC checks and retries on the SD communication
 //#define SD_EXTENDED_DIR     // Show extended directory including file length. Don't use this with Pronterface
 
+// Read ahead the file printed from SD, in blocks of 512 bytes (a power of 2).
+// The blocks are read while the moves wait for room in the planner, the
+// commands are then taken from RAM instead of stalling on the card at every
+// block boundary. Every block takes 512 bytes of RAM, 2 are enough on AVR.
+//#define SD_READ_AHEAD 2
+
+// Move the blocks of the SD card with the DMA controller of the Arduino Due
+// instead of polling the SPI for every byte. With SD_READ_AHEAD the blocks
+// read ahead are requested and transferred while the main loop goes on.
+// The SD card must be on the hardware SPI and can't share it with a MAX6675.
+//#define SD_SPI_DMA
+
+// Keep the G-code information read for JSON_OUTPUT (generated by, layer heights,
+// filament and object height) in an index file INFO.IDX of every folder, keyed by
+// the name, size and date of the file. Selecting a file already in the index
+// doesn't read the ~38KB of its head and tail again. Needs JSON_OUTPUT.
+//#define SD_FILE_INFO_CACHE
+
+// Scan the file selected in idle time, through a model of the planner motion, and
+// keep the start, Z and estimated print time of every layer in NAME.Lxx next to it,
+// xx the first two letters of its extension (NAME.LGC for NAME.GCO).
+// The progress and the time left come from the layers, M27 reports the layer and
+// M26 L<layer> moves the print to the start of a layer.
+//#define SD_LAYER_INDEX
+
 // Decomment this if you are external SD without DETECT_PIN
 //#define SD_DISABLED_DETECT
 // Some RAMPS and other boards don't detect when an SD card is inserted. You can work
@@ -1088,6 +1132,17 @@
 // using:
 //#define MENU_ADDAUTOSTART
 
+// Read the folder of the SD menu once into a table of its files, the menus of the
+// LCD and Nextion then read only the names they show instead of the folder from
+// its start for every line. Every file takes 5 bytes of RAM, with more files the
+// folder is read as before. The table is read again when the folder changes or a
+// file is written.
+//#define SD_DIR_CACHE 64
+// Sort the files of the table, folders first, by the first chars of their names.
+// Every file takes this number of bytes more. Disable SDCARD_RATHERRECENTFIRST
+// to list them from A to Z.
+//#define SD_DIR_CACHE_SORT 8
+
 // This enable the firmware to write some configuration that require frequent update, on the SD card
 //#define SD_SETTINGS                     // Uncomment to enable
 #define SD_CFG_SECONDS        300         // seconds between update
@@ -1622,6 +1677,26 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ************************ High speed stepper ***************************
+ ***********************************************************************
+ *                                                                     *
+ * 32 bit processors only (Arduino DUE).                               *
+ * When the step rate is higher than one interrupt can keep up with,   *
+ * up to MAX_STEP_LOOPS steps are done in a single stepper interrupt.  *
+ * The steps are batched above DOUBLE_STEP_FREQUENCY interrupts per    *
+ * second, or sooner when the measured stepper interrupt time would    *
+ * take more than STEPPER_ISR_MAX_LOAD % of the processor.             *
+ * Needed for high microstepping (1/32) at high feedrates.             *
+ *                                                                     *
+ ***********************************************************************/
+// Steps per interrupt [1, 2, 4, 8]
+#define MAX_STEP_LOOPS 8
+// (%) Max processor time for the stepper interrupt
+#define STEPPER_ISR_MAX_LOAD 50
+/***********************************************************************/
+
+
 /***********************************************************************
  *************************** Microstepping *****************************
  ***********************************************************************
@@ -1744,6 +1819,8 @@
 
 // The ASCII buffer for receiving from the serial:
 #define MAX_CMD_SIZE 96
+// The command queue takes BUFSIZE * (MAX_CMD_SIZE + 2) bytes. Each command takes only
+// its own length plus 2 bytes, so short G1 lines queue several times BUFSIZE commands.
 // For Arduino DUE setting to 8
 #define BUFSIZE 4
 
@@ -1763,6 +1840,14 @@
 // Moves with fewer segments than this will be ignored and joined with the next movement
 #define MIN_STEPS_PER_SEGMENT 6
 
+// Experimental: calculate the trapezoid of the blocks in the integer step domain
+// and the junction speeds with an integer square root instead of float math.
+// The speeds are rounded down to 1/16 mm/s. Part of the math is still float and
+// no speed gain has been measured on a processor without FPU yet, leave it
+// disabled unless you are testing it. With PLANNER_BENCHMARK M124 reports the
+// planning time and the worst difference from the float version.
+//#define PLANNER_FIXED_POINT
+
 // Uncomment to add the M100 Free Memory Watcher for debug purpose
 //#define M100_FREE_MEMORY_WATCHER
 
@@ -1770,6 +1855,19 @@
 #define M100_FREE_MEMORY_DUMPER
 // Comment out to remove Corrupt sub-command
 #define M100_FREE_MEMORY_CORRUPTOR
+
+// Uncomment to add the M124 Planner benchmark for debug purpose.
+// Counts the blocks queued, the time spent in the planner for each of them
+// and the times the steppers ran out of blocks while printing.
+//#define PLANNER_BENCHMARK
+
+// Uncomment to add the M130 ISR statistics for debug purpose.
+// Counts the CPU cycles of every stepper, advance and temperature interrupt
+// (min/avg/max) and how late the stepper interrupt starts after its timer
+// compare match, to tune MAX_STEP_FREQUENCY and the segments per second.
+// The last ISR_STATISTICS_BUFFER stepper interrupts are kept for M130 D.
+//#define ISR_STATISTICS
+#define ISR_STATISTICS_BUFFER 32
 /****************************************************************************************/
 
 
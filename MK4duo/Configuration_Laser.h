@@ -60,6 +60,7 @@
 // Raster mode enables the laser to etch bitmap data at high speeds. Increases command buffer size substantially.
 #define LASER_RASTER
 #define LASER_MAX_RASTER_LINE 68      // Maximum number of base64 encoded pixels per raster gcode command
+#define LASER_RASTER_POOL_SIZE 8      // Raster lines queued at the same time, only raster moves use them (LASER_MAX_RASTER_LINE bytes each)
 #define LASER_RASTER_ASPECT_RATIO 1   // pixels aren't square on most displays, 1.33 == 4:3 aspect ratio. 
 #define LASER_RASTER_MM_PER_PULSE 0.2 // Can be overridden by providing an R value in M649 command : M649 S17 B2 D0 R0.1 F4000
 
@@ -341,6 +341,16 @@
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ *********************************** Junction deviation **********************************
+ *****************************************************************************************/
+// Corner speed from the junction deviation instead of the jerk (see Documentation/Features.md)
+//#define JUNCTION_DEVIATION
+// Deviation from the sharp corner in mm, override with M205 J (J0 goes back to the jerk)
+#define JUNCTION_DEVIATION_MM 0.02
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  ************************************ Homing feedrate ************************************
  *****************************************************************************************/
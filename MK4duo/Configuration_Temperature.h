@@ -136,6 +136,20 @@
 // the minimum temperature your thermistor can read. The lower the better/safer.
 // This shouldn't need to be more than 30 seconds (30000)
 //#define MILLISECONDS_PREHEAT_TIME 0
+
+// Sample the analog inputs with the DMA of the ADC (Arduino Due only).
+// The ADC converts all the inputs in free-run and the PDC stores the
+// conversions in RAM, an ADC interrupt averages a buffer of them at a time
+// instead of the temperature ISR polling the ADC 3906 times a second.
+// Every input averages 2^OVERSAMPLE conversions (less the lowest and the
+// highest) into a sample and the last FILTER samples into the reading.
+// The thermistors are filtered, the filament width sensor, the power sensor
+// and the ADC keypad follow the input fast.
+//#define ADC_DMA
+#define ADC_TEMP_OVERSAMPLE 6
+#define ADC_TEMP_FILTER 10
+#define ADC_FAST_OVERSAMPLE 2
+#define ADC_FAST_FILTER 2
 /*****************************************************************************************/
 
 
@@ -307,6 +321,23 @@
 #define DEFAULT_Ki {07, 07, 07, 07}     // Ki for H0, H1, H2, H3
 #define DEFAULT_Kd {60, 60, 60, 60}     // Kd for H0, H1, H2, H3
 #define DEFAULT_Kc {100, 100, 100, 100} // heating power = Kc * (e_speed)
+
+// Model based feed-forward on top of the PID of the hotends.
+// A thermal model of every hotend gives the power it loses to the ambient,
+// to the part cooling fan and to the filament of the next moves in the planner,
+// the PID only corrects what the model misses, so the hotend doesn't sag on fast infill.
+// M303 H<hotend> M1 finds the model (start with a cold hotend), M307 sets it.
+//#define PID_FEEDFORWARD
+#define FEEDFORWARD_LOOKAHEAD 500       // ms of planned moves the extrusion rate is taken from
+#define FEEDFORWARD_I_RANGE    32       // PWM the I term can add to or take from the model power
+
+//              HotEnd{HE0,HE1,HE2,HE3}
+#define DEFAULT_HEATER_POWER  {40, 40, 40, 40}                  // W of the heater cartridge at full power
+#define DEFAULT_HEAT_CAPACITY {16.7, 16.7, 16.7, 16.7}          // J/K to heat up the hotend
+#define DEFAULT_AMBIENT_LOSS  {0.068, 0.068, 0.068, 0.068}      // W/K lost to the ambient
+#define DEFAULT_FAN_LOSS      {0.097, 0.097, 0.097, 0.097}      // W/K lost more with the part cooling fan at full speed
+#define DEFAULT_FILAMENT_HEAT {5.4e-3, 5.4e-3, 5.4e-3, 5.4e-3}  // J/K per mm of filament (1.75mm PLA 5.4e-3, 2.85mm PLA 1.4e-2)
+#define DEFAULT_AMBIENT_TEMP  25                                // C around the printer
 /***********************************************************************/
 
 
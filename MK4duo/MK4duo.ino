@@ -81,7 +81,7 @@
  * M23  - Select SD file (M23 filename.g)
  * M24  - Start/resume SD print
  * M25  - Pause SD print
- * M26  - Set SD position in bytes (M26 S12345)
+ * M26  - Set SD position in bytes (M26 S12345) or at the start of a layer with SD_LAYER_INDEX (M26 L12)
  * M27  - Report SD print status
  * M28  - Start SD write (M28 filename.g)
  * M29  - Stop SD write
@@ -129,11 +129,13 @@
  * M120 - Enable endstop detection
  * M121 - Disable endstop detection
  * M122 - S<1=true|0=false> Enable or disable check software endstop. (Requires MIN_SOFTWARE_ENDSTOPS or MAX_SOFTWARE_ENDSTOPS)
+ * M124 - Report planner benchmark, R to reset the counters. (Requires PLANNER_BENCHMARK)
  * M125 - Save current position and move to pause park position. (Requires PARK_HEAD_ON_PAUSE)
  * M126 - Solenoid Air Valve Open (BariCUDA support by jmil)
  * M127 - Solenoid Air Valve Closed (BariCUDA vent to atmospheric pressure by jmil)
  * M128 - EtoP Open (BariCUDA EtoP = electricity to air pressure transducer by jmil)
  * M129 - EtoP Closed (BariCUDA EtoP = electricity to air pressure transducer by jmil)
+ * M130 - Report ISR cycles and step lateness, R to reset the counters, D to dump the last stepper interrupts. (Requires ISR_STATISTICS)
  * M140 - Set hot bed target temp
  * M141 - Set hot chamber target temp
  * M142 - Set cooler target temp
@@ -155,7 +157,7 @@
  * M202 - Set max acceleration in units/s^2 for travel moves (M202 X1000 Y1000) Unused in Marlin!!
  * M203 - Set maximum feedrate that your machine can sustain (M203 X200 Y200 Z300 E10000) in mm/sec
  * M204 - Set default acceleration: P for Printing moves, R for Retract only (no X, Y, Z) moves and T for Travel (non printing) moves (ex. M204 P800 T3000 R9000) in mm/sec^2
- * M205 -  advanced settings:  minimum travel speed S=while printing T=travel only,  B=minimum segment time X= maximum xy jerk, Z=maximum Z jerk, E=maximum E jerk
+ * M205 -  advanced settings:  minimum travel speed S=while printing T=travel only,  B=minimum segment time X= maximum xy jerk, Z=maximum Z jerk, E=maximum E jerk, J=junction deviation
  * M206 - Set additional homing offset
  * M207 - Set retract length S[positive mm] F[feedrate mm/min] Z[additional zlift/hop], stays in mm regardless of M200 setting
  * M208 - Set recover=unretract length S[positive mm surplus to the M207 S*] F[feedrate mm/min]
@@ -171,10 +173,11 @@
  * M300 - Play beep sound S<frequency Hz> P<duration ms>
  * M301 - Set PID parameters P I D and C
  * M302 - Allow cold extrudes, or set the minimum extrude S<temperature>.
- * M303 - PID relay autotune S<temperature> sets the target temperature (default target temperature = 150C). H<hotend> C<cycles> U<Apply result>
+ * M303 - PID relay autotune S<temperature> sets the target temperature (default target temperature = 150C). H<hotend> C<cycles> U<Apply result> M<thermal model>
  * M304 - Set hot bed PID parameters P I and D
  * M305 - Set hot chamber PID parameters P I and D
  * M306 - Set cooler PID parameters P I and D
+ * M307 - Set the thermal model of a hotend (PID_FEEDFORWARD) H<hotend> P<heater W> C<J/K> A<ambient W/K> F<fan W/K> E<filament J/K mm> R<ambient C>
  * M320 - Enable/Disable S1=enable S0=disable, V[bool] Print the leveling grid, Z<height> for leveling fade height (Requires ENABLE_LEVELING_FADE_HEIGHT)
  * M321 - Set a single Auto Bed Leveling Z coordinate - X<gridx> Y<gridy> Z<level val> S<level add>
  * M322 - Reset Auto Bed Leveling matrix
@@ -118,6 +118,7 @@
 #include "src/utility/nozzle.h"
 #include "src/utility/blinkm.h"
 #include "src/utility/hex_print_routines.h"
+#include "src/utility/isr_stats.h"
 
 #if MB(ALLIGATOR) || MB(ALLIGATOR_V3)
   #include "src/alligator/external_dac.h"
@@ -0,0 +1,233 @@
+#!/usr/bin/python3
+
+# Binary G-code encoder
+#
+# Encodes G-code for the BINARY_PROTOCOL of the firmware (see the frame
+# layout in src/parser/parser.h). Every line gets a line number, the
+# commands that have no binary form (text arguments, sub-codes, values out
+# of range) are sent as ASCII with the usual N and checksum.
+#
+# Usage:
+#   scripts/binary_gcode.py encode file.gcode out.bin
+#   scripts/binary_gcode.py stream -p /dev/ttyACM0 [-r 250000] file.gcode
+#   scripts/binary_gcode.py bench [-r 250000] [-f] file.gcode [file.gcode ...]
+#
+# bench prints bytes per command and the commands/s the serial link can
+# carry at the given baud rate, for ASCII and for binary. With -f it also
+# builds the host-native Linux firmware (see Documentation/Compilation.md)
+# with BINARY_PROTOCOL, runs both streams through it and checks they end
+# at the same position without errors. The simulated serial has no baud
+# rate, so the host time of the runs only shows the parsing cost.
+
+import argparse
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+FRAME_START = 0xA5
+MAX_CMD_SIZE = 96
+STRING_CODES = (23, 28, 30, 32, 117, 928)
+
+word_re = re.compile(r'([A-Za-z])\s*([-+]?(\d+\.?\d*|\.\d+))?\s*')
+
+firmware_dir = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+
+
+def crc16(data):
+  crc = 0xFFFF
+  for b in data:
+    crc ^= b << 8
+    for _ in range(8):
+      crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+      crc &= 0xFFFF
+  return crc
+
+
+def clean(line):
+  return line.split(';', 1)[0].strip()
+
+
+def ascii_line(n, cmd):
+  line = 'N%d %s' % (n, cmd)
+  checksum = 0
+  for c in line.encode():
+    checksum ^= c
+  return ('%s*%d\n' % (line, checksum)).encode()
+
+
+def encode_value(value):
+  # Returns the word flags and the bytes of a value, or None if it can't be sent
+  for scale, flag in ((1000, 0x00), (100000, 0x80)):
+    raw = round(value * scale)
+    if abs(value * scale - raw) < 1e-6:
+      break
+  else:
+    scale, flag = (100000, 0x80) if abs(value) < 21474 else (1000, 0x00)
+    raw = round(value * scale)
+  for size, code, fmt in ((1, 1, '<b'), (2, 2, '<h'), (4, 3, '<i')):
+    if -(1 << (8 * size - 1)) <= raw < (1 << (8 * size - 1)):
+      return flag | (code << 5), struct.pack(fmt, raw)
+  return None
+
+
+def binary_frame(n, cmd):
+  # Returns the frame of a command, or None to send it as ASCII
+  m = re.match(r'([GMT])\s*(\d+)(?![.\d])\s*', cmd, re.I)
+  if not m:
+    return None
+  letter, code = m.group(1).upper(), int(m.group(2))
+  if code > 0xFFFF or (letter == 'M' and code in STRING_CODES):
+    return None
+  payload = struct.pack('<iBH', n, ord(letter), code)
+  slot = 2 + len('%s%d' % (letter, code)) + 7
+  rest = cmd[m.end():]
+  while rest:
+    w = word_re.match(rest)
+    if not w or w.end() == 0:
+      return None
+    param = ord(w.group(1).upper()) - ord('A')
+    if w.group(2) is None:
+      payload += bytes([param])
+      slot += 1
+    else:
+      value = encode_value(float(w.group(2)))
+      if value is None:
+        return None
+      payload += bytes([param | value[0]]) + value[1]
+      slot += 5
+    rest = rest[w.end():]
+  if len(payload) > 255 or len(payload) + 4 > MAX_CMD_SIZE or slot > MAX_CMD_SIZE:
+    return None
+  body = bytes([len(payload)]) + payload
+  return bytes([FRAME_START]) + body + struct.pack('<H', crc16(body))
+
+
+def encode(commands, binary=True):
+  # One packet per command, numbered from 1 after an M110
+  packets = [ascii_line(0, 'M110 N0')]
+  for n, cmd in enumerate(commands, 1):
+    frame = binary_frame(n, cmd) if binary else None
+    packets.append(frame if frame else ascii_line(n, cmd))
+  return packets
+
+
+def read_commands(path, skip=None):
+  commands = []
+  with open(path, errors='replace') as f:
+    for line in f:
+      line = clean(line)
+      if line and not (skip and skip.match(line)):
+        commands.append(line)
+  return commands
+
+
+def stream(args):
+  try:
+    import serial
+  except ImportError:
+    sys.exit('stream needs pyserial')
+  packets = encode(read_commands(args.files[0]))
+  port = serial.Serial(args.port, args.baud, timeout=30)
+  time.sleep(2)
+  port.reset_input_buffer()
+  i, start = 0, time.time()
+  while i < len(packets):
+    port.write(packets[i])
+    while True:
+      reply = port.readline().decode(errors='replace').strip()
+      if not reply:
+        sys.exit('Timeout waiting for the printer')
+      if reply.startswith('Resend:'):
+        i = int(reply.split(':', 1)[1])
+        break
+      if reply.startswith('ok'):
+        i += 1
+        break
+      print(reply)
+  print('%d commands in %.1fs' % (len(packets), time.time() - start))
+
+
+def build(work, cxx):
+  from planner_benchmark import build_firmware, set_define
+  basic = os.path.join(work, 'Configuration_Basic.h')
+  set_define(basic, 'FASTER_GCODE_PARSER', '')
+  set_define(basic, 'BINARY_PROTOCOL', '')
+  return build_firmware(work, os.path.join(work, 'mk4duo'), cxx)
+
+
+def run(binary, work, packets, count):
+  tail = [ascii_line(count + i, c) for i, c in enumerate(('M400', 'M114'), 1)]
+  env = dict(os.environ, MK4DUO_EEPROM=os.path.join(work, 'eeprom.bin'))
+  start = time.time()
+  out = subprocess.run([binary], input=b''.join([b'M302 P1\n'] + packets + tail),
+                       stdout=subprocess.PIPE, cwd=work, env=env).stdout.decode(errors='replace')
+  elapsed = time.time() - start
+  positions = [l for l in out.splitlines() if l.startswith('X:')]
+  errors = [l for l in out.splitlines() if l.startswith('Error') or l.startswith('Resend')]
+  return (positions[-1].split(' Count', 1)[0] if positions else None), errors, elapsed
+
+
+def bench(args):
+  from planner_benchmark import skip_codes
+  work = None
+  if args.firmware:
+    tmp = tempfile.mkdtemp(prefix='mk4duo_binary_')
+    work = os.path.join(tmp, 'MK4duo')
+    shutil.copytree(firmware_dir, work)
+    firmware = build(work, args.cxx)
+  try:
+    for path in args.files:
+      commands = read_commands(path, skip_codes)
+      print('== %s (%d commands)' % (os.path.basename(path), len(commands)))
+      results = []
+      for name, binary in (('ascii', False), ('binary', True)):
+        packets = encode(commands, binary)[1:]
+        size = sum(len(p) for p in packets)
+        frames = sum(1 for p in packets if p[0] == FRAME_START)
+        per_command = size / max(len(packets), 1)
+        line = '%-7s %9d bytes %6.1f bytes/cmd %7.0f cmd/s at %d baud' % (
+          name, size, per_command, args.baud / 10.0 / per_command, args.baud)
+        if binary:
+          line += ' (%d%% framed)' % (100 * frames // max(len(packets), 1))
+        if work:
+          position, errors, elapsed = run(firmware, work, packets, len(commands))
+          results.append(position)
+          line += ', run %.2fs, %d errors' % (elapsed, len(errors))
+        print(line)
+      if work:
+        print('final   ' + ('same position: ' + str(results[0]) if results[0] == results[1] and results[0]
+                            else 'MISMATCH: %s / %s' % tuple(results)))
+  finally:
+    if work:
+      shutil.rmtree(os.path.dirname(work))
+
+
+def main():
+  parser = argparse.ArgumentParser(description='MK4duo binary G-code encoder')
+  parser.add_argument('mode', choices=('encode', 'stream', 'bench'))
+  parser.add_argument('files', nargs='+', help='G-code files (encode: input and output)')
+  parser.add_argument('-p', '--port', help='serial port for stream')
+  parser.add_argument('-r', '--baud', type=int, default=250000, help='baud rate')
+  parser.add_argument('-f', '--firmware', action='store_true', help='run the streams through the Linux firmware')
+  parser.add_argument('--cxx', default='g++', help='host C++ compiler')
+  args = parser.parse_args()
+
+  if args.mode == 'encode':
+    if len(args.files) != 2:
+      sys.exit('encode needs an input and an output file')
+    with open(args.files[1], 'wb') as f:
+      f.write(b''.join(encode(read_commands(args.files[0]))))
+  elif args.mode == 'stream':
+    if not args.port:
+      sys.exit('stream needs -p')
+    stream(args)
+  else:
+    bench(args)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,142 @@
+#!/usr/bin/python3
+
+# G-code float parser check
+#
+# Builds the host-native Linux firmware (see Documentation/Compilation.md)
+# without its main() and links it with a small test program that feeds a
+# corpus of slicer-style numbers to GCodeParser::parse_float:
+#
+#  - every result must be bit-exact with strtod rounded to float, which
+#    is what value_float returned before;
+#  - a microbenchmark times parse_float and the old strtod conversion
+#    over the corpus and prints nanoseconds and host cycles per word.
+#
+# The cycles are those of the host CPU, use them to compare the two
+# conversions, not as the cost on the printer board.
+#
+# Usage:
+#   scripts/float_parser_check.py [-n 5] [--cxx g++]
+
+import argparse
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+from planner_benchmark import build_firmware, firmware_dir
+
+test_program = r'''
+#include <time.h>
+#include "base.h"
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define CYCLES() __rdtsc()
+#else
+  #define CYCLES() 0ULL
+#endif
+
+// value_float before the fast parser
+static float strtod_float(char *p) {
+  char *e = p;
+  for (;;) {
+    const char c = *e;
+    if (c == '\0' || c == ' ') break;
+    if (c == 'E' || c == 'e') {
+      *e = '\0';
+      const float ret = strtod(p, NULL);
+      *e = c;
+      return ret;
+    }
+    ++e;
+  }
+  return strtod(p, NULL);
+}
+
+static uint32_t bits(const float f) { uint32_t u; memcpy(&u, &f, sizeof(u)); return u; }
+
+static double now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static char **words;
+static size_t count;
+
+static void bench(const char *name, const int passes, float (*convert)(char*)) {
+  volatile float sink = 0;
+  const double start = now_ns();
+  const unsigned long long cycles = CYCLES();
+  for (int i = 0; i < passes; i++)
+    for (size_t w = 0; w < count; w++) sink = sink + convert(words[w]);
+  const double n = (double)passes * count;
+  printf("%-12s %7.1f ns/word %7.1f cycles/word\n", name, (now_ns() - start) / n, (CYCLES() - cycles) / n);
+}
+
+int main(int argc, char **argv) {
+  const int passes = argc > 1 ? atoi(argv[1]) : 5;
+
+  // One number per line on the standard input
+  size_t size = 0, allocated = 1 << 20;
+  char *text = (char*)malloc(allocated);
+  for (size_t n; (n = fread(text + size, 1, allocated - size, stdin)) > 0;)
+    if ((size += n) == allocated) text = (char*)realloc(text, allocated *= 2);
+  for (size_t i = 0; i < size; i++) if (text[i] == '\n') count++;
+  words = (char**)malloc(count * sizeof(char*));
+  char *p = text;
+  for (size_t w = 0; w < count; w++) {
+    words[w] = p;
+    p = strchr(p, '\n');
+    *p++ = '\0';
+  }
+
+  unsigned long mismatches = 0;
+  for (size_t w = 0; w < count; w++) {
+    const float fast = GCodeParser::parse_float(words[w]),
+                ref = (float)strtod(words[w], NULL);
+    if (bits(fast) != bits(ref) && ++mismatches <= 10)
+      printf("MISMATCH %s: %.9g / strtod %.9g\n", words[w], fast, ref);
+  }
+  printf("%lu numbers, %lu mismatches\n", (unsigned long)count, mismatches);
+
+  bench("strtod", passes, strtod_float);
+  bench("parse_float", passes, GCodeParser::parse_float);
+  return mismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+'''
+
+
+def corpus():
+  rnd = random.Random(1)
+  numbers = ['0', '-0', '+0', '.5', '5.', '+1.5', '-.25', '007', '-', '.', '',
+             '0.0000001', '0.00000000001', '16777215', '16777216', '123456789',
+             '1.23456789', '99999.99999', '-2147483.648', '1.2.3', '1800', '0.0200']
+  # X/Y/Z moves with 3 decimals
+  numbers += ['%.3f' % (i / 1000.0) for i in range(-300000, 300001)]
+  # Z with 2 decimals, feedrates
+  numbers += ['%.2f' % (i / 100.0) for i in range(0, 40001)]
+  numbers += ['%d' % i for i in range(0, 20001, 10)]
+  # E with 4 and 5 decimals
+  for _ in range(200000):
+    e = rnd.uniform(-5, 3000)
+    numbers += ['%.5f' % e, '%.4f' % e]
+  return numbers
+
+
+def main():
+  parser = argparse.ArgumentParser(description='MK4duo G-code float parser check')
+  parser.add_argument('-n', '--passes', type=int, default=5, help='benchmark passes over the corpus')
+  parser.add_argument('--cxx', default='g++', help='host C++ compiler')
+  args = parser.parse_args()
+
+  with tempfile.TemporaryDirectory(prefix='mk4duo_float_') as work:
+    test = os.path.join(work, 'float_check.cpp')
+    with open(test, 'w') as f:
+      f.write(test_program)
+    binary = build_firmware(firmware_dir, os.path.join(work, 'float_check'), args.cxx, test=test)
+    result = subprocess.run([binary, str(args.passes)], input='\n'.join(corpus()) + '\n', universal_newlines=True)
+    sys.exit(result.returncode)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,156 @@
+#!/usr/bin/python3
+
+# Hotend thermal model check
+#
+# Runs the host-native Linux firmware (see Documentation/Compilation.md)
+# with the simulated hotend of the Linux HAL (HAL_SIM_HOTEND_POWER): a
+# heater cartridge and a block with the sensor, losing heat to the ambient,
+# to the part cooling fan and to the extruded filament. It is built with the
+# PID alone and with PID_FEEDFORWARD, and linked with a small test program
+# that runs through loop():
+#
+#  - M303 H0 S<temp> C8 U1 (with M1 for PID_FEEDFORWARD, the identified
+#    model is compared to the one of the simulation);
+#  - the hotend cools down for 2 minutes, as the tuning leaves it at any
+#    point of a cycle, then the extremes of the block temperature in
+#    - heatup: the 30 s after M109 S<temp>;
+#    - rest:   the next minute;
+#    - flow:   zig-zag moves extruding --flow mm3/s of 1.75mm filament;
+#    - after:  the rest after the moves, the heater has to give the power back;
+#    - fan:    the part cooling fan switched on at full speed.
+#
+# Usage:
+#   scripts/hotend_model_check.py [-t 210] [-f 12] [-p 40] [--cxx g++]
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from planner_benchmark import build_firmware, firmware_dir, set_define
+
+test_program = r'''
+#include "base.h"
+
+extern void setup();
+extern void loop();
+
+static void run(const char* cmd) {
+  while (!enqueue_and_echo_command(cmd)) loop();
+}
+
+static void finish() {
+  while (commands_in_queue || planner.blocks_queued()) loop();
+}
+
+static void report(const char* name, const int target) {
+  fprintf(stderr, "%-6s min %6.2f max %6.2f (%+.2f %+.2f)\n", name, HAL_sim_hotend_min, HAL_sim_hotend_max,
+          HAL_sim_hotend_min - target, HAL_sim_hotend_max - target);
+  HAL_sim_hotend_min = HAL_sim_hotend_max = HAL_sim_hotend_temp;
+}
+
+int main(int argc, char** argv) {
+  const int target = atoi(argv[1]);
+  const float flow = atof(argv[2]);
+  char cmd[64];
+
+  setup();
+  finish();
+
+  #if ENABLED(PID_FEEDFORWARD)
+    sprintf(cmd, "M303 H0 S%i C8 U1 M1", target);
+  #else
+    sprintf(cmd, "M303 H0 S%i C8 U1", target);
+  #endif
+  run(cmd);
+  finish();
+  fprintf(stderr, "PID    Kp %.2f Ki %.3f Kd %.2f\n", PID_PARAM(Kp, 0), PID_PARAM(Ki, 0), PID_PARAM(Kd, 0));
+  #if ENABLED(PID_FEEDFORWARD)
+    fprintf(stderr, "model  C %.2f J/K (sim %.2f) A %.4f W/K (sim %.4f) F %.4f W/K (sim %.4f) R %.1f C\n",
+            PID_PARAM(heat_capacity, 0), HAL_SIM_HOTEND_HEATER_CAPACITY + HAL_SIM_HOTEND_BLOCK_CAPACITY,
+            PID_PARAM(ambient_loss, 0), HAL_SIM_HOTEND_AMBIENT_LOSS,
+            PID_PARAM(fan_loss, 0), HAL_SIM_HOTEND_FAN_LOSS, PID_PARAM(ambient_temp, 0));
+  #endif
+
+  run("G28");
+  run("M83");
+  run("M104 S0");
+  run("G4 S120");
+  finish();
+  sprintf(cmd, "M109 S%i", target);
+  run(cmd);
+  finish();
+  HAL_sim_hotend_min = HAL_sim_hotend_max = HAL_sim_hotend_temp;
+  run("G4 S30");
+  finish();
+  report("heatup", target);
+
+  run("G4 S60");
+  finish();
+  report("rest", target);
+
+  // 100 mm/s moves of 160 mm, the extruded mm of 1.75mm filament
+  const float e = flow / (M_PI * sq(1.75 / 2)) * 1.6;
+  for (int m = 0; m < 20; m++) {
+    sprintf(cmd, "G1 X%i Y100 E%.3f F6000", m & 1 ? 20 : 180, e);
+    run(cmd);
+  }
+  finish();
+  report("flow", target);
+
+  run("G4 S60");
+  finish();
+  report("after", target);
+
+  run("M106 S255");
+  run("G4 S60");
+  finish();
+  report("fan", target);
+
+  return EXIT_SUCCESS;
+}
+'''
+
+
+def build(work, feedforward, args):
+  if feedforward:
+    set_define(os.path.join(work, 'Configuration_Temperature.h'), 'PID_FEEDFORWARD', '')
+
+  test = os.path.join(work, 'hotend_check.cpp')
+  with open(test, 'w') as f:
+    f.write(test_program)
+  return build_firmware(work, os.path.join(work, 'hotend_check'), args.cxx, ['HAL_SIM_HOTEND_POWER=%g' % args.power], test)
+
+
+def main():
+  parser = argparse.ArgumentParser(description='MK4duo hotend thermal model check')
+  parser.add_argument('-t', '--temperature', type=int, default=210, help='target temperature')
+  parser.add_argument('-f', '--flow', type=float, default=12, help='volumetric flow of the moves (mm3/s)')
+  parser.add_argument('-p', '--power', type=float, default=40, help='heater power of the simulated hotend (W)')
+  parser.add_argument('--cxx', default='g++', help='host C++ compiler')
+  args = parser.parse_args()
+
+  tmp = tempfile.mkdtemp(prefix='mk4duo_hotend_')
+  try:
+    env = dict(os.environ, MK4DUO_EEPROM=os.path.join(tmp, 'eeprom.bin'))
+    for feedforward in (False, True):
+      work = os.path.join(tmp, 'MK4duo')
+      shutil.copytree(firmware_dir, work)
+      print('== %s, %g W heater, %d C, %g mm3/s' % ('PID_FEEDFORWARD' if feedforward else 'PID', args.power,
+                                                     args.temperature, args.flow))
+      sys.stdout.flush()
+      binary = build(work, feedforward, args)
+      out = subprocess.run([binary, str(args.temperature), str(args.flow)], stdin=subprocess.DEVNULL,
+                           stdout=subprocess.DEVNULL, env=env)
+      shutil.rmtree(work)
+      if os.path.exists(env['MK4DUO_EEPROM']):
+        os.remove(env['MK4DUO_EEPROM'])
+      if out.returncode:
+        sys.exit(out.returncode)
+  finally:
+    shutil.rmtree(tmp)
+
+if __name__ == '__main__':
+  main()
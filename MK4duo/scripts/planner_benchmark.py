@@ -0,0 +1,169 @@
+#!/usr/bin/python3
+
+# Planner benchmark
+#
+# Builds the host-native Linux firmware (see Documentation/Compilation.md)
+# once for every mechanism with PLANNER_BENCHMARK enabled, then feeds the
+# given sliced G-code files through it and prints the M124 report:
+# blocks/s of planner time, average and worst-case time to plan a block
+# and how many times the steppers starved waiting for the planner.
+#
+# The stepper ISR drains the blocks on the simulated clock and the host
+# time spent in the planner is charged to that clock (HAL_SIM_CPU_SCALE),
+# so a slow planner shows up as starvation just like on the printer.
+#
+# With -j the firmware is built with JUNCTION_DEVIATION and every file is
+# run once for each value given with M205 J (0 is the jerk cornering), the
+# time(ms) of the report is the print time of the file in each mode.
+# Delta can't use JUNCTION_DEVIATION, it's skipped.
+#
+# With -e the delta firmware is built with DELTA_CHORD_SEGMENTATION and
+# every file is run once for each chord error given with M666 E (0 splits
+# by segments per second). The report adds the segments queued and the
+# worst distance of a segment from the programmed line.
+#
+# Usage:
+#   scripts/planner_benchmark.py [options] file.gcode [file.gcode ...]
+#
+# Options:
+#   -m cartesian,corexy,delta   mechanisms to test (default all three)
+#   -b 16                       override BLOCK_BUFFER_SIZE
+#   -s 200                      override DELTA_SEGMENTS_PER_SECOND
+#   -c 20                       host to MCU speed ratio (HAL_SIM_CPU_SCALE)
+#   -j 0,0.02                   junction deviations to compare (M205 J)
+#   -e 0,0.005                  delta chord errors to compare (M666 E)
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+mechanisms = {
+  'cartesian': 'MECH_CARTESIAN',
+  'corexy':    'MECH_COREXY',
+  'delta':     'MECH_DELTA',
+}
+
+mechanism_configs = {
+  'cartesian': 'Configuration_Cartesian.h',
+  'corexy':    'Configuration_Core.h',
+  'delta':     'Configuration_Delta.h',
+}
+
+# Commands that would wait forever for the simulated heaters or for a user
+skip_codes = re.compile(r'^\s*(M0|M1|M104|M109|M140|M190|M141|M191|M303|M600)\b', re.I)
+
+firmware_dir = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+
+
+def set_define(path, name, value):
+  with open(path) as f:
+    text = f.read()
+  text, n = re.subn(r'^\s*(//)?\s*#define\s+' + name + r'\b.*$', '#define ' + name + ' ' + value, text, count=1, flags=re.M)
+  if not n:
+    sys.exit('%s not found in %s' % (name, path))
+  with open(path, 'w') as f:
+    f.write(text)
+
+
+def build_firmware(work, binary, cxx, defines=(), test=None, firmware=True):
+  # Compiles the host firmware of work (the MK4duo folder or a copy) into binary.
+  # With test, that C++ program is linked in place of the main() of the firmware,
+  # with firmware=False it's built alone, for the tests of the headers only.
+  sources = [test] if test else []
+  if firmware:
+    for root, dirs, files in os.walk(os.path.join(work, 'src')):
+      sources += [os.path.join(root, f) for f in files if f.endswith('.cpp')]
+  cmd = [cxx, '-std=gnu++11', '-O2', '-DARDUINO_ARCH_LINUX'] + ['-D' + d for d in defines]
+  if test and firmware:
+    cmd.append('-DHAL_SIM_NO_MAIN')
+  cmd += ['-I' + work, '-I' + os.path.join(work, 'src', 'HAL', 'HAL_LINUX', 'include')] + sources + ['-o', binary, '-lm']
+  subprocess.check_call(cmd, cwd=work)
+  return binary
+
+
+def build(work, mech, args):
+  set_define(os.path.join(work, 'Configuration_Basic.h'), 'MECHANISM', mechanisms[mech])
+  set_define(os.path.join(work, 'Configuration_Feature.h'), 'PLANNER_BENCHMARK', '')
+  if args.buffer:
+    set_define(os.path.join(work, 'Configuration_Feature.h'), 'BLOCK_BUFFER_SIZE', str(args.buffer))
+  if args.segments:
+    set_define(os.path.join(work, 'Configuration_Delta.h'), 'DELTA_SEGMENTS_PER_SECOND', str(args.segments))
+  if args.junction:
+    set_define(os.path.join(work, mechanism_configs[mech]), 'JUNCTION_DEVIATION', '')
+  if args.chord and mech == 'delta':
+    set_define(os.path.join(work, 'Configuration_Delta.h'), 'DELTA_CHORD_SEGMENTATION', '')
+
+  return build_firmware(work, os.path.join(work, 'mk4duo'), args.cxx, ['HAL_SIM_CPU_SCALE=%d' % args.cpu_scale])
+
+
+def run(binary, work, gcode, junction=None, chord=None):
+  lines = ['M302 P1']
+  if junction is not None:
+    lines.append('M205 J' + junction)
+  if chord is not None:
+    lines.append('M666 E' + chord)
+  lines.append('M124 R')
+  with open(gcode, errors='replace') as f:
+    for line in f:
+      line = line.split(';', 1)[0].strip()
+      if line and not skip_codes.match(line):
+        lines.append(line)
+  lines += ['M400', 'M124']
+
+  env = dict(os.environ, MK4DUO_EEPROM=os.path.join(work, 'eeprom.bin'))
+  out = subprocess.run([binary], input='\n'.join(lines) + '\n', stdout=subprocess.PIPE,
+                       universal_newlines=True, cwd=work, env=env).stdout
+  reports = [l for l in out.splitlines() if 'Planner blocks:' in l]
+  if not reports:
+    return 'no report (firmware stopped?)'
+  report = reports[-1].split('Planner ', 1)[1]
+  segments = [l for l in out.splitlines() if 'Delta segments:' in l]
+  if segments:
+    report += ' ' + segments[-1].split('Delta ', 1)[1]
+  return report
+
+
+def main():
+  parser = argparse.ArgumentParser(description='MK4duo look-ahead planner benchmark')
+  parser.add_argument('files', nargs='+', help='G-code files')
+  parser.add_argument('-m', '--mech', default=','.join(mechanisms), help='mechanisms to test')
+  parser.add_argument('-b', '--buffer', type=int, help='BLOCK_BUFFER_SIZE')
+  parser.add_argument('-s', '--segments', type=int, help='DELTA_SEGMENTS_PER_SECOND')
+  parser.add_argument('-c', '--cpu-scale', type=int, default=20, help='HAL_SIM_CPU_SCALE')
+  parser.add_argument('-j', '--junction', help='junction deviations to compare, e.g. 0,0.02')
+  parser.add_argument('-e', '--chord', help='delta chord errors to compare, e.g. 0,0.005')
+  parser.add_argument('--cxx', default='g++', help='host C++ compiler')
+  args = parser.parse_args()
+
+  for mech in args.mech.split(','):
+    if mech not in mechanisms:
+      sys.exit('Unknown mechanism ' + mech)
+    if args.junction and mech == 'delta':
+      print('== %s skipped, JUNCTION_DEVIATION is not available' % mech)
+      continue
+    tmp = tempfile.mkdtemp(prefix='mk4duo_bench_')
+    try:
+      work = os.path.join(tmp, 'MK4duo')
+      shutil.copytree(firmware_dir, work)
+      print('== %s' % mech)
+      binary = build(work, mech, args)
+      for gcode in args.files:
+        if args.junction:
+          for junction in args.junction.split(','):
+            name = '%s J%s' % (os.path.basename(gcode), junction)
+            print('%-30s %s' % (name, run(binary, work, os.path.abspath(gcode), junction)))
+        elif args.chord and mech == 'delta':
+          for chord in args.chord.split(','):
+            name = '%s E%s' % (os.path.basename(gcode), chord)
+            print('%-30s %s' % (name, run(binary, work, os.path.abspath(gcode), chord=chord)))
+        else:
+          print('%-30s %s' % (os.path.basename(gcode), run(binary, work, os.path.abspath(gcode))))
+    finally:
+      shutil.rmtree(tmp)
+
+if __name__ == '__main__':
+  main()
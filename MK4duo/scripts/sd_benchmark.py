@@ -0,0 +1,249 @@
+#!/usr/bin/python3
+
+# SD read benchmark
+#
+# Writes the given G-code files on a FAT16 disk image and reads them back
+# through CardReader from the SD card emulated by the host-native Linux
+# firmware (see Documentation/Compilation.md, the image is given to the
+# firmware with MK4DUO_SDCARD). The firmware is built with SDSUPPORT and
+# without its main(), without SD_READ_AHEAD, with it and with it and
+# SD_SPI_DMA, and linked with a small test program that reads every file
+# line by line:
+#
+#  - get:           the loop of get_sdcard_commands before get_line(),
+#                   one CardReader::get() per char;
+#  - get_line:      CardReader::get_line(), filling the read ahead buffer
+#                   on demand;
+#  - get_line+idle: the same with the buffer filled by read_ahead() between
+#                   the lines, as idle() does while the moves wait for the
+#                   planner. The time of the fill is not counted in the
+#                   time per line but reported apart, it is the CPU time
+#                   taken from the main loop. Every line is followed by
+#                   the time its moves take on the printer (-g), with
+#                   SD_SPI_DMA the card and the DMA work in that time.
+#
+# The card costs its SPI transfer time and a block access time on the
+# simulated clock. For every file the report gives the command lines,
+# the lines/s of host time and the simulated time per line with the worst
+# stall of a single line, which is the time the main loop can't feed the
+# planner.
+#
+# Usage:
+#   scripts/sd_benchmark.py [-b 4] [-a 300] [-g 100] [-n 5] [--cxx g++] file.gcode [file.gcode ...]
+
+import argparse
+import os
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+
+from planner_benchmark import build_firmware, firmware_dir, set_define
+
+SECTOR = 512
+SECTORS_PER_CLUSTER = 4
+ROOT_ENTRIES = 512
+RESERVED_SECTORS = 1
+
+test_program = r'''
+#include <time.h>
+#include "base.h"
+
+static double now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// The loop of get_sdcard_commands before get_line
+static uint16_t get_chars(char* buf, const uint16_t size) {
+  uint16_t count = 0;
+  bool comment = false;
+  for (;;) {
+    const int16_t n = card.get();
+    const char c = (char)n;
+    if (card.eof() || n == -1 || c == '\n' || c == '\r' || ((c == '#' || c == ':') && !comment)) break;
+    if (count >= size - 1) continue;
+    if (c == ';') comment = true;
+    if (!comment) buf[count++] = c;
+  }
+  buf[count] = '\0';
+  return count;
+}
+
+static void bench(const char* name, const char* file, const int mode, const int passes, const uint32_t gap) {
+  char line[MAX_CMD_SIZE];
+  unsigned long lines = 0;
+  uint64_t sim = 0, worst = 0, fill = 0;
+  double host = 0;
+
+  for (int p = 0; p < passes; p++) {
+    if (!card.selectFile(file, true)) {
+      printf("Can't open %s\n", file);
+      exit(EXIT_FAILURE);
+    }
+    card.startFileprint();
+    #if ENABLED(SD_READ_AHEAD)
+      // The buffer fills up while the print starts
+      if (mode == 2) for (uint8_t i = 0; i < 100; i++) {
+        card.read_ahead();
+        HAL_sim_consume(gap * STEPPER_TIMER_TICKS_PER_US);
+      }
+    #endif
+    lines = 0;
+    const double start = now_ns();
+    while (!card.eof()) {
+      const uint64_t t = HAL_sim_ticks;
+      int16_t term = 0;
+      const uint16_t count = mode ? card.get_line(line, sizeof(line), term) : get_chars(line, sizeof(line));
+      const uint64_t ticks = HAL_sim_ticks - t;
+      if (term < 0) {
+        printf("Read error in %s\n", file);
+        exit(EXIT_FAILURE);
+      }
+      sim += ticks;
+      if (ticks > worst) worst = ticks;
+      if (count) lines++;
+      #if ENABLED(SD_READ_AHEAD)
+        if (mode == 2) {
+          const uint64_t f = HAL_sim_ticks;
+          card.read_ahead();
+          fill += HAL_sim_ticks - f;
+          HAL_sim_consume(gap * STEPPER_TIMER_TICKS_PER_US);
+        }
+      #endif
+    }
+    host += now_ns() - start;
+    card.sdprinting = false;
+  }
+
+  const double n = (double)lines * passes;
+  printf("%-20s %-14s %7lu lines %9.0f lines/s host %7.1f us/line sim, worst %7.1f us", file, name, lines,
+         n * 1e9 / host, sim / n / STEPPER_TIMER_TICKS_PER_US, (double)worst / STEPPER_TIMER_TICKS_PER_US);
+  if (mode == 2) printf(", fill %5.1f us/line", fill / n / STEPPER_TIMER_TICKS_PER_US);
+  printf("\n");
+}
+
+int main(int argc, char** argv) {
+  const int passes = atoi(argv[1]);
+  const uint32_t gap = atoi(argv[2]);
+  card.mount();
+  if (!card.cardOK) return EXIT_FAILURE;
+  for (int f = 3; f < argc; f++) {
+    #if ENABLED(SD_READ_AHEAD)
+      bench("get_line", argv[f], 1, passes, gap);
+      bench("get_line+idle", argv[f], 2, passes, gap);
+    #else
+      bench("get", argv[f], 0, passes, gap);
+      bench("get_line", argv[f], 1, passes, gap);
+    #endif
+  }
+  return EXIT_SUCCESS;
+}
+'''
+
+
+def fat16_image(path, files, sectors=65536):
+  # Superfloppy FAT16 volume, every file is contiguous from cluster 2
+  cluster_size = SECTOR * SECTORS_PER_CLUSTER
+  root_sectors = ROOT_ENTRIES * 32 // SECTOR
+  clusters = sectors // SECTORS_PER_CLUSTER
+  fat_sectors = (2 * (clusters + 2) + SECTOR - 1) // SECTOR
+  fat_start = RESERVED_SECTORS
+  root_start = fat_start + 2 * fat_sectors
+  data_start = root_start + root_sectors
+
+  needed = sum((len(data) + cluster_size - 1) // cluster_size for name, data in files)
+  if needed > (sectors - data_start) // SECTORS_PER_CLUSTER:
+    sys.exit('The G-code files do not fit in the disk image')
+
+  boot = bytearray(SECTOR)
+  boot[0:3] = b'\xEB\x3C\x90'
+  boot[3:11] = b'MK4DUO  '
+  struct.pack_into('<HBHBHHBHHHII', boot, 11, SECTOR, SECTORS_PER_CLUSTER, RESERVED_SECTORS, 2,
+                   ROOT_ENTRIES, 0, 0xF8, fat_sectors, 63, 255, 0, sectors)
+  struct.pack_into('<BBBI11s8s', boot, 36, 0x80, 0, 0x29, 0x4D4B3444, b'MK4DUO SD  ', b'FAT16   ')
+  boot[510:512] = b'\x55\xAA'
+
+  fat = [0xFFF8, 0xFFFF]
+  root = bytearray()
+  data = bytearray()
+  for name, content in files:
+    count = (len(content) + cluster_size - 1) // cluster_size
+    first = len(fat) if count else 0
+    for c in range(count):
+      fat.append(len(fat) + 1 if c < count - 1 else 0xFFFF)
+    base, ext = name.upper().split('.')
+    root += struct.pack('<8s3sB10sHHHI', base.ljust(8).encode(), ext.ljust(3).encode(), 0x20,
+                        bytes(10), 0, 0x21, first, len(content))
+    data += content + bytes(count * cluster_size - len(content))
+
+  fat_bytes = struct.pack('<%dH' % len(fat), *fat)
+  with open(path, 'wb') as f:
+    f.truncate(sectors * SECTOR)
+    f.write(boot)
+    for n in range(2):
+      f.seek((fat_start + n * fat_sectors) * SECTOR)
+      f.write(fat_bytes)
+    f.seek(root_start * SECTOR)
+    f.write(root)
+    f.seek(data_start * SECTOR)
+    f.write(data)
+
+
+def build(work, read_ahead, dma, args):
+  feature = os.path.join(work, 'Configuration_Feature.h')
+  set_define(feature, 'SDSUPPORT', '')
+  if read_ahead:
+    set_define(feature, 'SD_READ_AHEAD', str(args.blocks))
+  if dma:
+    set_define(feature, 'SD_SPI_DMA', '')
+
+  test = os.path.join(work, 'sd_bench.cpp')
+  with open(test, 'w') as f:
+    f.write(test_program)
+  return build_firmware(work, os.path.join(work, 'sd_bench'), args.cxx, ['HAL_SIM_SD_ACCESS_US=%d' % args.access], test)
+
+
+def main():
+  parser = argparse.ArgumentParser(description='MK4duo SD read benchmark')
+  parser.add_argument('files', nargs='+', help='G-code files')
+  parser.add_argument('-b', '--blocks', type=int, default=4, help='SD_READ_AHEAD blocks')
+  parser.add_argument('-a', '--access', type=int, default=300, help='block access time in us (HAL_SIM_SD_ACCESS_US)')
+  parser.add_argument('-g', '--gap', type=int, default=100, help='time of the moves of a line in us, for get_line+idle')
+  parser.add_argument('-n', '--passes', type=int, default=5, help='reads of every file')
+  parser.add_argument('--cxx', default='g++', help='host C++ compiler')
+  args = parser.parse_args()
+
+  tmp = tempfile.mkdtemp(prefix='mk4duo_sd_')
+  try:
+    files = []
+    for i, path in enumerate(args.files):
+      with open(path, 'rb') as f:
+        files.append(('FILE%d.GCO' % i, f.read()))
+    image = os.path.join(tmp, 'sdcard.img')
+    fat16_image(image, files)
+    env = dict(os.environ, MK4DUO_SDCARD=image, MK4DUO_EEPROM=os.path.join(tmp, 'eeprom.bin'))
+
+    for read_ahead, dma in ((False, False), (True, False), (True, True)):
+      work = os.path.join(tmp, 'MK4duo')
+      shutil.copytree(firmware_dir, work)
+      print('== %s' % ('SD_READ_AHEAD %d%s' % (args.blocks, ' SD_SPI_DMA' if dma else '') if read_ahead else 'no read ahead'))
+      binary = build(work, read_ahead, dma, args)
+      out = subprocess.run([binary, str(args.passes), str(args.gap)] + [name.lower() for name, data in files],
+                           stdout=subprocess.PIPE, universal_newlines=True, env=env)
+      for line in out.stdout.splitlines():
+        if line.startswith('file'):
+          n = int(line[4:].split('.', 1)[0])
+          print(os.path.basename(args.files[n]).ljust(20) + line[20:])
+        elif 'rror' in line or 'fail' in line:
+          print(line)
+      shutil.rmtree(work)
+      if out.returncode:
+        sys.exit(out.returncode)
+  finally:
+    shutil.rmtree(tmp)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,113 @@
+#!/usr/bin/python3
+
+# Serial report benchmark
+#
+# Measures how long the main loop is stalled by a command that prints a
+# long report (M503 by default) on the serial port. The host-native Linux
+# firmware (see Documentation/Compilation.md) is built without its main()
+# and with the UART of the Due modelled at the given baud rate
+# (HAL_SIM_BAUDRATE): every character takes 10 bit times on the wire and
+# the writer waits when the 128 bytes buffer of the Arduino core is full.
+# It is built without SERIAL_TX_BUFFER and with it, and linked with a small
+# test program that runs every command through loop():
+#
+#  - stall: the simulated time of the loop() that executes the command,
+#           the time the main loop can't read commands or feed the planner;
+#  - wire:  the time until the last character of the report is sent,
+#           running idle() after the command.
+#
+# Usage:
+#   scripts/serial_benchmark.py [-b 250000] [-t 1024] [-n 5] [--cxx g++] [M503 M115 ...]
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from planner_benchmark import build_firmware, firmware_dir, set_define
+
+test_program = r'''
+#include "base.h"
+
+extern void setup();
+extern void loop();
+
+// Run idle() until the UART has sent everything
+static void drain() {
+  #if ENABLED(SERIAL_TX_BUFFER)
+    HAL::serialFlush();
+  #endif
+  while (HAL_sim_uart_available_for_write() < 128) idle();
+}
+
+int main(int argc, char** argv) {
+  const int passes = atoi(argv[1]);
+  setup();
+  while (commands_in_queue) loop();
+  drain();
+
+  for (int c = 2; c < argc; c++) {
+    uint64_t stall = 0, worst = 0, wire = 0;
+    for (int p = 0; p < passes; p++) {
+      enqueue_and_echo_command(argv[c]);
+      drain();
+      const uint64_t start = HAL_sim_ticks;
+      while (commands_in_queue) {
+        const uint64_t t = HAL_sim_ticks;
+        loop();
+        const uint64_t ticks = HAL_sim_ticks - t;
+        stall += ticks;
+        if (ticks > worst) worst = ticks;
+      }
+      drain();
+      wire += HAL_sim_ticks - start;
+    }
+    fprintf(stderr, "%-8s stall %9.1f us, worst %9.1f us, wire %9.1f us\n", argv[c],
+            (double)stall / passes / STEPPER_TIMER_TICKS_PER_US, (double)worst / STEPPER_TIMER_TICKS_PER_US,
+            (double)wire / passes / STEPPER_TIMER_TICKS_PER_US);
+  }
+  return EXIT_SUCCESS;
+}
+'''
+
+
+def build(work, tx_buffer, args):
+  if tx_buffer:
+    set_define(os.path.join(work, 'Configuration_Basic.h'), 'SERIAL_TX_BUFFER', str(tx_buffer))
+
+  test = os.path.join(work, 'serial_bench.cpp')
+  with open(test, 'w') as f:
+    f.write(test_program)
+  return build_firmware(work, os.path.join(work, 'serial_bench'), args.cxx, ['HAL_SIM_BAUDRATE=%d' % args.baudrate], test)
+
+
+def main():
+  parser = argparse.ArgumentParser(description='MK4duo serial report benchmark')
+  parser.add_argument('commands', nargs='*', default=['M503'], help='commands to run')
+  parser.add_argument('-b', '--baudrate', type=int, default=250000, help='baud rate of the UART (HAL_SIM_BAUDRATE)')
+  parser.add_argument('-t', '--tx-buffer', type=int, default=1024, help='SERIAL_TX_BUFFER size')
+  parser.add_argument('-n', '--passes', type=int, default=5, help='runs of every command')
+  parser.add_argument('--cxx', default='g++', help='host C++ compiler')
+  args = parser.parse_args()
+
+  tmp = tempfile.mkdtemp(prefix='mk4duo_serial_')
+  try:
+    env = dict(os.environ, MK4DUO_EEPROM=os.path.join(tmp, 'eeprom.bin'))
+    for tx_buffer in (0, args.tx_buffer):
+      work = os.path.join(tmp, 'MK4duo')
+      shutil.copytree(firmware_dir, work)
+      print('== %s at %d baud' % ('SERIAL_TX_BUFFER %d' % tx_buffer if tx_buffer else 'no TX buffer', args.baudrate))
+      sys.stdout.flush()
+      binary = build(work, tx_buffer, args)
+      out = subprocess.run([binary, str(args.passes)] + args.commands, stdin=subprocess.DEVNULL,
+                           stdout=subprocess.DEVNULL, env=env)
+      shutil.rmtree(work)
+      if out.returncode:
+        sys.exit(out.returncode)
+  finally:
+    shutil.rmtree(tmp)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,141 @@
+#!/usr/bin/python3
+
+# Dense thermistor table check
+#
+# For every thermistor table in src/temperature/thermistortable, builds a
+# small host program with TEMP_SENSOR_0 set to it and the Linux HAL (see
+# Documentation/Compilation.md), which compares thermistor2temp, the
+# conversion of temperature.cpp with the dense table, to the scan of the
+# temptable used before:
+#
+#  - over the whole ADC range (0 - 1023) the two must agree within 0.1 C;
+#  - out of the ADC range (-64 - 16383), where thermistor2temp scans the
+#    temptable, they must be equal;
+#  - where the scan gives more than THERMISTOR_DENSE_MAX or an infinity,
+#    the dense table must give the largest temperature of the same sign.
+#
+# The report gives the worst difference of every table and the host time
+# of both conversions.
+#
+# Usage:
+#   scripts/thermistor_table_check.py [--cxx g++] [1 5 60 ...]
+
+import argparse
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+from planner_benchmark import build_firmware, firmware_dir, set_define
+
+test_program = r'''
+#include <time.h>
+#include "base.h"
+#include "src/temperature/thermistortable/thermistortable_dense.h"
+
+#define PGM_RD_W(x)   (short)pgm_read_word(&x)
+
+static double now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Temperature::analog2temp before the dense tables
+static float scan2temp(const int raw) {
+  float celsius = 0;
+  uint8_t i;
+  short(*tt)[][2] = (short(*)[][2])(HEATER_0_TEMPTABLE);
+
+  for (i = 1; i < HEATER_0_TEMPTABLE_LEN; i++) {
+    if (PGM_RD_W((*tt)[i][0]) > raw) {
+      celsius = PGM_RD_W((*tt)[i - 1][1]) +
+                (raw - PGM_RD_W((*tt)[i - 1][0])) *
+                (float)(PGM_RD_W((*tt)[i][1]) - PGM_RD_W((*tt)[i - 1][1])) /
+                (float)(PGM_RD_W((*tt)[i][0]) - PGM_RD_W((*tt)[i - 1][0]));
+      break;
+    }
+  }
+
+  // Overflow: Set to last value in the table
+  if (i == HEATER_0_TEMPTABLE_LEN) celsius = PGM_RD_W((*tt)[i - 1][1]);
+
+  return celsius;
+}
+
+static float dense2temp(const int raw) {
+  return thermistor2temp(HEATER_0_TEMPTABLE, HEATER_0_TEMPTABLE_LEN, HEATER_0_DENSETABLE, raw);
+}
+
+int main() {
+  float worst = 0;
+  int worst_raw = 0, errors = 0;
+  for (int raw = -64; raw < 16384; raw++) {
+    const float scan = scan2temp(raw), dense = dense2temp(raw);
+    // The dense table saturates where the scan gives a huge temperature or an infinity
+    const float diff = WITHIN(raw, 0, THERMISTOR_DENSE_SIZE - 1) && fabs(scan) >= THERMISTOR_DENSE_MAX
+                       ? fabs(dense) * (THERMISTOR_DENSE_SCALE) != 32767 || (dense < 0) != (scan < 0)
+                       : dense == scan ? 0 : fabs(dense - scan);
+    if (WITHIN(raw, 0, THERMISTOR_DENSE_SIZE - 1) ? diff > 0.1 : diff != 0) {
+      if (++errors <= 5) printf("raw %5d: scan %8.3f dense %8.3f\n", raw, scan, dense);
+    }
+    if (diff > worst) {
+      worst = diff;
+      worst_raw = raw;
+    }
+  }
+
+  volatile float sink = 0;
+  double t = now_ns();
+  for (int n = 0; n < 100; n++)
+    for (int raw = 0; raw < THERMISTOR_DENSE_SIZE; raw++) sink += scan2temp(raw);
+  const double scan_ns = (now_ns() - t) / (100.0 * THERMISTOR_DENSE_SIZE);
+  t = now_ns();
+  for (int n = 0; n < 100; n++)
+    for (int raw = 0; raw < THERMISTOR_DENSE_SIZE; raw++) sink += dense2temp(raw);
+  const double dense_ns = (now_ns() - t) / (100.0 * THERMISTOR_DENSE_SIZE);
+
+  printf("%3d rows, worst %.4f C at raw %d, scan %6.1f ns, dense %5.1f ns%s\n", HEATER_0_TEMPTABLE_LEN,
+         worst, worst_raw, scan_ns, dense_ns, errors ? " FAILED" : "");
+  return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+'''
+
+
+def main():
+  parser = argparse.ArgumentParser(description='MK4duo dense thermistor table check')
+  parser.add_argument('tables', nargs='*', type=int, help='thermistor tables to check (default all)')
+  parser.add_argument('--cxx', default='g++', help='host C++ compiler')
+  args = parser.parse_args()
+
+  tables = args.tables
+  if not tables:
+    names = glob.glob(os.path.join(firmware_dir, 'src', 'temperature', 'thermistortable', 'thermistortable_*.h'))
+    tables = sorted(int(m.group(1)) for m in (re.search(r'_(\d+)\.h$', n) for n in names) if m)
+
+  tmp = tempfile.mkdtemp(prefix='mk4duo_thermistor_')
+  failed = 0
+  try:
+    work = os.path.join(tmp, 'MK4duo')
+    shutil.copytree(firmware_dir, work)
+    test = os.path.join(work, 'thermistor_check.cpp')
+    with open(test, 'w') as f:
+      f.write(test_program)
+    binary = os.path.join(work, 'thermistor_check')
+    for table in tables:
+      set_define(os.path.join(work, 'Configuration_Temperature.h'), 'TEMP_SENSOR_0', str(table))
+      build_firmware(work, binary, args.cxx, test=test, firmware=False)
+      out = subprocess.run([binary], stdout=subprocess.PIPE, universal_newlines=True)
+      for line in out.stdout.splitlines():
+        print('%-5d %s' % (table, line))
+      sys.stdout.flush()
+      failed |= out.returncode
+  finally:
+    shutil.rmtree(tmp)
+  sys.exit(failed)
+
+if __name__ == '__main__':
+  main()
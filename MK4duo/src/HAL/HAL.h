@@ -26,6 +26,7 @@
  * Supports platforms:
  *    ARDUINO_ARCH_SAM : For Arduino Due and other boards based on Atmel SAM3X8E
  *    ARDUINO_ARCH_AVR : For all Atmel AVR boards
+ *    ARDUINO_ARCH_LINUX : Host-native build running on a simulated clock
  */
 
 #ifndef _HAL_H
@@ -40,8 +41,18 @@
 #elif ENABLED(ARDUINO_ARCH_AVR)
   #include "HAL_AVR/HAL_AVR.h"
   #include "HAL_AVR/communication.h"
+#elif ENABLED(ARDUINO_ARCH_LINUX)
+  #define CPU_32_BIT
+  #include "HAL_LINUX/HAL_Linux.h"
+  #include "HAL_LINUX/communication.h"
 #else
   #error "Unsupported Platform!"
 #endif
 
+// Time base for the debug benchmarks, a HAL can override it
+#ifndef HAL_BENCH_MICROS
+  #define HAL_BENCH_MICROS()    micros()
+  #define HAL_BENCH_CHARGE(US)  NOOP
+#endif
+
 #endif // _HAL_H
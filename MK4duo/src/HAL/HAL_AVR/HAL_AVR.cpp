@@ -240,6 +240,7 @@ void HAL::setPwmFrequency(uint8_t pin, uint8_t val) {
  * It is used to update pwm values for heater and some other frequent jobs.
  *
  *  - Manage PWM to all the heaters and fan
+ *  - Every 100ms run the PID of the heaters (temp_controller_isr)
  *  - Prepare or Measure one of the raw ADC sensor values
  *  - Step the babysteps value for each axis towards 0
  *  - For PINS_DEBUGGING, monitor and report endstop pins
@@ -247,6 +248,10 @@ void HAL::setPwmFrequency(uint8_t pin, uint8_t val) {
  */
 HAL_TEMP_TIMER_ISR {
 
+  #if ENABLED(ISR_STATISTICS)
+    const uint32_t isr_start = HAL_CYCLE_COUNT();
+  #endif
+
   // Allow UART ISRs
   _DISABLE_ISRs();
 
@@ -283,16 +288,16 @@ HAL_TEMP_TIMER_ISR {
    */
   if (pwm_count_heater == 0) {
     #if HOTENDS > 0
-      if ((pwm_heater_pos[0] = (thermalManager.soft_pwm[0] & HEATER_PWM_MASK)) > 0)
+      if ((pwm_heater_pos[0] = (thermalManager.heaters[0].soft_pwm & HEATER_PWM_MASK)) > 0)
         WRITE_HEATER_0(HIGH);
       #if HOTENDS > 1
-        if ((pwm_heater_pos[1] = (thermalManager.soft_pwm[1] & HEATER_PWM_MASK)) > 0)
+        if ((pwm_heater_pos[1] = (thermalManager.heaters[1].soft_pwm & HEATER_PWM_MASK)) > 0)
           WRITE_HEATER_1(HIGH);
         #if HOTENDS > 2
-          if ((pwm_heater_pos[2] = (thermalManager.soft_pwm[2] & HEATER_PWM_MASK)) > 0)
+          if ((pwm_heater_pos[2] = (thermalManager.heaters[2].soft_pwm & HEATER_PWM_MASK)) > 0)
             WRITE_HEATER_2(HIGH);
           #if HOTENDS > 3
-            if ((pwm_heater_pos[3] = (thermalManager.soft_pwm[3] & HEATER_PWM_MASK)) > 0)
+            if ((pwm_heater_pos[3] = (thermalManager.heaters[3].soft_pwm & HEATER_PWM_MASK)) > 0)
               WRITE_HEATER_0(HIGH);
           #endif
         #endif
@@ -300,17 +305,17 @@ HAL_TEMP_TIMER_ISR {
     #endif
 
     #if HAS_HEATER_BED && HAS_TEMP_BED
-      if ((pwm_bed_pos = (thermalManager.soft_pwm_bed & HEATER_PWM_MASK)) > 0)
+      if ((pwm_bed_pos = (thermalManager.heaters[BED_INDEX].soft_pwm & HEATER_PWM_MASK)) > 0)
         WRITE_HEATER_BED(HIGH);
     #endif
 
     #if HAS_HEATER_CHAMBER && HAS_TEMP_CHAMBER
-      if ((pwm_chamber_pos = (thermalManager.soft_pwm_chamber & HEATER_PWM_MASK)) > 0)
+      if ((pwm_chamber_pos = (thermalManager.heaters[CHAMBER_INDEX].soft_pwm & HEATER_PWM_MASK)) > 0)
         WRITE_HEATER_CHAMBER(HIGH);
     #endif
 
     #if HAS_COOLER && HAS_TEMP_COOLER
-      if ((pwm_cooler_pos = (thermalManager.soft_pwm_cooler & HEATER_PWM_MASK)) > 0)
+      if ((pwm_cooler_pos = (thermalManager.heaters[COOLER_INDEX].soft_pwm & HEATER_PWM_MASK)) > 0)
         WRITE_COOLER(HIGH);
     #endif
 
@@ -395,6 +400,7 @@ HAL_TEMP_TIMER_ISR {
   if (cycle_100ms >= 390) {
     cycle_100ms = 0;
     HAL::execute_100ms = true;
+    thermalManager.temp_controller_isr();
     #if ENABLED(FAN_KICKSTART_TIME)
       if (fanKickstart) fanKickstart--;
     #endif
@@ -471,6 +477,10 @@ HAL_TEMP_TIMER_ISR {
     }
   #endif
 
+  #if ENABLED(ISR_STATISTICS)
+    isrStats.record(ISR_TEMPERATURE, HAL_CYCLES_SINCE(isr_start));
+  #endif
+
   _ENABLE_ISRs(); // re-enable ISRs
 }
 
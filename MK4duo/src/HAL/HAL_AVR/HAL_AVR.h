@@ -283,6 +283,19 @@ typedef uint8_t   Pin;
 
 // Clock speed factor
 #define CYCLES_PER_US ((F_CPU) / 1000000) // 16 or 20
+
+// Cycle counter for the ISR statistics. There is no free running counter,
+// Timer1 counts F_CPU / 8 in CTC mode from the last stepper compare match,
+// so at the entry of the stepper ISR it is also its lateness.
+#define HAL_CYCLE_COUNT()       ((uint32_t)TCNT1 << 3)
+#define HAL_STEPPER_LATENESS()  ((uint32_t)TCNT1 << 3)
+
+static FORCE_INLINE uint32_t HAL_cycles_since(const uint32_t start) {
+  uint32_t now = TCNT1;
+  if ((now << 3) < start) now += OCR1A + 1UL; // Timer1 restarted from zero
+  return (now << 3) - start;
+}
+#define HAL_CYCLES_SINCE(start) HAL_cycles_since(start)
 // Stepper pulse duration, in cycles
 #define STEP_PULSE_CYCLES ((MINIMUM_STEPPER_PULSE) * CYCLES_PER_US)
 
@@ -68,13 +68,34 @@ extern "C" char *sbrk(int i);
 uint8_t MCUSR;
 
 #if ANALOG_INPUTS > 0
+  #if ENABLED(ADC_DMA)
+    #define ADC_FILTER_MAX (ADC_TEMP_FILTER > ADC_FAST_FILTER ? ADC_TEMP_FILTER : ADC_FAST_FILTER)
+    #define ADC_DMA_WORDS (ADC_DMA_SEQUENCES * ANALOG_INPUTS)
+  #else
+    #define ADC_FILTER_MAX MEDIAN_COUNT
+  #endif
+
   int32_t   AnalogInputRead[ANALOG_INPUTS],
-            AnalogSamples[ANALOG_INPUTS][MEDIAN_COUNT],
+            AnalogSamples[ANALOG_INPUTS][ADC_FILTER_MAX],
             AnalogSamplesSum[ANALOG_INPUTS],
             adcSamplesMin[ANALOG_INPUTS],
             adcSamplesMax[ANALOG_INPUTS];
-  int       adcCounter = 0,
-            adcSamplePos = 0;
+  #if ENABLED(ADC_DMA)
+    int       adcCounter[ANALOG_INPUTS],
+              adcSamplePos[ANALOG_INPUTS];
+    uint8_t   adcSamples[ANALOG_INPUTS],    // conversions of a sample, with the lowest and the highest
+              adcShift[ANALOG_INPUTS],      // to the average of a sample, and to 10 bit
+              adcFilter[ANALOG_INPUTS],     // samples of the moving average
+              adcChannelInput[16];          // analog input of an ADC channel, 0xFF if not sampled
+    uint16_t  adcFilled = 0,
+              adcDmaBuffer[2][ADC_DMA_WORDS];
+    uint8_t   adcDmaPos = 0;
+
+    volatile uint32_t HAL::AnalogInputSeq = 0;
+  #else
+    int       adcCounter = 0,
+              adcSamplePos = 0;
+  #endif
   uint32_t  adcEnable = 0;
   bool      Analog_is_ready = false;
 
@@ -128,6 +149,13 @@ void HAL::hwSetup(void) {
                TC_CMR_WAVE | DELAY_TIMER_CLOCK);
   TC_Start(DELAY_TIMER, DELAY_TIMER_CHANNEL);
 
+  #if ENABLED(ISR_STATISTICS)
+    // Start the cycle counter
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  #endif
+
   #if MB(ALLIGATOR) || MB(ALLIGATOR_V3)
 
     ExternalDac::begin();
@@ -230,14 +258,42 @@ int HAL::getFreeRam() {
     ADC->ADC_WPMR = 0x41444300u;    // ADC_WPMR_WPKEY(0);
     pmc_enable_periph_clk(ID_ADC);  // enable adc clock
 
+    #if ENABLED(ADC_DMA)
+      for (int c = 0; c < 16; c++) adcChannelInput[c] = 0xFF;
+    #endif
+
     for (int i = 0; i < ANALOG_INPUTS; i++) {
       AnalogInputValues[i] = 0;
       adcSamplesMin[i] = 100000;
       adcSamplesMax[i] = 0;
       adcEnable |= (0x1u << pinToAdcChannel(AnalogInputChannels[i]));
-      AnalogSamplesSum[i] = 2048 * MEDIAN_COUNT;
-      for (int j = 0; j < MEDIAN_COUNT; j++)
-        AnalogSamples[i][j] = 2048;
+      #if ENABLED(ADC_DMA)
+        // The filament width, power and keypad readings follow the input fast, the thermistors are filtered
+        const bool fast = false
+          #if HAS_FILAMENT_SENSOR
+            || i == FILAMENT_SENSOR_INDEX
+          #endif
+          #if HAS_POWER_CONSUMPTION_SENSOR
+            || i == POWER_SENSOR_INDEX
+          #endif
+          #if ENABLED(ADC_KEYPAD)
+            || i == ADC_KEYPAD_SENSOR_INDEX
+          #endif
+        ;
+        const uint8_t oversample = fast ? ADC_FAST_OVERSAMPLE : ADC_TEMP_OVERSAMPLE;
+        adcChannelInput[pinToAdcChannel(AnalogInputChannels[i])] = i;
+        adcSamples[i] = 2 + (1 << oversample);
+        adcShift[i] = oversample + (i == MCU_SENSOR_INDEX ? 0 : 2 - ANALOG_REDUCE_BITS);
+        adcFilter[i] = fast ? ADC_FAST_FILTER : ADC_TEMP_FILTER;
+        adcCounter[i] = adcSamplePos[i] = 0;
+        AnalogInputRead[i] = AnalogSamplesSum[i] = 0;
+        for (int j = 0; j < ADC_FILTER_MAX; j++)
+          AnalogSamples[i][j] = 0;
+      #else
+        AnalogSamplesSum[i] = 2048 * MEDIAN_COUNT;
+        for (int j = 0; j < MEDIAN_COUNT; j++)
+          AnalogSamples[i][j] = 2048;
+      #endif
     }
 
     // enable channels
@@ -258,21 +314,120 @@ int HAL::getFreeRam() {
     // set tracking time  (TRACKTIM+1) * clock periods
     // set transfer period  (TRANSFER * 2 + 3)
     ADC->ADC_MR = ADC_MR_TRGEN_DIS | ADC_MR_TRGSEL_ADC_TRIG0 | ADC_MR_LOWRES_BITS_12 |
-                  ADC_MR_SLEEP_NORMAL | ADC_MR_FWUP_OFF | ADC_MR_FREERUN_OFF |
+                  ADC_MR_SLEEP_NORMAL | ADC_MR_FWUP_OFF |
+                  #if ENABLED(ADC_DMA)
+                    ADC_MR_FREERUN_ON |
+                  #else
+                    ADC_MR_FREERUN_OFF |
+                  #endif
                   ADC_MR_STARTUP_SUT64 | ADC_MR_SETTLING_AST17 | ADC_MR_ANACH_NONE |
                   ADC_MR_USEQ_NUM_ORDER |
                   ADC_MR_PRESCAL(AD_PRESCALE_FACTOR) |
                   ADC_MR_TRACKTIM(AD_TRACKING_CYCLES) |
                   ADC_MR_TRANSFER(AD_TRANSFER_CYCLES);
 
-    ADC->ADC_IER = 0;             // no ADC interrupts
     ADC->ADC_CGR = 0;             // Gain = 1
     ADC->ADC_COR = 0;             // Single-ended, no offset
 
+    #if ENABLED(ADC_DMA)
+      // Tag the conversions with the channel, the PDC fills a buffer and goes on with the next
+      ADC->ADC_EMR = ADC_EMR_TAG;
+      ADC->ADC_PTCR = ADC_PTCR_RXTDIS;
+      ADC->ADC_RPR = (uint32_t)adcDmaBuffer[0];
+      ADC->ADC_RCR = ADC_DMA_WORDS;
+      ADC->ADC_RNPR = (uint32_t)adcDmaBuffer[1];
+      ADC->ADC_RNCR = ADC_DMA_WORDS;
+      adcDmaPos = 0;
+      ADC->ADC_PTCR = ADC_PTCR_RXTEN;
+
+      // Above the temperature timer, set_current_temp_raw() never interrupts a write
+      ADC->ADC_IDR = 0xFFFFFFFF;
+      ADC->ADC_IER = ADC_IER_ENDRX;
+      NVIC_SetPriority(ADC_IRQn, 14);
+      NVIC_EnableIRQ(ADC_IRQn);
+    #else
+      ADC->ADC_IER = 0;           // no ADC interrupts
+    #endif
+
     // start first conversion
     ADC->ADC_CR = ADC_CR_START;
   }
 
+  #if ENABLED(ADC_DMA)
+
+    /**
+     * ADC with DMA
+     *
+     * The ADC converts the enabled channels in free-run and the PDC stores
+     * the tagged conversions in two buffers in turn. At the end of a buffer
+     * the conversions are summed per input: 2^oversample of them, less the
+     * lowest and the highest, make a sample, the moving average of the last
+     * samples is the value. The values are written with AnalogInputSeq odd,
+     * a reader copies them and checks the sequence did not change meanwhile.
+     */
+    static void adcStore(const uint16_t* buf) {
+      uint16_t updated = 0;
+
+      for (uint16_t w = 0; w < ADC_DMA_WORDS; w++) {
+        const uint8_t i = adcChannelInput[buf[w] >> 12];
+        if (i >= ANALOG_INPUTS) continue;
+        const int32_t cur = buf[w] & 0x0FFF;
+        AnalogInputRead[i] += cur;
+        NOMORE(adcSamplesMin[i], cur);
+        NOLESS(adcSamplesMax[i], cur);
+        if (++adcCounter[i] >= adcSamples[i]) {
+          const int32_t sample = (AnalogInputRead[i] - adcSamplesMin[i] - adcSamplesMax[i] + ((1 << adcShift[i]) >> 1)) >> adcShift[i];
+          AnalogSamplesSum[i] += sample - AnalogSamples[i][adcSamplePos[i]];
+          AnalogSamples[i][adcSamplePos[i]] = sample;
+          if (++adcSamplePos[i] >= adcFilter[i]) {
+            adcSamplePos[i] = 0;
+            adcFilled |= 1 << i;
+          }
+          AnalogInputRead[i] = 0;
+          adcSamplesMin[i] = 100000;
+          adcSamplesMax[i] = 0;
+          adcCounter[i] = 0;
+          updated |= 1 << i;
+        }
+      }
+
+      if (updated) {
+        HAL::AnalogInputSeq++;
+        for (uint8_t i = 0; i < ANALOG_INPUTS; i++)
+          if (TEST(updated, i)) HAL::AnalogInputValues[i] = AnalogSamplesSum[i] / adcFilter[i];
+        HAL::AnalogInputSeq++;
+        if (adcFilled == (1 << ANALOG_INPUTS) - 1) Analog_is_ready = true;
+      }
+    }
+
+    void ADC_Handler() {
+      const uint8_t pos = adcDmaPos;
+      adcStore(adcDmaBuffer[pos]);
+      if (ADC->ADC_ISR & ADC_ISR_RXBUFF) {
+        // Late, the PDC stopped with both buffers full: take the other one too and restart
+        adcStore(adcDmaBuffer[pos ^ 1]);
+        ADC->ADC_RPR = (uint32_t)adcDmaBuffer[pos ^ 1];
+        ADC->ADC_RCR = ADC_DMA_WORDS;
+      }
+      // The PDC goes on in the other buffer, this one is the next
+      ADC->ADC_RNPR = (uint32_t)adcDmaBuffer[pos];
+      ADC->ADC_RNCR = ADC_DMA_WORDS;
+      adcDmaPos = pos ^ 1;
+    }
+
+    // Copy the values if the ADC interrupt published new ones since the last copy
+    bool HAL::analogReadValues(int16_t values[ANALOG_INPUTS]) {
+      static uint32_t last_seq = 0;
+      const uint32_t seq = AnalogInputSeq;
+      if (seq == last_seq || (seq & 1)) return false;
+      for (uint8_t i = 0; i < ANALOG_INPUTS; i++) values[i] = AnalogInputValues[i];
+      if (AnalogInputSeq != seq) return false;
+      last_seq = seq;
+      return true;
+    }
+
+  #endif // ADC_DMA
+
 #endif
 
 // Reset peripherals and cpu
@@ -401,6 +556,14 @@ void HAL::resetHardware() {
     SPI_Configure(SPI0, ID_SPI0, SPI_MR_MSTR | SPI_MR_MODFDIS | SPI_MR_PS);
     SPI_Enable(SPI0);
 
+    #if ENABLED(SD_SPI_DMA)
+      // DMA controller with fixed priority, the receive channel first
+      pmc_enable_periph_clk(ID_DMAC);
+      DMAC->DMAC_EN &= ~DMAC_EN_ENABLE;
+      DMAC->DMAC_GCFG = DMAC_GCFG_ARB_CFG_FIXED;
+      DMAC->DMAC_EN = DMAC_EN_ENABLE;
+    #endif
+
     #if MB(ALLIGATOR) || MB(ALLIGATOR_V3)
       SET_OUTPUT(DAC0_SYNC);
       #if EXTRUDERS > 1
@@ -543,35 +706,131 @@ void HAL::resetHardware() {
 
   #endif // MB(ALLIGATOR) || MB(ALLIGATOR_V3)
 
-  // Read from SPI into buffer
-  void HAL::spiReadBlock(uint8_t* buf, uint16_t nbyte) {
-    if (nbyte-- == 0) return;
+  #if ENABLED(SD_SPI_DMA)
+
+    /**
+     * SPI block transfers with the DMA controller
+     *
+     * The receive channel moves SPI_RDR to the buffer while the transmit
+     * channel feeds SPI_TDR, with 0xFF for a read. The DMA writes only the
+     * data byte of SPI_TDR, so the SPI is switched to the fixed peripheral
+     * select of the SD card for the transfer.
+     */
+    #define SPI_DMAC_TX_CH  0
+    #define SPI_DMAC_RX_CH  1
+    #define SPI_TX_IDX      1
+    #define SPI_RX_IDX      2
+
+    static uint32_t spi_dma_mode;
+
+    static inline void dmac_channel_disable(const uint32_t ch) { DMAC->DMAC_CHDR = DMAC_CHDR_DIS0 << ch; }
+    static inline void dmac_channel_enable(const uint32_t ch) { DMAC->DMAC_CHER = DMAC_CHER_ENA0 << ch; }
+    static inline bool dmac_channel_done(const uint32_t ch) { return !(DMAC->DMAC_CHSR & (DMAC_CHSR_ENA0 << ch)); }
+
+    static void spiDmaSelect() {
+      spi_dma_mode = SPI0->SPI_MR;
+      SPI0->SPI_MR = (spi_dma_mode & ~(SPI_MR_PS | SPI_MR_PCS_Msk)) | SPI_PCS(SPI_CHAN);
+      // Clear the overrun flag and the data of the last byte
+      SPI0->SPI_SR;
+      SPI0->SPI_RDR;
+    }
 
-    for (int i = 0; i < nbyte; i++) {
-      //while ((SPI0->SPI_SR & SPI_SR_TDRE) == 0);
-      SPI0->SPI_TDR = 0x000000FF | SPI_PCS(SPI_CHAN);
-      while ((SPI0->SPI_SR & SPI_SR_RDRF) == 0);
-      buf[i] = SPI0->SPI_RDR;
-      // delayMicroseconds(1);
+    static void spiDmaTX(const uint8_t* src, const uint16_t count) {
+      static uint8_t ff = 0xFF;
+      uint32_t src_incr = DMAC_CTRLB_SRC_INCR_INCREMENTING;
+      if (!src) {
+        src = &ff;
+        src_incr = DMAC_CTRLB_SRC_INCR_FIXED;
+      }
+      dmac_channel_disable(SPI_DMAC_TX_CH);
+      DMAC->DMAC_CH_NUM[SPI_DMAC_TX_CH].DMAC_SADDR = (uint32_t)src;
+      DMAC->DMAC_CH_NUM[SPI_DMAC_TX_CH].DMAC_DADDR = (uint32_t)&SPI0->SPI_TDR;
+      DMAC->DMAC_CH_NUM[SPI_DMAC_TX_CH].DMAC_DSCR = 0;
+      DMAC->DMAC_CH_NUM[SPI_DMAC_TX_CH].DMAC_CTRLA = count | DMAC_CTRLA_SRC_WIDTH_BYTE | DMAC_CTRLA_DST_WIDTH_BYTE;
+      DMAC->DMAC_CH_NUM[SPI_DMAC_TX_CH].DMAC_CTRLB = DMAC_CTRLB_SRC_DSCR | DMAC_CTRLB_DST_DSCR |
+                                                     DMAC_CTRLB_FC_MEM2PER_DMA_FC | src_incr | DMAC_CTRLB_DST_INCR_FIXED;
+      DMAC->DMAC_CH_NUM[SPI_DMAC_TX_CH].DMAC_CFG = DMAC_CFG_DST_PER(SPI_TX_IDX) | DMAC_CFG_DST_H2SEL |
+                                                   DMAC_CFG_SOD | DMAC_CFG_FIFOCFG_ALAP_CFG;
+      dmac_channel_enable(SPI_DMAC_TX_CH);
     }
-    buf[nbyte] = spiReceive();
-  }
 
-  // Write from buffer to SPI
-  void HAL::spiSendBlock(uint8_t token, const uint8_t* buf) {
-    SPI0->SPI_TDR = (uint32_t)token | SPI_PCS(SPI_CHAN);
-    while ((SPI0->SPI_SR & SPI_SR_TDRE) == 0);
-    //while ((SPI0->SPI_SR & SPI_SR_RDRF) == 0);
-    //SPI0->SPI_RDR;
-    for (int i = 0; i < 511; i++) {
-      SPI0->SPI_TDR = (uint32_t)buf[i] | SPI_PCS(SPI_CHAN);
-      while ((SPI0->SPI_SR & SPI_SR_TDRE) == 0);
-      while ((SPI0->SPI_SR & SPI_SR_RDRF) == 0);
+    void HAL::spiDmaReadStart(uint8_t* buf, uint16_t nbyte) {
+      spiDmaSelect();
+      dmac_channel_disable(SPI_DMAC_RX_CH);
+      DMAC->DMAC_CH_NUM[SPI_DMAC_RX_CH].DMAC_SADDR = (uint32_t)&SPI0->SPI_RDR;
+      DMAC->DMAC_CH_NUM[SPI_DMAC_RX_CH].DMAC_DADDR = (uint32_t)buf;
+      DMAC->DMAC_CH_NUM[SPI_DMAC_RX_CH].DMAC_DSCR = 0;
+      DMAC->DMAC_CH_NUM[SPI_DMAC_RX_CH].DMAC_CTRLA = nbyte | DMAC_CTRLA_SRC_WIDTH_BYTE | DMAC_CTRLA_DST_WIDTH_BYTE;
+      DMAC->DMAC_CH_NUM[SPI_DMAC_RX_CH].DMAC_CTRLB = DMAC_CTRLB_SRC_DSCR | DMAC_CTRLB_DST_DSCR |
+                                                     DMAC_CTRLB_FC_PER2MEM_DMA_FC | DMAC_CTRLB_SRC_INCR_FIXED | DMAC_CTRLB_DST_INCR_INCREMENTING;
+      DMAC->DMAC_CH_NUM[SPI_DMAC_RX_CH].DMAC_CFG = DMAC_CFG_SRC_PER(SPI_RX_IDX) | DMAC_CFG_SRC_H2SEL |
+                                                   DMAC_CFG_SOD | DMAC_CFG_FIFOCFG_ASAP_CFG;
+      dmac_channel_enable(SPI_DMAC_RX_CH);
+      spiDmaTX(NULL, nbyte);
+    }
+
+    void HAL::spiDmaSendStart(const uint8_t* buf, uint16_t nbyte) {
+      spiDmaSelect();
+      spiDmaTX(buf, nbyte);
+    }
+
+    bool HAL::spiDmaDone() {
+      if (!dmac_channel_done(SPI_DMAC_RX_CH) || !dmac_channel_done(SPI_DMAC_TX_CH)) return false;
+      // Last byte out of the shift register, then back to the variable peripheral select
+      while ((SPI0->SPI_SR & SPI_SR_TXEMPTY) == 0);
+      SPI0->SPI_SR;
       SPI0->SPI_RDR;
-      // delayMicroseconds(1);
+      SPI0->SPI_MR = spi_dma_mode;
+      return true;
+    }
+
+    // Read from SPI into buffer
+    void HAL::spiReadBlock(uint8_t* buf, uint16_t nbyte) {
+      if (nbyte == 0) return;
+      spiDmaReadStart(buf, nbyte);
+      while (!spiDmaDone());
+    }
+
+    // Write from buffer to SPI
+    void HAL::spiSendBlock(uint8_t token, const uint8_t* buf) {
+      spiSend(token);
+      spiDmaSendStart(buf, 512);
+      while (!spiDmaDone());
+    }
+
+  #else
+
+    // Read from SPI into buffer
+    void HAL::spiReadBlock(uint8_t* buf, uint16_t nbyte) {
+      if (nbyte-- == 0) return;
+
+      for (int i = 0; i < nbyte; i++) {
+        //while ((SPI0->SPI_SR & SPI_SR_TDRE) == 0);
+        SPI0->SPI_TDR = 0x000000FF | SPI_PCS(SPI_CHAN);
+        while ((SPI0->SPI_SR & SPI_SR_RDRF) == 0);
+        buf[i] = SPI0->SPI_RDR;
+        // delayMicroseconds(1);
+      }
+      buf[nbyte] = spiReceive();
     }
-    spiSend(buf[511]);
-  }
+
+    // Write from buffer to SPI
+    void HAL::spiSendBlock(uint8_t token, const uint8_t* buf) {
+      SPI0->SPI_TDR = (uint32_t)token | SPI_PCS(SPI_CHAN);
+      while ((SPI0->SPI_SR & SPI_SR_TDRE) == 0);
+      //while ((SPI0->SPI_SR & SPI_SR_RDRF) == 0);
+      //SPI0->SPI_RDR;
+      for (int i = 0; i < 511; i++) {
+        SPI0->SPI_TDR = (uint32_t)buf[i] | SPI_PCS(SPI_CHAN);
+        while ((SPI0->SPI_SR & SPI_SR_TDRE) == 0);
+        while ((SPI0->SPI_SR & SPI_SR_RDRF) == 0);
+        SPI0->SPI_RDR;
+        // delayMicroseconds(1);
+      }
+      spiSend(buf[511]);
+    }
+
+  #endif // SD_SPI_DMA
 
 #endif // DISABLED(SOFTWARE_SPI)
 
@@ -959,18 +1218,71 @@ bool HAL::AnalogWrite(Pin pin, const uint8_t value, const uint16_t freq) {
 
 #endif // I2C_EEPROM
 
+#if ENABLED(SERIAL_TX_BUFFER)
+
+  /**
+   * Serial transmit ring
+   *
+   * Characters are queued here and moved into the UART driver buffer
+   * by serialTxPump() in chunks, as much as the driver has room for.
+   * The UART interrupt then sends them on the wire.
+   *
+   * The ring belongs to the main loop. The messages written from an
+   * interrupt, or with the interrupts off, go straight to the UART:
+   * they can't wait for the ring to drain and mustn't move head or tail.
+   */
+  static char tx_buffer[SERIAL_TX_BUFFER];
+  static uint16_t tx_head = 0,
+                  tx_tail = 0;
+
+  #define TX_MOD(x) ((x) & (SERIAL_TX_BUFFER - 1))
+
+  void HAL::serialWriteByte(char c) {
+    if (__get_IPSR() || __get_PRIMASK()) {
+      MKSERIAL.write(c);
+      return;
+    }
+    const uint16_t next = TX_MOD(tx_head + 1);
+    // Ring full: wait until the UART has room for some more characters
+    while (next == tx_tail) serialTxPump();
+    tx_buffer[tx_head] = c;
+    tx_head = next;
+  }
+
+  void HAL::serialTxPump() {
+    int room = MKSERIAL.availableForWrite();
+    while (room > 0 && tx_tail != tx_head) {
+      const uint16_t n = min(room, (tx_head > tx_tail ? tx_head : SERIAL_TX_BUFFER) - tx_tail);
+      MKSERIAL.write((const uint8_t*)&tx_buffer[tx_tail], n);
+      tx_tail = TX_MOD(tx_tail + n);
+      room -= n;
+    }
+  }
+
+  void HAL::serialFlush() {
+    while (tx_tail != tx_head) serialTxPump();
+    MKSERIAL.flush();
+  }
+
+#endif // SERIAL_TX_BUFFER
+
 /**
  * Timer 0 is is called 3906 timer per second.
  * It is used to update pwm values for heater and some other frequent jobs.
  *
  *  - Manage PWM to all the heaters and fan
- *  - Prepare or Measure one of the raw ADC sensor values
+ *  - Every 100ms run the PID of the heaters (temp_controller_isr)
+ *  - Prepare or Measure one of the raw ADC sensor values (with ADC_DMA take the published ones)
  *  - Step the babysteps value for each axis towards 0
  *  - For PINS_DEBUGGING, monitor and report endstop pins
  *  - For ENDSTOP_INTERRUPTS_FEATURE check endstops if flagged
  */
 HAL_TEMP_TIMER_ISR {
 
+  #if ENABLED(ISR_STATISTICS)
+    const uint32_t isr_start = HAL_CYCLE_COUNT();
+  #endif
+
   HAL_timer_isr_prologue(TEMP_TIMER);
 
   // Allow UART ISRs
@@ -1013,16 +1325,16 @@ HAL_TEMP_TIMER_ISR {
    */
   #if HOTENDS > 0
     if (pwm_heater_hd[0])
-      pwm_heater_hd[0] = HAL::AnalogWrite(HEATER_0_PIN, thermalManager.soft_pwm[0], HEATER_PWM_FREQ);
+      pwm_heater_hd[0] = HAL::AnalogWrite(HEATER_0_PIN, thermalManager.heaters[0].soft_pwm, HEATER_PWM_FREQ);
     #if HOTENDS > 1
       if (pwm_heater_hd[1])
-        pwm_heater_hd[1] = HAL::AnalogWrite(HEATER_1_PIN, thermalManager.soft_pwm[1], HEATER_PWM_FREQ);
+        pwm_heater_hd[1] = HAL::AnalogWrite(HEATER_1_PIN, thermalManager.heaters[1].soft_pwm, HEATER_PWM_FREQ);
       #if HOTENDS > 2
         if (pwm_heater_hd[2])
-          pwm_heater_hd[2] = HAL::AnalogWrite(HEATER_2_PIN, thermalManager.soft_pwm[2], HEATER_PWM_FREQ);
+          pwm_heater_hd[2] = HAL::AnalogWrite(HEATER_2_PIN, thermalManager.heaters[2].soft_pwm, HEATER_PWM_FREQ);
         #if HOTENDS > 3
           if (pwm_heater_hd[3])
-            pwm_heater_hd[3] = HAL::AnalogWrite(HEATER_3_PIN, thermalManager.soft_pwm[3], HEATER_PWM_FREQ);
+            pwm_heater_hd[3] = HAL::AnalogWrite(HEATER_3_PIN, thermalManager.heaters[3].soft_pwm, HEATER_PWM_FREQ);
         #endif
       #endif
     #endif
@@ -1030,17 +1342,17 @@ HAL_TEMP_TIMER_ISR {
 
   #if HAS_HEATER_BED && HAS_TEMP_BED
     if (pwm_bed_hd)
-      pwm_bed_hd = HAL::AnalogWrite(HEATER_BED_PIN, thermalManager.soft_pwm_bed, HEATER_PWM_FREQ);
+      pwm_bed_hd = HAL::AnalogWrite(HEATER_BED_PIN, thermalManager.heaters[BED_INDEX].soft_pwm, HEATER_PWM_FREQ);
   #endif
 
   #if HAS_HEATER_CHAMBER && HAS_TEMP_CHAMBER
     if (pwm_chamber_hd)
-      pwm_chamber_hd = HAL::AnalogWrite(HEATER_CHAMBER_PIN, thermalManager.soft_pwm_chamber, HEATER_PWM_FREQ);
+      pwm_chamber_hd = HAL::AnalogWrite(HEATER_CHAMBER_PIN, thermalManager.heaters[CHAMBER_INDEX].soft_pwm, HEATER_PWM_FREQ);
   #endif
 
   #if HAS_COOLER && HAS_TEMP_COOLER
     if (pwm_cooler_hd)
-      pwm_cooler_hd = HAL::AnalogWrite(COOLER_PIN, thermalManager.soft_pwm_cooler, HEATER_PWM_FREQ);
+      pwm_cooler_hd = HAL::AnalogWrite(COOLER_PIN, thermalManager.heaters[COOLER_INDEX].soft_pwm, HEATER_PWM_FREQ);
   #endif
 
   #if HAS_FAN0
@@ -1069,16 +1381,16 @@ HAL_TEMP_TIMER_ISR {
    */
   if (pwm_count_heater == 0) {
     #if HOTENDS > 0
-      if (!pwm_heater_hd[0] && (pwm_heater_pos[0] = (thermalManager.soft_pwm[0] & HEATER_PWM_MASK)) > 0)
+      if (!pwm_heater_hd[0] && (pwm_heater_pos[0] = (thermalManager.heaters[0].soft_pwm & HEATER_PWM_MASK)) > 0)
         WRITE_HEATER_0(HIGH);
       #if HOTENDS > 1
-        if (!pwm_heater_hd[1] && (pwm_heater_pos[1] = (thermalManager.soft_pwm[1] & HEATER_PWM_MASK)) > 0)
+        if (!pwm_heater_hd[1] && (pwm_heater_pos[1] = (thermalManager.heaters[1].soft_pwm & HEATER_PWM_MASK)) > 0)
           WRITE_HEATER_1(HIGH);
         #if HOTENDS > 2
-          if (!pwm_heater_hd[2] && (pwm_heater_pos[2] = (thermalManager.soft_pwm[2] & HEATER_PWM_MASK)) > 0)
+          if (!pwm_heater_hd[2] && (pwm_heater_pos[2] = (thermalManager.heaters[2].soft_pwm & HEATER_PWM_MASK)) > 0)
             WRITE_HEATER_2(HIGH);
           #if HOTENDS > 3
-            if (!pwm_heater_hd[3] && (pwm_heater_pos[3] = (thermalManager.soft_pwm[3] & HEATER_PWM_MASK)) > 0)
+            if (!pwm_heater_hd[3] && (pwm_heater_pos[3] = (thermalManager.heaters[3].soft_pwm & HEATER_PWM_MASK)) > 0)
               WRITE_HEATER_0(HIGH);
           #endif
         #endif
@@ -1086,17 +1398,17 @@ HAL_TEMP_TIMER_ISR {
     #endif
 
     #if HAS_HEATER_BED && HAS_TEMP_BED
-      if (!pwm_bed_hd && (pwm_bed_pos = (thermalManager.soft_pwm_bed & HEATER_PWM_MASK)) > 0)
+      if (!pwm_bed_hd && (pwm_bed_pos = (thermalManager.heaters[BED_INDEX].soft_pwm & HEATER_PWM_MASK)) > 0)
         WRITE_HEATER_BED(HIGH);
     #endif
 
     #if HAS_HEATER_CHAMBER && HAS_TEMP_CHAMBER
-      if (!pwm_chamber_hd && (pwm_chamber_pos = (thermalManager.soft_pwm_chamber & HEATER_PWM_MASK)) > 0)
+      if (!pwm_chamber_hd && (pwm_chamber_pos = (thermalManager.heaters[CHAMBER_INDEX].soft_pwm & HEATER_PWM_MASK)) > 0)
         WRITE_HEATER_CHAMBER(HIGH);
     #endif
 
     #if HAS_COOLER && !ENABLED(FAST_PWM_COOLER) && HAS_TEMP_COOLER
-      if (!pwm_cooler_hd && (pwm_cooler_pos = (thermalManager.soft_pwm_cooler & HEATER_PWM_MASK)) > 0)
+      if (!pwm_cooler_hd && (pwm_cooler_pos = (thermalManager.heaters[COOLER_INDEX].soft_pwm & HEATER_PWM_MASK)) > 0)
         WRITE_COOLER(HIGH);
     #endif
 
@@ -1181,13 +1493,14 @@ HAL_TEMP_TIMER_ISR {
   if (cycle_100ms >= 390) {
     cycle_100ms = 0;
     HAL::execute_100ms = true;
+    thermalManager.temp_controller_isr();
     #if ENABLED(FAN_KICKSTART_TIME)
       if (fanKickstart) fanKickstart--;
     #endif
   }
 
-  // read analog values
-  #if ANALOG_INPUTS > 0
+  // read analog values, with ADC_DMA the ADC interrupt does it
+  #if ANALOG_INPUTS > 0 && DISABLED(ADC_DMA)
 
     if ((ADC->ADC_ISR & adcEnable) == adcEnable) { // conversion finished?
       adcCounter++;
@@ -1218,9 +1531,11 @@ HAL_TEMP_TIMER_ISR {
       ADC->ADC_CR = ADC_CR_START; // reread values
     }
 
+  #endif
+
+  #if ANALOG_INPUTS > 0
     // Update the raw values if they've been read. Else we could be updating them during reading.
     if (Analog_is_ready) thermalManager.set_current_temp_raw();
-
   #endif
 
   pwm_count_heater  += HEATER_PWM_STEP;
@@ -1262,6 +1577,10 @@ HAL_TEMP_TIMER_ISR {
     }
   #endif
 
+  #if ENABLED(ISR_STATISTICS)
+    isrStats.record(ISR_TEMPERATURE, HAL_CYCLES_SINCE(isr_start));
+  #endif
+
   _ENABLE_ISRs(); // re-enable ISRs
 
 }
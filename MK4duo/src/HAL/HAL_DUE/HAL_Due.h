@@ -194,6 +194,8 @@
 #define MEDIAN_COUNT 10 // MEDIAN COUNT for Smoother temperature
 #define NUM_ADC_SAMPLES (2 + (1 << OVERSAMPLENR))
 #define ADC_TEMPERATURE_SENSOR 15
+// ADC_DMA: conversions of every analog input in a buffer of the PDC
+#define ADC_DMA_SEQUENCES 16
 
 // --------------------------------------------------------------------------
 // Types
@@ -223,6 +225,11 @@ class HAL {
 
     #if ANALOG_INPUTS > 0
       static volatile int16_t AnalogInputValues[ANALOG_INPUTS];
+      #if ENABLED(ADC_DMA)
+        // Odd while the ADC interrupt writes AnalogInputValues
+        static volatile uint32_t AnalogInputSeq;
+        static bool analogReadValues(int16_t values[ANALOG_INPUTS]);
+      #endif
     #endif
 
     static bool execute_100ms;
@@ -257,6 +264,13 @@ class HAL {
 
       // Write from buffer to SPI
       static void spiSendBlock(uint8_t token, const uint8_t* buf);
+
+      #if ENABLED(SD_SPI_DMA)
+        // Start a DMA transfer, spiDmaDone() is true when it's over
+        static void spiDmaReadStart(uint8_t* buf, uint16_t nbyte);
+        static void spiDmaSendStart(const uint8_t* buf, uint16_t nbyte);
+        static bool spiDmaDone();
+      #endif
     #endif
 
     static bool AnalogWrite(Pin pin, const uint8_t value, const uint16_t freq);
@@ -309,12 +323,18 @@ class HAL {
     static inline uint8_t serialReadByte() {
       return MKSERIAL.read();
     }
-    static inline void serialWriteByte(char c) {
-      MKSERIAL.write(c);
-    }
-    static inline void serialFlush() {
-      MKSERIAL.flush();
-    }
+    #if ENABLED(SERIAL_TX_BUFFER)
+      static void serialWriteByte(char c);
+      static void serialFlush();
+      static void serialTxPump();
+    #else
+      static inline void serialWriteByte(char c) {
+        MKSERIAL.write(c);
+      }
+      static inline void serialFlush() {
+        MKSERIAL.flush();
+      }
+    #endif
 
     static void showStartReason();
 
@@ -133,6 +133,13 @@ typedef struct {
 
 // Clock speed factor
 #define CYCLES_PER_US ((F_CPU) / 1000000) // 84
+
+// Cycle counter for the ISR statistics (DWT, enabled in HAL::hwSetup).
+// The stepper timer counts from the compare match, at the entry
+// of the ISR it is the lateness of the step.
+#define HAL_CYCLE_COUNT()       DWT->CYCCNT
+#define HAL_CYCLES_SINCE(start) (DWT->CYCCNT - (start))
+#define HAL_STEPPER_LATENESS()  (HAL_timer_get_current_count(STEPPER_TIMER) * (uint32_t)STEPPER_TIMER_PRESCALE)
 // Stepper pulse duration, in cycles
 #define STEP_PULSE_CYCLES ((MINIMUM_STEPPER_PULSE) * CYCLES_PER_US)
 
@@ -82,6 +82,36 @@ void Com::printFloat(float number, uint8_t digits) {
     print('-');
     number = -number;
   }
+
+  // Fast path: scale the fraction once to a fixed-point integer and
+  // build the whole number in a buffer, no per-digit float math
+  if (digits <= 9 && number < 4294967040.0) {
+    static const uint32_t pow10[10] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+    uint32_t int_part = (uint32_t)number,
+             frac = (uint32_t)((number - (float)int_part) * pow10[digits] + 0.5);
+    // Round correctly so that print(1.999, 2) prints as "2.00"
+    if (frac >= pow10[digits]) {
+      int_part++;
+      frac -= pow10[digits];
+    }
+    char buf[22];
+    char *str = &buf[21];
+    *str = '\0';
+    for (uint8_t i = digits; i--;) {
+      const uint32_t m = frac;
+      frac /= 10;
+      *--str = '0' + (m - 10 * frac);
+    }
+    if (digits) *--str = '.';
+    do {
+      const uint32_t m = int_part;
+      int_part /= 10;
+      *--str = '0' + (m - 10 * int_part);
+    } while (int_part);
+    print(str);
+    return;
+  }
+
   // Round correctly so that print(1.999, 2) prints as "2.00"
   float rounding = 0.5;
   for (uint8_t i = 0; i < digits; ++i)
@@ -0,0 +1,971 @@
+/**
+ * MK4duo 3D Printer Firmware
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 - 2017 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * This is the main Hardware Abstraction Layer (HAL).
+ * To make the firmware work with different processors and toolchains,
+ * all hardware related code should be packed into the hal files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Description: HAL for host-native Linux builds
+ *
+ * The firmware runs as a normal process on a simulated clock, so the
+ * planner, the stepper ISR and the command queue can be measured on a
+ * PC without any board attached.
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+
+#include "../../../base.h"
+
+#if ENABLED(ARDUINO_ARCH_LINUX)
+
+#include <unistd.h>
+#include <poll.h>
+
+// --------------------------------------------------------------------------
+// Externals
+// --------------------------------------------------------------------------
+
+extern uint8_t commands_in_queue;
+
+void setup();
+void loop();
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+uint8_t MCUSR = RST_POWER_ON;
+
+Fastio_Pin Fastio[NUM_DIGITAL_PINS];
+
+#if ANALOG_INPUTS > 0
+  volatile int16_t HAL::AnalogInputValues[ANALOG_INPUTS] = { 0 };
+  #if ENABLED(ADC_DMA)
+    volatile uint32_t HAL::AnalogInputSeq = 0;
+  #endif
+#endif
+
+static unsigned int cycle_100ms = 0;
+
+// disable interrupts
+void cli(void) {
+  HAL_sim_irq_enabled = false;
+}
+
+// enable interrupts
+void sei(void) {
+  HAL_sim_irq_enabled = true;
+  HAL_sim_dispatch();
+}
+
+HAL::HAL() {
+  // ctor
+}
+
+HAL::~HAL() {
+  // dtor
+}
+
+bool HAL::execute_100ms = false;
+
+// do any hardware-specific initialization here
+void HAL::hwSetup(void) {
+  // Answer the host a line at a time also when stdout is a pipe
+  setvbuf(stdout, NULL, _IOLBF, 0);
+}
+
+// Print apparent cause of start/restart
+void HAL::showStartReason() {
+  switch (MCUSR) {
+    case RST_POWER_ON:
+      SERIAL_EM(MSG_POWERUP); break;
+    case RST_WATCHDOG:
+      SERIAL_EM(MSG_WATCHDOG_RESET); break;
+    case RST_SOFTWARE:
+      SERIAL_EM(MSG_SOFTWARE_RESET); break;
+  }
+}
+
+// Return available memory, the host has no real limit so report the Due SRAM
+int HAL::getFreeRam() {
+  return 96 * 1024;
+}
+
+#if ANALOG_INPUTS > 0
+
+  // Initialize ADC channels
+  void HAL::analogStart(void) {
+    for (int i = 0; i < ANALOG_INPUTS; i++)
+      AnalogInputValues[i] = HAL_SIM_ADC_DEFAULT;
+    #if ENABLED(ADC_DMA)
+      AnalogInputSeq = 2;
+    #endif
+  }
+
+  #if ENABLED(ADC_DMA)
+
+    /**
+     * The values set by the simulator are published like the ADC interrupt
+     * of the Due does, the oversampling and the filters are not simulated.
+     */
+    static void sim_analog_write(const uint8_t index, const int16_t value) {
+      if (HAL::AnalogInputValues[index] == value) return;
+      HAL::AnalogInputSeq++;
+      HAL::AnalogInputValues[index] = value;
+      HAL::AnalogInputSeq++;
+    }
+
+    // Copy the values if new ones were published since the last copy
+    bool HAL::analogReadValues(int16_t values[ANALOG_INPUTS]) {
+      static uint32_t last_seq = 0;
+      const uint32_t seq = AnalogInputSeq;
+      if (seq == last_seq || (seq & 1)) return false;
+      for (uint8_t i = 0; i < ANALOG_INPUTS; i++) values[i] = AnalogInputValues[i];
+      if (AnalogInputSeq != seq) return false;
+      last_seq = seq;
+      return true;
+    }
+
+  #else
+
+    static void sim_analog_write(const uint8_t index, const int16_t value) {
+      HAL::AnalogInputValues[index] = value;
+    }
+
+  #endif
+
+#endif
+
+// Reset peripherals and cpu, on the host the process simply ends
+void HAL::resetHardware() {
+  serialFlush();
+  exit(RST_SOFTWARE);
+}
+
+// --------------------------------------------------------------------------
+// SPI
+// --------------------------------------------------------------------------
+
+/**
+ * SD card on the SPI bus
+ *
+ * The card is the raw disk image named by the MK4DUO_SDCARD environment
+ * variable, answered in SPI mode as an SDHC card. Without the variable the
+ * bus reads back 0xFF and the card fails to initialize.
+ *
+ * Every byte costs its time on the simulated clock at the SPI rate of the
+ * Due, and the card is busy for HAL_SIM_SD_ACCESS_US before the data of
+ * each block read, so a sector read stalls the main loop as on the board.
+ * With SD_SPI_DMA the blocks are moved by a simulated DMA controller.
+ */
+#ifndef HAL_SIM_SD_ACCESS_US
+  #define HAL_SIM_SD_ACCESS_US 300
+#endif
+
+static const uint8_t spi_dividers[] = { 10, 21, 42, 84, 168 };
+
+static uint32_t spi_byte_ticks = 8 * 21 / STEPPER_TIMER_PRESCALE;
+
+enum SdState { SD_COMMAND, SD_WRITE_TOKEN, SD_WRITE_DATA };
+
+static FILE*    sd_image = NULL;
+static uint32_t sd_blocks = 0;
+static uint8_t  sd_command[6],
+                sd_command_count = 0,
+                sd_reply[2 + 512 + 2 + 8];
+static uint16_t sd_reply_head = 0,
+                sd_reply_count = 0,
+                sd_token_index = 0,
+                sd_data_count = 0;
+static uint64_t sd_ready_ticks = 0;
+static uint32_t sd_multi_block = 0,
+                sd_write_block = 0,
+                sd_erase_start = 0,
+                sd_erase_end = 0;
+static bool     sd_idle = true,
+                sd_app_command = false,
+                sd_multi_read = false,
+                sd_multi_write = false;
+static SdState  sd_state = SD_COMMAND;
+
+static void sd_reply_byte(const uint8_t b) {
+  if (sd_reply_count < sizeof(sd_reply)) sd_reply[sd_reply_count++] = b;
+}
+
+// Data token, data and crc of a block read, after the access time of the card
+static void sd_reply_block(const uint32_t block) {
+  sd_ready_ticks = HAL_sim_ticks + HAL_SIM_SD_ACCESS_US * STEPPER_TIMER_TICKS_PER_US;
+  sd_token_index = sd_reply_count;
+  sd_reply_byte(0xFE);
+  uint8_t* data = &sd_reply[sd_reply_count];
+  memset(data, 0, 512);
+  fseek(sd_image, (long)block * 512, SEEK_SET);
+  if (fread(data, 1, 512, sd_image) != 512) memset(data, 0, 512);
+  sd_reply_count += 512;
+  sd_reply_byte(0xFF);
+  sd_reply_byte(0xFF);
+}
+
+static void sd_reply_register(const uint8_t* reg) {
+  sd_reply_byte(0xFE);
+  for (uint8_t i = 0; i < 16; i++) sd_reply_byte(reg[i]);
+  sd_reply_byte(0xFF);
+  sd_reply_byte(0xFF);
+}
+
+static void sd_execute() {
+  const uint8_t cmd = sd_command[0] & 0x3F;
+  const uint32_t arg = ((uint32_t)sd_command[1] << 24) | ((uint32_t)sd_command[2] << 16) | ((uint32_t)sd_command[3] << 8) | sd_command[4];
+  const bool app = sd_app_command;
+  const uint8_t r1 = sd_idle ? 0x01 : 0x00;
+
+  sd_app_command = false;
+  sd_reply_head = sd_reply_count = 0;
+  sd_multi_read = false;
+
+  if (app) switch (cmd) {
+    case 41: sd_idle = false; sd_reply_byte(0x00); return;  // ACMD41 SD_SEND_OP_COMD
+    case 23: sd_reply_byte(r1); return;                     // ACMD23 SET_WR_BLK_ERASE_COUNT
+  }
+
+  switch (cmd) {
+    case 0:   // GO_IDLE_STATE
+      sd_idle = true;
+      sd_reply_byte(0x01);
+      break;
+    case 8:   // SEND_IF_COND, voltage accepted
+      sd_reply_byte(r1);
+      sd_reply_byte(0x00); sd_reply_byte(0x00);
+      sd_reply_byte(0x01); sd_reply_byte(arg & 0xFF);
+      break;
+    case 9: { // SEND_CSD, version 2.0 with the size of the image
+      const uint32_t c_size = sd_blocks / 1024 - 1;
+      const uint8_t csd[16] = { 0x40, 0x0E, 0x00, 0x32, 0x5B, 0x59, 0x00, (uint8_t)((c_size >> 16) & 0x3F),
+                                (uint8_t)(c_size >> 8), (uint8_t)c_size, 0x7F, 0x80, 0x0A, 0x40, 0x00, 0x01 };
+      sd_reply_byte(r1);
+      sd_reply_register(csd);
+    } break;
+    case 10: { // SEND_CID
+      const uint8_t cid[16] = { 0x00, 'M', 'K', 'L', 'I', 'N', 'U', 'X', 0x10, 0, 0, 0, 1, 0x01, 0x11, 0x01 };
+      sd_reply_byte(r1);
+      sd_reply_register(cid);
+    } break;
+    case 12:  // STOP_TRANSMISSION, after the stuff byte
+      sd_reply_byte(0xFF);
+      sd_reply_byte(r1);
+      break;
+    case 13:  // SEND_STATUS, R2
+      sd_reply_byte(r1);
+      sd_reply_byte(0x00);
+      break;
+    case 17:  // READ_SINGLE_BLOCK
+    case 18:  // READ_MULTIPLE_BLOCK
+      if (arg >= sd_blocks) { sd_reply_byte(0x40); break; }
+      sd_reply_byte(r1);
+      sd_reply_block(arg);
+      sd_multi_read = (cmd == 18);
+      sd_multi_block = arg + 1;
+      break;
+    case 24:  // WRITE_BLOCK
+    case 25:  // WRITE_MULTIPLE_BLOCK
+      if (arg >= sd_blocks) { sd_reply_byte(0x40); break; }
+      sd_reply_byte(r1);
+      sd_write_block = arg;
+      sd_multi_write = (cmd == 25);
+      sd_state = SD_WRITE_TOKEN;
+      break;
+    case 32: sd_erase_start = arg; sd_reply_byte(r1); break;  // ERASE_WR_BLK_START
+    case 33: sd_erase_end = arg; sd_reply_byte(r1); break;    // ERASE_WR_BLK_END
+    case 38: {  // ERASE
+      uint8_t zero[512] = { 0 };
+      for (uint32_t b = sd_erase_start; b <= sd_erase_end && b < sd_blocks; b++) {
+        fseek(sd_image, (long)b * 512, SEEK_SET);
+        fwrite(zero, 1, 512, sd_image);
+      }
+      sd_reply_byte(r1);
+    } break;
+    case 55: sd_app_command = true; sd_reply_byte(r1); break;  // APP_CMD
+    case 58:  // READ_OCR, card power up and high capacity
+      sd_reply_byte(r1);
+      sd_reply_byte(0xC0); sd_reply_byte(0xFF);
+      sd_reply_byte(0x80); sd_reply_byte(0x00);
+      break;
+    case 59: sd_reply_byte(r1); break;  // CRC_ON_OFF
+    default: sd_reply_byte(r1 | 0x04);  // Illegal command
+  }
+}
+
+static void sd_write_byte(const uint8_t b) {
+  switch (sd_state) {
+    case SD_COMMAND:
+      if (sd_command_count || (b & 0xC0) == 0x40) {
+        sd_command[sd_command_count++] = b;
+        if (sd_command_count == 6) {
+          sd_command_count = 0;
+          sd_execute();
+        }
+      }
+      break;
+    case SD_WRITE_TOKEN:
+      if (b == 0xFE || b == 0xFC) {
+        sd_data_count = 0;
+        sd_state = SD_WRITE_DATA;
+      }
+      else if (b == 0xFD) sd_state = SD_COMMAND;  // Stop tran token
+      break;
+    case SD_WRITE_DATA:
+      // 512 bytes of data and 2 of crc
+      if (sd_data_count < 512) sd_reply[sd_data_count] = b;
+      if (++sd_data_count == 514) {
+        fseek(sd_image, (long)sd_write_block++ * 512, SEEK_SET);
+        fwrite(sd_reply, 1, 512, sd_image);
+        sd_reply_head = sd_reply_count = 0;
+        sd_reply_byte(0x05);  // Data accepted
+        sd_state = sd_multi_write ? SD_WRITE_TOKEN : SD_COMMAND;
+      }
+      break;
+  }
+}
+
+static uint8_t sd_read_byte() {
+  // Busy until the block is ready
+  if (sd_reply_head == sd_token_index && HAL_sim_ticks < sd_ready_ticks) return 0xFF;
+  if (sd_reply_head < sd_reply_count) {
+    const uint8_t b = sd_reply[sd_reply_head++];
+    if (sd_reply_head == sd_reply_count && sd_multi_read && sd_multi_block < sd_blocks) {
+      sd_reply_head = sd_reply_count = 0;
+      sd_reply_block(sd_multi_block++);
+    }
+    return b;
+  }
+  return 0xFF;
+}
+
+void HAL::spiBegin() {
+  SET_OUTPUT(SS_PIN);
+  WRITE(SS_PIN, HIGH);
+  if (sd_image) return;
+  const char* name = getenv("MK4DUO_SDCARD");
+  if (name && (sd_image = fopen(name, "r+b"))) {
+    fseek(sd_image, 0, SEEK_END);
+    sd_blocks = ftell(sd_image) / 512;
+  }
+}
+
+void HAL::spiInit(uint8_t spiClock) {
+  if (spiClock > 4) spiClock = 1;
+  spi_byte_ticks = 8 * spi_dividers[spiClock] / STEPPER_TIMER_PRESCALE;
+}
+
+void HAL::spiSend(uint8_t b) {
+  HAL_sim_consume(spi_byte_ticks);
+  if (sd_image) sd_write_byte(b);
+}
+
+void HAL::spiSend(const uint8_t* buf, size_t n) {
+  for (size_t i = 0; i < n; i++) spiSend(buf[i]);
+}
+
+uint8_t HAL::spiReceive() {
+  HAL_sim_consume(spi_byte_ticks);
+  return sd_image ? sd_read_byte() : 0xFF;
+}
+
+#if ENABLED(SD_SPI_DMA)
+
+  /**
+   * The DMA controller of the Due: the transfer takes the time of its
+   * bytes on the simulated clock without the CPU, the bytes are moved to
+   * or from the card when spiDmaDone() finds it over.
+   */
+  static uint8_t*       spi_dma_dst = NULL;
+  static const uint8_t* spi_dma_src = NULL;
+  static uint16_t       spi_dma_count = 0;
+  static uint64_t       spi_dma_end_ticks = 0;
+
+  static void spi_dma_start(uint8_t* dst, const uint8_t* src, const uint16_t nbyte) {
+    spi_dma_dst = dst;
+    spi_dma_src = src;
+    spi_dma_count = nbyte;
+    spi_dma_end_ticks = HAL_sim_ticks + (uint64_t)nbyte * spi_byte_ticks;
+  }
+
+  void HAL::spiDmaReadStart(uint8_t* buf, uint16_t nbyte) { spi_dma_start(buf, NULL, nbyte); }
+
+  void HAL::spiDmaSendStart(const uint8_t* buf, uint16_t nbyte) { spi_dma_start(NULL, buf, nbyte); }
+
+  bool HAL::spiDmaDone() {
+    // Read of the channel status, it changes once per byte
+    if (spi_dma_count && HAL_sim_ticks < spi_dma_end_ticks) {
+      HAL_sim_consume(min(spi_byte_ticks, (uint32_t)(spi_dma_end_ticks - HAL_sim_ticks)));
+      return false;
+    }
+    HAL_sim_consume(HAL_SIM_READ_TICKS);
+    if (!spi_dma_count) return true;
+    for (uint16_t i = 0; i < spi_dma_count; i++) {
+      if (spi_dma_dst)
+        spi_dma_dst[i] = sd_image ? sd_read_byte() : 0xFF;
+      else if (sd_image)
+        sd_write_byte(spi_dma_src[i]);
+    }
+    spi_dma_count = 0;
+    return true;
+  }
+
+  void HAL::spiReadBlock(uint8_t* buf, uint16_t nbyte) {
+    spiDmaReadStart(buf, nbyte);
+    while (!spiDmaDone());
+  }
+
+  void HAL::spiSendBlock(uint8_t token, const uint8_t* buf) {
+    spiSend(token);
+    spiDmaSendStart(buf, 512);
+    while (!spiDmaDone());
+  }
+
+#else
+
+  void HAL::spiReadBlock(uint8_t* buf, uint16_t nbyte) {
+    for (uint16_t i = 0; i < nbyte; i++) buf[i] = spiReceive();
+  }
+
+  void HAL::spiSendBlock(uint8_t token, const uint8_t* buf) {
+    spiSend(token);
+    spiSend(buf, 512);
+  }
+
+#endif
+
+// --------------------------------------------------------------------------
+// Analogic write to a PWM Pin
+// --------------------------------------------------------------------------
+
+// Every pin has a "hardware" PWM, the duty is kept in the pin file
+bool HAL::AnalogWrite(Pin pin, const uint8_t value, const uint16_t freq) {
+  UNUSED(freq);
+  if (pin < 0) return false;
+  Fastio[pin].pwm = value;
+  Fastio[pin].value = value ? HIGH : LOW;
+  return true;
+}
+
+// --------------------------------------------------------------------------
+// Serial
+// --------------------------------------------------------------------------
+
+static uint8_t  rx_buffer[256];
+static uint16_t rx_head = 0,
+                rx_tail = 0;
+static bool     rx_closed = false;
+
+bool HAL::serialByteAvailable() {
+  HAL_sim_consume(HAL_SIM_POLL_TICKS);
+
+  if (rx_head != rx_tail) return true;
+  if (rx_closed) return false;
+
+  struct pollfd pfd = { STDIN_FILENO, POLLIN, 0 };
+  if (poll(&pfd, 1, 0) <= 0) return false;
+
+  const ssize_t n = read(STDIN_FILENO, rx_buffer, sizeof(rx_buffer));
+  if (n <= 0) {
+    rx_closed = true;
+    return false;
+  }
+  rx_head = n;
+  rx_tail = 0;
+  return true;
+}
+
+uint8_t HAL::serialReadByte() {
+  return rx_head != rx_tail ? rx_buffer[rx_tail++] : 0xFF;
+}
+
+bool HAL_sim_input_closed() {
+  return rx_closed && rx_head == rx_tail;
+}
+
+/**
+ * Transmit side of the simulated UART.
+ *
+ * Everything goes to stdout at once. With HAL_SIM_BAUDRATE set, the Due
+ * core's 128 byte UART buffer is modelled as well: a character takes
+ * 10 bit times on the wire, and a writer finding the buffer full waits
+ * for it the way UARTClass::write does.
+ */
+#ifndef HAL_SIM_BAUDRATE
+  #define HAL_SIM_BAUDRATE 0
+#endif
+
+#define HAL_SIM_UART_BUFFER 128
+
+#if HAL_SIM_BAUDRATE > 0
+
+  static const uint32_t uart_byte_ticks = 10UL * HAL_STEPPER_TIMER_RATE / (HAL_SIM_BAUDRATE);
+  static uint64_t uart_done_ticks = 0;  // When the last buffered character leaves the wire
+
+  static uint32_t uart_pending() {
+    if (uart_done_ticks <= HAL_sim_ticks) return 0;
+    return (uart_done_ticks - HAL_sim_ticks + uart_byte_ticks - 1) / uart_byte_ticks;
+  }
+
+#endif
+
+void HAL_sim_uart_write(const char c) {
+  putchar(c);
+  #if HAL_SIM_BAUDRATE > 0
+    while (uart_pending() >= HAL_SIM_UART_BUFFER) HAL_sim_consume(HAL_SIM_POLL_TICKS);
+    uart_done_ticks = max(uart_done_ticks, (uint64_t)HAL_sim_ticks) + uart_byte_ticks;
+  #endif
+}
+
+int HAL_sim_uart_available_for_write() {
+  HAL_sim_consume(HAL_SIM_POLL_TICKS);
+  #if HAL_SIM_BAUDRATE > 0
+    return HAL_SIM_UART_BUFFER - uart_pending();
+  #else
+    return HAL_SIM_UART_BUFFER;
+  #endif
+}
+
+#if ENABLED(SERIAL_TX_BUFFER)
+
+  // Same ring as the Due HAL, drained into the simulated UART.
+  // From an ISR or with the interrupts off straight to the UART.
+  static char tx_buffer[SERIAL_TX_BUFFER];
+  static uint16_t tx_head = 0,
+                  tx_tail = 0;
+
+  #define TX_MOD(x) ((x) & (SERIAL_TX_BUFFER - 1))
+
+  void HAL::serialWriteByte(char c) {
+    if (HAL_sim_in_isr() || !HAL_sim_irq_enabled) {
+      HAL_sim_uart_write(c);
+      return;
+    }
+    const uint16_t next = TX_MOD(tx_head + 1);
+    // Ring full: wait until the UART has room for some more characters
+    while (next == tx_tail) serialTxPump();
+    tx_buffer[tx_head] = c;
+    tx_head = next;
+  }
+
+  void HAL::serialTxPump() {
+    int room = HAL_sim_uart_available_for_write();
+    while (room > 0 && tx_tail != tx_head) {
+      HAL_sim_uart_write(tx_buffer[tx_tail]);
+      tx_tail = TX_MOD(tx_tail + 1);
+      room--;
+    }
+  }
+
+  void HAL::serialFlush() {
+    while (tx_tail != tx_head) serialTxPump();
+    fflush(stdout);
+  }
+
+#endif // SERIAL_TX_BUFFER
+
+// --------------------------------------------------------------------------
+// eeprom
+// --------------------------------------------------------------------------
+
+static uint8_t  eeprom_data[EEPROM_SIZE];
+static bool     eeprom_loaded = false,
+                eeprom_dirty  = false;
+
+static const char* eeprom_filename() {
+  const char* name = getenv("MK4DUO_EEPROM");
+  return name ? name : "eeprom.bin";
+}
+
+static void eeprom_store(void) {
+  if (!eeprom_dirty) return;
+  FILE* file = fopen(eeprom_filename(), "wb");
+  if (file) {
+    fwrite(eeprom_data, 1, EEPROM_SIZE, file);
+    fclose(file);
+  }
+  eeprom_dirty = false;
+}
+
+static void eeprom_load(void) {
+  if (eeprom_loaded) return;
+  memset(eeprom_data, 0xFF, EEPROM_SIZE);
+  FILE* file = fopen(eeprom_filename(), "rb");
+  if (file) {
+    if (fread(eeprom_data, 1, EEPROM_SIZE, file) == 0) memset(eeprom_data, 0xFF, EEPROM_SIZE);
+    fclose(file);
+  }
+  atexit(eeprom_store);
+  eeprom_loaded = true;
+}
+
+static inline uint8_t* eeprom_cell(const void* pos) {
+  return &eeprom_data[(uintptr_t)pos % EEPROM_SIZE];
+}
+
+uint8_t eeprom_read_byte(uint8_t* pos) {
+  eeprom_load();
+  return *eeprom_cell(pos);
+}
+
+void eeprom_read_block(void* pos, const void* eeprom_address, size_t n) {
+  eeprom_load();
+  for (size_t c = 0; c < n; c++)
+    ((uint8_t*)pos)[c] = *eeprom_cell((const uint8_t*)eeprom_address + c);
+}
+
+void eeprom_write_byte(uint8_t* pos, uint8_t value) {
+  eeprom_load();
+  *eeprom_cell(pos) = value;
+  eeprom_dirty = true;
+}
+
+void eeprom_update_block(const void* pos, void* eeprom_address, size_t n) {
+  eeprom_load();
+  for (size_t c = 0; c < n; c++)
+    *eeprom_cell((uint8_t*)eeprom_address + c) = ((const uint8_t*)pos)[c];
+  eeprom_dirty = true;
+  eeprom_store();
+}
+
+// --------------------------------------------------------------------------
+// Arduino core
+// --------------------------------------------------------------------------
+
+unsigned long millis(void) {
+  HAL_sim_consume(HAL_SIM_POLL_TICKS);
+  return (unsigned long)(HAL_sim_ticks / (STEPPER_TIMER_TICKS_PER_US * 1000));
+}
+
+unsigned long micros(void) {
+  HAL_sim_consume(HAL_SIM_POLL_TICKS);
+  return (unsigned long)(HAL_sim_ticks / STEPPER_TIMER_TICKS_PER_US);
+}
+
+void delay(unsigned long ms) { HAL::delayMilliseconds(ms); }
+void delayMicroseconds(unsigned int us) { HAL::delayMicroseconds(us); }
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (mode == INPUT_PULLUP) SET_INPUT_PULLUP(pin);
+  else HAL::pinMode(pin, mode);
+}
+void digitalWrite(uint8_t pin, uint8_t value) { WRITE(pin, value); }
+int digitalRead(uint8_t pin) { return READ(pin); }
+
+int analogRead(uint8_t pin) {
+  #if ANALOG_INPUTS > 0
+    const int8_t channel = pin >= A0 ? pin - A0 : pin;
+    if (channel >= 0 && channel < ANALOG_INPUTS) return HAL::AnalogInputValues[channel];
+  #else
+    UNUSED(pin);
+  #endif
+  return HAL_SIM_ADC_DEFAULT;
+}
+
+void analogWrite(uint8_t pin, int value) { HAL::AnalogWrite(pin, value, 0); }
+
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode) {
+  UNUSED(mode);
+  Fastio[pin].isr = isr;
+}
+void detachInterrupt(uint8_t pin) { Fastio[pin].isr = NULL; }
+
+void noInterrupts(void) { cli(); }
+void interrupts(void) { sei(); }
+
+long random(long howbig) { return howbig ? rand() % howbig : 0; }
+long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+void randomSeed(unsigned long seed) { srand(seed); }
+
+char* ultoa(unsigned long value, char* str, int radix) {
+  char buf[33], *p = &buf[32];
+  *p = '\0';
+  do {
+    const uint8_t digit = value % radix;
+    *--p = digit < 10 ? '0' + digit : 'a' + digit - 10;
+    value /= radix;
+  } while (value);
+  return strcpy(str, p);
+}
+
+char* ltoa(long value, char* str, int radix) {
+  if (value < 0 && radix == 10) {
+    *str = '-';
+    ultoa(-value, str + 1, radix);
+    return str;
+  }
+  return ultoa(value, str, radix);
+}
+
+char* itoa(int value, char* str, int radix) { return ltoa(value, str, radix); }
+char* utoa(unsigned int value, char* str, int radix) { return ultoa(value, str, radix); }
+
+char* dtostrf(double val, signed char width, unsigned char prec, char* sout) {
+  sprintf(sout, "%*.*f", width, prec, val);
+  return sout;
+}
+
+// --------------------------------------------------------------------------
+// Simulator hooks
+// --------------------------------------------------------------------------
+
+void HAL_sim_set_analog(const uint8_t index, const int16_t value) {
+  #if ANALOG_INPUTS > 0
+    if (index < ANALOG_INPUTS) sim_analog_write(index, value);
+  #else
+    UNUSED(index);
+    UNUSED(value);
+  #endif
+}
+
+/**
+ * Simulated hotend on HEATER_0 and TEMP_0
+ *
+ * With HAL_SIM_HOTEND_POWER set, the temperature of hotend 0 comes from a
+ * thermal plant run by the temperature ISR instead of HAL_sim_set_analog.
+ * The plant has two bodies, so the sensor lags the heater as on a printer:
+ *  - the heater cartridge, taking HAL_SIM_HOTEND_POWER W at full PWM and
+ *    giving it to the block through HAL_SIM_HOTEND_COUPLING W/K;
+ *  - the block with the sensor and the nozzle, losing heat to the ambient,
+ *    more with the part cooling fan on, and heating the extruded filament
+ *    from the ambient temperature, as the E steps of the stepper go by.
+ * HAL_sim_hotend_temp is the block temperature, _min and _max its extremes
+ * since a test harness last reset them.
+ */
+#if HAL_SIM_HOTEND_POWER > 0 && HAS_TEMP_0 && TEMP_SENSOR_0 > 0
+
+  float HAL_sim_hotend_temp = HAL_SIM_HOTEND_AMBIENT,
+        HAL_sim_hotend_min = HAL_SIM_HOTEND_AMBIENT,
+        HAL_sim_hotend_max = HAL_SIM_HOTEND_AMBIENT;
+
+  static float sim_heater_temp = HAL_SIM_HOTEND_AMBIENT;
+  static long sim_e_position = 0;
+
+  // ADC value of a temperature, from the thermistor table of TEMP_0
+  static int16_t sim_temp2analog(const float celsius) {
+    const short (*tt)[2] = HEATER_0_TEMPTABLE;
+    for (uint8_t i = 1; i < HEATER_0_TEMPTABLE_LEN; i++) {
+      const float t0 = tt[i - 1][1], t1 = tt[i][1];
+      if ((t0 - celsius) * (t1 - celsius) <= 0 && t0 != t1)
+        return tt[i - 1][0] + (celsius - t0) * (tt[i][0] - tt[i - 1][0]) / (t1 - t0) + 0.5;
+    }
+    return (celsius > tt[0][1]) == (tt[0][1] > tt[HEATER_0_TEMPTABLE_LEN - 1][1]) ? tt[0][0] : tt[HEATER_0_TEMPTABLE_LEN - 1][0];
+  }
+
+  static void sim_hotend() {
+    const float dt = 1.0 / (TEMP_TIMER_FREQUENCY),
+                flow = HAL_sim_hotend_temp - sim_heater_temp;
+
+    float loss = HAL_SIM_HOTEND_AMBIENT_LOSS;
+    #if HAS_FAN0
+      loss += HAL_SIM_HOTEND_FAN_LOSS * fanSpeeds[0] * (1.0 / 255.0);
+    #endif
+    float lost = loss * dt; // J/K in this period
+
+    const long e_position = stepper.position(E_AXIS);
+    if (e_position > sim_e_position) lost += (e_position - sim_e_position) * Mechanics.steps_to_mm[E_AXIS] * (HAL_SIM_HOTEND_FILAMENT_HEAT);
+    sim_e_position = e_position;
+
+    sim_heater_temp += ((HAL_SIM_HOTEND_POWER) * thermalManager.heaters[0].soft_pwm * (1.0 / 255.0) + (HAL_SIM_HOTEND_COUPLING) * flow) * dt / (HAL_SIM_HOTEND_HEATER_CAPACITY);
+    HAL_sim_hotend_temp += (-(HAL_SIM_HOTEND_COUPLING) * flow * dt - lost * (HAL_sim_hotend_temp - (HAL_SIM_HOTEND_AMBIENT))) / (HAL_SIM_HOTEND_BLOCK_CAPACITY);
+
+    NOMORE(HAL_sim_hotend_min, HAL_sim_hotend_temp);
+    NOLESS(HAL_sim_hotend_max, HAL_sim_hotend_temp);
+    sim_analog_write(HOT0_SENSOR_INDEX, sim_temp2analog(HAL_sim_hotend_temp));
+  }
+
+#endif
+
+/**
+ * Timer 1 is called 3906 timer per second on the simulated clock.
+ * It is used to update pwm values for heater and some other frequent jobs.
+ *
+ *  - Manage PWM to all the heaters and fan
+ *  - Every 100ms run the PID of the heaters (temp_controller_isr)
+ *  - Run the simulated hotend (HAL_SIM_HOTEND_POWER)
+ *  - Hand the simulated ADC values to the temperature manager
+ *  - Step the babysteps value for each axis towards 0
+ *  - For PINS_DEBUGGING, monitor and report endstop pins
+ *  - For ENDSTOP_INTERRUPTS_FEATURE check endstops if flagged
+ *  - For USE_WATCHDOG check the simulated watchdog
+ */
+HAL_TEMP_TIMER_ISR {
+
+  #if ENABLED(ISR_STATISTICS)
+    const uint32_t isr_start = HAL_CYCLE_COUNT();
+  #endif
+
+  HAL_timer_isr_prologue(TEMP_TIMER);
+
+  // Allow UART ISRs
+  _DISABLE_ISRs();
+
+  #if HOTENDS > 0
+    HAL::AnalogWrite(HEATER_0_PIN, thermalManager.heaters[0].soft_pwm, HEATER_PWM_FREQ);
+    #if HOTENDS > 1
+      HAL::AnalogWrite(HEATER_1_PIN, thermalManager.heaters[1].soft_pwm, HEATER_PWM_FREQ);
+      #if HOTENDS > 2
+        HAL::AnalogWrite(HEATER_2_PIN, thermalManager.heaters[2].soft_pwm, HEATER_PWM_FREQ);
+        #if HOTENDS > 3
+          HAL::AnalogWrite(HEATER_3_PIN, thermalManager.heaters[3].soft_pwm, HEATER_PWM_FREQ);
+        #endif
+      #endif
+    #endif
+  #endif
+
+  #if HAS_HEATER_BED && HAS_TEMP_BED
+    HAL::AnalogWrite(HEATER_BED_PIN, thermalManager.heaters[BED_INDEX].soft_pwm, HEATER_PWM_FREQ);
+  #endif
+
+  #if HAS_HEATER_CHAMBER && HAS_TEMP_CHAMBER
+    HAL::AnalogWrite(HEATER_CHAMBER_PIN, thermalManager.heaters[CHAMBER_INDEX].soft_pwm, HEATER_PWM_FREQ);
+  #endif
+
+  #if HAS_COOLER && HAS_TEMP_COOLER
+    HAL::AnalogWrite(COOLER_PIN, thermalManager.heaters[COOLER_INDEX].soft_pwm, HEATER_PWM_FREQ);
+  #endif
+
+  #if HAS_FAN0
+    HAL::AnalogWrite(FAN_PIN, fanSpeeds[0], FAN_PWM_FREQ);
+  #endif
+  #if HAS_FAN1
+    HAL::AnalogWrite(FAN1_PIN, fanSpeeds[1], FAN_PWM_FREQ);
+  #endif
+  #if HAS_FAN2
+    HAL::AnalogWrite(FAN2_PIN, fanSpeeds[2], FAN_PWM_FREQ);
+  #endif
+  #if HAS_FAN3
+    HAL::AnalogWrite(FAN3_PIN, fanSpeeds[3], FAN_PWM_FREQ);
+  #endif
+  #if HAS_CONTROLLERFAN
+    HAL::AnalogWrite(CONTROLLERFAN_PIN, controller_fanSpeeds, FAN_PWM_FREQ);
+  #endif
+
+  // Calculation cycle approximate a 100ms
+  cycle_100ms++;
+  if (cycle_100ms >= 390) {
+    cycle_100ms = 0;
+    HAL::execute_100ms = true;
+    thermalManager.temp_controller_isr();
+    #if ENABLED(FAN_KICKSTART_TIME)
+      if (fanKickstart) fanKickstart--;
+    #endif
+  }
+
+  #if HAL_SIM_HOTEND_POWER > 0 && HAS_TEMP_0 && TEMP_SENSOR_0 > 0
+    sim_hotend();
+  #endif
+
+  // The simulated ADC is always ready
+  #if ANALOG_INPUTS > 0
+    thermalManager.set_current_temp_raw();
+  #endif
+
+  #if ENABLED(BABYSTEPPING)
+    LOOP_XYZ(axis) {
+      int curTodo = thermalManager.babystepsTodo[axis]; //get rid of volatile for performance
+
+      if (curTodo > 0) {
+        stepper.babystep((AxisEnum)axis,/*fwd*/true);
+        thermalManager.babystepsTodo[axis]--; //fewer to do next time
+      }
+      else if (curTodo < 0) {
+        stepper.babystep((AxisEnum)axis,/*fwd*/false);
+        thermalManager.babystepsTodo[axis]++; //fewer to do next time
+      }
+    }
+  #endif //BABYSTEPPING
+
+  #if ENABLED(PINS_DEBUGGING)
+    extern bool endstop_monitor_flag;
+    // run the endstop monitor at 15Hz
+    static uint8_t endstop_monitor_count = 16;  // offset this check from the others
+    if (endstop_monitor_flag) {
+      endstop_monitor_count += _BV(1);  //  15 Hz
+      endstop_monitor_count &= 0x7F;
+      if (!endstop_monitor_count) endstops.endstop_monitor();  // report changes in endstop status
+    }
+  #endif
+
+  #if ENABLED(ENDSTOP_INTERRUPTS_FEATURE)
+
+    extern volatile uint8_t e_hit;
+
+    if (e_hit && ENDSTOPS_ENABLED) {
+      endstops.update();  // call endstop update routine
+      e_hit--;
+    }
+  #endif
+
+  #if ENABLED(USE_WATCHDOG)
+    watchdog_check();
+  #endif
+
+  #if ENABLED(ISR_STATISTICS)
+    isrStats.record(ISR_TEMPERATURE, HAL_CYCLES_SINCE(isr_start));
+  #endif
+
+  _ENABLE_ISRs(); // re-enable ISRs
+
+}
+
+/**
+ * Host entry-point: run the firmware until the input is closed
+ * and every queued command, move and SD print is done.
+ * Host test programs linked with the firmware define HAL_SIM_NO_MAIN.
+ */
+#ifndef HAL_SIM_NO_MAIN
+
+  int main(void) {
+    setup();
+    for (;;) {
+      loop();
+      if (HAL_sim_input_closed() && !commands_in_queue && !planner.blocks_queued() && !IS_SD_PRINTING) break;
+    }
+    HAL::serialFlush();
+    return EXIT_SUCCESS;
+  }
+
+#endif
+
+#endif // ARDUINO_ARCH_LINUX
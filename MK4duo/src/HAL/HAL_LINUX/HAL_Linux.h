@@ -0,0 +1,346 @@
+/**
+ * MK4duo 3D Printer Firmware
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 - 2017 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * This is the main Hardware Abstraction Layer (HAL).
+ * To make the firmware work with different processors and toolchains,
+ * all hardware related code should be packed into the hal files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Description: HAL for host-native Linux builds
+ *
+ * The firmware runs as a normal process on a simulated clock, so the
+ * planner, the stepper ISR and the command queue can be measured on a
+ * PC without any board attached.
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+
+/**
+ * Build from the MK4duo folder with any C++11 host compiler, e.g.:
+ *
+ *   g++ -std=gnu++11 -O2 -DARDUINO_ARCH_LINUX -Isrc/HAL/HAL_LINUX/include \
+ *       $(find src -name '*.cpp') -o mk4duo -lm
+ *
+ * The process reads G-code from stdin and answers on stdout, it stops
+ * when stdin is closed and all the queued moves are done.
+ * EEPROM is kept in the file named by the MK4DUO_EEPROM environment
+ * variable (default "eeprom.bin"), with SDSUPPORT the SD card is the raw
+ * FAT disk image named by MK4DUO_SDCARD.
+ */
+
+#ifndef _HAL_LINUX_H
+#define _HAL_LINUX_H
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <Arduino.h>
+#include "fastio_Linux.h"
+#include "watchdog_Linux.h"
+#include "HAL_timers_Linux.h"
+
+// --------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------
+
+// No program space memory on the host
+#define PROGMEM
+#ifndef PGM_P
+  #define PGM_P const char*
+#endif
+#undef PSTR
+#define PSTR(s) s
+#undef pgm_read_byte_near
+#define pgm_read_byte_near(x) (*(int8_t*)x)
+#undef pgm_read_byte
+#define pgm_read_byte(x) (*(int8_t*)x)
+#undef pgm_read_float
+#define pgm_read_float(addr) (*(const float *)(addr))
+#undef pgm_read_word
+#define pgm_read_word(addr) (*(addr))
+#undef pgm_read_word_near
+#define pgm_read_word_near(addr) pgm_read_word(addr)
+#undef pgm_read_dword
+#define pgm_read_dword(addr) (*(addr))
+#undef pgm_read_dword_near
+#define pgm_read_dword_near(addr) pgm_read_dword(addr)
+#undef pgm_read_ptr
+#define pgm_read_ptr(addr) (*(addr))
+#define strcpy_P(dest, src)               strcpy((dest), (src))
+#define strncpy_P(dest, src, num)         strncpy((dest), (src), (num))
+#define strcat_P(dest, src)               strcat((dest), (src))
+#define strstr_P(str, sub)                strstr((str), (sub))
+#define strchr_P(str, c)                  strchr((str), (c))
+#define strcmp_P(a, b)                    strcmp((a), (b))
+#define strncmp_P(a, b, num)              strncmp((a), (b), (num))
+#define strlen_P(s)                       strlen(s)
+#define memcpy_P(dest, src, num)          memcpy((dest), (src), (num))
+#define sprintf_P(buf, ...)               sprintf((buf), __VA_ARGS__)
+#define vsnprintf_P(buf, size, a, b)      vsnprintf((buf), (size), (a), (b))
+
+// EEPROM START
+#define EEPROM_OFFSET 10
+#define EEPROM_SIZE   4096
+
+// MATH
+#define MATH_USE_HAL
+#undef ATAN2
+#undef FABS
+#undef POW
+#undef SQRT
+#undef CEIL
+#undef FLOOR
+#undef LROUND
+#undef FMOD
+#undef COS
+#undef SIN
+#define ATAN2(y, x) atan2f(y, x)
+#define FABS(x)     fabsf(x)
+#define POW(x, y)   powf(x, y)
+#define SQRT(x)     sqrtf(x)
+#define CEIL(x)     ceilf(x)
+#define FLOOR(x)    floorf(x)
+#define LROUND(x)   lroundf(x)
+#define FMOD(x, y)  fmodf(x, y)
+#define COS(x)      cosf(x)
+#define SIN(x)      sinf(x)
+
+#define CRITICAL_SECTION_START  const bool irq_state = HAL_sim_irq_enabled; cli();
+#define CRITICAL_SECTION_END    if (irq_state) sei();
+
+// Voltage
+#define HAL_VOLTAGE_PIN 3.3
+
+// reset reason
+#define RST_POWER_ON   1
+#define RST_EXTERNAL   2
+#define RST_BROWN_OUT  4
+#define RST_WATCHDOG   8
+#define RST_JTAG       16
+#define RST_SOFTWARE   32
+#define RST_BACKUP     64
+
+#define SPR0    0
+#define SPR1    1
+
+#define PACK    __attribute__ ((packed))
+
+#define MultiU16X8toH16(intRes, charIn1, intIn2)   intRes = ((charIn1) * (intIn2)) >> 16
+#define MultiU32X32toH32(intRes, longIn1, longIn2) intRes = ((uint64_t)longIn1 * longIn2 + 0x80000000) >> 32
+// Macros for stepper.cpp
+#define HAL_MULTI_ACC(intRes, longIn1, longIn2) MultiU32X32toH32(intRes, longIn1, longIn2)
+
+#define ADV_NEVER 0xFFFFFFFF
+
+// TEMPERATURE
+// Bits of the ADC converter
+#define ANALOG_INPUT_BITS 12
+#define ANALOG_REDUCE_BITS 0
+#define ANALOG_REDUCE_FACTOR 1
+
+#define MAX_ANALOG_PIN_NUMBER 15
+#define OVERSAMPLENR 6
+#define MEDIAN_COUNT 10 // MEDIAN COUNT for Smoother temperature
+#define NUM_ADC_SAMPLES (2 + (1 << OVERSAMPLENR))
+
+// Value returned by every ADC channel until a harness sets it with HAL_sim_set_analog
+#define HAL_SIM_ADC_DEFAULT 512
+
+// --------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------
+
+typedef uint32_t millis_t;
+typedef int16_t Pin;
+
+// UART of the simulated Due, see HAL_SIM_BAUDRATE in HAL_Linux.cpp
+void HAL_sim_uart_write(const char c);
+int HAL_sim_uart_available_for_write();
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+// reset reason
+extern uint8_t MCUSR;
+
+class HAL {
+  public:
+
+    HAL();
+
+    virtual ~HAL();
+
+    #if ANALOG_INPUTS > 0
+      static volatile int16_t AnalogInputValues[ANALOG_INPUTS];
+      #if ENABLED(ADC_DMA)
+        // Odd while a simulator hook writes AnalogInputValues
+        static volatile uint32_t AnalogInputSeq;
+        static bool analogReadValues(int16_t values[ANALOG_INPUTS]);
+      #endif
+    #endif
+
+    static bool execute_100ms;
+
+    static void hwSetup(void);
+
+    // SPI bus with the SD card image of MK4DUO_SDCARD
+    static void spiBegin();
+    static void spiInit(uint8_t spiClock);
+    static void spiSend(uint8_t b);
+    static void spiSend(const uint8_t* buf, size_t n);
+    static uint8_t spiReceive();
+    static void spiReadBlock(uint8_t* buf, uint16_t nbyte);
+    static void spiSendBlock(uint8_t token, const uint8_t* buf);
+    #if ENABLED(SD_SPI_DMA)
+      // DMA transfers, the bytes move on the simulated clock while the program goes on
+      static void spiDmaReadStart(uint8_t* buf, uint16_t nbyte);
+      static void spiDmaSendStart(const uint8_t* buf, uint16_t nbyte);
+      static bool spiDmaDone();
+    #endif
+
+    static bool AnalogWrite(Pin pin, const uint8_t value, const uint16_t freq);
+
+    static inline void digitalWrite(Pin pin, uint8_t value) {
+      WRITE_VAR(pin, value);
+    }
+    static inline uint8_t digitalRead(Pin pin) {
+      return READ_VAR(pin);
+    }
+    static inline void pinMode(Pin pin, uint8_t mode) {
+      if (mode == INPUT) {
+        SET_INPUT(pin);
+      }
+      else SET_OUTPUT(pin);
+    }
+
+    static FORCE_INLINE void delayMicroseconds(uint32_t usec) {
+      HAL_sim_consume(usec * STEPPER_TIMER_TICKS_PER_US);
+    }
+    static inline void delayMilliseconds(unsigned int delayMs) {
+      while (delayMs--) delayMicroseconds(1000);
+    }
+    static inline unsigned long timeInMilliseconds() {
+      return millis();
+    }
+
+    // Serial communication
+    static inline char readFlashByte(PGM_P ptr) {
+      return pgm_read_byte(ptr);
+    }
+    static inline void serialSetBaudrate(long baud) {
+      UNUSED(baud);
+    }
+    static bool serialByteAvailable();
+    static uint8_t serialReadByte();
+    #if ENABLED(SERIAL_TX_BUFFER)
+      static void serialWriteByte(char c);
+      static void serialFlush();
+      static void serialTxPump();
+    #else
+      static inline void serialWriteByte(char c) {
+        HAL_sim_uart_write(c);
+      }
+      static inline void serialFlush() {
+        fflush(stdout);
+      }
+    #endif
+
+    static void showStartReason();
+
+    static int getFreeRam();
+    static void resetHardware();
+
+    static void analogStart();
+
+  protected:
+  private:
+
+};
+
+/**
+ * Public functions
+ */
+
+// Disable interrupts
+void cli(void);
+
+// Enable interrupts
+void sei(void);
+
+int freeMemory(void);
+
+// EEPROM
+uint8_t eeprom_read_byte(uint8_t* pos);
+void eeprom_read_block(void* pos, const void* eeprom_address, size_t n);
+void eeprom_write_byte(uint8_t* pos, uint8_t value);
+void eeprom_update_block(const void* pos, void* eeprom_address, size_t n);
+
+// Simulator hooks for a test harness
+void HAL_sim_set_analog(const uint8_t index, const int16_t value);
+bool HAL_sim_input_closed();
+
+// Simulated hotend, see HAL_SIM_HOTEND_POWER in HAL_Linux.cpp
+#ifndef HAL_SIM_HOTEND_POWER
+  #define HAL_SIM_HOTEND_POWER 0  // W of the heater at full power, 0 to read HAL_SIM_ADC_DEFAULT
+#endif
+#ifndef HAL_SIM_HOTEND_HEATER_CAPACITY
+  #define HAL_SIM_HOTEND_HEATER_CAPACITY  2.5     // J/K
+#endif
+#ifndef HAL_SIM_HOTEND_COUPLING
+  #define HAL_SIM_HOTEND_COUPLING         0.6     // W/K from the cartridge to the block
+#endif
+#ifndef HAL_SIM_HOTEND_BLOCK_CAPACITY
+  #define HAL_SIM_HOTEND_BLOCK_CAPACITY   13.0    // J/K
+#endif
+#ifndef HAL_SIM_HOTEND_AMBIENT_LOSS
+  #define HAL_SIM_HOTEND_AMBIENT_LOSS     0.07    // W/K
+#endif
+#ifndef HAL_SIM_HOTEND_FAN_LOSS
+  #define HAL_SIM_HOTEND_FAN_LOSS         0.1     // W/K more with the fan at full speed
+#endif
+#ifndef HAL_SIM_HOTEND_FILAMENT_HEAT
+  #define HAL_SIM_HOTEND_FILAMENT_HEAT    5.4e-3  // J/K per mm of filament
+#endif
+#ifndef HAL_SIM_HOTEND_AMBIENT
+  #define HAL_SIM_HOTEND_AMBIENT          25.0    // C
+#endif
+
+extern float HAL_sim_hotend_temp, HAL_sim_hotend_min, HAL_sim_hotend_max;
+
+#endif // _HAL_LINUX_H
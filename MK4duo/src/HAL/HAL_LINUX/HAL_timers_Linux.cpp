@@ -0,0 +1,186 @@
+/**
+ * MK4duo 3D Printer Firmware
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 - 2017 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * This is the main Hardware Abstraction Layer (HAL).
+ * To make the firmware work with different processors and toolchains,
+ * all hardware related code should be packed into the hal files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Description: HAL for host-native Linux builds
+ *
+ * The firmware runs as a normal process on a simulated clock, so the
+ * planner, the stepper ISR and the command queue can be measured on a
+ * PC without any board attached.
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+
+#include "../../../base.h"
+
+#if ENABLED(ARDUINO_ARCH_LINUX)
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+
+#include "HAL_timers_Linux.h"
+#include <time.h>
+
+// --------------------------------------------------------------------------
+// Externals
+// --------------------------------------------------------------------------
+
+extern HAL_STEP_TIMER_ISR;
+extern HAL_TEMP_TIMER_ISR;
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+volatile uint64_t HAL_sim_ticks = 0;
+volatile bool HAL_sim_irq_enabled = true;
+
+tTimerConfig TimerConfig[NUM_HARDWARE_TIMERS] = {
+  { 1, 0, false, false, HAL_step_timer_isr }, // 0 - stepper
+  { 1, 0, false, false, HAL_temp_timer_isr }, // 1 - temperature
+  { 1, 0, false, false, NULL }                // 2 - beeper
+};
+
+// --------------------------------------------------------------------------
+// Private Variables
+// --------------------------------------------------------------------------
+
+static uint8_t isr_nesting = 0;
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+// True while a simulated ISR runs
+bool HAL_sim_in_isr() {
+  return isr_nesting != 0;
+}
+
+/**
+ * Move the simulated clock forward.
+ * Outside of an ISR every compare match that is now due is serviced.
+ */
+void HAL_sim_consume(const uint32_t ticks) {
+  HAL_sim_ticks += ticks;
+  if (!isr_nesting && HAL_sim_irq_enabled) HAL_sim_dispatch();
+}
+
+/**
+ * Move the simulated clock forward as a busy main program would do,
+ * in small slices so that every ISR runs on time meanwhile.
+ */
+void HAL_sim_run(uint32_t ticks) {
+  while (ticks) {
+    const uint32_t slice = min(ticks, (uint32_t)HAL_SIM_POLL_TICKS);
+    HAL_sim_consume(slice);
+    ticks -= slice;
+  }
+}
+
+/**
+ * Host CPU time scaled to the target, in microseconds.
+ * Only used to benchmark code, it doesn't move the simulated clock.
+ */
+uint32_t HAL_sim_cpu_micros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec) * HAL_SIM_CPU_SCALE / 1000);
+}
+
+/**
+ * Run the ISRs of all the compare match that are due, oldest first,
+ * exactly as the NVIC would do after a long critical section.
+ */
+void HAL_sim_dispatch() {
+  if (isr_nesting) return;
+
+  for (;;) {
+    tTimerConfig *next = NULL;
+    uint64_t due = 0;
+
+    for (uint8_t t = 0; t < NUM_HARDWARE_TIMERS; t++) {
+      tTimerConfig *pConfig = &TimerConfig[t];
+      if (!pConfig->started || !pConfig->enabled || !pConfig->isr) continue;
+      const uint64_t match = pConfig->period_start + pConfig->compare;
+      if (match <= HAL_sim_ticks && (!next || match < due)) {
+        next = pConfig;
+        due = match;
+      }
+    }
+
+    if (!next) break;
+
+    next->period_start = due;
+    isr_nesting++;
+    next->isr();
+    isr_nesting--;
+  }
+}
+
+void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency) {
+  tTimerConfig *pConfig = &TimerConfig[timer_num];
+
+  pConfig->compare = HAL_STEPPER_TIMER_RATE / frequency;
+  pConfig->period_start = HAL_sim_ticks;
+  pConfig->started = true;
+  pConfig->enabled = true;
+}
+
+void HAL_timer_enable_interrupt(const uint8_t timer_num) {
+  TimerConfig[timer_num].enabled = true;
+}
+
+void HAL_timer_disable_interrupt(const uint8_t timer_num) {
+  TimerConfig[timer_num].enabled = false;
+}
+
+// No sound on the host, just keep the beeper pin coherent
+void tone(uint8_t pin, int frequency, unsigned long duration) {
+  UNUSED(frequency);
+  UNUSED(duration);
+  OUT_WRITE(pin, HIGH);
+}
+
+void noTone(uint8_t pin) {
+  WRITE(pin, LOW);
+}
+
+#endif // ARDUINO_ARCH_LINUX
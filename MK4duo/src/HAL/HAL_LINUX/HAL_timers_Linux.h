@@ -0,0 +1,215 @@
+/**
+ * MK4duo 3D Printer Firmware
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 - 2017 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * This is the main Hardware Abstraction Layer (HAL).
+ * To make the firmware work with different processors and toolchains,
+ * all hardware related code should be packed into the hal files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Description: HAL for host-native Linux builds
+ *
+ * The firmware runs as a normal process on a simulated clock, so the
+ * planner, the stepper ISR and the command queue can be measured on a
+ * PC without any board attached.
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+
+#ifndef _HAL_TIMERS_LINUX_H
+#define _HAL_TIMERS_LINUX_H
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+
+#include <stdint.h>
+
+// --------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------
+
+typedef uint32_t HAL_TIMER_TYPE;
+
+typedef struct {
+  uint32_t  compare;        // Ticks between two compare match (the Due TC_RC)
+  uint64_t  period_start;   // Simulated time of the last compare match
+  bool      started,
+            enabled;
+  void      (*isr)(void);
+} tTimerConfig;
+
+// --------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------
+
+#define NUM_HARDWARE_TIMERS 3
+
+#define STEPPER_TIMER 0
+#define STEPPER_TIMER_PRESCALE  2.0
+#define HAL_STEPPER_TIMER_RATE      ((F_CPU) / STEPPER_TIMER_PRESCALE)  // 42 MHz
+#define STEPPER_TIMER_TICKS_PER_US  (HAL_STEPPER_TIMER_RATE / 1000000)  // 42
+
+#define TEMP_TIMER 1
+#define TEMP_TIMER_FREQUENCY 3906
+
+#define BEEPER_TIMER 2
+
+// Simulated time charged to the main program every time it polls the HAL
+// (millis, micros, serial, watchdog) and to every read of the timer counter.
+#define HAL_SIM_POLL_TICKS  (5 * STEPPER_TIMER_TICKS_PER_US)
+#define HAL_SIM_READ_TICKS  1
+
+// Host CPU time measured with HAL_BENCH_MICROS is multiplied by this factor,
+// so that the planner costs about as much simulated time as on a Due.
+#ifndef HAL_SIM_CPU_SCALE
+  #define HAL_SIM_CPU_SCALE   20
+#endif
+
+#define HAL_BENCH_MICROS()    HAL_sim_cpu_micros()
+#define HAL_BENCH_CHARGE(US)  HAL_sim_run((US) * STEPPER_TIMER_TICKS_PER_US)
+
+#define HAL_STEPPER_TIMER_START()           HAL_timer_start(STEPPER_TIMER, 122)
+#define HAL_TEMP_TIMER_START()              HAL_timer_start(TEMP_TIMER, TEMP_TIMER_FREQUENCY)
+
+#define ENABLE_STEPPER_INTERRUPT()          HAL_timer_enable_interrupt (STEPPER_TIMER)
+#define DISABLE_STEPPER_INTERRUPT()         HAL_timer_disable_interrupt (STEPPER_TIMER)
+
+#define ENABLE_TEMP_INTERRUPT()             HAL_timer_enable_interrupt (TEMP_TIMER)
+#define DISABLE_TEMP_INTERRUPT()            HAL_timer_disable_interrupt (TEMP_TIMER)
+
+#define HAL_TIMER_SET_STEPPER_COUNT(count)  HAL_timer_set_count(STEPPER_TIMER, count);
+#define HAL_TIMER_SET_TEMP_COUNT(count)     HAL_timer_set_count(TEMP_TIMER, count);
+
+#define HAL_STEP_TIMER_ISR    void HAL_step_timer_isr()
+#define HAL_TEMP_TIMER_ISR    void HAL_temp_timer_isr()
+
+#define _ENABLE_ISRs() \
+        do { \
+          ENABLE_TEMP_INTERRUPT(); \
+          ENABLE_STEPPER_INTERRUPT(); \
+        } while(0)
+
+#define _DISABLE_ISRs() \
+        do { \
+          DISABLE_TEMP_INTERRUPT(); \
+          DISABLE_STEPPER_INTERRUPT(); \
+          sei(); \
+        } while(0)
+
+// Clock speed factor
+#define CYCLES_PER_US ((F_CPU) / 1000000) // 84
+
+// Cycle counter for the ISR statistics, the simulated clock.
+// The stepper timer counts from the compare match, at the entry
+// of the ISR it is the lateness of the step.
+#define HAL_CYCLE_COUNT()       ((uint32_t)HAL_sim_ticks * (uint32_t)STEPPER_TIMER_PRESCALE)
+#define HAL_CYCLES_SINCE(start) (HAL_CYCLE_COUNT() - (start))
+#define HAL_STEPPER_LATENESS()  (HAL_timer_get_current_count(STEPPER_TIMER) * (uint32_t)STEPPER_TIMER_PRESCALE)
+// Stepper pulse duration, in cycles
+#define STEP_PULSE_CYCLES ((MINIMUM_STEPPER_PULSE) * CYCLES_PER_US)
+
+// Delays only move the simulated clock
+#define DELAY_0_NOP   NOOP
+#define DELAY_1_NOP   HAL_sim_consume(1)
+#define DELAY_2_NOP   HAL_sim_consume(1)
+#define DELAY_3_NOP   HAL_sim_consume(2)
+#define DELAY_4_NOP   HAL_sim_consume(2)
+#define DELAY_5_NOP   HAL_sim_consume(3)
+#define DELAY_10_NOP  HAL_sim_consume(5)
+#define DELAY_20_NOP  HAL_sim_consume(10)
+#define DELAY_40_NOP  HAL_sim_consume(20)
+#define DELAY_80_NOP  HAL_sim_consume(40)
+
+#define DELAY_NOPS(X) HAL_sim_consume(((X) + 1) / 2)
+
+#define DELAY_1US   HAL_sim_consume(STEPPER_TIMER_TICKS_PER_US)
+#define DELAY_2US   HAL_sim_consume(2 * STEPPER_TIMER_TICKS_PER_US)
+#define DELAY_3US   HAL_sim_consume(3 * STEPPER_TIMER_TICKS_PER_US)
+#define DELAY_4US   HAL_sim_consume(4 * STEPPER_TIMER_TICKS_PER_US)
+#define DELAY_5US   HAL_sim_consume(5 * STEPPER_TIMER_TICKS_PER_US)
+#define DELAY_6US   HAL_sim_consume(6 * STEPPER_TIMER_TICKS_PER_US)
+#define DELAY_7US   HAL_sim_consume(7 * STEPPER_TIMER_TICKS_PER_US)
+#define DELAY_8US   HAL_sim_consume(8 * STEPPER_TIMER_TICKS_PER_US)
+#define DELAY_9US   HAL_sim_consume(9 * STEPPER_TIMER_TICKS_PER_US)
+#define DELAY_10US  HAL_sim_consume(10 * STEPPER_TIMER_TICKS_PER_US)
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+// Simulated time in stepper timer ticks since power on
+extern volatile uint64_t HAL_sim_ticks;
+
+// Interrupt flag, cleared by cli() and set by sei()
+extern volatile bool HAL_sim_irq_enabled;
+
+extern tTimerConfig TimerConfig[NUM_HARDWARE_TIMERS];
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+void HAL_sim_consume(const uint32_t ticks);
+void HAL_sim_dispatch();
+bool HAL_sim_in_isr();
+void HAL_sim_run(uint32_t ticks);
+uint32_t HAL_sim_cpu_micros();
+
+void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency);
+
+static FORCE_INLINE void HAL_timer_set_count(const uint8_t timer_num, const uint32_t count) {
+  TimerConfig[timer_num].compare = count ? count : 1;
+}
+
+static FORCE_INLINE HAL_TIMER_TYPE HAL_timer_get_count(const uint8_t timer_num) {
+  return TimerConfig[timer_num].compare;
+}
+
+static FORCE_INLINE uint32_t HAL_timer_get_current_count(const uint8_t timer_num) {
+  // A busy loop on the counter must see the time go on
+  HAL_sim_consume(HAL_SIM_READ_TICKS);
+  return (uint32_t)(HAL_sim_ticks - TimerConfig[timer_num].period_start);
+}
+
+void HAL_timer_enable_interrupt(const uint8_t timer_num);
+void HAL_timer_disable_interrupt(const uint8_t timer_num);
+
+static FORCE_INLINE void HAL_timer_isr_prologue(const uint8_t timer_num) { UNUSED(timer_num); }
+
+void tone(uint8_t pin, int frequency, unsigned long duration);
+void noTone(uint8_t pin);
+
+#endif // _HAL_TIMERS_LINUX_H
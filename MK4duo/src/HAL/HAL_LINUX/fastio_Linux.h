@@ -0,0 +1,145 @@
+/**
+ * MK4duo 3D Printer Firmware
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 - 2017 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Description: Fast IO functions for the host-native Linux HAL
+ *
+ * Every pin is a slot of a shadow register file. Writes only update the
+ * slot, so the firmware can run at full speed while a test harness or a
+ * benchmark can inspect levels, modes and the number of step pulses.
+ */
+
+// **************************************************************************
+//
+// Description: Fast IO functions for Linux
+//
+// ARDUINO_ARCH_LINUX
+// **************************************************************************
+
+#ifndef _HAL_FASTIO_LINUX_H
+#define _HAL_FASTIO_LINUX_H
+
+#include <Arduino.h>
+
+/**
+ * Types
+ */
+
+typedef struct {
+  uint8_t   value;        // Current logic level
+  uint8_t   mode;         // INPUT, OUTPUT or INPUT_PULLUP
+  uint8_t   pwm;          // Last value set with HAL::AnalogWrite
+  uint32_t  rising;       // Rising edges written, i.e. step pulses
+  void      (*isr)(void); // Attached external interrupt
+} Fastio_Pin;
+
+/**
+ * pins
+ */
+
+extern Fastio_Pin Fastio[NUM_DIGITAL_PINS];
+
+// UART
+#define RXD (0u)
+#define TXD (1u)
+
+/**
+ * utility functions
+ */
+
+#ifndef MASK
+  #define MASK(PIN) (1 << PIN)
+#endif
+
+/**
+ * magic I/O routines
+ * now you can simply SET_OUTPUT(STEP); WRITE(STEP, 1); WRITE(STEP, 0);
+ */
+
+// Read a pin
+static FORCE_INLINE bool READ(const uint8_t pin) {
+  return Fastio[pin].value;
+}
+
+static FORCE_INLINE bool READ_VAR(const uint8_t pin) {
+  return Fastio[pin].value;
+}
+
+// write to a pin
+static FORCE_INLINE void WRITE(const uint8_t pin, uint8_t flag) {
+  if (flag && !Fastio[pin].value) Fastio[pin].rising++;
+  Fastio[pin].value = flag ? HIGH : LOW;
+}
+
+static FORCE_INLINE void WRITE_VAR(const uint8_t pin, uint8_t flag) {
+  WRITE(pin, flag);
+}
+
+// toggle a pin
+static FORCE_INLINE void TOGGLE(const uint8_t pin) {
+  WRITE(pin, !READ(pin));
+}
+
+// set pin as input
+static FORCE_INLINE void SET_INPUT(const uint8_t pin) {
+  Fastio[pin].mode = INPUT;
+}
+
+// set pin as output
+static FORCE_INLINE void _SET_OUTPUT(const uint8_t pin) {
+  Fastio[pin].mode = OUTPUT;
+}
+
+// Write doesn't work for pullups
+static FORCE_INLINE void PULLUP(const uint8_t pin) {
+  Fastio[pin].mode = INPUT_PULLUP;
+  Fastio[pin].value = HIGH;
+}
+
+// set pin as input with pullup wrapper
+static FORCE_INLINE void SET_INPUT_PULLUP(const uint8_t pin) {
+  SET_INPUT(pin);
+  PULLUP(pin);
+}
+
+// Shorthand
+static FORCE_INLINE void OUT_WRITE(const uint8_t pin, uint8_t flag) {
+  _SET_OUTPUT(pin);
+  WRITE(pin, flag);
+}
+
+// set pin as output wrapper
+static FORCE_INLINE void SET_OUTPUT(const uint8_t pin) {
+  OUT_WRITE(pin, LOW);
+}
+
+/**
+ * Drive an input pin from outside the firmware (endstops, probes, buttons).
+ * An attached interrupt is fired on every change of level.
+ */
+static FORCE_INLINE void SIM_WRITE_INPUT(const uint8_t pin, uint8_t flag) {
+  const uint8_t old_value = Fastio[pin].value;
+  Fastio[pin].value = flag ? HIGH : LOW;
+  if (old_value != Fastio[pin].value && Fastio[pin].isr) Fastio[pin].isr();
+}
+
+#endif  // _HAL_FASTIO_LINUX_H
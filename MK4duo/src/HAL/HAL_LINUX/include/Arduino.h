@@ -0,0 +1,154 @@
+/**
+ * MK4duo 3D Printer Firmware
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 - 2017 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Description: Minimal Arduino core for the host-native Linux HAL
+ *
+ * Only the part of the Arduino API that MK4duo uses outside of the HAL
+ * is provided here. Everything is backed by the simulated pin file and
+ * the simulated clock of HAL_LINUX.
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+
+#ifndef _ARDUINO_LINUX_H
+#define _ARDUINO_LINUX_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+// --------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------
+
+// The simulated core runs at the same clock of an Arduino Due,
+// so the timing numbers are comparable with the real board.
+#ifndef F_CPU
+  #define F_CPU 84000000UL
+#endif
+
+#define ARDUINO 10802
+
+#define HIGH          0x1
+#define LOW           0x0
+
+#define INPUT         0x0
+#define OUTPUT        0x1
+#define INPUT_PULLUP  0x2
+
+#define CHANGE        2
+#define FALLING       3
+#define RISING        4
+
+#define NUM_DIGITAL_PINS  256
+#define NUM_ANALOG_INPUTS 16
+
+#define A0  54
+#define A1  55
+#define A2  56
+#define A3  57
+#define A4  58
+#define A5  59
+#define A6  60
+#define A7  61
+#define A8  62
+#define A9  63
+#define A10 64
+#define A11 65
+#define A12 66
+#define A13 67
+#define A14 68
+#define A15 69
+
+#define digitalPinToInterrupt(p)  (p)
+#define analogInputToDigitalPin(p) ((p < NUM_ANALOG_INPUTS) ? (p) + A0 : -1)
+
+#ifndef min
+  #define min(a,b) ((a)<(b)?(a):(b))
+#endif
+#ifndef max
+  #define max(a,b) ((a)>(b)?(a):(b))
+#endif
+#ifndef constrain
+  #define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#endif
+#ifndef sq
+  #define sq(x) ((x)*(x))
+#endif
+#ifndef radians
+  #define radians(deg) ((deg)*DEG_TO_RAD)
+#endif
+#ifndef degrees
+  #define degrees(rad) ((rad)*RAD_TO_DEG)
+#endif
+
+#define PI          3.1415926535897932384626433832795
+#define HALF_PI     1.5707963267948966192313216916398
+#define TWO_PI      6.283185307179586476925286766559
+#define DEG_TO_RAD  0.017453292519943295769236907684886
+#define RAD_TO_DEG  57.295779513082320876798154814105
+
+// --------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------
+
+typedef uint8_t byte;
+typedef bool    boolean;
+typedef uint16_t word;
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+void noInterrupts(void);
+void interrupts(void);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+char* itoa(int value, char* str, int radix);
+char* utoa(unsigned int value, char* str, int radix);
+char* ltoa(long value, char* str, int radix);
+char* dtostrf(double val, signed char width, unsigned char prec, char* sout);
+
+inline bool isDigit(int c) { return isdigit(c); }
+
+#endif // _ARDUINO_LINUX_H
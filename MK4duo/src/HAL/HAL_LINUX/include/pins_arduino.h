@@ -0,0 +1,35 @@
+/**
+ * MK4duo 3D Printer Firmware
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 - 2017 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Description: Pin definitions for the host-native Linux HAL
+ *
+ * The simulated board has no fixed pin map, every pin number used by the
+ * selected MOTHERBOARD is mapped into the simulated pin file.
+ *
+ * ARDUINO_ARCH_LINUX
+ */
+
+#ifndef _PINS_ARDUINO_LINUX_H
+#define _PINS_ARDUINO_LINUX_H
+
+#endif // _PINS_ARDUINO_LINUX_H
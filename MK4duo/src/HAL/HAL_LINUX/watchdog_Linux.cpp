@@ -0,0 +1,56 @@
+/**
+ * MK4duo 3D Printer Firmware
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 - 2017 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../base.h"
+
+#if ENABLED(ARDUINO_ARCH_LINUX)
+
+  #if ENABLED(USE_WATCHDOG)
+
+    #include "watchdog_Linux.h"
+
+    #define WATCHDOG_TIMEOUT_TICKS (4ULL * 1000000ULL * STEPPER_TIMER_TICKS_PER_US)
+
+    static bool watchdog_enabled = false;
+    static uint64_t watchdog_last_reset = 0;
+
+    void watchdog_init(void) {
+      watchdog_last_reset = HAL_sim_ticks;
+      watchdog_enabled = true;
+    }
+
+    void watchdog_reset(void) {
+      HAL_sim_consume(HAL_SIM_POLL_TICKS);
+      watchdog_last_reset = HAL_sim_ticks;
+    }
+
+    void watchdog_check(void) {
+      if (watchdog_enabled && HAL_sim_ticks - watchdog_last_reset > WATCHDOG_TIMEOUT_TICKS) {
+        SERIAL_LM(ER, MSG_WATCHDOG_RESET);
+        HAL::serialFlush();
+        exit(RST_WATCHDOG);
+      }
+    }
+
+  #endif // USE_WATCHDOG
+
+#endif
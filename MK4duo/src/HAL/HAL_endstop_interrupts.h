@@ -38,6 +38,8 @@ void endstop_ISR(void) { endstop_ISR_worker(); }
   #include "HAL_DUE/endstop_interrupts.h"
 #elif ENABLED(ARDUINO_ARCH_AVR)
   #include "HAL_AVR/endstop_interrupts.h"
+#elif ENABLED(ARDUINO_ARCH_LINUX)
+  #include "HAL_LINUX/endstop_interrupts.h"
 #else
   #error "Unsupported Platform!"
 #endif
@@ -101,23 +101,34 @@ static long gcode_N, gcode_LastN, Stopped_gcode_LastN = 0;
 
 /**
  * GCode Command Queue
- * A simple ring buffer of BUFSIZE command strings.
+ * A ring buffer of COMMAND_QUEUE_SIZE bytes holding the commands one
+ * after the other, each one taking only its own length:
+ *
+ *   SIZE  SAY_OK  COMMAND...
+ *
+ * SIZE counts the whole entry. A command is never split at the end of
+ * the buffer: a SIZE of 0 (or the end) sends the reader back to the start.
  *
  * Commands are copied into this buffer by the command injectors
  * (immediate, serial, sd card) and they are processed sequentially by
  * the main loop. The process_next_command function parses the next
  * command and hands off execution to individual handler functions.
  */
+#define COMMAND_HEADER_SIZE 2
+#define COMMAND_ENTRY_SIZE  (COMMAND_HEADER_SIZE + MAX_CMD_SIZE)
+
 uint8_t commands_in_queue = 0;          // Count of commands in the queue
-static uint8_t  cmd_queue_index_r = 0,  // Ring buffer read position
+static uint16_t cmd_queue_index_r = 0,  // Ring buffer read position
                 cmd_queue_index_w = 0;  // Ring buffer write position
 
 #if ENABLED(M100_FREE_MEMORY_WATCHER)
-  char command_queue[BUFSIZE][MAX_CMD_SIZE];
+  char command_queue[COMMAND_QUEUE_SIZE];
 #else
-  static char command_queue[BUFSIZE][MAX_CMD_SIZE];
+  static char command_queue[COMMAND_QUEUE_SIZE];
 #endif
 
+FORCE_INLINE char* current_command_ptr() { return command_queue + cmd_queue_index_r + COMMAND_HEADER_SIZE; }
+
 /**
  * Next Injected Command pointer. NULL if no commands are being injected.
  * Used by MK4duo internally to ensure that commands initiated from within
@@ -367,7 +378,6 @@ PrintCounter print_job_counter = PrintCounter();
   bool allow_lengthy_extrude_once; // for load/unload
 #endif
 
-static bool send_ok[BUFSIZE];
 
 #if HAS_SERVOS
   #define MOVE_SERVO(I, P) servo[I].move(P)
@@ -461,27 +471,110 @@ void enqueue_and_echo_commands_P(const char * const pgcode) {
  * Clear the MK4duo command queue
  */
 void clear_command_queue() {
-  cmd_queue_index_r = cmd_queue_index_w;
+  cmd_queue_index_r = cmd_queue_index_w = 0;
   commands_in_queue = 0;
 }
 
 /**
- * Once a new command is in the ring buffer, call this to commit it
+ * Where the next command goes, with room for the longest one,
+ * or NULL if the queue is full
+ */
+static uint16_t command_slot_index() {
+  if (!commands_in_queue) return 0;
+  if (commands_in_queue == 255) return COMMAND_QUEUE_SIZE;
+  if (cmd_queue_index_w > cmd_queue_index_r) {
+    if (COMMAND_QUEUE_SIZE - cmd_queue_index_w >= COMMAND_ENTRY_SIZE) return cmd_queue_index_w;
+    return cmd_queue_index_r >= COMMAND_ENTRY_SIZE ? 0 : COMMAND_QUEUE_SIZE;
+  }
+  return cmd_queue_index_r - cmd_queue_index_w >= COMMAND_ENTRY_SIZE ? cmd_queue_index_w : COMMAND_QUEUE_SIZE;
+}
+
+inline char* command_slot() {
+  const uint16_t i = command_slot_index();
+  return i < COMMAND_QUEUE_SIZE ? command_queue + i + COMMAND_HEADER_SIZE : NULL;
+}
+
+inline bool command_queue_has_room() { return command_slot_index() < COMMAND_QUEUE_SIZE; }
+
+#if ENABLED(ADVANCED_OK)
+
+  /**
+   * Commands of MAX_CMD_SIZE that still fit in the command queue, the
+   * ones command_slot_index() is sure to accept. Shorter commands take
+   * less room, so more of them may fit.
+   */
+  static uint16_t command_queue_free() {
+    uint16_t free;
+    if (!commands_in_queue)
+      free = COMMAND_QUEUE_SIZE / COMMAND_ENTRY_SIZE;
+    else if (cmd_queue_index_w > cmd_queue_index_r)
+      free = (COMMAND_QUEUE_SIZE - cmd_queue_index_w) / COMMAND_ENTRY_SIZE + cmd_queue_index_r / COMMAND_ENTRY_SIZE;
+    else
+      free = (cmd_queue_index_r - cmd_queue_index_w) / COMMAND_ENTRY_SIZE;
+    return min(free, (uint16_t)(255 - commands_in_queue));
+  }
+
+#endif
+
+/**
+ * Once a new command is in the slot given by command_slot(),
+ * call this to commit it
  */
 inline void _commit_command(bool say_ok) {
-  send_ok[cmd_queue_index_w] = say_ok;
-  if (++cmd_queue_index_w >= BUFSIZE) cmd_queue_index_w = 0;
+  const uint16_t i = command_slot_index();
+  char * const entry = command_queue + i;
+  const char * const cmd = entry + COMMAND_HEADER_SIZE;
+  uint8_t size = COMMAND_HEADER_SIZE;
+  #if HAS_PACKED_COMMANDS
+    if (*cmd == PACKED_COMMAND_MARK)
+      size += parser.packed_size(cmd);
+    else
+  #endif
+      size += strlen(cmd) + 1;
+
+  // Send the reader back to the start
+  if (i < cmd_queue_index_w && cmd_queue_index_w < COMMAND_QUEUE_SIZE) command_queue[cmd_queue_index_w] = 0;
+
+  entry[0] = size;
+  entry[1] = say_ok;
+  cmd_queue_index_w = i + size;
   commands_in_queue++;
 }
 
+/**
+ * Drop the command just processed
+ */
+inline void _dequeue_command() {
+  if (!commands_in_queue) return;
+  if (--commands_in_queue) {
+    cmd_queue_index_r += (uint8_t)command_queue[cmd_queue_index_r];
+    if (cmd_queue_index_r >= COMMAND_QUEUE_SIZE || !command_queue[cmd_queue_index_r]) cmd_queue_index_r = 0;
+  }
+  else
+    clear_command_queue();
+}
+
+/**
+ * Copy a line of text into the next command queue slot,
+ * parsed if PREPARSED_COMMAND_QUEUE is enabled
+ */
+inline void _copy_command(const char* cmd) {
+  char * const slot = command_slot();
+  #if ENABLED(PREPARSED_COMMAND_QUEUE)
+    if (parser.pack(cmd, slot)) return;
+  #endif
+  strncpy(slot, cmd, MAX_CMD_SIZE - 1);
+  slot[MAX_CMD_SIZE - 1] = '\0';
+}
+
 /**
  * Copy a command from RAM into the main command buffer.
  * Return true if the command was successfully added.
  * Return false for a full buffer, or if the 'command' is a comment.
  */
 inline bool _enqueuecommand(const char* cmd, bool say_ok = false) {
-  if (*cmd == ';' || commands_in_queue >= BUFSIZE) return false;
-  strcpy(command_queue[cmd_queue_index_w], cmd);
+  if (*cmd == ';' || !command_queue_has_room()) return false;
+  _copy_command(cmd);
   _commit_command(say_ok);
   return true;
 }
@@ -649,6 +742,65 @@ void gcode_line_error(const char* err, bool doFlush = true) {
   serial_count = 0;
 }
 
+#if ENABLED(BINARY_PROTOCOL)
+
+  /**
+   * Check a binary frame and decode it into the command queue.
+   * Return false on a transmission error.
+   */
+  inline bool get_binary_command(const uint8_t * const frame) {
+    const uint8_t length = frame[1];
+    const uint16_t crc = frame[length + 2] | (frame[length + 3] << 8);
+
+    if (parser.crc16(frame + 1, length + 1) != crc) {
+      gcode_line_error(PSTR(MSG_ERR_CHECKSUM_MISMATCH));
+      return false;
+    }
+
+    const char letter = frame[6];
+    const uint16_t codenum = frame[7] | (frame[8] << 8);
+    const bool M110 = letter == 'M' && codenum == 110;
+
+    gcode_N = frame[2] | ((long)frame[3] << 8) | ((long)frame[4] << 16) | ((long)frame[5] << 24);
+    if (gcode_N != gcode_LastN + 1 && !M110) {
+      gcode_line_error(PSTR(MSG_ERR_LINE_NO));
+      return false;
+    }
+
+    if (!parser.decode_binary(frame + 1, command_slot())) {
+      gcode_line_error(PSTR(MSG_ERR_BINARY_FRAME));
+      return false;
+    }
+
+    gcode_LastN = gcode_N;
+
+    // Movement commands alert when stopped
+    if (IsStopped() && letter == 'G' && codenum <= 3) {
+      SERIAL_LM(ER, MSG_ERR_STOPPED);
+      LCD_MESSAGEPGM(MSG_STOPPED);
+    }
+
+    #if DISABLED(EMERGENCY_PARSER)
+      // If command was e-stop process now
+      if (letter == 'M') switch (codenum) {
+        case 108:
+          wait_for_heatup = false;
+          #if ENABLED(ULTIPANEL)
+            wait_for_user = false;
+          #endif
+          break;
+        case 112: kill(PSTR(MSG_KILLED)); break;
+        case 410: quickstop_stepper(); break;
+      }
+    #endif
+
+    // Add the command to the queue
+    _commit_command(true);
+    return true;
+  }
+
+#endif // BINARY_PROTOCOL
+
 /**
  * Get all commands waiting on the serial port and queue them.
  * Exit when the buffer is full or when no more characters are
@@ -679,10 +831,34 @@ inline void get_serial_commands() {
   /**
    * Loop while serial characters are incoming and the queue is not full
    */
-  while (commands_in_queue < BUFSIZE && HAL::serialByteAvailable() > 0) {
+  while (command_queue_has_room() && HAL::serialByteAvailable() > 0) {
 
     char serial_char = HAL::serialReadByte();
 
+    #if ENABLED(BINARY_PROTOCOL)
+      /**
+       * A binary frame starts a line with BINARY_FRAME_START
+       * and is collected up to its CRC
+       */
+      if (serial_count ? (uint8_t)serial_line_buffer[0] == BINARY_FRAME_START
+                       : !serial_comment_mode && (uint8_t)serial_char == BINARY_FRAME_START) {
+        serial_line_buffer[serial_count++] = serial_char;
+        if (serial_count < 2) continue;
+        const uint8_t length = serial_line_buffer[1];
+        if (length < BINARY_FRAME_HEADER || length + BINARY_FRAME_EXTRA > MAX_CMD_SIZE) {
+          gcode_line_error(PSTR(MSG_ERR_CHECKSUM_MISMATCH));
+          return;
+        }
+        if (serial_count < length + BINARY_FRAME_EXTRA) continue;
+        serial_count = 0;
+        if (!get_binary_command((uint8_t*)serial_line_buffer)) return;
+        #if ENABLED(NO_TIMEOUTS) && NO_TIMEOUTS > 0
+          last_command_time = ms;
+        #endif
+        continue;
+      }
+    #endif
+
     /**
      * If the character ends the line
      */
@@ -826,8 +1002,7 @@ inline void get_serial_commands() {
    * can also interrupt buffering.
    */
   inline void get_sdcard_commands() {
-    static bool stop_buffering = false,
-                sd_comment_mode = false;
+    static bool stop_buffering = false;
 
     if (!card.sdprinting) return;
 
@@ -854,54 +1029,48 @@ inline void get_serial_commands() {
 
     if (commands_in_queue == 0) stop_buffering = false;
 
-    uint16_t sd_count = 0;
-    bool card_eof = card.eof();
-    while (commands_in_queue < BUFSIZE && !card_eof && !stop_buffering) {
-      const int16_t n = card.get();
-      char sd_char = (char)n;
-      card_eof = card.eof();
-      if (card_eof || n == -1
-          || sd_char == '\n' || sd_char == '\r'
-          || ((sd_char == '#' || sd_char == ':') && !sd_comment_mode)
-      ) {
-        if (card_eof) {
-          SERIAL_EM(MSG_FILE_PRINTED);
-          card.printingHasFinished();
-          #if ENABLED(PRINTER_EVENT_LEDS)
-            LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
-            set_led_color(0, 255, 0); // Green
-            #if HAS(RESUME_CONTINUE)
-              enqueue_and_echo_commands_P(PSTR("M0")); // end of the queue!
-            #else
-              safe_delay(1000);
-            #endif
-            set_led_color(0, 0, 0);   // OFF
-          #endif
-          card.checkautostart(true);
-        }
-        else if (n == -1) {
-          SERIAL_LM(ER, MSG_SD_ERR_READ);
-        }
-        if (sd_char == '#') stop_buffering = true;
+    #if ENABLED(PREPARSED_COMMAND_QUEUE)
+      static char sd_line_buffer[MAX_CMD_SIZE];
+    #endif
 
-        sd_comment_mode = false; // for new command
+    while (command_queue_has_room() && !card.eof() && !stop_buffering) {
+      int16_t term;
+      #if ENABLED(PREPARSED_COMMAND_QUEUE)
+        const uint16_t sd_count = card.get_line(sd_line_buffer, MAX_CMD_SIZE, term);
+      #else
+        const uint16_t sd_count = card.get_line(command_slot(), MAX_CMD_SIZE, term);
+      #endif
 
-        if (!sd_count) continue; // skip empty lines (and comment lines)
+      if (term < 0) {
+        SERIAL_LM(ER, MSG_SD_ERR_READ);
+        break;
+      }
 
-        command_queue[cmd_queue_index_w][sd_count] = '\0'; // terminate string
-        sd_count = 0; // clear sd line buffer
+      if (term == '#') stop_buffering = true;
 
+      // Skip empty lines (and comment lines)
+      if (sd_count) {
+        #if ENABLED(PREPARSED_COMMAND_QUEUE)
+          _copy_command(sd_line_buffer);
+        #endif
         _commit_command(false);
       }
-      else if (sd_count >= MAX_CMD_SIZE - 1) {
-        /**
-         * Keep fetching, but ignore normal characters beyond the max length
-         * The command will be injected when EOL is reached
-         */
-      }
-      else {
-        if (sd_char == ';') sd_comment_mode = true;
-        if (!sd_comment_mode) command_queue[cmd_queue_index_w][sd_count++] = sd_char;
+
+      // The last line is queued before the commands of the end of the print
+      if (card.eof()) {
+        SERIAL_EM(MSG_FILE_PRINTED);
+        card.printingHasFinished();
+        #if ENABLED(PRINTER_EVENT_LEDS)
+          LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
+          set_led_color(0, 255, 0); // Green
+          #if HAS(RESUME_CONTINUE)
+            enqueue_and_echo_commands_P(PSTR("M0")); // end of the queue!
+          #else
+            safe_delay(1000);
+          #endif
+          set_led_color(0, 0, 0);   // OFF
+        #endif
+        card.checkautostart(true);
       }
     }
   }
@@ -1979,7 +2148,7 @@ void gcode_get_destination() {
 
     // Store in old temperature the target temperature for hotend and bed
     int16_t old_target_temperature[HOTENDS];
-    HOTEND_LOOP() old_target_temperature[h] = thermalManager.target_temperature[h]; // Save nozzle temps
+    HOTEND_LOOP() old_target_temperature[h] = thermalManager.heaters[h].target_temperature; // Save nozzle temps
 
     // Second retract filament with Cool Down
     if (retract2) {
@@ -5388,6 +5557,10 @@ inline void gcode_M17() {
   inline void gcode_M26() {
     if (card.cardOK && parser.seen('S'))
       card.setIndex(parser.value_long());
+    #if ENABLED(SD_LAYER_INDEX)
+      else if (card.cardOK && parser.seen('L') && !card.layer_seek(parser.value_ushort()))
+        SERIAL_LM(ER, MSG_SD_NO_LAYER);
+    #endif
   }
 
   /**
@@ -6232,6 +6405,9 @@ inline void gcode_M92() {
     }
   }
   Mechanics.refresh_positioning();
+  #if ENABLED(PIDTEMP) && ENABLED(PID_ADD_EXTRUSION_RATE)
+    thermalManager.updatePID(); // Kc is taken per step of the extruder
+  #endif
 }
 
 #if ENABLED(ZWOBBLE)
@@ -6639,6 +6815,29 @@ inline void gcode_M122() {
   SERIAL_EOL();
 }
 
+#if ENABLED(PLANNER_BENCHMARK)
+
+  /**
+   * M124: Planner benchmark
+   *
+   *  M124    - Report blocks/s, average and worst-case planner time and starvations
+   *  M124 R  - Report and reset the counters
+   */
+  inline void gcode_M124() {
+    planner.bench_report();
+    #if IS_DELTA
+      Mechanics.bench_report();
+    #endif
+    if (parser.seen('R')) {
+      planner.bench_reset();
+      #if IS_DELTA
+        Mechanics.bench_reset();
+      #endif
+    }
+  }
+
+#endif // PLANNER_BENCHMARK
+
 #if ENABLED(PARK_HEAD_ON_PAUSE)
 
   /**
@@ -6734,6 +6933,26 @@ inline void gcode_M122() {
   #endif
 #endif // BARICUDA
 
+#if ENABLED(ISR_STATISTICS)
+
+  /**
+   * M130: ISR statistics
+   *
+   *  M130    - Report min/avg/max cycles of the ISRs, the step lateness and the ISR load
+   *  M130 R  - Report and reset the counters
+   *  M130 D  - Dump the last ISR_STATISTICS_BUFFER stepper interrupts
+   */
+  inline void gcode_M130() {
+    if (parser.seen('D')) {
+      isrStats.dump();
+      return;
+    }
+    isrStats.report();
+    if (parser.seen('R')) isrStats.reset();
+  }
+
+#endif // ISR_STATISTICS
+
 #if HAS_TEMP_BED
   /**
    * M140: Set Bed temperature
@@ -7088,6 +7307,7 @@ inline void gcode_M204() {
  *    Y = Max Y Jerk (units/sec^2)
  *    Z = Max Z Jerk (units/sec^2)
  *    E = Max E Jerk (units/sec^2)
+ *    J = Junction Deviation (units), 0 use the jerk (Requires JUNCTION_DEVIATION)
  */
 inline void gcode_M205() {
 
@@ -7100,6 +7320,15 @@ inline void gcode_M205() {
   if (parser.seen('Y')) Mechanics.max_jerk[Y_AXIS] = parser.value_linear_units();
   if (parser.seen('Z')) Mechanics.max_jerk[Z_AXIS] = parser.value_linear_units();
   if (parser.seen('E')) Mechanics.max_jerk[E_AXIS + TARGET_EXTRUDER] = parser.value_linear_units();
+  #if ENABLED(JUNCTION_DEVIATION)
+    if (parser.seen('J')) {
+      const float junc_dev = parser.value_linear_units();
+      if (WITHIN(junc_dev, 0, 0.5))
+        Mechanics.junction_deviation_mm = junc_dev;
+      else
+        SERIAL_LM(ER, "?J out of range (0 to 0.5)");
+    }
+  #endif
 }
 
 #if ENABLED(WORKSPACE_OFFSETS)
@@ -7449,12 +7678,14 @@ inline void gcode_M226() {
    *       H<hotend> (-1 for the bed, -2 for chamber, -3 for cooler) (default 0)
    *       C<cycles>
    *       U<bool> with a non-zero value will apply the result to current settings
+   *       M<bool> with a non-zero value will find the thermal model of the hotend too (Requires PID_FEEDFORWARD)
    */
   inline void gcode_M303() {
     #if HAS(PID_HEATING) || HAS(PID_COOLING)
       const int   h = parser.seen('H') ? parser.value_int() : 0,
                   c = parser.seen('C') ? parser.value_int() : 5;
-      const bool  u = parser.seen('U') && parser.value_bool() != 0;
+      const bool  u = parser.seen('U') && parser.value_bool() != 0,
+                  m = parser.seen('M') && parser.value_bool() != 0;
 
       int16_t temp = parser.seen('S') ? parser.value_celsius() : (h < 0 ? 70 : 200);
 
@@ -7462,7 +7693,7 @@ inline void gcode_M226() {
 
       KEEPALIVE_STATE(NOT_BUSY); // don't send "busy: processing" messages during autotune output
 
-      thermalManager.PID_autotune(temp, h, c, u);
+      thermalManager.PID_autotune(temp, h, c, u, m);
 
       KEEPALIVE_STATE(IN_HANDLER);
     #else
@@ -7476,14 +7707,14 @@ inline void gcode_M226() {
 
   // M304: Set bed PID parameters P I and D
   inline void gcode_M304() {
-    if (parser.seen('P')) thermalManager.bedKp = parser.value_float();
-    if (parser.seen('I')) thermalManager.bedKi = parser.value_float();
-    if (parser.seen('D')) thermalManager.bedKd = parser.value_float();
+    if (parser.seen('P')) PID_PARAM(Kp, BED_INDEX) = parser.value_float();
+    if (parser.seen('I')) PID_PARAM(Ki, BED_INDEX) = parser.value_float();
+    if (parser.seen('D')) PID_PARAM(Kd, BED_INDEX) = parser.value_float();
 
     thermalManager.updatePID();
-    SERIAL_SMV(ECHO, " p:", thermalManager.bedKp);
-    SERIAL_MV(" i:", thermalManager.bedKi);
-    SERIAL_EMV(" d:", thermalManager.bedKd);
+    SERIAL_SMV(ECHO, " p:", PID_PARAM(Kp, BED_INDEX));
+    SERIAL_MV(" i:", PID_PARAM(Ki, BED_INDEX));
+    SERIAL_EMV(" d:", PID_PARAM(Kd, BED_INDEX));
   }
 
 #endif // PIDTEMPBED
@@ -7492,14 +7723,14 @@ inline void gcode_M226() {
 
   // M305: Set chamber PID parameters P I and D
   inline void gcode_M305() {
-    if (parser.seen('P')) thermalManager.chamberKp = parser.value_float();
-    if (parser.seen('I')) thermalManager.chamberKi = parser.value_float();
-    if (parser.seen('D')) thermalManager.chamberKd = parser.value_float();
+    if (parser.seen('P')) PID_PARAM(Kp, CHAMBER_INDEX) = parser.value_float();
+    if (parser.seen('I')) PID_PARAM(Ki, CHAMBER_INDEX) = parser.value_float();
+    if (parser.seen('D')) PID_PARAM(Kd, CHAMBER_INDEX) = parser.value_float();
 
     thermalManager.updatePID();
-    SERIAL_SMV(OK, " p:", thermalManager.chamberKp);
-    SERIAL_MV(" i:", thermalManager.chamberKi);
-    SERIAL_EMV(" d:", thermalManager.chamberKd);
+    SERIAL_SMV(OK, " p:", PID_PARAM(Kp, CHAMBER_INDEX));
+    SERIAL_MV(" i:", PID_PARAM(Ki, CHAMBER_INDEX));
+    SERIAL_EMV(" d:", PID_PARAM(Kd, CHAMBER_INDEX));
   }
 
 #endif // PIDTEMPCHAMBER
@@ -7508,18 +7739,57 @@ inline void gcode_M226() {
 
   // M306: Set cooler PID parameters P I and D
   inline void gcode_M306() {
-    if (parser.seen('P')) thermalManager.coolerKp = parser.value_float();
-    if (parser.seen('I')) thermalManager.coolerKi = parser.value_float();
-    if (parser.seen('D')) thermalManager.coolerKd = parser.value_float();
+    if (parser.seen('P')) PID_PARAM(Kp, COOLER_INDEX) = parser.value_float();
+    if (parser.seen('I')) PID_PARAM(Ki, COOLER_INDEX) = parser.value_float();
+    if (parser.seen('D')) PID_PARAM(Kd, COOLER_INDEX) = parser.value_float();
 
     thermalManager.updatePID();
-    SERIAL_SMV(OK, " p:", thermalManager.coolerKp);
-    SERIAL_MV(" i:", thermalManager.coolerKi);
-    SERIAL_EMV(" d:", thermalManager.coolerKd);
+    SERIAL_SMV(OK, " p:", PID_PARAM(Kp, COOLER_INDEX));
+    SERIAL_MV(" i:", PID_PARAM(Ki, COOLER_INDEX));
+    SERIAL_EMV(" d:", PID_PARAM(Kd, COOLER_INDEX));
   }
 
 #endif // PIDTEMPCOOLER
 
+#if ENABLED(PID_FEEDFORWARD)
+
+  /**
+   * M307: Set the thermal model of a hotend for the feed-forward
+   *
+   *   H[int]   hotend (default 0)
+   *   P[float] heater power at full power (W)
+   *   C[float] heat capacity (J/K)
+   *   A[float] heat loss to the ambient (W/K)
+   *   F[float] more heat loss with the part cooling fan at full speed (W/K)
+   *   E[float] heat taken by the filament (J/K per mm)
+   *   R[float] ambient temperature (C)
+   */
+  inline void gcode_M307() {
+    const int h = parser.seen('H') ? parser.value_int() : 0;
+
+    if (WITHIN(h, 0, HOTENDS - 1)) {
+      if (parser.seen('P')) PID_PARAM(heater_power, h) = parser.value_float();
+      if (parser.seen('C')) PID_PARAM(heat_capacity, h) = parser.value_float();
+      if (parser.seen('A')) PID_PARAM(ambient_loss, h) = parser.value_float();
+      if (parser.seen('F')) PID_PARAM(fan_loss, h) = parser.value_float();
+      if (parser.seen('E')) PID_PARAM(filament_heat, h) = parser.value_float();
+      if (parser.seen('R')) PID_PARAM(ambient_temp, h) = parser.value_float();
+
+      SERIAL_SMV(ECHO, "H", h);
+      SERIAL_MV(" P:", PID_PARAM(heater_power, h));
+      SERIAL_MV(" C:", PID_PARAM(heat_capacity, h));
+      SERIAL_MV(" A:", PID_PARAM(ambient_loss, h), 4);
+      SERIAL_MV(" F:", PID_PARAM(fan_loss, h), 4);
+      SERIAL_MV(" E:", PID_PARAM(filament_heat, h), 5);
+      SERIAL_EMV(" R:", PID_PARAM(ambient_temp, h));
+    }
+    else {
+      SERIAL_LM(ER, MSG_INVALID_EXTRUDER);
+    }
+  }
+
+#endif // PID_FEEDFORWARD
+
 #if HAS_ABL
 
   /**
@@ -8828,6 +9098,7 @@ inline void gcode_M532() {
    *    D = Diagonal Rod
    *    R = Delta Radius
    *    S = Segments per Second
+   *    E = Chord error of the segments (Requires DELTA_CHORD_SEGMENTATION)
    *    A = Alpha (Tower 1) Diagonal Rod Adjust
    *    B = Beta  (Tower 2) Diagonal Rod Adjust
    *    C = Gamma (Tower 3) Diagonal Rod Adjust
@@ -8855,6 +9126,9 @@ inline void gcode_M532() {
     if (parser.seen('D')) Mechanics.delta_diagonal_rod              = parser.value_linear_units();
     if (parser.seen('R')) Mechanics.delta_radius              = parser.value_linear_units();
     if (parser.seen('S')) Mechanics.delta_segments_per_second       = parser.value_float();
+    #if ENABLED(DELTA_CHORD_SEGMENTATION)
+      if (parser.seen('E')) Mechanics.delta_chord_error             = parser.value_linear_units();
+    #endif
     if (parser.seen('A')) Mechanics.delta_diagonal_rod_adj[A_AXIS]  = parser.value_linear_units();
     if (parser.seen('B')) Mechanics.delta_diagonal_rod_adj[B_AXIS]  = parser.value_linear_units();
     if (parser.seen('C')) Mechanics.delta_diagonal_rod_adj[C_AXIS]  = parser.value_linear_units();
@@ -8932,6 +9206,9 @@ inline void gcode_M532() {
       SERIAL_LMV(CFG, "R (Delta Radius): ",                     Mechanics.delta_radius, 4);
       SERIAL_LMV(CFG, "D (Diagonal Rod Length): ",              Mechanics.delta_diagonal_rod, 4);
       SERIAL_LMV(CFG, "S (Delta Segments per second): ",        Mechanics.delta_segments_per_second);
+      #if ENABLED(DELTA_CHORD_SEGMENTATION)
+        SERIAL_LMV(CFG, "E (Delta Chord error): ",              Mechanics.delta_chord_error, 4);
+      #endif
       SERIAL_LMV(CFG, "O (Delta Print Radius): ",               Mechanics.delta_print_radius);
       SERIAL_LMV(CFG, "H (Z-Height): ",                         Mechanics.delta_height, 3);
     }
@@ -9967,15 +10244,46 @@ inline void invalid_extruder_error(const uint8_t e) {
 
 #endif
 
+#if HAS_PACKED_COMMANDS
+
+  /**
+   * Echo a command of the queue, rebuilding the text of a packed command.
+   * Out of process_next_command(), to keep the buffer off the handlers stack.
+   */
+  void echo_packed_command(const char* cmd) {
+    if (*cmd == PACKED_COMMAND_MARK) {
+      char text[MAX_CMD_SIZE * 2];
+      parser.packed_to_text(cmd, text, sizeof(text));
+      SERIAL_LV(ECHO, text);
+    }
+    else
+      SERIAL_LV(ECHO, cmd);
+  }
+
+  #if HAS_SDSUPPORT
+    // Write a packed command to the file being saved, as text without the line number
+    void save_packed_command(const char* cmd) {
+      char text[MAX_CMD_SIZE * 2];
+      parser.packed_to_text(cmd, text, sizeof(text), false);
+      card.write_command(text);
+    }
+  #endif
+
+#endif // HAS_PACKED_COMMANDS
+
 /**
  * Process a single command and dispatch it to its handler
  * This is called from the main loop()
  */
 void process_next_command() {
-  char * const current_command = command_queue[cmd_queue_index_r];
+  char * const current_command = current_command_ptr();
 
   if (DEBUGGING(ECHO)) {
-    SERIAL_LV(ECHO, current_command);
+    #if HAS_PACKED_COMMANDS
+      echo_packed_command(current_command);
+    #else
+      SERIAL_LV(ECHO, current_command);
+    #endif
     #if ENABLED(M100_FREE_MEMORY_WATCHER)
       SERIAL_SMV(ECHO, "slot:", cmd_queue_index_r);
       #if ENABLED(M100_FREE_MEMORY_DUMPER)
@@ -9987,7 +10295,12 @@ void process_next_command() {
   KEEPALIVE_STATE(IN_HANDLER);
 
   // Parse the next command in the queue
-  parser.parse(current_command);
+  #if HAS_PACKED_COMMANDS
+    if (*current_command == PACKED_COMMAND_MARK)
+      parser.unpack(current_command);
+    else
+  #endif
+      parser.parse(current_command);
 
   // Handle a known G, M, or T
   switch(parser.command_letter) {
@@ -10320,6 +10633,11 @@ void process_next_command() {
           gcode_M123(); break;
       #endif
 
+      #if ENABLED(PLANNER_BENCHMARK)
+        case 124: // M124: Planner benchmark
+          gcode_M124(); break;
+      #endif
+
       #if ENABLED(PARK_HEAD_ON_PAUSE)
         case 125: // M125: Store current position and move to pause park position
           gcode_M125(); break;
@@ -10343,6 +10661,11 @@ void process_next_command() {
         #endif // HAS_HEATER_2
       #endif // BARICUDA
 
+      #if ENABLED(ISR_STATISTICS)
+        case 130: // M130: ISR statistics
+          gcode_M130(); break;
+      #endif
+
       #if HAS_TEMP_BED
         case 140: // M140 - Set bed temp
           gcode_M140(); break;
@@ -10495,6 +10818,11 @@ void process_next_command() {
           gcode_M306(); break;
       #endif
 
+      #if ENABLED(PID_FEEDFORWARD)
+        case 307: // M307: Set the thermal model of a hotend
+          gcode_M307(); break;
+      #endif
+
       #if HAS_ABL
         case 320: // M320: Activate ABL
           gcode_M320(); break;
@@ -10740,14 +11068,19 @@ void FlushSerialRequestResend() {
  * If ADVANCED_OK is enabled also include:
  *   N<int>  Line number of the command, if any
  *   P<int>  Planner space remaining
- *   B<int>  Block queue space remaining
+ *   B<int>  Commands of MAX_CMD_SIZE that still fit in the command queue
  */
 void ok_to_send() {
   refresh_cmd_timeout();
-  if (!send_ok[cmd_queue_index_r]) return;
+  if (commands_in_queue && !command_queue[cmd_queue_index_r + 1]) return;
   SERIAL_STR(OK);
   #if ENABLED(ADVANCED_OK)
-    char* p = command_queue[cmd_queue_index_r];
+    char* p = current_command_ptr();
+    #if HAS_PACKED_COMMANDS
+      long line;
+      if (*p == PACKED_COMMAND_MARK && parser.packed_line(p, line))
+        SERIAL_MV(" N", line);
+    #endif
     if (*p == 'N') {
       SERIAL_CHR(' ');
       SERIAL_CHR(*p++);
@@ -10755,7 +11088,7 @@ void ok_to_send() {
         SERIAL_CHR(*p++);
     }
     SERIAL_MV(" P", (int)(BLOCK_BUFFER_SIZE - planner.movesplanned() - 1));
-    SERIAL_MV(" B", BUFSIZE - commands_in_queue);
+    SERIAL_MV(" B", (int)command_queue_free());
   #endif
   SERIAL_EOL();
 }
@@ -11473,7 +11806,7 @@ void report_current_position_detail() {
     millis_t ms = millis();
     if (ELAPSED(ms, nextMotorCheck)) {
       nextMotorCheck = ms + 2500UL; // Not a time critical function, so only check every 2.5s
-      if (X_ENABLE_READ == X_ENABLE_ON || Y_ENABLE_READ == Y_ENABLE_ON || Z_ENABLE_READ == Z_ENABLE_ON || thermalManager.soft_pwm_bed > 0
+      if (X_ENABLE_READ == X_ENABLE_ON || Y_ENABLE_READ == Y_ENABLE_ON || Z_ENABLE_READ == Z_ENABLE_ON || thermalManager.heaters[BED_INDEX].soft_pwm > 0
         || E0_ENABLE_READ == E_ENABLE_ON // If any of the drivers are enabled...
         #if EXTRUDERS > 1
           || E1_ENABLE_READ == E_ENABLE_ON
@@ -11771,7 +12104,7 @@ void manage_inactivity(bool ignore_stepper_queue/*=false*/) {
       handle_filament_runout();
   #endif
 
-  if (commands_in_queue < BUFSIZE) get_available_commands();
+  if (command_queue_has_room()) get_available_commands();
 
   const millis_t ms = millis();
 
@@ -12031,6 +12364,10 @@ void idle(
     auto_report_temperatures();
   #endif
 
+  #if ENABLED(SERIAL_TX_BUFFER)
+    HAL::serialTxPump();
+  #endif
+
   #if ENABLED(FLOWMETER_SENSOR)
     flowrate_manage();
   #endif
@@ -12047,6 +12384,16 @@ void idle(
 
   print_job_counter.tick();
 
+  #if ENABLED(SD_READ_AHEAD)
+    // Read the file printed ahead while the moves wait for the planner
+    if (planner.is_full()) card.read_ahead();
+  #endif
+
+  #if ENABLED(SD_LAYER_INDEX)
+    // Build the layer index of the file selected and follow the print on it
+    card.layer_idle();
+  #endif
+
   if (HAL::execute_100ms) {
     // Event 100 Ms
     HAL::execute_100ms = false;
@@ -12073,7 +12420,7 @@ void kill(const char* lcd_msg) {
   thermalManager.disable_all_coolers();
   stepper.disable_all_steppers();
 
-  #if ENABLED(KILL_METHOD) && (KILL_METHOD == 1)
+  #if (ENABLED(KILL_METHOD) && (KILL_METHOD == 1)) || ENABLED(ARDUINO_ARCH_LINUX)
     HAL::resetHardware();
   #endif
   #if ENABLED(FLOWMETER_SENSOR) && ENABLED(MINFLOW_PROTECTION)
@@ -12208,10 +12555,7 @@ void setup() {
   #endif // STRING_DISTRIBUTION_DATE
 
   SERIAL_SMV(ECHO, MSG_FREE_MEMORY, HAL::getFreeRam());
-  SERIAL_EMV(MSG_PLANNER_BUFFER_BYTES, (int)sizeof(block_t)*BLOCK_BUFFER_SIZE);
-
-  // Send "ok" after commands by default
-  for (int8_t i = 0; i < BUFSIZE; i++) send_ok[i] = true;
+  SERIAL_EMV(MSG_PLANNER_BUFFER_BYTES, (int)(sizeof(block_t) + sizeof(block_plan_t)) * (BLOCK_BUFFER_SIZE));
 
   #if MECH(MUVE3D) && ENABLED(PROJECTOR_PORT) && ENABLED(PROJECTOR_BAUDRATE)
     DLPSerial.begin(PROJECTOR_BAUDRATE);
@@ -12240,6 +12584,10 @@ void setup() {
   // Vital to init stepper/planner equivalent for current_position
   Mechanics.sync_plan_position();
 
+  #if ENABLED(ISR_STATISTICS)
+    isrStats.reset();
+  #endif
+
   thermalManager.init();    // Initialize temperature loop
 
   #if ENABLED(CNCROUTER)
@@ -12377,7 +12725,7 @@ void setup() {
  */
 void loop() {
 
-  if (commands_in_queue < BUFSIZE) get_available_commands();
+  if (command_queue_has_room()) get_available_commands();
 
   #if HAS_EEPROM_SD
     static uint8_t wait_for_host_init_string_to_finish = 1;
@@ -12401,12 +12749,18 @@ void loop() {
     #if HAS_SDSUPPORT
 
       if (card.saving) {
-        char* command = command_queue[cmd_queue_index_r];
+        char* command = current_command_ptr();
         if (strstr_P(command, PSTR("M29"))) {
           // M29 closes the file
           card.finishWrite();
           ok_to_send();
         }
+        #if HAS_PACKED_COMMANDS
+          else if (*command == PACKED_COMMAND_MARK) {
+            save_packed_command(command);
+            ok_to_send();
+          }
+        #endif
         else {
           // Write the string from the read buffer to SD
           card.write_command(command);
@@ -12423,10 +12777,7 @@ void loop() {
     #endif // SDSUPPORT
 
     // The queue may be reset by a command handler or by code invoked by idle() within a handler
-    if (commands_in_queue) {
-      --commands_in_queue;
-      if (++cmd_queue_index_r >= BUFSIZE) cmd_queue_index_r = 0;
-    }
+    _dequeue_command();
   }
   endstops.report_state();
   idle();
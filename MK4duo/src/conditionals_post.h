@@ -39,9 +39,9 @@
   #endif
 
   /**
-   * SAM3X8E
+   * SAM3X8E and host-native Linux
    */
-  #if ENABLED(ARDUINO_ARCH_SAM)
+  #if ENABLED(ARDUINO_ARCH_SAM) || ENABLED(ARDUINO_ARCH_LINUX)
     #if ENABLED(M100_FREE_MEMORY_WATCHER)
       #undef M100_FREE_MEMORY_WATCHER
     #endif
@@ -269,7 +269,9 @@
   #define WATCH_HOTENDS     (ENABLED(THERMAL_PROTECTION_HOTENDS) && WATCH_TEMP_PERIOD > 0)
   #define WATCH_THE_BED     (HAS_THERMALLY_PROTECTED_BED && WATCH_BED_TEMP_PERIOD > 0)
   #define WATCH_THE_CHAMBER (HAS_THERMALLY_PROTECTED_CHAMBER && WATCH_CHAMBER_TEMP_PERIOD > 0)
-  #define WATCH_THE_COOLER  (HAS_THERMALLY_PROTECTED_COOLER && WATCH_COOLER_TEMP_PERIOD > 0)
+  #define WATCH_THE_COOLER  (HAS_THERMALLY_PROTECTED_COOLER && WATCH_TEMP_COOLER_PERIOD > 0)
+  #define HAS_THERMAL_PROTECTION  (ENABLED(THERMAL_PROTECTION_HOTENDS) || HAS_THERMALLY_PROTECTED_BED || HAS_THERMALLY_PROTECTED_CHAMBER || HAS_THERMALLY_PROTECTED_COOLER)
+  #define WATCH_THE_HEATERS (WATCH_HOTENDS || WATCH_THE_BED || WATCH_THE_CHAMBER || WATCH_THE_COOLER)
 
   // Auto fans
   #define HAS_AUTO_FAN_0    (ENABLED(HOTEND_AUTO_FAN) && HOTENDS > 0 && PIN_EXISTS(H0_AUTO_FAN))
@@ -575,7 +577,7 @@
   /**
    * DOUBLE_STEP_FREQUENCY for Arduino DUE or Mega
    */
-  #if ENABLED(ARDUINO_ARCH_SAM)
+  #if ENABLED(ARDUINO_ARCH_SAM) || ENABLED(ARDUINO_ARCH_LINUX)
     #if ENABLED(ADVANCE) || ENABLED(LIN_ADVANCE)
       #define DOUBLE_STEP_FREQUENCY 60000 // 60KHz
     #else
@@ -594,6 +596,18 @@
     #define MAX_STEP_FREQUENCY (DOUBLE_STEP_FREQUENCY * 4L) // Max step frequency for the Due is approx. 330kHz
   #endif
 
+  /**
+   * Step batching for the 32 bit processors
+   */
+  #if ENABLED(ARDUINO_ARCH_SAM) || ENABLED(ARDUINO_ARCH_LINUX)
+    #if DISABLED(MAX_STEP_LOOPS)
+      #define MAX_STEP_LOOPS 8
+    #endif
+    #if DISABLED(STEPPER_ISR_MAX_LOAD)
+      #define STEPPER_ISR_MAX_LOAD 50
+    #endif
+  #endif
+
   // MS1 MS2 Stepper Driver Microstepping mode table
   #define MICROSTEP1 LOW,LOW
   #define MICROSTEP2 HIGH,LOW
@@ -966,6 +980,12 @@
   // Add commands that need sub-codes to this list
   #define USE_GCODE_SUBCODES ENABLED(G38_PROBE_TARGET)
 
+  // Bytes of the command queue
+  #define COMMAND_QUEUE_SIZE (BUFSIZE * (MAX_CMD_SIZE + 2))
+
+  // Commands kept parsed in the command queue
+  #define HAS_PACKED_COMMANDS (ENABLED(BINARY_PROTOCOL) || ENABLED(PREPARSED_COMMAND_QUEUE))
+
   // MESH_BED_LEVELING overrides PROBE_MANUALLY
   #if ENABLED(MESH_BED_LEVELING)
     #undef PROBE_MANUALLY
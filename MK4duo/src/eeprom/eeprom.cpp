@@ -38,7 +38,7 @@
 
 #include "../../base.h"
 
-#define EEPROM_VERSION "MKV34"
+#define EEPROM_VERSION "MKV37"
 
 /**
  * MKV431 EEPROM Layout:
@@ -59,6 +59,7 @@
  *  M205  Y               Mechanics.max_jerk[Y_AXIS]            (float)
  *  M205  Z               Mechanics.max_jerk[Z_AXIS]            (float)
  *  M205  E   E0 ...      Mechanics.max_jerk[E_AXIS * EXTRDURES](float x6)
+ *  M205  J               Mechanics.junction_deviation_mm       (float)
  *  M206  XYZ             Mechanics.home_offset                 (float x3)
  *  M218  T   XY          hotend_offset                         (float x6)
  *
@@ -93,6 +94,7 @@
  *  M666  R               Mechanics.delta_radius                (float)
  *  M666  D               Mechanics.delta_diagonal_rod          (float)
  *  M666  S               Mechanics.delta_segments_per_second   (float)
+ *  M666  E               Mechanics.delta_chord_error           (float)
  *  M666  H               Mechanics.delta_height                (float)
  *  M666  ABC             Mechanics.delta_tower_radius_adj      (float x3)
  *  M666  IJK             Mechanics.delta_tower_pos_adj         (float x3)
@@ -111,6 +113,13 @@
  *  M301  E3  PIDC        Kp[3], Ki[3], Kd[3], Kc[3]            (float x4)
  *  M301  L               lpq_len
  *
+ * PID_FEEDFORWARD:
+ *  M307  H0  PCAFER      heater_power[0], heat_capacity[0], ambient_loss[0],
+ *                        fan_loss[0], filament_heat[0], ambient_temp[0]    (float x6)
+ *  M307  H1  PCAFER      ...                                   (float x6)
+ *  M307  H2  PCAFER      ...                                   (float x6)
+ *  M307  H3  PCAFER      ...                                   (float x6)
+ *
  * PIDTEMPBED:
  *  M304      PID         bedKp, bedKi, bedKd                   (float x3)
  * PIDTEMPCHAMBER
@@ -329,6 +338,9 @@ void EEPROM::Postprocess() {
     EEPROM_WRITE(Mechanics.min_travel_feedrate_mm_s);
     EEPROM_WRITE(Mechanics.min_segment_time);
     EEPROM_WRITE(Mechanics.max_jerk);
+    #if ENABLED(JUNCTION_DEVIATION)
+      EEPROM_WRITE(Mechanics.junction_deviation_mm);
+    #endif
     #if ENABLED(WORKSPACE_OFFSETS)
       EEPROM_WRITE(Mechanics.home_offset);
     #endif
@@ -395,6 +407,9 @@ void EEPROM::Postprocess() {
       EEPROM_WRITE(Mechanics.delta_radius);
       EEPROM_WRITE(Mechanics.delta_diagonal_rod);
       EEPROM_WRITE(Mechanics.delta_segments_per_second);
+      #if ENABLED(DELTA_CHORD_SEGMENTATION)
+        EEPROM_WRITE(Mechanics.delta_chord_error);
+      #endif
       EEPROM_WRITE(Mechanics.delta_height);
       EEPROM_WRITE(Mechanics.delta_tower_radius_adj);
       EEPROM_WRITE(Mechanics.delta_tower_pos_adj);
@@ -436,23 +451,34 @@ void EEPROM::Postprocess() {
       const int lpq_len = 20;
     #endif
     EEPROM_WRITE(lpq_len);
+
+    #if ENABLED(PID_FEEDFORWARD)
+      for (uint8_t h = 0; h < HOTENDS; h++) {
+        EEPROM_WRITE(PID_PARAM(heater_power, h));
+        EEPROM_WRITE(PID_PARAM(heat_capacity, h));
+        EEPROM_WRITE(PID_PARAM(ambient_loss, h));
+        EEPROM_WRITE(PID_PARAM(fan_loss, h));
+        EEPROM_WRITE(PID_PARAM(filament_heat, h));
+        EEPROM_WRITE(PID_PARAM(ambient_temp, h));
+      }
+    #endif
     
     #if ENABLED(PIDTEMPBED)
-      EEPROM_WRITE(thermalManager.bedKp);
-      EEPROM_WRITE(thermalManager.bedKi);
-      EEPROM_WRITE(thermalManager.bedKd);
+      EEPROM_WRITE(PID_PARAM(Kp, BED_INDEX));
+      EEPROM_WRITE(PID_PARAM(Ki, BED_INDEX));
+      EEPROM_WRITE(PID_PARAM(Kd, BED_INDEX));
     #endif
 
     #if ENABLED(PIDTEMPCHAMBER)
-      EEPROM_WRITE(thermalManager.chamberKp);
-      EEPROM_WRITE(thermalManager.chamberKi);
-      EEPROM_WRITE(thermalManager.chamberKd);
+      EEPROM_WRITE(PID_PARAM(Kp, CHAMBER_INDEX));
+      EEPROM_WRITE(PID_PARAM(Ki, CHAMBER_INDEX));
+      EEPROM_WRITE(PID_PARAM(Kd, CHAMBER_INDEX));
     #endif
 
     #if ENABLED(PIDTEMPCOOLER)
-      EEPROM_WRITE(thermalManager.coolerKp);
-      EEPROM_WRITE(thermalManager.coolerKi);
-      EEPROM_WRITE(thermalManager.coolerKd);
+      EEPROM_WRITE(PID_PARAM(Kp, COOLER_INDEX));
+      EEPROM_WRITE(PID_PARAM(Ki, COOLER_INDEX));
+      EEPROM_WRITE(PID_PARAM(Kd, COOLER_INDEX));
     #endif
 
     #if !HAS_LCD_CONTRAST
@@ -660,6 +686,9 @@ void EEPROM::Postprocess() {
       EEPROM_READ(Mechanics.min_travel_feedrate_mm_s);
       EEPROM_READ(Mechanics.min_segment_time);
       EEPROM_READ(Mechanics.max_jerk);
+      #if ENABLED(JUNCTION_DEVIATION)
+        EEPROM_READ(Mechanics.junction_deviation_mm);
+      #endif
       #if ENABLED(WORKSPACE_OFFSETS)
         EEPROM_READ(Mechanics.home_offset);
       #endif
@@ -740,6 +769,9 @@ void EEPROM::Postprocess() {
         EEPROM_READ(Mechanics.delta_radius);
         EEPROM_READ(Mechanics.delta_diagonal_rod);
         EEPROM_READ(Mechanics.delta_segments_per_second);
+        #if ENABLED(DELTA_CHORD_SEGMENTATION)
+          EEPROM_READ(Mechanics.delta_chord_error);
+        #endif
         EEPROM_READ(Mechanics.delta_height);
         EEPROM_READ(Mechanics.delta_tower_radius_adj);
         EEPROM_READ(Mechanics.delta_tower_pos_adj);
@@ -780,22 +812,33 @@ void EEPROM::Postprocess() {
       #endif
       EEPROM_READ(lpq_len);
 
+      #if ENABLED(PID_FEEDFORWARD)
+        for (uint8_t h = 0; h < HOTENDS; h++) {
+          EEPROM_READ(PID_PARAM(heater_power, h));
+          EEPROM_READ(PID_PARAM(heat_capacity, h));
+          EEPROM_READ(PID_PARAM(ambient_loss, h));
+          EEPROM_READ(PID_PARAM(fan_loss, h));
+          EEPROM_READ(PID_PARAM(filament_heat, h));
+          EEPROM_READ(PID_PARAM(ambient_temp, h));
+        }
+      #endif
+
       #if ENABLED(PIDTEMPBED)
-        EEPROM_READ(thermalManager.bedKp);
-        EEPROM_READ(thermalManager.bedKi);
-        EEPROM_READ(thermalManager.bedKd);
+        EEPROM_READ(PID_PARAM(Kp, BED_INDEX));
+        EEPROM_READ(PID_PARAM(Ki, BED_INDEX));
+        EEPROM_READ(PID_PARAM(Kd, BED_INDEX));
       #endif
 
       #if ENABLED(PIDTEMPCHAMBER)
-        EEPROM_READ(thermalManager.chamberKp);
-        EEPROM_READ(thermalManager.chamberKi);
-        EEPROM_READ(thermalManager.chamberKd);
+        EEPROM_READ(PID_PARAM(Kp, CHAMBER_INDEX));
+        EEPROM_READ(PID_PARAM(Ki, CHAMBER_INDEX));
+        EEPROM_READ(PID_PARAM(Kd, CHAMBER_INDEX));
       #endif
 
       #if ENABLED(PIDTEMPCOOLER)
-        EEPROM_READ(thermalManager.coolerKp);
-        EEPROM_READ(thermalManager.coolerKi);
-        EEPROM_READ(thermalManager.coolerKd);
+        EEPROM_READ(PID_PARAM(Kp, COOLER_INDEX));
+        EEPROM_READ(PID_PARAM(Ki, COOLER_INDEX));
+        EEPROM_READ(PID_PARAM(Kd, COOLER_INDEX));
       #endif
 
       #if !HAS_LCD_CONTRAST
@@ -997,6 +1040,9 @@ void EEPROM::Factory_Settings() {
   Mechanics.max_jerk[X_AXIS] = DEFAULT_XJERK;
   Mechanics.max_jerk[Y_AXIS] = DEFAULT_YJERK;
   Mechanics.max_jerk[Z_AXIS] = DEFAULT_ZJERK;
+  #if ENABLED(JUNCTION_DEVIATION)
+    Mechanics.junction_deviation_mm = JUNCTION_DEVIATION_MM;
+  #endif
 
   #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
     bedlevel.z_fade_height = 0.0;
@@ -1046,22 +1092,38 @@ void EEPROM::Factory_Settings() {
     #endif
   #endif // PIDTEMP
 
+  #if ENABLED(PID_FEEDFORWARD)
+    constexpr float heater_power[] = DEFAULT_HEATER_POWER,
+                    heat_capacity[] = DEFAULT_HEAT_CAPACITY,
+                    ambient_loss[] = DEFAULT_AMBIENT_LOSS,
+                    fan_loss[] = DEFAULT_FAN_LOSS,
+                    filament_heat[] = DEFAULT_FILAMENT_HEAT;
+    HOTEND_LOOP() {
+      PID_PARAM(heater_power, h) = heater_power[h];
+      PID_PARAM(heat_capacity, h) = heat_capacity[h];
+      PID_PARAM(ambient_loss, h) = ambient_loss[h];
+      PID_PARAM(fan_loss, h) = fan_loss[h];
+      PID_PARAM(filament_heat, h) = filament_heat[h];
+      PID_PARAM(ambient_temp, h) = DEFAULT_AMBIENT_TEMP;
+    }
+  #endif
+
   #if ENABLED(PIDTEMPBED)
-    thermalManager.bedKp = DEFAULT_bedKp;
-    thermalManager.bedKi = DEFAULT_bedKi;
-    thermalManager.bedKd = DEFAULT_bedKd;
+    PID_PARAM(Kp, BED_INDEX) = DEFAULT_bedKp;
+    PID_PARAM(Ki, BED_INDEX) = DEFAULT_bedKi;
+    PID_PARAM(Kd, BED_INDEX) = DEFAULT_bedKd;
   #endif
 
   #if ENABLED(PIDTEMPCHAMBER)
-    thermalManager.chamberKp = DEFAULT_chamberKp;
-    thermalManager.chamberKi = DEFAULT_chamberKi;
-    thermalManager.chamberKd = DEFAULT_chamberKd;
+    PID_PARAM(Kp, CHAMBER_INDEX) = DEFAULT_chamberKp;
+    PID_PARAM(Ki, CHAMBER_INDEX) = DEFAULT_chamberKi;
+    PID_PARAM(Kd, CHAMBER_INDEX) = DEFAULT_chamberKd;
   #endif
 
   #if ENABLED(PIDTEMPCOOLER)
-    thermalManager.coolerKp = DEFAULT_coolerKp;
-    thermalManager.coolerKi = DEFAULT_coolerKi;
-    thermalManager.coolerKd = DEFAULT_coolerKd;
+    PID_PARAM(Kp, COOLER_INDEX) = DEFAULT_coolerKp;
+    PID_PARAM(Ki, COOLER_INDEX) = DEFAULT_coolerKi;
+    PID_PARAM(Kd, COOLER_INDEX) = DEFAULT_coolerKd;
   #endif
 
   #if ENABLED(FWRETRACT)
@@ -1251,13 +1313,20 @@ void EEPROM::Factory_Settings() {
       }
     #endif
 
-    CONFIG_MSG_START("Advanced variables: S<min_feedrate> V<min_travel_feedrate> B<min_segment_time_ms> X<max_xy_jerk> Z<max_z_jerk> T* E<max_e_jerk>");
+    #if ENABLED(JUNCTION_DEVIATION)
+      CONFIG_MSG_START("Advanced variables: S<min_feedrate> V<min_travel_feedrate> B<min_segment_time_ms> X<max_xy_jerk> Z<max_z_jerk> J<junc_dev> T* E<max_e_jerk>");
+    #else
+      CONFIG_MSG_START("Advanced variables: S<min_feedrate> V<min_travel_feedrate> B<min_segment_time_ms> X<max_xy_jerk> Z<max_z_jerk> T* E<max_e_jerk>");
+    #endif
     SERIAL_SMV(CFG, "  M205 S", LINEAR_UNIT(Mechanics.min_feedrate_mm_s), 3);
     SERIAL_MV(" V", LINEAR_UNIT(Mechanics.min_travel_feedrate_mm_s), 3);
     SERIAL_MV(" B", Mechanics.min_segment_time);
     SERIAL_MV(" X", LINEAR_UNIT(Mechanics.max_jerk[X_AXIS]), 3);
     SERIAL_MV(" Y", LINEAR_UNIT(Mechanics.max_jerk[Y_AXIS]), 3);
     SERIAL_MV(" Z", LINEAR_UNIT(Mechanics.max_jerk[Z_AXIS]), 3);
+    #if ENABLED(JUNCTION_DEVIATION)
+      SERIAL_MV(" J", LINEAR_UNIT(Mechanics.junction_deviation_mm), 3);
+    #endif
     #if EXTRUDERS == 1
       SERIAL_MV(" T0 E", LINEAR_UNIT(Mechanics.max_jerk[E_AXIS]), 3);
     #endif
@@ -1340,6 +1409,9 @@ void EEPROM::Factory_Settings() {
       CONFIG_MSG_START("Geometry adjustment: ABC=TOWER_DIAGROD_ADJ, IJK=TOWER_RADIUS_ADJ, UVW=TOWER_POSITION_ADJ");
       CONFIG_MSG_START("                     R=Delta Radius, D=DELTA_DIAGONAL_ROD, S=DELTA_SEGMENTS_PER_SECOND");
       CONFIG_MSG_START("                     O=DELTA_PRINTABLE_RADIUS, H=DELTA_HEIGHT");
+      #if ENABLED(DELTA_CHORD_SEGMENTATION)
+        CONFIG_MSG_START("                     E=DELTA_CHORD_ERROR");
+      #endif
       SERIAL_SM(CFG, "  M666");
       SERIAL_MV(" A", LINEAR_UNIT(Mechanics.delta_diagonal_rod_adj[0]), 3);
       SERIAL_MV(" B", LINEAR_UNIT(Mechanics.delta_diagonal_rod_adj[1]), 3);
@@ -1353,6 +1425,9 @@ void EEPROM::Factory_Settings() {
       SERIAL_MV(" R", LINEAR_UNIT(Mechanics.delta_radius));
       SERIAL_MV(" D", LINEAR_UNIT(Mechanics.delta_diagonal_rod));
       SERIAL_MV(" S", Mechanics.delta_segments_per_second);
+      #if ENABLED(DELTA_CHORD_SEGMENTATION)
+        SERIAL_MV(" E", LINEAR_UNIT(Mechanics.delta_chord_error), 4);
+      #endif
       SERIAL_MV(" O", LINEAR_UNIT(Mechanics.delta_print_radius));
       SERIAL_MV(" H", LINEAR_UNIT(Mechanics.delta_height), 3);
       SERIAL_EOL();
@@ -1410,22 +1485,35 @@ void EEPROM::Factory_Settings() {
         #endif
       #endif
       #if ENABLED(PIDTEMPBED)
-        SERIAL_SMV(CFG, "  M304 P", thermalManager.bedKp);
-        SERIAL_MV(" I", thermalManager.bedKi);
-        SERIAL_EMV(" D", thermalManager.bedKd);
+        SERIAL_SMV(CFG, "  M304 P", PID_PARAM(Kp, BED_INDEX));
+        SERIAL_MV(" I", PID_PARAM(Ki, BED_INDEX));
+        SERIAL_EMV(" D", PID_PARAM(Kd, BED_INDEX));
       #endif
       #if ENABLED(PIDTEMPCHAMBER)
-        SERIAL_SMV(CFG, "  M305 P", thermalManager.chamberKp);
-        SERIAL_MV(" I", thermalManager.chamberKi);
-        SERIAL_EMV(" D", thermalManager.chamberKd);
+        SERIAL_SMV(CFG, "  M305 P", PID_PARAM(Kp, CHAMBER_INDEX));
+        SERIAL_MV(" I", PID_PARAM(Ki, CHAMBER_INDEX));
+        SERIAL_EMV(" D", PID_PARAM(Kd, CHAMBER_INDEX));
       #endif
       #if ENABLED(PIDTEMPCOOLER)
-        SERIAL_SMV(CFG, "  M306 P", thermalManager.coolerKp);
-        SERIAL_MV(" I", thermalManager.coolerKi);
-        SERIAL_EMV(" D", thermalManager.coolerKd);
+        SERIAL_SMV(CFG, "  M306 P", PID_PARAM(Kp, COOLER_INDEX));
+        SERIAL_MV(" I", PID_PARAM(Ki, COOLER_INDEX));
+        SERIAL_EMV(" D", PID_PARAM(Kd, COOLER_INDEX));
       #endif
     #endif
 
+    #if ENABLED(PID_FEEDFORWARD)
+      CONFIG_MSG_START("Thermal model: P<heater W> C<J/K> A<ambient W/K> F<fan W/K> E<filament J/K mm> R<ambient C>");
+      HOTEND_LOOP() {
+        SERIAL_SMV(CFG, "  M307 H", h);
+        SERIAL_MV(" P", PID_PARAM(heater_power, h));
+        SERIAL_MV(" C", PID_PARAM(heat_capacity, h));
+        SERIAL_MV(" A", PID_PARAM(ambient_loss, h), 4);
+        SERIAL_MV(" F", PID_PARAM(fan_loss, h), 4);
+        SERIAL_MV(" E", PID_PARAM(filament_heat, h), 5);
+        SERIAL_EMV(" R", PID_PARAM(ambient_temp, h));
+      }
+    #endif
+
     #if ENABLED(FWRETRACT)
       CONFIG_MSG_START("Retract: S=Length (mm) F:Speed (mm/m) Z: ZLift (mm)");
       SERIAL_SMV(CFG, "  M207 S", retract_length);
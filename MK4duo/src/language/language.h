@@ -90,6 +90,7 @@
 #define MSG_ERR_CHECKSUM_MISMATCH           "checksum mismatch, Last Line: "
 #define MSG_ERR_NO_CHECKSUM                 "No Checksum with line number, Last Line: "
 #define MSG_ERR_NO_LINENUMBER_WITH_CHECKSUM "No Line Number with checksum, Last Line: "
+#define MSG_ERR_BINARY_FRAME                "Invalid binary frame, Last Line: "
 #define MSG_FILE_PRINTED                    "Done printing file"
 #define MSG_STATS                           "Stats: "
 #define MSG_BEGIN_FILE_LIST                 "Begin file list"
@@ -169,6 +170,10 @@
 #define MSG_SD_DIRECTORY_CREATED            "Directory created"
 #define MSG_SD_CREATION_FAILED              "Creation failed"
 #define MSG_SD_SLASH                        "/"
+#define MSG_SD_LAYER                        "SD layer "
+#define MSG_SD_LAYER_Z                      " Z:"
+#define MSG_SD_TIME_LEFT                    " Remaining(s):"
+#define MSG_SD_NO_LAYER                     "No such layer"
 #define MSG_SD_MAX_DEPTH                    "trying to call sub-gcode files with too many levels. MAX level is:"
 
 #define MSG_STEPPER_TOO_HIGH                "Steprate too high: "
@@ -221,6 +226,9 @@
 #define MSG_CAT                             " C@:"
 #define MSG_W                               " W:"
 #define MSG_PID_AUTOTUNE_FINISHED           MSG_PID_AUTOTUNE " finished! Put the last Kp, Ki and Kd constants from above into Configuration.h or send command M500 for save in EEPROM the new value!"
+#define MSG_MODEL_FINISHED                  "Thermal model found! Put it into Configuration_Temperature.h or send the M307 below and M500 for save in EEPROM"
+#define MSG_MODEL_TOO_HOT                   "Thermal model needs a cold hotend, finding the PID only"
+#define MSG_MODEL_HOTEND_ONLY               "Thermal model is only for the hotends, finding the PID only"
 #define MSG_PID_DEBUG                       " PID_DEBUG "
 #define MSG_PID_DEBUG_INPUT                 ": Input "
 #define MSG_PID_DEBUG_OUTPUT                " Output "
@@ -1042,14 +1042,14 @@ void kill_screen(const char* lcd_msg) {
     // Nozzle [1-4]:
     //
     #if HOTENDS == 1
-      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE, &thermalManager.target_temperature[0], 0, HEATER_0_MAXTEMP - 15, watch_temp_callback_E0);
+      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE, &thermalManager.heaters[0].target_temperature, 0, HEATER_0_MAXTEMP - 15, watch_temp_callback_E0);
     #elif HOTENDS > 1
-      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N1, &thermalManager.target_temperature[0], 0, HEATER_0_MAXTEMP - 15, watch_temp_callback_E0);
-      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N2, &thermalManager.target_temperature[1], 0, HEATER_1_MAXTEMP - 15, watch_temp_callback_E1);
+      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N1, &thermalManager.heaters[0].target_temperature, 0, HEATER_0_MAXTEMP - 15, watch_temp_callback_E0);
+      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N2, &thermalManager.heaters[1].target_temperature, 0, HEATER_1_MAXTEMP - 15, watch_temp_callback_E1);
       #if HOTENDS > 2
-        MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N3, &thermalManager.target_temperature[2], 0, HEATER_2_MAXTEMP - 15, watch_temp_callback_E2);
+        MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N3, &thermalManager.heaters[2].target_temperature, 0, HEATER_2_MAXTEMP - 15, watch_temp_callback_E2);
         #if HOTENDS > 3
-          MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N4, &thermalManager.target_temperature[3], 0, HEATER_3_MAXTEMP - 15, watch_temp_callback_E3);
+          MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N4, &thermalManager.heaters[3].target_temperature, 0, HEATER_3_MAXTEMP - 15, watch_temp_callback_E3);
         #endif // HOTENDS > 3
       #endif // HOTENDS > 2
     #endif // HOTENDS > 1
@@ -1058,21 +1058,21 @@ void kill_screen(const char* lcd_msg) {
     // Bed:
     //
     #if HAS_TEMP_BED
-      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_BED, &thermalManager.target_temperature_bed, 0, BED_MAXTEMP - 15, watch_temp_callback_bed);
+      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_BED, &thermalManager.heaters[BED_INDEX].target_temperature, 0, BED_MAXTEMP - 15, watch_temp_callback_bed);
     #endif
 
     //
     // Chamber:
     //
     #if HAS_TEMP_CHAMBER
-      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_CHAMBER, &thermalManager.target_temperature_chamber, 0, CHAMBER_MAXTEMP - 15, watch_temp_callback_chamber);
+      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_CHAMBER, &thermalManager.heaters[CHAMBER_INDEX].target_temperature, 0, CHAMBER_MAXTEMP - 15, watch_temp_callback_chamber);
     #endif
 
     //
     // Cooler:
     //
     #if HAS_TEMP_COOLER
-      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_COOLER, &thermalManager.target_temperature_cooler, 0, COOLER_MAXTEMP - 15, watch_temp_callback_cooler);
+      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_COOLER, &thermalManager.heaters[COOLER_INDEX].target_temperature, 0, COOLER_MAXTEMP - 15, watch_temp_callback_cooler);
     #endif
 
     //
@@ -1821,16 +1821,16 @@ void kill_screen(const char* lcd_msg) {
         //
         bool has_heat = false;
         #if HAS_TEMP_HOTEND
-          HOTEND_LOOP() if (thermalManager.target_temperature[h]) { has_heat = true; break; }
+          HOTEND_LOOP() if (thermalManager.heaters[h].target_temperature) { has_heat = true; break; }
         #endif
         #if HAS_TEMP_BED
-          if (thermalManager.target_temperature_bed) has_heat = true;
+          if (thermalManager.heaters[BED_INDEX].target_temperature) has_heat = true;
         #endif
         #if HAS_TEMP_CHAMBER
-          if (thermalManager.target_temperature_chamber) has_heat = true;
+          if (thermalManager.heaters[CHAMBER_INDEX].target_temperature) has_heat = true;
         #endif
         #if HAS_TEMP_COOLER
-          if (thermalManager.target_temperature_cooler) has_heat = true;
+          if (thermalManager.heaters[COOLER_INDEX].target_temperature) has_heat = true;
         #endif
         if (has_heat) MENU_ITEM(function, MSG_COOLDOWN, lcd_cooldown);
 
@@ -2311,6 +2311,7 @@ void kill_screen(const char* lcd_msg) {
       PID_PARAM(Kd, h) = raw_Kd;
       thermalManager.updatePID();
     }
+    void _update_PID() { thermalManager.updatePID(); }
     #define _DEFINE_PIDTEMP_BASE_FUNCS(N) \
       void copy_PID_i_H ## N() { copy_PID_i(N); } \
       void copy_PID_d_H ## N() { copy_PID_d(N); }
@@ -2354,14 +2355,14 @@ void kill_screen(const char* lcd_msg) {
     // Nozzle [1-4]:
     //
     #if HOTENDS == 1
-      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE, &thermalManager.target_temperature[0], 0, HEATER_0_MAXTEMP - 15, watch_temp_callback_E0);
+      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE, &thermalManager.heaters[0].target_temperature, 0, HEATER_0_MAXTEMP - 15, watch_temp_callback_E0);
     #elif HOTENDS > 1
-      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N1, &thermalManager.target_temperature[0], 0, HEATER_0_MAXTEMP - 15, watch_temp_callback_E0);
-      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N2, &thermalManager.target_temperature[1], 0, HEATER_1_MAXTEMP - 15, watch_temp_callback_E1);
+      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N1, &thermalManager.heaters[0].target_temperature, 0, HEATER_0_MAXTEMP - 15, watch_temp_callback_E0);
+      MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N2, &thermalManager.heaters[1].target_temperature, 0, HEATER_1_MAXTEMP - 15, watch_temp_callback_E1);
       #if HOTENDS > 2
-        MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N3, &thermalManager.target_temperature[2], 0, HEATER_2_MAXTEMP - 15, watch_temp_callback_E2);
+        MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N3, &thermalManager.heaters[2].target_temperature, 0, HEATER_2_MAXTEMP - 15, watch_temp_callback_E2);
         #if HOTENDS > 3
-          MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N4, &thermalManager.target_temperature[3], 0, HEATER_3_MAXTEMP - 15, watch_temp_callback_E3);
+          MENU_MULTIPLIER_ITEM_EDIT_CALLBACK(int3, MSG_NOZZLE MSG_N4, &thermalManager.heaters[3].target_temperature, 0, HEATER_3_MAXTEMP - 15, watch_temp_callback_E3);
         #endif // HOTENDS > 3
       #endif // HOTENDS > 2
     #endif // HOTENDS > 1
@@ -2370,21 +2371,21 @@ void kill_screen(const char* lcd_msg) {
     // Bed:
     //
     #if HAS_TEMP_BED
-      MENU_MULTIPLIER_ITEM_EDIT(int3, MSG_BED, &thermalManager.target_temperature_bed, 0, BED_MAXTEMP - 15);
+      MENU_MULTIPLIER_ITEM_EDIT(int3, MSG_BED, &thermalManager.heaters[BED_INDEX].target_temperature, 0, BED_MAXTEMP - 15);
     #endif
 
     //
     // Chamber:
     //
     #if HAS_TEMP_CHAMBER
-      MENU_MULTIPLIER_ITEM_EDIT(int3, MSG_CHAMBER, &thermalManager.target_temperature_chamber, 0, CHAMBER_MAXTEMP - 15);
+      MENU_MULTIPLIER_ITEM_EDIT(int3, MSG_CHAMBER, &thermalManager.heaters[CHAMBER_INDEX].target_temperature, 0, CHAMBER_MAXTEMP - 15);
     #endif
 
     //
     // Cooler:
     //
     #if HAS_TEMP_COOLER
-      MENU_MULTIPLIER_ITEM_EDIT(int3, MSG_COOLER, &thermalManager.target_temperature_cooler, 0, COOLER_MAXTEMP - 15);
+      MENU_MULTIPLIER_ITEM_EDIT(int3, MSG_COOLER, &thermalManager.heaters[COOLER_INDEX].target_temperature, 0, COOLER_MAXTEMP - 15);
     #endif
 
     //
@@ -2431,7 +2432,7 @@ void kill_screen(const char* lcd_msg) {
       #define _PID_BASE_MENU_ITEMS(HLABEL, hindex) \
         raw_Ki = PID_PARAM(Ki, hindex); \
         raw_Kd = PID_PARAM(Kd, hindex); \
-        MENU_ITEM_EDIT(float52, MSG_PID_P HLABEL, &PID_PARAM(Kp, hindex), 1, 9990); \
+        MENU_ITEM_EDIT_CALLBACK(float52, MSG_PID_P HLABEL, &PID_PARAM(Kp, hindex), 1, 9990, _update_PID); \
         MENU_ITEM_EDIT_CALLBACK(float52, MSG_PID_I HLABEL, &raw_Ki, 0.01, 9990, copy_PID_i_H ## hindex); \
         MENU_ITEM_EDIT_CALLBACK(float52, MSG_PID_D HLABEL, &raw_Kd, 1, 9990, copy_PID_d_H ## hindex)
 
@@ -2561,13 +2562,22 @@ void kill_screen(const char* lcd_msg) {
     #endif // EXTRUDERS > 2
   #endif // EXTRUDERS > 1
 
-  void _planner_refresh_positioning() { Mechanics.refresh_positioning(); }
+  void _planner_refresh_positioning() {
+    Mechanics.refresh_positioning();
+    #if ENABLED(PIDTEMP) && ENABLED(PID_ADD_EXTRUSION_RATE)
+      thermalManager.updatePID(); // Kc is taken per step of the extruder
+    #endif
+  }
   #if EXTRUDERS > 1
     void _planner_refresh_e_positioning(const uint8_t e) {
       if (e == active_extruder)
         _planner_refresh_positioning();
-      else
+      else {
         Mechanics.steps_to_mm[E_AXIS + e] = 1.0 / Mechanics.axis_steps_per_mm[E_AXIS + e];
+        #if ENABLED(PIDTEMP) && ENABLED(PID_ADD_EXTRUSION_RATE)
+          thermalManager.updatePID();
+        #endif
+      }
     }
     void _planner_refresh_e0_positioning() { _planner_refresh_e_positioning(0); }
     void _planner_refresh_e1_positioning() { _planner_refresh_e_positioning(1); }
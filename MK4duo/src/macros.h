@@ -182,7 +182,7 @@
 
 #define PIN_EXISTS(PN) (defined(PN##_PIN) && PN##_PIN >= 0)
 
-#define PENDING(NOW,SOON) ((long)(NOW-(SOON))<0)
+#define PENDING(NOW,SOON) ((int32_t)(NOW-(SOON))<0)
 #define ELAPSED(NOW,SOON) (!PENDING(NOW,SOON))
 
 #define NOOP do{}while(0)
@@ -59,6 +59,9 @@
                 retract_acceleration[EXTRUDERS],      // Retract acceleration mm/s^2 filament pull-back and push-forward while standing still in the other axes M204 TXXXX
                 travel_acceleration,                  // Travel acceleration mm/s^2  DEFAULT ACCELERATION for all NON printing moves. M204 MXXXX
                 max_jerk[XYZE_N];                     // The largest speed change requiring no acceleration
+      #if ENABLED(JUNCTION_DEVIATION)
+        float   junction_deviation_mm;                // Junction deviation for the cornering speeds, 0 use the jerk. M205 J
+      #endif
       uint32_t  max_acceleration_steps_per_s2[XYZE_N],
                 max_acceleration_mm_per_s2[XYZE_N];   // Use M201 to override by software
 
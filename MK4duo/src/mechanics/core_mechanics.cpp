@@ -51,7 +51,7 @@
       );
     }
     else
-      axis_steps = stepper.position((axis);
+      axis_steps = stepper.position(axis);
 
     return axis_steps * steps_to_mm[axis];
   }
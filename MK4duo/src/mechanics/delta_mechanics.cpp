@@ -36,6 +36,9 @@
     delta_diagonal_rod              = DELTA_DIAGONAL_ROD;
     delta_radius                    = DEFAULT_DELTA_RADIUS;
     delta_segments_per_second       = DELTA_SEGMENTS_PER_SECOND;
+    #if ENABLED(DELTA_CHORD_SEGMENTATION)
+      delta_chord_error             = DELTA_CHORD_ERROR;
+    #endif
     delta_print_radius              = DELTA_PRINTABLE_RADIUS;
     delta_probe_radius              = DELTA_PRINTABLE_RADIUS - max(abs(X_PROBE_OFFSET_FROM_NOZZLE), abs(Y_PROBE_OFFSET_FROM_NOZZLE));
     delta_height                    = DELTA_HEIGHT;
@@ -209,6 +212,83 @@
       // Get the linear distance in XYZ
       float cartesian_mm = SQRT(sq(difference[A_AXIS]) + sq(difference[B_AXIS]) + sq(difference[C_AXIS]));
 
+      #if ENABLED(PLANNER_BENCHMARK)
+        // Carriages at the start of every segment and direction of the move to measure the segments,
+        // checking the length first: a move too short for a direction only measures the distance
+        float bench_from[ABC];
+        const float bench_inv_mm = UNEAR_ZERO(cartesian_mm) ? 0.0 : 1.0 / cartesian_mm,
+                    bench_unit[XYZ] = {
+                      difference[A_AXIS] * bench_inv_mm,
+                      difference[B_AXIS] * bench_inv_mm,
+                      difference[C_AXIS] * bench_inv_mm
+                    };
+        Transform(current_position);
+        COPY_ARRAY(bench_from, delta);
+      #endif
+
+      #if ENABLED(DELTA_CHORD_SEGMENTATION)
+
+        if (delta_chord_error > 0 && !UNEAR_ZERO(cartesian_mm)) {
+
+          // Direction of the move, E is moved in proportion
+          const float inv_mm = 1.0 / cartesian_mm,
+                      unit[XYZ] = {
+                        difference[A_AXIS] * inv_mm,
+                        difference[B_AXIS] * inv_mm,
+                        difference[C_AXIS] * inv_mm
+                      },
+                      e_per_mm = difference[E_AXIS] * inv_mm;
+
+          float logical[XYZE];
+          COPY_ARRAY(logical, current_position);
+          Transform(logical);
+
+          float remaining_mm = cartesian_mm,
+                segment_mm = chord_segment_mm(logical, unit);
+
+          // Make every segment as long as the chord error allows at its start,
+          // the rest of the move is split evenly to avoid a short last segment
+          while (remaining_mm > segment_mm) {
+            segment_mm = remaining_mm / CEIL(remaining_mm / segment_mm);
+            remaining_mm -= segment_mm;
+
+            LOOP_XYZ(i) logical[i] += unit[i] * segment_mm;
+            logical[E_AXIS] += e_per_mm * segment_mm;
+
+            Transform(logical);
+
+            #if ENABLED(PLANNER_BENCHMARK)
+              bench_segment(bench_from, delta, current_position, unit);
+              COPY_ARRAY(bench_from, delta);
+            #endif
+
+            segment_mm = chord_segment_mm(logical, unit);
+
+            // Adjust Z if bed leveling is enabled
+            #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+              if (bedlevel.abl_enabled) {
+                const float zadj = bedlevel.bilinear_z_offset(logical);
+                delta[A_AXIS] += zadj;
+                delta[B_AXIS] += zadj;
+                delta[C_AXIS] += zadj;
+              }
+            #endif
+
+            planner.buffer_line(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], logical[E_AXIS], _feedrate_mm_s, active_extruder, active_driver);
+          }
+
+          #if ENABLED(PLANNER_BENCHMARK)
+            Transform(destination);
+            bench_segment(bench_from, delta, current_position, unit);
+          #endif
+
+          planner.buffer_line_kinematic(destination, _feedrate_mm_s, active_extruder, active_driver);
+          set_current_to_destination();
+          return;
+        }
+
+      #endif // DELTA_CHORD_SEGMENTATION
+
       // If the move is very short, check the E move distance
       if (UNEAR_ZERO(cartesian_mm)) cartesian_mm = abs(difference[E_AXIS]);
 
@@ -251,6 +331,11 @@
         LOOP_XYZE(i) logical[i] += segment_distance[i];
         Transform(logical);
 
+        #if ENABLED(PLANNER_BENCHMARK)
+          bench_segment(bench_from, delta, current_position, bench_unit);
+          COPY_ARRAY(bench_from, delta);
+        #endif
+
         // Adjust Z if bed leveling is enabled
         #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
           if (bedlevel.abl_enabled) {
@@ -265,6 +350,11 @@
 
       }
 
+      #if ENABLED(PLANNER_BENCHMARK)
+        Transform(destination);
+        bench_segment(bench_from, delta, current_position, bench_unit);
+      #endif
+
       planner.buffer_line_kinematic(destination, _feedrate_mm_s, active_extruder, active_driver);
 
     #endif // !UBL_DELTA
@@ -681,6 +771,31 @@
     delta_clip_start_height = delta_height - FABS(distance - delta[A_AXIS]);
   }
 
+  #if ENABLED(DELTA_CHORD_SEGMENTATION)
+
+    /**
+     * Along the move the height of a carriage over the nozzle is
+     * h(s) = SQRT(rod^2 - r(s)^2), r the XY distance from its tower.
+     * With u the unit vector of the move its curvature is
+     *
+     *   |h''| = (|u_xy|^2 * h^2 + (u_xy . r)^2) / h^3
+     *
+     * and a chord of length l deviates l^2 * |h''| / 8 from the curve.
+     * Z moves all the carriages linearly, only the XY motion counts.
+     */
+    float Delta_Mechanics::chord_segment_mm(const float logical[XYZ], const float unit[XYZ]) {
+      const float uxy2 = sq(unit[X_AXIS]) + sq(unit[Y_AXIS]);
+      float curvature = 0.0;
+      LOOP_XYZ(i) {
+        const float h = delta[i] - logical[Z_AXIS],
+                    ur = unit[X_AXIS] * (logical[X_AXIS] - towerX[i]) + unit[Y_AXIS] * (logical[Y_AXIS] - towerY[i]);
+        NOLESS(curvature, (uxy2 * sq(h) + sq(ur)) / (h * sq(h)));
+      }
+      return curvature > 0.0 ? SQRT(8.0 * delta_chord_error / curvature) : delta_print_radius * 2.0;
+    }
+
+  #endif // DELTA_CHORD_SEGMENTATION
+
   // Recalculate the steps/s^2 acceleration rates, based on the mm/s^2
   void Delta_Mechanics::reset_acceleration_rates() {
     #if EXTRUDERS > 1
@@ -905,6 +1020,41 @@
     return position_is_reachable_raw_xy(RAW_X_POSITION(lx), RAW_Y_POSITION(ly));
   }
 
+  #if ENABLED(PLANNER_BENCHMARK)
+
+    /**
+     * The steppers move the carriages linearly between the ends of
+     * a segment: measure how far the nozzle is from the line of the
+     * move at the middle of the segment.
+     */
+    void Delta_Mechanics::bench_segment(const float from[ABC], const float to[ABC], const float start[XYZ], const float unit[XYZ]) {
+      float middle[ABC], cartesian[ABC];
+      LOOP_XYZ(i) middle[i] = (from[i] + to[i]) * 0.5;
+      InverseTransform(middle, cartesian);
+
+      float along = 0.0;
+      LOOP_XYZ(i) {
+        cartesian[i] -= start[i];
+        along += cartesian[i] * unit[i];
+      }
+      const float error = SQRT(sq(cartesian[X_AXIS] - along * unit[X_AXIS]) + sq(cartesian[Y_AXIS] - along * unit[Y_AXIS]) + sq(cartesian[Z_AXIS] - along * unit[Z_AXIS]));
+
+      NOLESS(bench_chord_error, error);
+      bench_segments++;
+    }
+
+    void Delta_Mechanics::bench_reset() {
+      bench_chord_error = 0.0;
+      bench_segments = 0;
+    }
+
+    void Delta_Mechanics::bench_report() {
+      SERIAL_SMV(ECHO, "Delta segments:", bench_segments);
+      SERIAL_EMV(" max chord error(mm):", bench_chord_error, 4);
+    }
+
+  #endif // PLANNER_BENCHMARK
+
   #if ENABLED(DEBUG_LEVELING_FEATURE)
 
     void Delta_Mechanics::print_xyz(const char* prefix, const char* suffix, const float x, const float y, const float z) {
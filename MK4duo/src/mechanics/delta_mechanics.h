@@ -51,6 +51,15 @@
             delta_tower_radius_adj[ABC],
             delta_tower_pos_adj[ABC];
 
+      #if ENABLED(DELTA_CHORD_SEGMENTATION)
+        float delta_chord_error;                // Max deviation of the segments, 0 use the segments per second. M666 E
+      #endif
+
+      #if ENABLED(PLANNER_BENCHMARK)
+        float     bench_chord_error;            // Worst deviation of a segment midpoint from the line
+        uint32_t  bench_segments;
+      #endif
+
       /**
        * Feedrate, min, max, travel
        */
@@ -286,6 +295,11 @@
       bool position_is_reachable_by_probe_xy(const float &lx, const float &ly);
       bool position_is_reachable_xy(const float &lx, const float &ly);
 
+      #if ENABLED(PLANNER_BENCHMARK)
+        void bench_reset();
+        void bench_report();
+      #endif
+
       #if ENABLED(DEBUG_LEVELING_FEATURE)
         void print_xyz(const char* prefix, const char* suffix, const float x, const float y, const float z);
         void print_xyz(const char* prefix, const char* suffix, const float xyz[]);
@@ -326,6 +340,18 @@
        */
       void Set_clip_start_height();
 
+      #if ENABLED(DELTA_CHORD_SEGMENTATION)
+        /**
+         * Longest segment from the point of delta[] along
+         * the unit vector that keeps within delta_chord_error
+         */
+        float chord_segment_mm(const float logical[XYZ], const float unit[XYZ]);
+      #endif
+
+      #if ENABLED(PLANNER_BENCHMARK)
+        void bench_segment(const float from[ABC], const float to[ABC], const float start[XYZ], const float unit[XYZ]);
+      #endif
+
       /**
        * Some planner shorthand inline functions
        */
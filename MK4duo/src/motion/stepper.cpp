@@ -148,6 +148,9 @@ volatile signed char Stepper::count_direction[NUM_AXIS] = { 1, 1, 1, 1 };
 HAL_TIMER_TYPE  Stepper::acc_step_rate, // needed for deceleration start point
                 Stepper::OCR1A_nominal;
 uint8_t Stepper::step_loops, Stepper::step_loops_nominal;
+#if ENABLED(CPU_32_BIT)
+  HAL_TIMER_TYPE Stepper::isr_ticks = 0;
+#endif
 
 volatile long Stepper::endstops_trigsteps[XYZ];
 
@@ -352,12 +355,23 @@ void Stepper::set_directions() {
  *  4000   500  Hz - init rate
  */
 HAL_STEP_TIMER_ISR {
+  #if ENABLED(ISR_STATISTICS)
+    const uint32_t isr_lateness = HAL_STEPPER_LATENESS(),
+                   isr_start = HAL_CYCLE_COUNT();
+  #endif
   HAL_timer_isr_prologue (STEPPER_TIMER);
   #if ENABLED(ADVANCE) || ENABLED(LIN_ADVANCE)
     Stepper::advance_isr_scheduler();
   #else
     Stepper::isr();
   #endif
+  #if ENABLED(ISR_STATISTICS)
+    const uint32_t isr_cycles = HAL_CYCLES_SINCE(isr_start);
+    #if DISABLED(ADVANCE) && DISABLED(LIN_ADVANCE)
+      isrStats.record(ISR_STEPPER, isr_cycles);
+    #endif
+    isrStats.step_timer(isr_lateness, isr_cycles);
+  #endif
 }
 
 void Stepper::isr() {
@@ -386,7 +400,7 @@ void Stepper::isr() {
       } \
     } while(0)
 
-    if (step_remaining && ENDSTOPS_ENABLED) {   // just doing a check of the endstops - not yet time for a step
+    if (step_remaining && ENDSTOPS_ENABLED && current_block) {   // just doing a check of the endstops - not yet time for a step
       endstops.update();
       ocr_val = step_remaining;
       if (step_remaining > ENDSTOP_NOMINAL_OCR_VAL) {
@@ -416,6 +430,9 @@ void Stepper::isr() {
   if (cleaning_buffer_counter) {
     --cleaning_buffer_counter;
     current_block = NULL;
+    #if DISABLED(ENDSTOP_INTERRUPTS_FEATURE)
+      step_remaining = 0;
+    #endif
     planner.discard_current_block();
     #if ENABLED(SD_FINISHED_RELEASECOMMAND)
       if (!cleaning_buffer_counter && (SD_FINISHED_STEPPERRELEASE)) enqueue_and_echo_commands_P(PSTR(SD_FINISHED_RELEASECOMMAND));
@@ -455,7 +472,7 @@ void Stepper::isr() {
       #endif
 
       // Initialize Bresenham counters to 1/2 the ceiling
-      counter_X = counter_Y = counter_Z = counter_E = -(current_block->step_event_count >> 1);
+      counter_X = counter_Y = counter_Z = counter_E = -(long)(current_block->step_event_count >> 1);
 
       #if ENABLED(LASER)
         #if ENABLED(CPU_32_BIT)
@@ -470,7 +487,7 @@ void Stepper::isr() {
 
       #if ENABLED(COLOR_MIXING_EXTRUDER)
         MIXING_STEPPERS_LOOP(i)
-          counter_m[i] = -(current_block->mix_event_count[i] >> 1);
+          counter_m[i] = -(long)(current_block->mix_event_count[i] >> 1);
       #endif
 
       step_events_completed = 0;
@@ -778,8 +795,12 @@ void Stepper::isr() {
   // Calculate new timer value
   if (step_events_completed <= (uint32_t)current_block->accelerate_until) {
 
-    HAL_MULTI_ACC(acc_step_rate, acceleration_time, current_block->acceleration_rate);
-    acc_step_rate += current_block->initial_rate;
+    #if ENABLED(S_CURVE_ACCELERATION)
+      acc_step_rate = eval_bezier_curve(acceleration_time, current_block->acceleration_time_inverse, current_block->initial_rate, current_block->cruise_rate);
+    #else
+      HAL_MULTI_ACC(acc_step_rate, acceleration_time, current_block->acceleration_rate);
+      acc_step_rate += current_block->initial_rate;
+    #endif
 
     // upper limit
     NOMORE(acc_step_rate, current_block->nominal_rate);
@@ -831,15 +852,19 @@ void Stepper::isr() {
   }
   else if (step_events_completed > (uint32_t)current_block->decelerate_after) {
     HAL_TIMER_TYPE step_rate;
-    HAL_MULTI_ACC(step_rate, deceleration_time, current_block->acceleration_rate);
+    #if ENABLED(S_CURVE_ACCELERATION)
+      step_rate = eval_bezier_curve(deceleration_time, current_block->deceleration_time_inverse, current_block->cruise_rate, current_block->final_rate);
+    #else
+      HAL_MULTI_ACC(step_rate, deceleration_time, current_block->acceleration_rate);
 
-    if (step_rate < acc_step_rate) {
-      step_rate = acc_step_rate - step_rate; // Decelerate from acceleration end point.
-      NOLESS(step_rate, current_block->final_rate);
-    }
-    else {
-      step_rate = current_block->final_rate;
-    }
+      if (step_rate < acc_step_rate) {
+        step_rate = acc_step_rate - step_rate; // Decelerate from acceleration end point.
+        NOLESS(step_rate, current_block->final_rate);
+      }
+      else {
+        step_rate = current_block->final_rate;
+      }
+    #endif
 
     // step_rate to timer interval
     const HAL_TIMER_TYPE timer = calc_timer(step_rate);
@@ -902,6 +927,11 @@ void Stepper::isr() {
     step_loops = step_loops_nominal;
   }
 
+  #if ENABLED(CPU_32_BIT)
+    // The timer counts from the compare match that fired the interrupt
+    isr_ticks = (isr_ticks * 7 + HAL_timer_get_current_count(STEPPER_TIMER)) >> 3;
+  #endif
+
   #if DISABLED(ADVANCE) && DISABLED(LIN_ADVANCE)
     #if ENABLED(CPU_32_BIT)
       HAL_TIMER_TYPE stepper_timer_count = HAL_timer_get_count(STEPPER_TIMER);
@@ -917,6 +947,10 @@ void Stepper::isr() {
     current_block = NULL;
     planner.discard_current_block();
 
+    #if ENABLED(PLANNER_BENCHMARK)
+      if (!planner.blocks_queued()) planner.bench_drained = true;
+    #endif
+
     #if ENABLED(CPU_32_BIT)
       #if ENABLED(LASER)
         laser_extinguish();
@@ -1037,11 +1071,31 @@ void Stepper::isr() {
     // Allow UART ISRs
     _DISABLE_ISRs();
 
-    // Run main stepping ISR if flagged
-    if (!nextMainISR) isr();
+    #if ENABLED(ISR_STATISTICS)
+
+      // Run main stepping ISR if flagged
+      if (!nextMainISR) {
+        const uint32_t isr_start = HAL_CYCLE_COUNT();
+        isr();
+        isrStats.record(ISR_STEPPER, HAL_CYCLES_SINCE(isr_start));
+      }
+
+      // Run Advance stepping ISR if flagged
+      if (!nextAdvanceISR) {
+        const uint32_t isr_start = HAL_CYCLE_COUNT();
+        advance_isr();
+        isrStats.record(ISR_ADVANCE, HAL_CYCLES_SINCE(isr_start));
+      }
 
-    // Run Advance stepping ISR if flagged
-    if (!nextAdvanceISR) advance_isr();
+    #else
+
+      // Run main stepping ISR if flagged
+      if (!nextMainISR) isr();
+
+      // Run Advance stepping ISR if flagged
+      if (!nextAdvanceISR) advance_isr();
+
+    #endif
   
     // Is the next advance ISR scheduled before the next main ISR?
     if (nextAdvanceISR <= nextMainISR) {
@@ -1297,7 +1351,12 @@ void Stepper::init() {
 /**
  * Block until all buffered steps are executed
  */
-void Stepper::synchronize() { while (planner.blocks_queued()) idle(); }
+void Stepper::synchronize() {
+  while (planner.blocks_queued()) idle();
+  #if ENABLED(PLANNER_BENCHMARK)
+    planner.bench_drained = false; // Waiting for the moves to end is not a starvation
+  #endif
+}
 
 /**
  * Set the stepper positions directly in steps
@@ -109,6 +109,9 @@ class Stepper {
                           OCR1A_nominal;
 
     static uint8_t step_loops, step_loops_nominal;
+    #if ENABLED(CPU_32_BIT)
+      static HAL_TIMER_TYPE isr_ticks;  // Smoothed time spent in the stepper interrupt, for the step batching
+    #endif
 
     static volatile long endstops_trigsteps[XYZ];
     static volatile long endstops_stepsTotal, endstops_stepsDone;
@@ -188,6 +191,16 @@ class Stepper {
     //
     static long position(AxisEnum axis);
 
+    //
+    // Get the position of the extruder from another ISR, without a critical section.
+    // Read twice, the stepper ISR can change it between the bytes on AVR.
+    //
+    FORCE_INLINE static long position_e_isr() {
+      long e_position;
+      do { e_position = machine_position[E_AXIS]; } while (e_position != machine_position[E_AXIS]);
+      return e_position;
+    }
+
     //
     // Report the positions of the steppers, in steps
     //
@@ -293,7 +306,23 @@ class Stepper {
 
       NOMORE(step_rate, MAX_STEP_FREQUENCY);
 
-      #if ENABLED(ARDUINO_ARCH_AVR)
+      #if ENABLED(CPU_32_BIT)
+        // Take more steps per interrupt when they come faster than DOUBLE_STEP_FREQUENCY
+        // or when the interrupt would take more than STEPPER_ISR_MAX_LOAD % of the processor
+        const HAL_TIMER_TYPE min_timer = max((HAL_TIMER_TYPE)(HAL_STEPPER_TIMER_RATE / (DOUBLE_STEP_FREQUENCY)),
+                                             (HAL_TIMER_TYPE)(isr_ticks * 100UL / (STEPPER_ISR_MAX_LOAD)));
+        timer = HAL_STEPPER_TIMER_RATE / step_rate;
+        step_loops = 1;
+        while (timer < min_timer && step_loops < MAX_STEP_LOOPS) {
+          step_loops <<= 1;
+          timer <<= 1;
+        }
+        if (timer < min_timer) {
+          // Too fast even with MAX_STEP_LOOPS: slow down rather than lose steps
+          if (timer < (HAL_TIMER_TYPE)(HAL_STEPPER_TIMER_RATE / (DOUBLE_STEP_FREQUENCY))) SERIAL_EMT(MSG_STEPPER_TOO_HIGH, step_rate);
+          timer = min_timer;
+        }
+      #else
         if (step_rate > (2 * DOUBLE_STEP_FREQUENCY)) { // If steprate > 2*DOUBLE_STEP_FREQUENCY >> step 4 times
           step_rate >>= 2;
           step_loops = 4;
@@ -302,19 +331,10 @@ class Stepper {
           step_rate >>= 1;
           step_loops = 2;
         }
-        else
-      #endif
-        {
+        else {
           step_loops = 1;
         }
 
-      #if ENABLED(ARDUINO_ARCH_SAM)
-        timer = HAL_STEPPER_TIMER_RATE / step_rate;
-        if (timer < (HAL_STEPPER_TIMER_RATE / (DOUBLE_STEP_FREQUENCY * 2))) {
-          timer = (HAL_STEPPER_TIMER_RATE / (DOUBLE_STEP_FREQUENCY * 2));
-          SERIAL_EMT(MSG_STEPPER_TOO_HIGH, step_rate);
-        }
-      #else
         NOLESS(step_rate, F_CPU / 500000);
         step_rate -= F_CPU / 500000; // Correct for minimal speed
         if (step_rate >= (8 * 256)) { // higher step rate
@@ -339,6 +359,28 @@ class Stepper {
       return timer;
     }
 
+    #if ENABLED(S_CURVE_ACCELERATION)
+
+      /**
+       * Step rate at the given time of a ramp from rate v0 to v1 lasting
+       * 2^32 / inverse timer ticks. The rate follows the 6th order Bezier
+       * v0 + (v1 - v0) * (10t^3 - 15t^4 + 6t^5), t = 0..1, whose acceleration
+       * is zero at both ends. Covers the same distance as the linear ramp
+       * in the same time. Only 32x32 bit multiplies, single cycle on ARM.
+       */
+      static FORCE_INLINE HAL_TIMER_TYPE eval_bezier_curve(const uint32_t time, const uint32_t inverse, const uint32_t v0, const uint32_t v1) {
+        const uint64_t t32 = (uint64_t)time * inverse;
+        if (t32 >> 32) return v1;
+        const uint32_t t = (uint32_t)t32 >> 16,                                       // Q16
+                       t2 = t * t;                                                    // Q32
+        const uint64_t t3 = ((uint64_t)t2 * t) >> 16,                                 // Q32
+                       p = (10ULL << 32) + 6ULL * t2 - ((uint64_t)(15 * t) << 16);    // Q32, 1 to 10
+        const uint32_t s = ((uint64_t)(uint32_t)(t3 >> 8) * (uint32_t)(p >> 8)) >> 16; // Q32, 0 to 1
+        return v1 > v0 ? v0 + (((uint64_t)(v1 - v0) * s) >> 32) : v0 - (((uint64_t)(v0 - v1) * s) >> 32);
+      }
+
+    #endif
+
     // Initializes the trapezoid generator from the current block. Called whenever a new
     // block begins.
     static FORCE_INLINE void trapezoid_generator_reset() {
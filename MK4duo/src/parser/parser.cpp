@@ -26,6 +26,10 @@
 
 #include "../../base.h"
 
+#if HAS_PACKED_COMMANDS && ENABLED(ARDUINO_ARCH_SAM)
+  #include <avr/dtostrf.h>
+#endif
+
 // Must be declared for allocation and to satisfy the linker
 // Zero values need no initialization.
 
@@ -47,6 +51,10 @@ int   GCodeParser::codenum;
   int GCodeParser::subcode;
 #endif
 
+#if HAS_PACKED_COMMANDS
+  bool GCodeParser::packed;
+#endif
+
 #if ENABLED(FASTER_GCODE_PARSER)
   // Optimized Parameters
   byte GCodeParser::codebits[4];   // found bits
@@ -66,6 +74,9 @@ GCodeParser parser;
  */
 void GCodeParser::reset() {
   string_arg = NULL;                    // No whole line argument
+  #if HAS_PACKED_COMMANDS
+    packed = false;                     // Text values
+  #endif
   command_letter = '?';                 // No command letter
   codenum = 0;                          // No command code
   #if USE_GCODE_SUBCODES
@@ -226,6 +237,418 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+#if HAS_PACKED_COMMANDS
+
+  /**
+   * Write the name and the header of a packed command.
+   * Return a pointer to COUNT.
+   */
+  char* GCodeParser::pack_header(char *slot, const char letter, const uint16_t code, const uint8_t sub, const bool has_line, const int32_t line) {
+    *slot++ = PACKED_COMMAND_MARK;
+
+    // The command name, for the echo and the error messages
+    *slot++ = letter;
+    char digits[5];
+    uint8_t n = 0;
+    uint16_t c = code;
+    do { digits[n++] = '0' + c % 10; c /= 10; } while (c);
+    while (n) *slot++ = digits[--n];
+    if (sub) {
+      *slot++ = '.';
+      if (sub >= 100) *slot++ = '0' + sub / 100;
+      if (sub >= 10) *slot++ = '0' + (sub / 10) % 10;
+      *slot++ = '0' + sub % 10;
+    }
+    *slot++ = '\0';
+
+    *slot++ = has_line ? PACKED_HAS_LINE : 0;
+    memcpy(slot, &code, sizeof(code)); slot += sizeof(code);
+    *slot++ = sub;
+    memcpy(slot, &line, sizeof(line)); slot += sizeof(line);
+    *slot = 0;
+    return slot;
+  }
+
+  // Populate all fields from a packed command
+  void GCodeParser::unpack(char *p) {
+
+    reset(); // No codes to report
+
+    packed = true;
+
+    // The command name, for the echo
+    command_ptr = ++p;
+    command_letter = *p;
+    p += strlen(p) + 1;
+
+    const uint8_t flags = *p++;
+    uint16_t code;
+    memcpy(&code, p, sizeof(code));
+    codenum = code;
+    p += sizeof(code);
+    #if USE_GCODE_SUBCODES
+      subcode = (uint8_t)*p;
+    #endif
+    p += 1 + sizeof(int32_t);             // Skip the line number
+
+    // The values follow their WORD
+    for (uint8_t count = *p++; count--;) {
+      const uint8_t word = *p++;
+      const char param = 'A' + (word & 0x1F);
+      if (word & PACKED_VALUE_MASK) {
+        set(param, p);
+        p += sizeof(int32_t);
+      }
+      else
+        set(param, NULL);
+    }
+
+    if (flags & PACKED_HAS_STRING) string_arg = p;
+  }
+
+  uint8_t GCodeParser::packed_size(const char *p) {
+    const char * const start = p;
+    p += strlen(p + 1) + 2;               // Mark and name
+    const uint8_t flags = *p;
+    p += PACKED_HEADER_SIZE;
+    for (uint8_t count = (uint8_t)p[-1]; count--;)
+      if (*p++ & PACKED_VALUE_MASK) p += sizeof(int32_t);
+    if (flags & PACKED_HAS_STRING) p += strlen(p) + 1;
+    return p - start;
+  }
+
+  bool GCodeParser::packed_line(const char *p, long &line) {
+    p += strlen(p + 1) + 2;               // Mark and name
+    if (!(*p & PACKED_HAS_LINE)) return false;
+    int32_t n;
+    memcpy(&n, p + 4, sizeof(n));         // After FLAGS, CODE and SUBCODE
+    line = n;
+    return true;
+  }
+
+  /**
+   * Rebuild the text of a packed command, as "N12 G1 X10.5 E0.12345",
+   * with the line number only if it had one and 'with_line' is set.
+   * Floats get 9 significant digits, enough to read back the same value.
+   * The words that don't fit in 'size' minus a few characters of margin
+   * are dropped.
+   */
+  void GCodeParser::packed_to_text(const char *p, char *text, const uint16_t size, const bool with_line/*=true*/) {
+    const char * const text_end = text + size - 24;
+    long line;
+    if (with_line && packed_line(p, line)) text += sprintf_P(text, PSTR("N%ld "), line);
+
+    ++p;
+    strcpy(text, p);
+    text += strlen(p);
+    p += strlen(p) + 1;
+
+    const uint8_t flags = *p;
+    p += PACKED_HEADER_SIZE;
+    for (uint8_t count = (uint8_t)p[-1]; count-- && text < text_end;) {
+      const uint8_t word = *p++;
+      *text++ = ' ';
+      *text++ = 'A' + (word & 0x1F);
+      switch (word & PACKED_VALUE_MASK) {
+        case PACKED_VALUE_LONG: {
+          int32_t l;
+          memcpy(&l, p, sizeof(l));
+          text += sprintf_P(text, PSTR("%ld"), (long)l);
+          p += sizeof(l);
+        } break;
+        case PACKED_VALUE_FLOAT: {
+          float f;
+          memcpy(&f, p, sizeof(f));
+          const int8_t digits = f == 0.0f ? 0 : constrain(8 - (int8_t)floor(log10(fabs(f))), 0, 15);
+          dtostrf(f, 1, digits, text);
+          text += strlen(text);
+          if (digits) {
+            while (text[-1] == '0') --text; // Trailing zeros
+            if (text[-1] == '.') --text;
+          }
+          p += sizeof(f);
+        } break;
+      }
+    }
+
+    if (flags & PACKED_HAS_STRING) {
+      *text++ = ' ';
+      while (*p && text < text_end) *text++ = *p++;
+    }
+
+    *text = '\0';
+  }
+
+#endif // HAS_PACKED_COMMANDS
+
+#if ENABLED(PREPARSED_COMMAND_QUEUE)
+
+  /**
+   * Parse a line of GCode into a packed command, following the rules of parse().
+   * The line is kept as text (return false) when it isn't a valid G, M or T
+   * command, when the packed command doesn't fit in the slot, for M32 and G7
+   * that handle their own string and for the commands with a string argument
+   * other than M23, M28, M30, M117 and M928.
+   */
+  bool GCodeParser::pack(const char *p, char * const slot) {
+    const char * const slot_end = slot + MAX_CMD_SIZE;
+
+    // Skip spaces
+    while (*p == ' ') ++p;
+
+    // Line number
+    const bool has_line = *p == 'N' && NUMERIC_SIGNED(p[1]);
+    int32_t line = 0;
+    if (has_line) {
+      line = strtol(p + 1, NULL, 10);
+      p += 2;                             // skip N[-0-9]
+      while (NUMERIC(*p)) ++p;            // skip [0-9]*
+      while (*p == ' ') ++p;              // skip [ ]*
+    }
+
+    // The command letter, which must be G, M, or T
+    const char letter = *p++;
+    switch (letter) { case 'G': case 'M': case 'T': break; default: return false; }
+
+    while (*p == ' ') p++;
+    if (!NUMERIC(*p)) return false;
+
+    uint32_t code = 0;
+    do {
+      code *= 10, code += *p++ - '0';
+      if (code > 0xFFFF) return false;
+    } while (NUMERIC(*p));
+
+    uint8_t sub = 0;
+    if (*p == '.') {
+      #if USE_GCODE_SUBCODES
+        uint16_t s = 0;
+        p++;
+        while (NUMERIC(*p)) {
+          s *= 10, s += *p++ - '0';
+          if (s > 0xFF) return false;
+        }
+        sub = s;
+      #else
+        return false;
+      #endif
+    }
+
+    // These commands read a free-form string argument
+    if (letter == 'G' ? code == 7 : (letter == 'M' && (code <= 1 || code == 32 || code == 34 || code == 118 || code == 531)))
+      return false;
+
+    // The end of the command, before the checksum
+    const char *end = strchr(p, '*');
+    if (!end) end = p + strlen(p);
+    while (end > p && end[-1] == ' ') --end;
+
+    while (*p == ' ') p++;
+
+    char *s = pack_header(slot, letter, code, sub, has_line, line);
+    uint8_t * const count = (uint8_t*)s++;
+    char * const flags = s - PACKED_HEADER_SIZE;
+
+    // Only use the string for these M codes
+    bool string = false;
+    if (letter == 'M') switch (code) { case 23: case 28: case 30: case 117: case 928: string = true; default: break; }
+
+    if (!string) while (p < end) {
+      const char param = *p++;
+
+      // Arguments must be uppercase, like for FASTER_GCODE_PARSER
+      if (!WITHIN(param, 'A', 'Z')) return false;
+
+      while (*p == ' ') p++;
+
+      if (s + 1 + sizeof(int32_t) > slot_end) return false;
+
+      if (!DECIMAL_SIGNED(*p)) {
+        *s++ = (param - 'A') | PACKED_VALUE_NONE;
+        (*count)++;
+        continue;
+      }
+
+      // The value, up to a letter, a space or the end
+      char number[16];
+      uint8_t len = 0;
+      bool decimal = false;
+      while (p < end && (DECIMAL_SIGNED(*p))) {
+        if (len >= COUNT(number) - 1) return false;
+        if (*p == '.') decimal = true;
+        number[len++] = *p++;
+      }
+      number[len] = '\0';
+
+      // A whole number is kept as a long, unless it overflows 32 bits
+      const bool negative = number[0] == '-';
+      uint32_t u = 0;
+      for (const char *n = number + (negative || number[0] == '+'); !decimal && *n; ++n) {
+        if (!NUMERIC(*n) || u > (uint32_t)(INT32_MAX - (*n - '0')) / 10) decimal = true;
+        else u = u * 10 + *n - '0';
+      }
+
+      if (decimal) {
+        *s++ = (param - 'A') | PACKED_VALUE_FLOAT;
+        const float f = parse_float(number);
+        memcpy(s, &f, sizeof(f));
+      }
+      else {
+        *s++ = (param - 'A') | PACKED_VALUE_LONG;
+        const int32_t l = negative ? -(int32_t)u : (int32_t)u;
+        memcpy(s, &l, sizeof(l));
+      }
+      s += sizeof(int32_t);
+      (*count)++;
+
+      while (*p == ' ') p++;
+    }
+    else {
+      const uint8_t len = end - p;
+      if (s + len + 1 > slot_end) return false;
+      memcpy(s, p, len);
+      s[len] = '\0';
+      *flags |= PACKED_HAS_STRING;
+    }
+
+    return true;
+  }
+
+#endif // PREPARSED_COMMAND_QUEUE
+
+#if ENABLED(BINARY_PROTOCOL)
+
+  uint16_t GCodeParser::crc16(const uint8_t *data, uint8_t length) {
+    static const uint16_t crc_table[16] PROGMEM = {
+      0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+      0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+    };
+    uint16_t crc = 0xFFFF;
+    while (length--) {
+      const uint8_t b = *data++;
+      crc = (crc << 4) ^ pgm_read_word(&crc_table[(crc >> 12) ^ (b >> 4)]);
+      crc = (crc << 4) ^ pgm_read_word(&crc_table[(crc >> 12) ^ (b & 0x0F)]);
+    }
+    return crc;
+  }
+
+  /**
+   * Decode the payload of a binary frame, starting from LEN.
+   * The CRC must be checked before. Return false for a malformed
+   * frame, or if the command doesn't fit in the slot.
+   */
+  bool GCodeParser::decode_binary(const uint8_t *frame, char *slot) {
+    const uint8_t length = *frame++;
+    if (length < BINARY_FRAME_HEADER) return false;
+
+    const uint8_t * const end = frame + length;
+    const char * const slot_end = slot + MAX_CMD_SIZE;
+
+    uint32_t line = 0;
+    for (uint8_t i = 4; i--;) line = (line << 8) | frame[i];
+    const char letter = frame[4];
+    const uint16_t code = frame[5] | (frame[6] << 8);
+    frame += BINARY_FRAME_HEADER;
+
+    switch (letter) { case 'G': case 'M': case 'T': break; default: return false; }
+
+    char *s = pack_header(slot, letter, code, 0, true, line);
+    uint8_t * const count = (uint8_t*)s++;
+    char * const flags = s - PACKED_HEADER_SIZE;
+
+    while (frame < end) {
+      const uint8_t word = *frame++;
+      const char param = 'A' + (word & 0x1F);
+      const uint8_t size = (word >> 5) & 0x03,
+                    bytes = size == 3 ? 4 : size;
+      if (param > 'Z' || frame + bytes > end || s + 1 + sizeof(float) > slot_end) return false;
+
+      if (bytes) {
+        // Sign extend the little endian value
+        uint32_t raw = (frame[bytes - 1] & 0x80) ? 0xFFFFFFFF : 0;
+        for (uint8_t i = bytes; i--;) raw = (raw << 8) | frame[i];
+        frame += bytes;
+        const float value = (int32_t)raw / ((word & 0x80) ? 100000.0 : 1000.0);
+        *s++ = (param - 'A') | PACKED_VALUE_FLOAT;
+        memcpy(s, &value, sizeof(value));
+        s += sizeof(value);
+      }
+      else
+        *s++ = (param - 'A') | PACKED_VALUE_NONE;
+
+      (*count)++;
+    }
+
+    // No text arguments in a binary frame
+    if (letter == 'M') switch (code) {
+      case 23: case 28: case 30: case 32: case 117: case 928:
+        if (s >= slot_end) return false;
+        *s = '\0';
+        *flags |= PACKED_HAS_STRING;
+        break;
+      default: break;
+    }
+
+    return true;
+  }
+
+#endif // BINARY_PROTOCOL
+
+/**
+ * Convert the number at p, up to the first character that isn't part of
+ * [-+]digits[.digits]. There is no exponent, 'E' is a parameter.
+ *
+ * With less than 24 bits of digits and up to 10 decimals both the digits
+ * and the power of ten are exact in a float, so a single rounded division
+ * gives the same float as strtod. Longer numbers are left to strtod.
+ */
+float GCodeParser::parse_float(char *p) {
+  static const float pow10[] PROGMEM = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10 };
+
+  const char *s = p;
+  const bool negative = *s == '-';
+  if (negative || *s == '+') s++;
+
+  uint32_t mantissa = 0;
+  uint8_t decimals = 0;
+  bool digits = false, point = false;
+  for (;; s++) {
+    const char c = *s;
+    if (NUMERIC(c)) {
+      mantissa = mantissa * 10 + (c - '0');
+      if (mantissa >= 0x1000000UL) return strtod_float(p);
+      if (point) decimals++;
+      digits = true;
+    }
+    else if (c == '.' && !point)
+      point = true;
+    else
+      break;
+  }
+
+  if (!digits) return 0.0;
+  if (decimals >= COUNT(pow10)) return strtod_float(p);
+
+  const float f = decimals ? mantissa / pgm_read_float(&pow10[decimals]) : (float)mantissa;
+  return negative ? -f : f;
+}
+
+float GCodeParser::strtod_float(char *p) {
+  char *e = p;
+  for (;;) {
+    const char c = *e;
+    if (c == '\0' || c == ' ') break;
+    if (c == 'E' || c == 'e') {
+      *e = '\0';
+      const float ret = strtod(p, NULL);
+      *e = c;
+      return ret;
+    }
+    ++e;
+  }
+  return strtod(p, NULL);
+}
+
 void GCodeParser::unknown_command_error() {
   SERIAL_SMV(ECHO, MSG_UNKNOWN_COMMAND, command_ptr);
   SERIAL_CHR('"');
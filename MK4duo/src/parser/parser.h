@@ -35,6 +35,51 @@
   extern bool volumetric_enabled;
 #endif
 
+#if ENABLED(BINARY_PROTOCOL)
+
+  /**
+   * Binary frame, sent as a line of its own:
+   *
+   *   0xA5 LEN  N(4)  LETTER  CODE(2)  [WORD [VALUE]]...  CRC(2)
+   *
+   *  - LEN counts the bytes from N up to the last word.
+   *  - Multi-byte fields are little endian, the values are signed.
+   *  - WORD bits 0-4 are the parameter letter - 'A', bits 5-6 the value
+   *    size (0 = no value, 1, 2 or 4 bytes) and bit 7 the scale of the
+   *    value (0 = 1/1000, 1 = 1/100000).
+   *  - CRC is the CRC-16/CCITT of LEN and of the payload.
+   *
+   * A frame is decoded into a packed command.
+   */
+  #define BINARY_FRAME_START    0xA5
+  #define BINARY_FRAME_HEADER   7     // N, LETTER and CODE
+  #define BINARY_FRAME_EXTRA    4     // START, LEN and CRC
+
+#endif
+
+#if HAS_PACKED_COMMANDS
+
+  /**
+   * Packed command, as kept in the command queue:
+   *
+   *   0x01  NAME '\0'  FLAGS  CODE(2)  SUBCODE  N(4)  COUNT  [WORD [VALUE]]...  [STRING '\0']
+   *
+   *  - NAME is the command as text ("G1"), for the echo and the error messages.
+   *  - FLAGS tell if the command has a line number and a string argument.
+   *  - WORD bits 0-4 are the parameter letter - 'A', bits 5-6 the type of
+   *    the 4 byte VALUE that follows, if any.
+   */
+  #define PACKED_COMMAND_MARK   0x01
+  #define PACKED_HAS_LINE       0x01
+  #define PACKED_HAS_STRING     0x02
+  #define PACKED_VALUE_NONE     0x00
+  #define PACKED_VALUE_LONG     0x20
+  #define PACKED_VALUE_FLOAT    0x40
+  #define PACKED_VALUE_MASK     0x60
+  #define PACKED_HEADER_SIZE    9     // FLAGS, CODE, SUBCODE, N and COUNT
+
+#endif
+
 /**
  * Parser Gcode
  *
@@ -52,6 +97,17 @@ class GCodeParser {
 private:
   static char *value_ptr;           // Set by seen, used to fetch the value
 
+  // strtod of a number, cut at 'E'
+  static float strtod_float(char *p);
+
+  #if HAS_PACKED_COMMANDS
+    // The value of a packed parameter follows its WORD
+    FORCE_INLINE static bool packed_float() { return (value_ptr[-1] & PACKED_VALUE_MASK) == PACKED_VALUE_FLOAT; }
+    template <typename T>
+    FORCE_INLINE static T packed_value() { T v; memcpy(&v, value_ptr, sizeof(v)); return v; }
+    static char* pack_header(char *slot, const char letter, const uint16_t code, const uint8_t sub, const bool has_line, const int32_t line);
+  #endif
+
   #if ENABLED(FASTER_GCODE_PARSER)
     static byte codebits[4];        // Parameters pre-scanned
     static uint8_t param[26];       // For A-Z, offsets into command args
@@ -81,6 +137,10 @@ public:
     static int subcode;                   // .1
   #endif
 
+  #if HAS_PACKED_COMMANDS
+    static bool packed;                   // Values are binary, from a packed command
+  #endif
+
   #if ENABLED(DEBUG_GCODE_PARSER)
     void debug();
   #endif
@@ -115,7 +175,7 @@ public:
       const uint8_t ind = c - 'A';
       if (ind >= COUNT(param)) return false; // Only A-Z
       const bool b = TEST(codebits[ind >> 3], ind & 0x7);
-      if (b) value_ptr = command_ptr + param[ind];
+      if (b) value_ptr = param[ind] ? command_ptr + param[ind] : (char*)NULL;
       return b;
     }
 
@@ -136,32 +196,62 @@ public:
   // This uses 54 bytes of SRAM to speed up seen/value
   static void parse(char * p);
 
+  #if HAS_PACKED_COMMANDS
+    // Populate all fields from a packed command
+    static void unpack(char *p);
+    // Bytes taken by a packed command
+    static uint8_t packed_size(const char *p);
+    // Line number of a packed command, false if it has none
+    static bool packed_line(const char *p, long &line);
+    // Rebuild the text of a packed command
+    static void packed_to_text(const char *p, char *text, const uint16_t size, const bool with_line=true);
+  #endif
+
+  #if ENABLED(PREPARSED_COMMAND_QUEUE)
+    // Parse a line of GCode into a packed command. Return false to keep it as text.
+    static bool pack(const char *p, char *slot);
+  #endif
+
+  #if ENABLED(BINARY_PROTOCOL)
+    // CRC-16/CCITT of a binary frame
+    static uint16_t crc16(const uint8_t *data, uint8_t length);
+    // Decode the payload of a binary frame into a packed command
+    static bool decode_binary(const uint8_t *frame, char *slot);
+  #endif
+
   // Code value pointer was set
   FORCE_INLINE static bool has_value() { return value_ptr != NULL; }
 
-  // Float removes 'E' to prevent scientific notation interpretation
+  // Convert a decimal number, [-+]digits[.digits] with no exponent
+  static float parse_float(char *p);
+
+  // Float stops at 'E' to prevent scientific notation interpretation
   inline static float value_float() {
     if (value_ptr) {
-      char *e = value_ptr;
-      for (;;) {
-        const char c = *e;
-        if (c == '\0' || c == ' ') break;
-        if (c == 'E' || c == 'e') {
-          *e = '\0';
-          const float ret = strtod(value_ptr, NULL);
-          *e = c;
-          return ret;
-        }
-        ++e;
-      }
-      return strtod(value_ptr, NULL);
+      #if HAS_PACKED_COMMANDS
+        if (packed) return packed_float() ? packed_value<float>() : packed_value<int32_t>();
+      #endif
+      return parse_float(value_ptr);
     }
     return 0.0;
   }
 
   // Code value as a long or ulong
-  inline          static long value_long()  { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
-  inline unsigned static long value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+  #if HAS_PACKED_COMMANDS
+    inline static long value_long() {
+      if (!value_ptr) return 0L;
+      if (packed) return packed_float() ? (long)packed_value<float>() : packed_value<int32_t>();
+      return strtol(value_ptr, NULL, 10);
+    }
+    inline unsigned static long value_ulong() {
+      if (!value_ptr) return 0UL;
+      if (packed) return packed_float() ? (unsigned long)packed_value<float>() : (unsigned long)packed_value<int32_t>();
+      return strtoul(value_ptr, NULL, 10);
+    }
+  #else
+    inline          static long value_long()  { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
+    inline unsigned static long value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+  #endif
 
   // Code value for use as time
   FORCE_INLINE static millis_t value_millis()               { return value_ulong(); }
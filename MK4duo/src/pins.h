@@ -30,6 +30,13 @@
 
 #define AS_QUOTED_STRING(S) #S
 #define INCLUDE_BY_MB(M)    AS_QUOTED_STRING(boards/M.h)
+
+#if ENABLED(ARDUINO_ARCH_LINUX)
+  // The host-native build always runs on the simulated board
+  #undef MOTHERBOARD
+  #define MOTHERBOARD BOARD_LINUX_SIMULATOR
+#endif
+
 #include INCLUDE_BY_MB(MOTHERBOARD)
 
 #if DISABLED(BOARD_NAME)
@@ -112,6 +119,11 @@
     #define SS_PIN            SDSS
   #endif
 
+#elif ENABLED(ARDUINO_ARCH_LINUX)
+  #define MOSI_PIN            51
+  #define MISO_PIN            50
+  #define SCK_PIN             52
+  #define SS_PIN              53
 #endif
 /****************************************************************************************/
 
@@ -68,8 +68,10 @@ Planner planner;
  * A ring buffer of moves described in steps
  */
 block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
-volatile uint8_t  Planner::block_buffer_head = 0, // Index of the next block to be pushed
-                  Planner::block_buffer_tail = 0;
+block_plan_t Planner::block_plan[BLOCK_BUFFER_SIZE];
+volatile uint8_t  Planner::block_buffer_head = 0,     // Index of the next block to be pushed
+                  Planner::block_buffer_tail = 0,
+                  Planner::block_buffer_planned = 0;  // Index of the first block whose entry speed can still change
 
 #if HAS_TEMP_HOTEND && ENABLED(AUTOTEMP)
   float Planner::autotemp_max = 250,
@@ -108,6 +110,27 @@ float Planner::previous_speed[NUM_AXIS],
   volatile uint32_t Planner::block_buffer_runtime_us = 0;
 #endif
 
+#if ENABLED(LASER_RASTER)
+  unsigned char Planner::raster_pool[LASER_RASTER_POOL_SIZE + 1][LASER_MAX_RASTER_LINE];
+  volatile uint8_t  Planner::raster_pool_head = 0,
+                    Planner::raster_pool_tail = 0;
+#endif
+
+#if ENABLED(PLANNER_BENCHMARK)
+  uint32_t  Planner::bench_blocks   = 0,
+            Planner::bench_total_us = 0,
+            Planner::bench_max_us   = 0,
+            Planner::bench_starved  = 0,
+            Planner::bench_start_ms = 0;
+  volatile bool Planner::bench_drained = false;
+  #if ENABLED(PLANNER_FIXED_POINT)
+    uint32_t  Planner::bench_check_us   = 0,
+              Planner::bench_rate_error = 0,
+              Planner::bench_step_error = 0;
+    float     Planner::bench_speed_error = 0.0;
+  #endif
+#endif
+
 /**
  * Class and Instance Methods
  */
@@ -115,7 +138,10 @@ float Planner::previous_speed[NUM_AXIS],
 Planner::Planner() { init(); }
 
 void Planner::init() {
-  block_buffer_head = block_buffer_tail = 0;
+  block_buffer_head = block_buffer_tail = block_buffer_planned = 0;
+  #if ENABLED(LASER_RASTER)
+    raster_pool_head = raster_pool_tail = 0;
+  #endif
   ZERO(position);
   #if ENABLED(LIN_ADVANCE)
     ZERO(position_float);
@@ -130,21 +156,22 @@ void Planner::init() {
 #define MINIMAL_STEP_RATE 120
 
 /**
- * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
- * by the provided factors.
+ * Float trapezoid generator: the rates and the distances in steps
+ * are calculated in floating point and rounded to whole steps.
  */
-void Planner::calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor) {
-  uint32_t initial_rate = CEIL(block->nominal_rate * entry_factor),
-           final_rate = CEIL(block->nominal_rate * exit_factor); // (steps per second)
+void Planner::trapezoid_float(const block_t* const block, const int32_t accel, const float &entry_factor, const float &exit_factor,
+                              uint32_t &initial_rate, uint32_t &final_rate, int32_t &accelerate_steps, int32_t &plateau_steps) {
+
+  initial_rate = CEIL(block->nominal_rate * entry_factor);
+  final_rate = CEIL(block->nominal_rate * exit_factor); // (steps per second)
 
   // Limit minimal step rate (Otherwise the timer will overflow.)
   NOLESS(initial_rate, MINIMAL_STEP_RATE);
   NOLESS(final_rate, MINIMAL_STEP_RATE);
 
-  int32_t accel = block->acceleration_steps_per_s2,
-          accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, block->nominal_rate, accel)),
-          decelerate_steps = FLOOR(estimate_acceleration_distance(block->nominal_rate, final_rate, -accel)),
-          plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
+  accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, block->nominal_rate, accel));
+  const int32_t decelerate_steps = FLOOR(estimate_acceleration_distance(block->nominal_rate, final_rate, -accel));
+  plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
 
   // Is the Plateau of Nominal Rate smaller than nothing? That means no cruising, and we will
   // have to use intersection_distance() to calculate when to abort accel and start braking
@@ -155,132 +182,320 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
     accelerate_steps = min((uint32_t)accelerate_steps, block->step_event_count);//(We can cast here to unsigned, because the above line ensures that we are above zero)
     plateau_steps = 0;
   }
+}
+
+#if ENABLED(PLANNER_FIXED_POINT)
+
+  /**
+   * Divide rounding up or down. The squares of the step rates need 64 bit,
+   * but most of the time the numerator fits 32 bit and the 32 bit division
+   * (a single instruction on the Cortex-M3) is used.
+   */
+  static uint32_t udiv_ceil(const uint64_t n, const uint32_t d) {
+    if (n >> 32) return (n + d - 1) / d;
+    const uint32_t n32 = n;
+    return n32 / d + (n32 % d ? 1 : 0);
+  }
+  static uint32_t udiv_floor(const uint64_t n, const uint32_t d) {
+    if (n >> 32) return n / d;
+    return (uint32_t)n / d;
+  }
+
+  /**
+   * Integer square root, rounded down
+   */
+  static uint32_t isqrt(uint32_t x) {
+    uint32_t root = 0, bit = 1UL << 30;
+    while (bit > x) bit >>= 2;
+    while (bit) {
+      if (x >= root + bit) {
+        x -= root + bit;
+        root = (root >> 1) + bit;
+      }
+      else
+        root >>= 1;
+      bit >>= 2;
+    }
+    return root;
+  }
+
+  /**
+   * Calculate the maximum allowable speed with an integer square root.
+   * The square of the speed is taken in 1/256 mm^2/s^2 so the result has a
+   * resolution of 1/16 mm/s up to 4096 mm/s. 2 * accel * distance is taken
+   * from the block, the target speed is truncated and the root is rounded
+   * down, so it never allows a faster junction than the float version.
+   */
+  float Planner::max_allowable_speed(const block_plan_t* const plan, const float &target_velocity) {
+    const uint32_t target_x16 = target_velocity * 16.0f;
+    const uint64_t v2 = (uint64_t)target_x16 * target_x16 + plan->accel_distance_x2;
+    const float speed = isqrt(v2 >> 32 ? 0xFFFFFFFFUL : (uint32_t)v2) * 0.0625f;
+
+    #if ENABLED(PLANNER_BENCHMARK)
+      const uint32_t check_start_us = HAL_BENCH_MICROS();
+      NOLESS(bench_speed_error, FABS(speed - max_allowable_speed_float(-plan->acceleration, target_velocity, plan->millimeters)));
+      bench_check_us += HAL_BENCH_MICROS() - check_start_us;
+    #endif
+
+    return speed;
+  }
+
+  /**
+   * Fixed point trapezoid generator: the speeds are taken in 1/4096 mm/s to
+   * scale the nominal rate and the distances are calculated in the integer
+   * step domain, so there is no float division nor rounding call. The results
+   * are the same as the float version within rounding (see M124 with
+   * PLANNER_BENCHMARK).
+   */
+  void Planner::trapezoid_fixed(const block_t* const block, const uint32_t accel, const float &entry_speed, const float &exit_speed, const float &nominal_speed,
+                                uint32_t &initial_rate, uint32_t &final_rate, int32_t &accelerate_steps, int32_t &plateau_steps) {
+
+    const uint32_t nominal_rate = block->nominal_rate,
+                   step_event_count = block->step_event_count,
+                   nominal_x4096 = nominal_speed * 4096.0f;
+
+    // r = m * v / nominal_speed
+    if (nominal_x4096) {
+      initial_rate = udiv_ceil((uint64_t)nominal_rate * (uint32_t)(entry_speed * 4096.0f), nominal_x4096);
+      final_rate = udiv_ceil((uint64_t)nominal_rate * (uint32_t)(exit_speed * 4096.0f), nominal_x4096); // (steps per second)
+    }
+    else
+      initial_rate = final_rate = nominal_rate;
+
+    // Limit minimal step rate (Otherwise the timer will overflow.)
+    NOLESS(initial_rate, MINIMAL_STEP_RATE);
+    NOLESS(final_rate, MINIMAL_STEP_RATE);
+
+    if (accel == 0) { // accel was 0, no acceleration nor deceleration
+      accelerate_steps = 0;
+      plateau_steps = step_event_count;
+      return;
+    }
+
+    const uint64_t nominal_sq = (uint64_t)nominal_rate * nominal_rate,
+                   initial_sq = (uint64_t)initial_rate * initial_rate,
+                   final_sq = (uint64_t)final_rate * final_rate;
+    const uint32_t accel_x2 = accel << 1;
+
+    // d = (m^2 - s^2) / (2 a)
+    accelerate_steps = nominal_sq > initial_sq ? udiv_ceil(nominal_sq - initial_sq, accel_x2) : 0;
+    const int32_t decelerate_steps = nominal_sq > final_sq ? udiv_floor(nominal_sq - final_sq, accel_x2) : 0;
+    plateau_steps = step_event_count - accelerate_steps - decelerate_steps;
+
+    // No cruising: di = (2 a d - s1^2 + s2^2) / (4 a)
+    if (plateau_steps < 0) {
+      const uint64_t n = (uint64_t)accel_x2 * step_event_count + final_sq;
+      accelerate_steps = n > initial_sq ? min(udiv_ceil(n - initial_sq, accel_x2 << 1), step_event_count) : 0;
+      plateau_steps = 0;
+    }
+  }
+
+#endif // PLANNER_FIXED_POINT
+
+/**
+ * Calculate trapezoid parameters for the provided entry- and exit-speeds.
+ * Return false if the block was already busy and has not been changed.
+ */
+bool Planner::calculate_trapezoid_for_block(const uint8_t block_index, const float &entry_speed, const float &exit_speed) {
+  block_t* const block = &block_buffer[block_index];
+  block_plan_t* const plan = &block_plan[block_index];
+
+  uint32_t initial_rate, final_rate;
+  int32_t accelerate_steps, plateau_steps;
+
+  #if DISABLED(PLANNER_FIXED_POINT) || ENABLED(PLANNER_BENCHMARK) || ENABLED(ADVANCE)
+    // NOTE: Entry and exit factors always > 0 by all previous logic operations.
+    const float entry_factor = entry_speed / plan->nominal_speed,
+                exit_factor = exit_speed / plan->nominal_speed;
+  #endif
+
+  #if ENABLED(PLANNER_FIXED_POINT)
+
+    trapezoid_fixed(block, plan->acceleration_steps_per_s2, entry_speed, exit_speed, plan->nominal_speed, initial_rate, final_rate, accelerate_steps, plateau_steps);
+
+    #if ENABLED(PLANNER_BENCHMARK)
+      // Check the fixed point trapezoid against the float one. A rate above
+      // nominal gives a negative deceleration in float, only compare the rest.
+      if (entry_factor <= 1.0f && exit_factor <= 1.0f) {
+        const uint32_t check_start_us = HAL_BENCH_MICROS();
+        uint32_t f_initial_rate, f_final_rate;
+        int32_t f_accelerate_steps, f_plateau_steps;
+        trapezoid_float(block, plan->acceleration_steps_per_s2, entry_factor, exit_factor, f_initial_rate, f_final_rate, f_accelerate_steps, f_plateau_steps);
+        NOLESS(bench_rate_error, (uint32_t)labs((int32_t)(initial_rate - f_initial_rate)));
+        NOLESS(bench_rate_error, (uint32_t)labs((int32_t)(final_rate - f_final_rate)));
+        NOLESS(bench_step_error, (uint32_t)labs(accelerate_steps - f_accelerate_steps));
+        NOLESS(bench_step_error, (uint32_t)labs(accelerate_steps + plateau_steps - f_accelerate_steps - f_plateau_steps));
+        bench_check_us += HAL_BENCH_MICROS() - check_start_us;
+      }
+    #endif
+
+  #else
+
+    trapezoid_float(block, plan->acceleration_steps_per_s2, entry_factor, exit_factor, initial_rate, final_rate, accelerate_steps, plateau_steps);
+
+  #endif
 
   // block->accelerate_until = accelerate_steps;
   // block->decelerate_after = accelerate_steps+plateau_steps;
 
+  #if ENABLED(S_CURVE_ACCELERATION)
+    // The S-curve is evaluated over time, so the stepper needs the duration of the ramps.
+    // Without plateau the acceleration stops before the nominal rate.
+    const uint32_t accel = plan->acceleration_steps_per_s2,
+                   cruise_rate = plateau_steps ? block->nominal_rate
+                               : min((uint32_t)SQRT(sq((float)initial_rate) + 2.0f * accel * accelerate_steps), block->nominal_rate),
+                   acceleration_ticks = accel && cruise_rate > initial_rate ? (uint64_t)(cruise_rate - initial_rate) * (uint32_t)(HAL_STEPPER_TIMER_RATE) / accel : 0,
+                   deceleration_ticks = accel && cruise_rate > final_rate ? (uint64_t)(cruise_rate - final_rate) * (uint32_t)(HAL_STEPPER_TIMER_RATE) / accel : 0;
+  #endif
+
   CRITICAL_SECTION_START;  // Fill variables used by the stepper in a critical section
-  if (!TEST(block->flag, BLOCK_BIT_BUSY)) { // Don't update variables if block is busy.
+  const bool busy = TEST(plan->flag, BLOCK_BIT_BUSY);
+  if (!busy) { // Don't update variables if block is busy.
     block->accelerate_until = accelerate_steps;
     block->decelerate_after = accelerate_steps + plateau_steps;
     block->initial_rate = initial_rate;
     block->final_rate = final_rate;
+    #if ENABLED(S_CURVE_ACCELERATION)
+      block->cruise_rate = cruise_rate;
+      block->acceleration_time_inverse = acceleration_ticks ? 0xFFFFFFFFUL / acceleration_ticks : 0;
+      block->deceleration_time_inverse = deceleration_ticks ? 0xFFFFFFFFUL / deceleration_ticks : 0;
+    #endif
     #if ENABLED(ADVANCE)
-      block->initial_advance = block->advance * sq(entry_factor);
-      block->final_advance = block->advance * sq(exit_factor);
+      block->initial_advance = plan->advance * sq(entry_factor);
+      block->final_advance = plan->advance * sq(exit_factor);
     #endif
   }
   CRITICAL_SECTION_END;
+  return !busy;
 }
 
 // The kernel called by recalculate() when scanning the plan from last to first entry.
-void Planner::reverse_pass_kernel(block_t* const current, const block_t *next) {
-  if (!current || !next) return;
-  // If entry speed is already at the maximum entry speed, no need to recheck. Block is cruising.
-  // If not, block in state of Mechanics.acceleration or deceleration. Reset entry speed to maximum and
-  // check for maximum allowable speed reductions to ensure maximum possible planned speed.
-  float max_entry_speed = current->max_entry_speed;
-  if (current->entry_speed != max_entry_speed) {
+void Planner::reverse_pass_kernel(block_plan_t* const current, const block_plan_t *next) {
+  // If entry speed is already at the maximum entry speed and the next block didn't change,
+  // no need to recheck. Block is cruising. If not, block in state of acceleration or deceleration.
+  // Reset entry speed to maximum and check for maximum allowable speed reductions to ensure
+  // maximum possible planned speed.
+  const float max_entry_speed = current->max_entry_speed;
+  if (current->entry_speed != max_entry_speed || (next && TEST(next->flag, BLOCK_BIT_RECALCULATE))) {
     // If nominal length true, max junction speed is guaranteed to be reached. Only compute
     // for max allowable speed if block is decelerating and nominal length is false.
-    current->entry_speed = (TEST(current->flag, BLOCK_BIT_NOMINAL_LENGTH) || max_entry_speed <= next->entry_speed)
+    // The newest block must be able to stop at the end of the plan.
+    const float entry_speed = TEST(current->flag, BLOCK_BIT_NOMINAL_LENGTH)
       ? max_entry_speed
-      : min(max_entry_speed, max_allowable_speed(-current->acceleration, next->entry_speed, current->millimeters));
-    SBI(current->flag, BLOCK_BIT_RECALCULATE);
+      : min(max_entry_speed, max_allowable_speed(current, next ? next->entry_speed : MINIMUM_PLANNER_SPEED));
+    if (current->entry_speed != entry_speed) {
+      current->entry_speed = entry_speed;
+      SBI(current->flag, BLOCK_BIT_RECALCULATE);
+    }
   }
 }
 
 /**
  * recalculate() needs to go over the current plan twice.
  * Once in reverse and once forward. This implements the reverse pass.
+ *
+ * Only the blocks after block_buffer_planned are visited: adding a block
+ * that stops at the end of the plan can only raise the speeds that the
+ * previous plan had limited, so the blocks before it are already optimal.
  */
 void Planner::reverse_pass() {
 
-  if (movesplanned() > 3) {
-
-    block_t* block[3] = { NULL, NULL, NULL };
-
-    // Make a local copy of block_buffer_tail, because the interrupt can alter it
-    //CRITICAL_SECTION_START;
-    uint8_t tail = block_buffer_tail;
-    //CRITICAL_SECTION_END
-
-    uint8_t b = BLOCK_MOD(block_buffer_head - 3);
-    while (b != tail) {
-      if (block[0] && TEST(block[0]->flag, BLOCK_BIT_START_FROM_FULL_HALT)) break;
-      b = prev_block_index(b);
-      block[2] = block[1];
-      block[1] = block[0];
-      block[0] = &block_buffer[b];
-      reverse_pass_kernel(block[1], block[2]);
+  // Make a local copy of block_buffer_planned, because the interrupt can alter it
+  uint8_t planned_block_index = block_buffer_planned;
+
+  // Nothing to plan if the interrupt has taken every block
+  if (planned_block_index == block_buffer_head) return;
+
+  const block_plan_t *next = NULL;
+  uint8_t b = prev_block_index(block_buffer_head);
+  while (b != planned_block_index) {
+    block_plan_t* const current = &block_plan[b];
+    reverse_pass_kernel(current, next);
+    next = current;
+    b = prev_block_index(b);
+
+    // Follow the planned pointer if the interrupt has moved it
+    // and stop before reaching a block that is already busy
+    while (planned_block_index != block_buffer_planned) {
+      if (b == planned_block_index) return;
+      planned_block_index = next_block_index(planned_block_index);
     }
   }
 }
 
 // The kernel called by recalculate() when scanning the plan from first to last entry.
-void Planner::forward_pass_kernel(const block_t* previous, block_t* const current) {
+void Planner::forward_pass_kernel(const block_plan_t* previous, block_plan_t* const current, const uint8_t block_index) {
   if (!previous) return;
 
-  // If the previous block is an Mechanics.acceleration block, but it is not long enough to complete the
+  // If the previous block is an acceleration block, but it is not long enough to complete the
   // full speed change within the block, we need to adjust the entry speed accordingly. Entry
   // speeds have already been reset, maximized, and reverse planned by reverse planner.
   // If nominal length is true, max junction speed is guaranteed to be reached. No need to recheck.
-  if (!TEST(previous->flag, BLOCK_BIT_NOMINAL_LENGTH)) {
-    if (previous->entry_speed < current->entry_speed) {
-      float entry_speed = min(current->entry_speed,
-                               max_allowable_speed(-previous->acceleration, previous->entry_speed, previous->millimeters));
-      // Check for junction speed change
-      if (current->entry_speed != entry_speed) {
-        current->entry_speed = entry_speed;
-        SBI(current->flag, BLOCK_BIT_RECALCULATE);
-      }
+  if (!TEST(previous->flag, BLOCK_BIT_NOMINAL_LENGTH) && previous->entry_speed < current->entry_speed) {
+    const float entry_speed = max_allowable_speed(previous, previous->entry_speed);
+    // Check for junction speed change
+    if (entry_speed < current->entry_speed) {
+      current->entry_speed = entry_speed;
+      SBI(current->flag, BLOCK_BIT_RECALCULATE);
+      // Limited by the acceleration of the previous block: the plan is optimal up to here
+      block_buffer_planned = block_index;
     }
   }
+
+  // A block entering at its maximum speed can't go any faster: the plan is optimal up to here
+  if (current->entry_speed == current->max_entry_speed)
+    block_buffer_planned = block_index;
 }
 
 /**
  * recalculate() needs to go over the current plan twice.
- * Once in reverse and once forward. This implements the forward pass.
+ * Once in reverse and once forward. This implements the forward pass
+ * starting from the last optimal block and moves block_buffer_planned
+ * forward to the new optimal breakpoint.
  */
 void Planner::forward_pass() {
-  block_t* block[3] = { NULL, NULL, NULL };
-
-  for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
-    block[0] = block[1];
-    block[1] = block[2];
-    block[2] = &block_buffer[b];
-    forward_pass_kernel(block[0], block[1]);
+  const block_plan_t* previous = NULL;
+
+  for (uint8_t b = block_buffer_planned; b != block_buffer_head; b = next_block_index(b)) {
+    block_plan_t* const current = &block_plan[b];
+    // The exit speed of a busy block can't change anymore, so neither can this entry speed
+    if (!previous || !TEST(previous->flag, BLOCK_BIT_BUSY))
+      forward_pass_kernel(previous, current, b);
+    previous = current;
   }
-  forward_pass_kernel(block[1], block[2]);
 }
 
 /**
- * Recalculate the trapezoid speed profiles for all blocks in the plan
- * according to the entry_factor for each junction. Must be called by
- * recalculate() after updating the blocks.
+ * Recalculate the trapezoid speed profiles for the blocks in the plan
+ * whose entry or exit junction speed has changed (BLOCK_BIT_RECALCULATE).
+ * Must be called by recalculate() after updating the blocks.
  */
 void Planner::recalculate_trapezoids() {
-  int8_t block_index = block_buffer_tail;
-  block_t *current, *next = NULL;
+  uint8_t block_index = block_buffer_tail;
+  int16_t current_index = -1;
+  block_plan_t *current, *next = NULL;
 
   while (block_index != block_buffer_head) {
     current = next;
-    next = &block_buffer[block_index];
+    next = &block_plan[block_index];
     if (current) {
       // Recalculate if current block entry or exit junction speed has changed.
       if (TEST(current->flag, BLOCK_BIT_RECALCULATE) || TEST(next->flag, BLOCK_BIT_RECALCULATE)) {
-        // NOTE: Entry and exit factors always > 0 by all previous logic operations.
-        float nom = current->nominal_speed;
-        calculate_trapezoid_for_block(current, current->entry_speed / nom, next->entry_speed / nom);
+        if (!calculate_trapezoid_for_block(current_index, current->entry_speed, next->entry_speed)) {
+          // The steppers took the block meanwhile, the next one has to enter at its actual exit speed
+          const block_t* const block = &block_buffer[current_index];
+          next->entry_speed = current->nominal_speed * block->final_rate / block->nominal_rate;
+          SBI(next->flag, BLOCK_BIT_RECALCULATE);
+        }
         CBI(current->flag, BLOCK_BIT_RECALCULATE); // Reset current only to ensure next trapezoid is computed
       }
     }
+    current_index = block_index;
     block_index = next_block_index(block_index);
   }
   // Last/newest block in buffer. Exit speed is set with MINIMUM_PLANNER_SPEED. Always recalculated.
   if (next) {
-    float nom = next->nominal_speed;
-    calculate_trapezoid_for_block(next, next->entry_speed / nom, (MINIMUM_PLANNER_SPEED) / nom);
+    calculate_trapezoid_for_block(current_index, next->entry_speed, MINIMUM_PLANNER_SPEED);
     CBI(next->flag, BLOCK_BIT_RECALCULATE);
   }
 }
@@ -328,7 +543,7 @@ void Planner::recalculate() {
     for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
       block_t* block = &block_buffer[b];
       if (block->steps[X_AXIS] || block->steps[Y_AXIS] || block->steps[Z_AXIS]) {
-        float se = (float)block->steps[E_AXIS] / block->step_event_count * block->nominal_speed; // mm/sec;
+        float se = (float)block->steps[E_AXIS] / block->step_event_count * block_plan[b].nominal_speed; // mm/sec;
         NOLESS(high, se);
       }
     }
@@ -342,6 +557,36 @@ void Planner::recalculate() {
 
 #endif //AUTOTEMP
 
+#if ENABLED(PID_FEEDFORWARD)
+
+  /**
+   * Filament fed to the hotend h by the moves in the buffer (mm/s),
+   * averaged over at most horizon seconds of them from the current block.
+   * Retractions and moves of the extruder alone don't count, they take
+   * no heat from the hotend for long.
+   */
+  float Planner::extrusion_rate(const uint8_t h, const float horizon) {
+    #if HOTENDS <= 1
+      UNUSED(h);
+    #endif
+    float time = 0, length = 0;
+    for (uint8_t b = block_buffer_tail; b != block_buffer_head && time < horizon; b = next_block_index(b)) {
+      const block_t* block = &block_buffer[b];
+      const block_plan_t* plan = &block_plan[b];
+      if (plan->nominal_speed <= 0) continue;
+      time += plan->millimeters / plan->nominal_speed;
+      if (!block->steps[E_AXIS] || TEST(block->direction_bits, E_AXIS)) continue;
+      if (!block->steps[X_AXIS] && !block->steps[Y_AXIS] && !block->steps[Z_AXIS]) continue;
+      #if HOTENDS > 1
+        if (block->active_extruder != h) continue;
+      #endif
+      length += block->steps[E_AXIS] * Mechanics.steps_to_mm[E_AXIS + block->active_extruder];
+    }
+    return time > 0 ? length / time : 0;
+  }
+
+#endif // PID_FEEDFORWARD
+
 /**
  * Maintain fans, paste extruder pressure,
  */
@@ -546,11 +791,16 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
   // Rest here until there is room in the buffer.
   while (block_buffer_tail == next_buffer_head) idle();
 
+  #if ENABLED(PLANNER_BENCHMARK)
+    uint32_t bench_start_us = HAL_BENCH_MICROS();
+  #endif
+
   // Prepare to set up new block
   block_t* block = &block_buffer[block_buffer_head];
+  block_plan_t* plan = &block_plan[block_buffer_head];
 
   // Clear the block flags
-  block->flag = 0;
+  plan->flag = 0;
 
   // Set direction bits
   block->direction_bits = dirb;
@@ -852,10 +1102,10 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
   delta_mm[E_AXIS] = esteps_float * Mechanics.steps_to_mm[E_AXIS_N];
 
   if (block->steps[X_AXIS] < MIN_STEPS_PER_SEGMENT && block->steps[Y_AXIS] < MIN_STEPS_PER_SEGMENT && block->steps[Z_AXIS] < MIN_STEPS_PER_SEGMENT) {
-    block->millimeters = FABS(delta_mm[E_AXIS]);
+    plan->millimeters = FABS(delta_mm[E_AXIS]);
   }
   else {
-    block->millimeters = SQRT(
+    plan->millimeters = SQRT(
       #if CORE_IS_XY
         sq(delta_mm[X_HEAD]) + sq(delta_mm[Y_HEAD]) + sq(delta_mm[Z_AXIS])
       #elif CORE_IS_XZ
@@ -878,29 +1128,40 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
     // When operating in PULSED or RASTER modes, laser pulsing must operate in sync with movement.
     // Calculate steps between laser firings (steps_l) and consider that when determining largest
     // interval between steps for X, Y, Z, E, L to feed to the motion control code.
-    if (laser.mode == RASTER || laser.mode == PULSED) {
-      block->steps_l = labs(block->millimeters * laser.ppm);
-      for (uint8_t i = 0; i < LASER_MAX_RASTER_LINE; i++) {
-        // Scale the image intensity based on the raster power.
-        // 100% power on a pixel basis is 255, convert back to 255 = 100.
-        #if ENABLED(LASER_REMAP_INTENSITY)
-          const int NewRange = (laser.rasterlaserpower * 255.0 / 100.0 - LASER_REMAP_INTENSITY);
-          float     NewValue = (float)(((((float)laser.raster_data[i] - 0) * NewRange) / 255.0) + LASER_REMAP_INTENSITY);
-        #else
-          const int NewRange = (laser.rasterlaserpower * 255.0 / 100.0);
-          float     NewValue = (float)(((((float)laser.raster_data[i] - 0) * NewRange) / 255.0));
-        #endif
+    if (laser.mode == RASTER || laser.mode == PULSED)
+      block->steps_l = labs(plan->millimeters * laser.ppm);
+    else
+      block->steps_l = 0;
 
-        #if ENABLED(LASER_REMAP_INTENSITY)
-          // If less than 7%, turn off the laser tube.
-          if (NewValue <= LASER_REMAP_INTENSITY) NewValue = 0;
-        #endif
+    #if ENABLED(LASER_RASTER)
+      block->laser_raster_data = NULL;
+      if (laser.mode == RASTER) {
+        // Take a line from the raster pool, the steppers give them back in order
+        const uint8_t next_raster_head = RASTER_POOL_NEXT(raster_pool_head);
+        while (raster_pool_tail == next_raster_head) idle();
+        block->laser_raster_data = raster_pool[raster_pool_head];
+        raster_pool_head = next_raster_head;
+
+        for (uint8_t i = 0; i < LASER_MAX_RASTER_LINE; i++) {
+          // Scale the image intensity based on the raster power.
+          // 100% power on a pixel basis is 255, convert back to 255 = 100.
+          #if ENABLED(LASER_REMAP_INTENSITY)
+            const int NewRange = (laser.rasterlaserpower * 255.0 / 100.0 - LASER_REMAP_INTENSITY);
+            float     NewValue = (float)(((((float)laser.raster_data[i] - 0) * NewRange) / 255.0) + LASER_REMAP_INTENSITY);
+          #else
+            const int NewRange = (laser.rasterlaserpower * 255.0 / 100.0);
+            float     NewValue = (float)(((((float)laser.raster_data[i] - 0) * NewRange) / 255.0));
+          #endif
+
+          #if ENABLED(LASER_REMAP_INTENSITY)
+            // If less than 7%, turn off the laser tube.
+            if (NewValue <= LASER_REMAP_INTENSITY) NewValue = 0;
+          #endif
 
-        block->laser_raster_data[i] = NewValue;
+          block->laser_raster_data[i] = NewValue;
+        }
       }
-    }
-    else
-      block->steps_l = 0;
+    #endif
 
     block->step_event_count = max(block->step_event_count, block->steps_l);
 
@@ -909,7 +1170,7 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
 
   #endif // LASER
 
-  float inverse_millimeters = 1.0 / block->millimeters;  // Inverse millimeters to remove multiple divides
+  float inverse_millimeters = 1.0 / plan->millimeters;  // Inverse millimeters to remove multiple divides
 
   // Calculate moves/second for this move. No divide by zero due to previous checks.
   float inverse_mm_s = fr_mm_s * inverse_millimeters;
@@ -935,12 +1196,13 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
   #endif
 
   #if ENABLED(ULTRA_LCD)
+    plan->segment_time = segment_time;
     CRITICAL_SECTION_START
       block_buffer_runtime_us += segment_time;
     CRITICAL_SECTION_END
   #endif
 
-  block->nominal_speed = block->millimeters * inverse_mm_s; // (mm/sec) Always > 0
+  plan->nominal_speed = plan->millimeters * inverse_mm_s; // (mm/sec) Always > 0
   block->nominal_rate = CEIL(block->step_event_count * inverse_mm_s); // (step/sec) Always > 0
 
   #if ENABLED(FILAMENT_SENSOR)
@@ -1026,7 +1288,7 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
   // Correct the speed
   if (speed_factor < 1.0) {
     LOOP_XYZE(i) current_speed[i] *= speed_factor;
-    block->nominal_speed *= speed_factor;
+    plan->nominal_speed *= speed_factor;
     block->nominal_rate *= speed_factor;
   }
 
@@ -1069,10 +1331,10 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
       LIMIT_ACCEL_FLOAT(E_AXIS, extruder);
     }
   }
-  block->acceleration_steps_per_s2 = accel;
-  block->acceleration = accel / steps_per_mm;
+  plan->acceleration_steps_per_s2 = accel;
+  plan->acceleration = accel / steps_per_mm;
 
-  #if ENABLED(ARDUINO_ARCH_SAM)
+  #if ENABLED(CPU_32_BIT)
     block->acceleration_rate = (long)(accel * (4294967296.0 / (HAL_STEPPER_TIMER_RATE)));
   #else
     block->acceleration_rate = (long)(accel * 16777216.0 / (HAL_STEPPER_TIMER_RATE));
@@ -1081,55 +1343,6 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
   // Initial limit on the segment entry velocity
   float vmax_junction;
 
-  #if 0  // Use old jerk for now
-
-    float junction_deviation = 0.1;
-
-    // Compute path unit vector
-    double unit_vec[XYZ] = {
-      delta_mm[X_AXIS] * inverse_millimeters,
-      delta_mm[Y_AXIS] * inverse_millimeters,
-      delta_mm[Z_AXIS] * inverse_millimeters
-    };
-
-    /*
-       Compute maximum allowable entry speed at junction by centripetal Mechanics.acceleration approximation.
-
-       Let a circle be tangent to both previous and current path line segments, where the junction
-       deviation is defined as the distance from the junction to the closest edge of the circle,
-       collinear with the circle center.
-
-       The circular segment joining the two paths represents the path of centripetal Mechanics.acceleration.
-       Solve for max velocity based on max Mechanics.acceleration about the radius of the circle, defined
-       indirectly by junction deviation.
-
-       This may be also viewed as path width or max_jerk in the previous grbl version. This approach
-       does not actually deviate from path, but used as a robust way to compute cornering speeds, as
-       it takes into account the nonlinearities of both the junction angle and junction velocity.
-     */
-
-    vmax_junction = MINIMUM_PLANNER_SPEED; // Set default max junction speed
-
-    // Skip first block or when previous_nominal_speed is used as a flag for homing and offset cycles.
-    if (block_buffer_head != block_buffer_tail && previous_nominal_speed > 0.0) {
-      // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
-      // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
-      float cos_theta = - previous_unit_vec[X_AXIS] * unit_vec[X_AXIS]
-                        - previous_unit_vec[Y_AXIS] * unit_vec[Y_AXIS]
-                        - previous_unit_vec[Z_AXIS] * unit_vec[Z_AXIS];
-      // Skip and use default max junction speed for 0 degree acute junction.
-      if (cos_theta < 0.95) {
-        vmax_junction = min(previous_nominal_speed, block->nominal_speed);
-        // Skip and avoid divide by zero for straight junctions at 180 degrees. Limit to min() of nominal speeds.
-        if (cos_theta > -0.95) {
-          // Compute maximum junction velocity based on maximum Mechanics.acceleration and junction deviation
-          float sin_theta_d2 = SQRT(0.5 * (1.0 - cos_theta)); // Trig half angle identity. Always positive.
-          NOMORE(vmax_junction, SQRT(block->acceleration * junction_deviation * sin_theta_d2 / (1.0 - sin_theta_d2)));
-        }
-      }
-    }
-  #endif
-
   /**
    * Start with a safe speed (from which the machine may halt to stop immediately).
    */
@@ -1137,7 +1350,7 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
   // Exit speed limited by a jerk to full halt of a previous last segment
   static float previous_safe_speed;
 
-  float safe_speed = block->nominal_speed;
+  float safe_speed = plan->nominal_speed;
   uint8_t limited = 0;
   LOOP_XYZE(i) {
     const float jerk = FABS(current_speed[i]),
@@ -1145,7 +1358,7 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
 
     if (jerk > maxj) {
       if (limited) {
-        const float mjerk = maxj * block->nominal_speed;
+        const float mjerk = maxj * plan->nominal_speed;
         if (jerk * safe_speed > mjerk) safe_speed = mjerk / jerk;
       }
       else {
@@ -1155,64 +1368,141 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
     }
   }
 
+  #if ENABLED(JUNCTION_DEVIATION)
+
+    // Unit vector of the head path, zero for the extruder only moves
+    static float previous_unit_vec[XYZ];
+    float unit_vec[XYZ] = { 0.0 };
+    if (block->steps[X_AXIS] >= MIN_STEPS_PER_SEGMENT || block->steps[Y_AXIS] >= MIN_STEPS_PER_SEGMENT || block->steps[Z_AXIS] >= MIN_STEPS_PER_SEGMENT) {
+      #if CORE_IS_XY
+        unit_vec[X_AXIS] = delta_mm[X_HEAD] * inverse_millimeters;
+        unit_vec[Y_AXIS] = delta_mm[Y_HEAD] * inverse_millimeters;
+        unit_vec[Z_AXIS] = delta_mm[Z_AXIS] * inverse_millimeters;
+      #elif CORE_IS_XZ
+        unit_vec[X_AXIS] = delta_mm[X_HEAD] * inverse_millimeters;
+        unit_vec[Y_AXIS] = delta_mm[Y_AXIS] * inverse_millimeters;
+        unit_vec[Z_AXIS] = delta_mm[Z_HEAD] * inverse_millimeters;
+      #elif CORE_IS_YZ
+        unit_vec[X_AXIS] = delta_mm[X_AXIS] * inverse_millimeters;
+        unit_vec[Y_AXIS] = delta_mm[Y_HEAD] * inverse_millimeters;
+        unit_vec[Z_AXIS] = delta_mm[Z_HEAD] * inverse_millimeters;
+      #else
+        LOOP_XYZ(i) unit_vec[i] = delta_mm[i] * inverse_millimeters;
+      #endif
+    }
+    const bool previous_head_move = previous_unit_vec[X_AXIS] || previous_unit_vec[Y_AXIS] || previous_unit_vec[Z_AXIS],
+               head_move = unit_vec[X_AXIS] || unit_vec[Y_AXIS] || unit_vec[Z_AXIS];
+
+    const bool jerk_cornering = Mechanics.junction_deviation_mm <= 0;
+
+  #else
+
+    constexpr bool jerk_cornering = true;
+
+  #endif // JUNCTION_DEVIATION
+
   if (moves_queued > 1 && previous_nominal_speed > 0.0001) {
-    // Estimate a maximum velocity allowed at a joint of two successive segments.
-    // If this maximum velocity allowed is lower than the minimum of the entry / exit safe velocities,
-    // then the machine is not coasting anymore and the safe entry / exit velocities shall be used.
-
-    // The junction velocity will be shared between successive segments. Limit the junction velocity to their minimum.
-    bool prev_speed_larger = previous_nominal_speed > block->nominal_speed;
-    float smaller_speed_factor = prev_speed_larger ? (block->nominal_speed / previous_nominal_speed) : (previous_nominal_speed / block->nominal_speed);
-    // Pick the smaller of the nominal speeds. Higher speed shall not be achieved at the junction during coasting.
-    vmax_junction = prev_speed_larger ? block->nominal_speed : previous_nominal_speed;
-    // Factor to multiply the previous / current nominal velocities to get componentwise limited velocities.
-    float v_factor = 1.f;
-    limited = 0;
-    // Now limit the jerk in all axes.
-    LOOP_XYZE(axis) {
-      // Limit an axis. We have to differentiate: coasting, reversal of an axis, full stop.
-      float v_exit = previous_speed[axis], v_entry = current_speed[axis];
-      const float maxj = (axis == E_AXIS) ? Mechanics.max_jerk[axis + extruder] : Mechanics.max_jerk[axis];
-
-      if (prev_speed_larger) v_exit *= smaller_speed_factor;
-      if (limited) {
-        v_exit *= v_factor;
-        v_entry *= v_factor;
+
+    #if ENABLED(JUNCTION_DEVIATION)
+      if (!jerk_cornering) {
+        if (previous_head_move && head_move) {
+          /**
+           * Compute maximum allowable entry speed at junction by centripetal acceleration approximation.
+           *
+           * Let a circle be tangent to both previous and current path line segments, where the junction
+           * deviation is defined as the distance from the junction to the closest edge of the circle,
+           * collinear with the circle center. The circular segment joining the two paths represents the
+           * path of centripetal acceleration. Solve for max velocity based on max acceleration about the
+           * radius of the circle, defined indirectly by junction deviation.
+           *
+           * NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
+           */
+          // Cosine of the angle between previous and current path (previous_unit_vec is negated)
+          const float cos_theta = - previous_unit_vec[X_AXIS] * unit_vec[X_AXIS]
+                                  - previous_unit_vec[Y_AXIS] * unit_vec[Y_AXIS]
+                                  - previous_unit_vec[Z_AXIS] * unit_vec[Z_AXIS];
+
+          // The junction speed is shared between the two moves, not faster than the slowest one
+          vmax_junction = min(previous_nominal_speed, plan->nominal_speed);
+
+          if (cos_theta > 0.999999f) // A reversal of the path stops at the junction
+            vmax_junction = MINIMUM_PLANNER_SPEED;
+          else if (cos_theta > -0.999999f) { // A straight junction is only limited by the nominal speeds
+            const float sin_theta_d2 = SQRT(0.5f * (1.0f - cos_theta)); // Trig half angle identity. Always positive.
+            NOMORE(vmax_junction, SQRT(plan->acceleration * Mechanics.junction_deviation_mm * sin_theta_d2 / (1.0f - sin_theta_d2)));
+          }
+        }
+        else {
+          // From or to an extruder only move: the junction can be taken at a speed both moves can stop from
+          vmax_junction = min(safe_speed, previous_safe_speed);
+        }
       }
-      // Calculate jerk depending on whether the axis is coasting in the same direction or reversing.
-      const float jerk = (v_exit > v_entry)
-          ? //                                  coasting             axis reversal
-            ( (v_entry > 0.f || v_exit < 0.f) ? (v_exit - v_entry) : max(v_exit, -v_entry) )
-          : // v_exit <= v_entry                coasting             axis reversal
-            ( (v_entry < 0.f || v_exit > 0.f) ? (v_entry - v_exit) : max(-v_exit, v_entry) );
-
-      if (jerk > maxj) {
-        v_factor *= maxj / jerk;
-        ++limited;
+    #endif
+
+    if (jerk_cornering) {
+      // Estimate a maximum velocity allowed at a joint of two successive segments.
+      // If this maximum velocity allowed is lower than the minimum of the entry / exit safe velocities,
+      // then the machine is not coasting anymore and the safe entry / exit velocities shall be used.
+
+      // The junction velocity will be shared between successive segments. Limit the junction velocity to their minimum.
+      bool prev_speed_larger = previous_nominal_speed > plan->nominal_speed;
+      float smaller_speed_factor = prev_speed_larger ? (plan->nominal_speed / previous_nominal_speed) : (previous_nominal_speed / plan->nominal_speed);
+      // Pick the smaller of the nominal speeds. Higher speed shall not be achieved at the junction during coasting.
+      vmax_junction = prev_speed_larger ? plan->nominal_speed : previous_nominal_speed;
+      // Factor to multiply the previous / current nominal velocities to get componentwise limited velocities.
+      float v_factor = 1.f;
+      limited = 0;
+      // Now limit the jerk in all axes.
+      LOOP_XYZE(axis) {
+        // Limit an axis. We have to differentiate: coasting, reversal of an axis, full stop.
+        float v_exit = previous_speed[axis], v_entry = current_speed[axis];
+        const float maxj = (axis == E_AXIS) ? Mechanics.max_jerk[axis + extruder] : Mechanics.max_jerk[axis];
+
+        if (prev_speed_larger) v_exit *= smaller_speed_factor;
+        if (limited) {
+          v_exit *= v_factor;
+          v_entry *= v_factor;
+        }
+        // Calculate jerk depending on whether the axis is coasting in the same direction or reversing.
+        const float jerk = (v_exit > v_entry)
+            ? //                                  coasting             axis reversal
+              ( (v_entry > 0.f || v_exit < 0.f) ? (v_exit - v_entry) : max(v_exit, -v_entry) )
+            : // v_exit <= v_entry                coasting             axis reversal
+              ( (v_entry < 0.f || v_exit > 0.f) ? (v_entry - v_exit) : max(-v_exit, v_entry) );
+
+        if (jerk > maxj) {
+          v_factor *= maxj / jerk;
+          ++limited;
+        }
+      }
+      if (limited) vmax_junction *= v_factor;
+      // Now the transition velocity is known, which maximizes the shared exit / entry velocity while
+      // respecting the jerk factors, it may be possible, that applying separate safe exit / entry velocities will achieve faster prints.
+      const float vmax_junction_threshold = vmax_junction * 0.99f;
+      if (previous_safe_speed > vmax_junction_threshold && safe_speed > vmax_junction_threshold) {
+        // Not coasting. The machine will stop and start the movements anyway,
+        // better to start the segment from start.
+        SBI(plan->flag, BLOCK_BIT_START_FROM_FULL_HALT);
+        vmax_junction = safe_speed;
       }
-    }
-    if (limited) vmax_junction *= v_factor;
-    // Now the transition velocity is known, which maximizes the shared exit / entry velocity while
-    // respecting the jerk factors, it may be possible, that applying separate safe exit / entry velocities will achieve faster prints.
-    const float vmax_junction_threshold = vmax_junction * 0.99f;
-    if (previous_safe_speed > vmax_junction_threshold && safe_speed > vmax_junction_threshold) {
-      // Not coasting. The machine will stop and start the movements anyway,
-      // better to start the segment from start.
-      SBI(block->flag, BLOCK_BIT_START_FROM_FULL_HALT);
-      vmax_junction = safe_speed;
     }
   }
   else {
-    SBI(block->flag, BLOCK_BIT_START_FROM_FULL_HALT);
+    SBI(plan->flag, BLOCK_BIT_START_FROM_FULL_HALT);
     vmax_junction = safe_speed;
   }
 
   // Max entry speed of this block equals the max exit speed of the previous block.
-  block->max_entry_speed = vmax_junction;
+  plan->max_entry_speed = vmax_junction;
 
   // Initialize block entry speed. Compute based on deceleration to user-defined MINIMUM_PLANNER_SPEED.
-  const float v_allowable = max_allowable_speed(-block->acceleration, MINIMUM_PLANNER_SPEED, block->millimeters);
-  block->entry_speed = min(vmax_junction, v_allowable);
+  #if ENABLED(PLANNER_FIXED_POINT)
+    // Taken once per block, max_allowable_speed() runs at every recalculation
+    const float accel_distance_x2 = plan->acceleration * plan->millimeters * 512.0f;
+    plan->accel_distance_x2 = accel_distance_x2 < 4294967296.0f ? (uint32_t)accel_distance_x2 : 0xFFFFFFFFUL;
+  #endif
+  const float v_allowable = max_allowable_speed(plan, MINIMUM_PLANNER_SPEED);
+  plan->entry_speed = min(vmax_junction, v_allowable);
 
   // Initialize planner efficiency flags
   // Set flag if block will always reach maximum junction speed regardless of entry/exit speeds.
@@ -1222,12 +1512,15 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
   // block nominal speed limits both the current and next maximum junction speeds. Hence, in both
   // the reverse and forward planners, the corresponding block junction speed will always be at the
   // the maximum junction speed and may always be ignored for any speed reduction checks.
-  block->flag |= BLOCK_FLAG_RECALCULATE | (block->nominal_speed <= v_allowable ? BLOCK_FLAG_NOMINAL_LENGTH : 0);
+  plan->flag |= BLOCK_FLAG_RECALCULATE | (plan->nominal_speed <= v_allowable ? BLOCK_FLAG_NOMINAL_LENGTH : 0);
 
   // Update previous path unit_vector and nominal speed
   COPY_ARRAY(previous_speed, current_speed);
-  previous_nominal_speed = block->nominal_speed;
+  previous_nominal_speed = plan->nominal_speed;
   previous_safe_speed = safe_speed;
+  #if ENABLED(JUNCTION_DEVIATION)
+    COPY_ARRAY(previous_unit_vec, unit_vec);
+  #endif
 
   #if ENABLED(LIN_ADVANCE)
 
@@ -1255,7 +1548,7 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
       block->abs_adv_steps_multiplier8 = LROUND(
         extruder_advance_k
         * (UNEAR_ZERO(advance_ed_ratio) ? de_float / mm_D_float : advance_ed_ratio) // Use the fixed ratio, if set
-        * (block->nominal_speed / (float)block->nominal_rate)
+        * (plan->nominal_speed / (float)block->nominal_rate)
         * Mechanics.axis_steps_per_mm[E_AXIS_N] * 256.0
       );
 
@@ -1263,22 +1556,36 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
 
     // Calculate advance rate
     if (esteps && (block->steps[X_AXIS] || block->steps[Y_AXIS] || block->steps[Z_AXIS])) {
-      const long acc_dist = estimate_acceleration_distance(0, block->nominal_rate, block->acceleration_steps_per_s2);
+      const long acc_dist = estimate_acceleration_distance(0, block->nominal_rate, plan->acceleration_steps_per_s2);
       const float advance = ((STEPS_PER_CUBIC_MM_E) * (EXTRUDER_ADVANCE_K)) * HYPOT(current_speed[E_AXIS], EXTRUSION_AREA) * 256;
-      block->advance = advance;
+      plan->advance = advance;
       block->advance_rate = acc_dist ? advance / (float)acc_dist : 0;
     }
     else
-      block->advance_rate = block->advance = 0;
+      block->advance_rate = plan->advance = 0;
 
     /**
-    SERIAL_SMV(ECHO, "advance :", block->advance/256);
+    SERIAL_SMV(ECHO, "advance :", plan->advance/256);
     SERIAL_EMV("advance rate :", block->advance_rate/256);
     */
 
   #endif // ADVANCE or LIN_ADVANCE
 
-  calculate_trapezoid_for_block(block, block->entry_speed / block->nominal_speed, safe_speed / block->nominal_speed);
+  calculate_trapezoid_for_block(block_buffer_head, plan->entry_speed, safe_speed);
+
+  #if ENABLED(PLANNER_BENCHMARK)
+    // The block is not visible to the steppers before it is planned
+    uint32_t bench_us = HAL_BENCH_MICROS() - bench_start_us;
+    #if ENABLED(PLANNER_FIXED_POINT)
+      bench_us -= bench_check_us;
+      bench_check_us = 0;
+    #endif
+    HAL_BENCH_CHARGE(bench_us);
+    // The steppers stopped and waited for this block
+    if (bench_drained && !blocks_queued()) bench_starved++;
+    bench_drained = false;
+    bench_start_us = HAL_BENCH_MICROS();
+  #endif
 
   // Move buffer head
   block_buffer_head = next_buffer_head;
@@ -1294,10 +1601,59 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
 
   recalculate();
 
+  #if ENABLED(PLANNER_BENCHMARK)
+    #if ENABLED(PLANNER_FIXED_POINT)
+      const uint32_t recalculate_us = HAL_BENCH_MICROS() - bench_start_us - bench_check_us;
+      bench_check_us = 0;
+    #else
+      const uint32_t recalculate_us = HAL_BENCH_MICROS() - bench_start_us;
+    #endif
+    HAL_BENCH_CHARGE(recalculate_us);
+    bench_us += recalculate_us;
+    bench_blocks++;
+    bench_total_us += bench_us;
+    NOLESS(bench_max_us, bench_us);
+  #endif
+
   stepper.wake_up();
 
 } // _buffer_line()
 
+#if ENABLED(PLANNER_BENCHMARK)
+
+  void Planner::bench_reset() {
+    CRITICAL_SECTION_START
+      bench_blocks = bench_total_us = bench_max_us = bench_starved = 0;
+      #if ENABLED(PLANNER_FIXED_POINT)
+        bench_rate_error = bench_step_error = 0;
+        bench_speed_error = 0.0;
+      #endif
+    CRITICAL_SECTION_END
+    bench_start_ms = millis();
+  }
+
+  /**
+   * Report the planner throughput since the last reset:
+   *  blocks/s of planner time, average and worst-case time
+   *  for a block and how many times the steppers starved.
+   */
+  void Planner::bench_report() {
+    const uint32_t elapsed_ms = millis() - bench_start_ms;
+    SERIAL_SMV(ECHO, "Planner blocks:", bench_blocks);
+    SERIAL_MV(" time(ms):", elapsed_ms);
+    SERIAL_MV(" blocks/s:", bench_total_us ? (float)bench_blocks * 1000000.0 / bench_total_us : 0.0);
+    SERIAL_MV(" avg(us):", bench_blocks ? (float)bench_total_us / bench_blocks : 0.0);
+    SERIAL_MV(" max(us):", bench_max_us);
+    SERIAL_EMV(" starved:", bench_starved);
+    #if ENABLED(PLANNER_FIXED_POINT)
+      SERIAL_SMV(ECHO, "Fixed point error rate:", bench_rate_error);
+      SERIAL_MV(" steps:", bench_step_error);
+      SERIAL_EMV(" speed:", bench_speed_error, 4);
+    #endif
+  }
+
+#endif // PLANNER_BENCHMARK
+
 /**
  * Sync from the stepper positions. (e.g., after an interrupted move)
  */
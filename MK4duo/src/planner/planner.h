@@ -58,19 +58,23 @@ enum BlockFlag {
 /**
  * struct block_t
  *
- * A single entry in the planner buffer.
+ * A single entry in the planner buffer, as seen by the stepper ISR.
  * Tracks linear movement over multiple axes.
  *
- * The "nominal" values are as-specified by gcode, and
- * may never actually be reached due to acceleration limits.
+ * Only the fields read while stepping live here, the values used
+ * to plan the move are kept apart in block_plan_t, so the stepper
+ * works on a compact record and the look-ahead walks a dense array.
+ * The two records together are only a few bytes smaller than a single
+ * one, the RAM for a deeper BLOCK_BUFFER_SIZE comes from the raster
+ * pool of LASER_RASTER alone.
  */
 typedef struct {
 
-  uint8_t flag;                             // Block flags (See BlockFlag enum above)
-
   unsigned char active_extruder;            // The extruder to move (if E move)
   unsigned char active_driver;              // Selects the active driver for E
 
+  uint8_t direction_bits;                   // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
+
   // Fields used by the bresenham algorithm for tracing the line
   int32_t steps[NUM_AXIS];                  // Step count along each axis
   uint32_t step_event_count;                // The number of step events required to complete this block
@@ -83,8 +87,6 @@ typedef struct {
           decelerate_after,                 // The index of the step event on which to start decelerating
           acceleration_rate;                // The acceleration rate used for acceleration calculation
 
-  uint8_t direction_bits;                   // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
-
   // Advance extrusion
   #if ENABLED(LIN_ADVANCE)
     bool use_advance_lead;
@@ -92,28 +94,23 @@ typedef struct {
   #elif ENABLED(ADVANCE)
     int32_t advance_rate;
     volatile int32_t initial_advance, final_advance;
-    float advance;
   #endif
 
-  // Fields used by the motion planner to manage acceleration
-  float nominal_speed,                          // The nominal speed for this block in mm/sec
-        entry_speed,                            // Entry speed at previous-current junction in mm/sec
-        max_entry_speed,                        // Maximum allowable junction entry speed in mm/sec
-        millimeters,                            // The total travel of this block in mm
-        acceleration;                           // acceleration mm/sec^2
-
   // Settings for the trapezoid generator
   uint32_t nominal_rate,                        // The nominal step rate for this block in step_events/sec
            initial_rate,                        // The jerk-adjusted step rate at start of block
-           final_rate,                          // The minimal rate at exit
-           acceleration_steps_per_s2;           // acceleration steps/sec^2
+           final_rate;                          // The minimal rate at exit
+
+  #if ENABLED(S_CURVE_ACCELERATION)
+    uint32_t cruise_rate,                       // The rate reached at the end of the acceleration
+             acceleration_time_inverse,         // 2^32 / duration of the acceleration (stepper timer ticks)
+             deceleration_time_inverse;         // 2^32 / duration of the deceleration (stepper timer ticks)
+  #endif
 
   #if ENABLED(BARICUDA)
     uint32_t valve_pressure, e_to_p_pressure;
   #endif
 
-  uint32_t segment_time;
-
   #if ENABLED(LASER)
     uint8_t laser_mode;         // CONTINUOUS, PULSED, RASTER
     bool laser_status;          // LASER_OFF, LASER_ON
@@ -123,14 +120,53 @@ typedef struct {
               steps_l;          // Step count between firings of the laser, for pulsed firing mode
 
     #if ENABLED(LASER_RASTER)
-      unsigned char laser_raster_data[LASER_MAX_RASTER_LINE];
+      unsigned char *laser_raster_data; // Line in the raster pool, NULL if not a raster block
     #endif
   #endif
 
 } block_t;
 
+/**
+ * struct block_plan_t
+ *
+ * The planner side of a block_t, same index in the ring buffer.
+ *
+ * The "nominal" values are as-specified by gcode, and
+ * may never actually be reached due to acceleration limits.
+ */
+typedef struct {
+
+  uint8_t flag;                             // Block flags (See BlockFlag enum above)
+
+  // Fields used by the motion planner to manage acceleration
+  float nominal_speed,                      // The nominal speed for this block in mm/sec
+        entry_speed,                        // Entry speed at previous-current junction in mm/sec
+        max_entry_speed,                    // Maximum allowable junction entry speed in mm/sec
+        millimeters,                        // The total travel of this block in mm
+        acceleration;                       // acceleration mm/sec^2
+
+  uint32_t acceleration_steps_per_s2;       // acceleration steps/sec^2
+
+  #if ENABLED(PLANNER_FIXED_POINT)
+    uint32_t accel_distance_x2;             // 2 * acceleration * millimeters in 1/256 mm^2/sec^2
+  #endif
+
+  #if ENABLED(ADVANCE)
+    float advance;
+  #endif
+
+  #if ENABLED(ULTRA_LCD)
+    uint32_t segment_time;
+  #endif
+
+} block_plan_t;
+
 #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
 
+#if ENABLED(LASER_RASTER)
+  #define RASTER_POOL_NEXT(n) ((n) < (LASER_RASTER_POOL_SIZE) ? (n) + 1 : 0)
+#endif
+
 class Planner {
 
   public:
@@ -142,17 +178,35 @@ class Planner {
     static long position[NUM_AXIS];
 
     /**
-     * A ring buffer of moves described in steps
+     * A ring buffer of moves described in steps,
+     * with the planner data of each block alongside
      */
     static block_t block_buffer[BLOCK_BUFFER_SIZE];
-    static volatile uint8_t block_buffer_head,  // Index of the next block to be pushed
-                            block_buffer_tail;
+    static block_plan_t block_plan[BLOCK_BUFFER_SIZE];
+    static volatile uint8_t block_buffer_head,    // Index of the next block to be pushed
+                            block_buffer_tail,
+                            block_buffer_planned; // Index of the first block whose entry speed can still change
 
     /**
      * Limit where 64bit math is necessary for acceleration calculation
  	   */
     static uint32_t cutoff_long;
 
+    #if ENABLED(PLANNER_BENCHMARK)
+      static uint32_t bench_blocks,   // Blocks queued since the last reset
+                      bench_total_us, // Time spent planning them
+                      bench_max_us,   // Worst-case time for a single block
+                      bench_starved,  // Times the steppers ran dry with commands waiting
+                      bench_start_ms; // When the counters were reset
+      static volatile bool bench_drained; // The steppers emptied the buffer outside a synchronize
+      #if ENABLED(PLANNER_FIXED_POINT)
+        static uint32_t bench_check_us,   // Time spent checking against the float math, not counted
+                        bench_rate_error, // Worst difference from the float trapezoid (steps/s)
+                        bench_step_error; // Worst difference from the float trapezoid (steps)
+        static float bench_speed_error;   // Worst difference from the float max_allowable_speed (mm/s)
+      #endif
+    #endif
+
   private:
 
     /**
@@ -185,6 +239,16 @@ class Planner {
       volatile static uint32_t block_buffer_runtime_us; // Theoretical block buffer runtime in µs
     #endif
 
+    #if ENABLED(LASER_RASTER)
+      /**
+       * Raster lines of the queued blocks, only RASTER blocks take one.
+       * Lines are taken and given back in the same order as the blocks.
+       */
+      static unsigned char raster_pool[LASER_RASTER_POOL_SIZE + 1][LASER_MAX_RASTER_LINE];
+      static volatile uint8_t raster_pool_head,
+                              raster_pool_tail;
+    #endif
+
   public:
 
     /**
@@ -209,6 +273,11 @@ class Planner {
 
     static bool is_full() { return (block_buffer_tail == BLOCK_MOD(block_buffer_head + 1)); }
 
+    #if ENABLED(PLANNER_BENCHMARK)
+      static void bench_reset();
+      static void bench_report();
+    #endif
+
     /**
      * Planner::_buffer_line
      *
@@ -299,8 +368,16 @@ class Planner {
      * Called when the current block is no longer needed.
      */
     static void discard_current_block() {
-      if (blocks_queued())
+      if (blocks_queued()) {
+        // A block dropped without running (quick stop) takes the planned pointer along
+        if (block_buffer_tail == block_buffer_planned)
+          block_buffer_planned = next_block_index(block_buffer_planned);
+        #if ENABLED(LASER_RASTER)
+          if (block_buffer[block_buffer_tail].laser_raster_data)
+            raster_pool_tail = RASTER_POOL_NEXT(raster_pool_tail);
+        #endif
         block_buffer_tail = BLOCK_MOD(block_buffer_tail + 1);
+      }
     }
 
     /**
@@ -309,12 +386,18 @@ class Planner {
      */
     static block_t* get_current_block() {
       if (blocks_queued()) {
-        block_t* block = &block_buffer[block_buffer_tail];
+        block_plan_t* plan = &block_plan[block_buffer_tail];
+
         #if ENABLED(ULTRA_LCD)
-          block_buffer_runtime_us -= block->segment_time; // We can't be sure how long an active block will take, so don't count it.
+          block_buffer_runtime_us -= plan->segment_time; // We can't be sure how long an active block will take, so don't count it.
         #endif
-        SBI(block->flag, BLOCK_BIT_BUSY);
-        return block;
+        SBI(plan->flag, BLOCK_BIT_BUSY);
+
+        // A busy block can't be planned anymore
+        if (block_buffer_tail == block_buffer_planned)
+          block_buffer_planned = next_block_index(block_buffer_planned);
+
+        return &block_buffer[block_buffer_tail];
       }
       else {
         #if ENABLED(ULTRA_LCD)
@@ -347,6 +430,10 @@ class Planner {
 
     #endif
 
+    #if ENABLED(PID_FEEDFORWARD)
+      static float extrusion_rate(const uint8_t h, const float horizon);
+    #endif
+
     #if HAS_TEMP_HOTEND && ENABLED(AUTOTEMP)
       static float autotemp_max, autotemp_min, autotemp_factor;
       static bool autotemp_enabled;
@@ -389,14 +476,37 @@ class Planner {
      * to reach 'target_velocity' using 'acceleration' within a given
      * 'distance'.
      */
-    static float max_allowable_speed(const float &accel, const float &target_velocity, const float &distance) {
+    static float max_allowable_speed_float(const float &accel, const float &target_velocity, const float &distance) {
       return SQRT(sq(target_velocity) - 2 * accel * distance);
     }
 
-    static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
+    /**
+     * The maximum speed at the start of a block that can
+     * decelerate to 'target_velocity' at its end.
+     */
+    #if ENABLED(PLANNER_FIXED_POINT)
+      static float max_allowable_speed(const block_plan_t* const plan, const float &target_velocity);
+    #else
+      FORCE_INLINE static float max_allowable_speed(const block_plan_t* const plan, const float &target_velocity) {
+        return max_allowable_speed_float(-plan->acceleration, target_velocity, plan->millimeters);
+      }
+    #endif
+
+    /**
+     * Calculate the trapezoid of a block: the entry and exit rates
+     * and the steps spent accelerating and cruising.
+     */
+    static void trapezoid_float(const block_t* const block, const int32_t accel, const float &entry_factor, const float &exit_factor,
+                                uint32_t &initial_rate, uint32_t &final_rate, int32_t &accelerate_steps, int32_t &plateau_steps);
+    #if ENABLED(PLANNER_FIXED_POINT)
+      static void trapezoid_fixed(const block_t* const block, const uint32_t accel, const float &entry_speed, const float &exit_speed, const float &nominal_speed,
+                                  uint32_t &initial_rate, uint32_t &final_rate, int32_t &accelerate_steps, int32_t &plateau_steps);
+    #endif
+
+    static bool calculate_trapezoid_for_block(const uint8_t block_index, const float &entry_speed, const float &exit_speed);
 
-    static void reverse_pass_kernel(block_t* const current, const block_t *next);
-    static void forward_pass_kernel(const block_t *previous, block_t* const current);
+    static void reverse_pass_kernel(block_plan_t* const current, const block_plan_t *next);
+    static void forward_pass_kernel(const block_plan_t *previous, block_plan_t* const current, const uint8_t block_index);
 
     static void reverse_pass();
     static void forward_pass();
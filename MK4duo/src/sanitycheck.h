@@ -40,6 +40,18 @@
 #if DISABLED(BAUDRATE)
   #error DEPENDENCY ERROR: Missing setting BAUDRATE
 #endif
+
+// Serial transmit buffer
+#if ENABLED(SERIAL_TX_BUFFER)
+  #if DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_LINUX)
+    #error CONFLICT ERROR: SERIAL_TX_BUFFER requires an Arduino Due.
+  #elif ENABLED(ARDUINO_ARCH_SAM) && SERIAL_PORT == -1 && DISABLED(BLUETOOTH)
+    #error CONFLICT ERROR: SERIAL_TX_BUFFER does not work with the native USB port (SERIAL_PORT -1).
+  #elif SERIAL_TX_BUFFER < 2 || (SERIAL_TX_BUFFER & (SERIAL_TX_BUFFER - 1))
+    #error CONFLICT ERROR: SERIAL_TX_BUFFER must be a power of 2.
+  #endif
+#endif
+
 #if DISABLED(STRING_CONFIG_H_AUTHOR)
   #define STRING_CONFIG_H_AUTHOR "(none, default config)"
 #endif
@@ -239,7 +251,44 @@
     #error DEPENDENCY ERROR: Missing setting DEFAULT_Kd
   #endif
 #endif
+#if ENABLED(PID_FEEDFORWARD)
+  #if DISABLED(PIDTEMP)
+    #error DEPENDENCY ERROR: PID_FEEDFORWARD requires PIDTEMP
+  #endif
+  #if ENABLED(PID_ADD_EXTRUSION_RATE)
+    #error CONFLICT ERROR: PID_FEEDFORWARD and PID_ADD_EXTRUSION_RATE both add the extrusion power, enable only one
+  #endif
+  #if ENABLED(PID_OPENLOOP)
+    #error CONFLICT ERROR: PID_FEEDFORWARD is not compatible with PID_OPENLOOP
+  #endif
+  #if DISABLED(FEEDFORWARD_LOOKAHEAD)
+    #error DEPENDENCY ERROR: Missing setting FEEDFORWARD_LOOKAHEAD
+  #endif
+  #if DISABLED(FEEDFORWARD_I_RANGE)
+    #error DEPENDENCY ERROR: Missing setting FEEDFORWARD_I_RANGE
+  #endif
+  #if DISABLED(DEFAULT_HEATER_POWER) || DISABLED(DEFAULT_HEAT_CAPACITY) || DISABLED(DEFAULT_AMBIENT_LOSS) || DISABLED(DEFAULT_FAN_LOSS) || DISABLED(DEFAULT_FILAMENT_HEAT) || DISABLED(DEFAULT_AMBIENT_TEMP)
+    #error DEPENDENCY ERROR: Missing setting DEFAULT_HEATER_POWER, DEFAULT_HEAT_CAPACITY, DEFAULT_AMBIENT_LOSS, DEFAULT_FAN_LOSS, DEFAULT_FILAMENT_HEAT or DEFAULT_AMBIENT_TEMP
+  #endif
+#endif
+#if ENABLED(ADC_DMA)
+  #if DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_LINUX)
+    #error CONFLICT ERROR: ADC_DMA requires an Arduino Due.
+  #endif
+  #if DISABLED(ADC_TEMP_OVERSAMPLE) || DISABLED(ADC_TEMP_FILTER) || DISABLED(ADC_FAST_OVERSAMPLE) || DISABLED(ADC_FAST_FILTER)
+    #error DEPENDENCY ERROR: Missing setting ADC_TEMP_OVERSAMPLE, ADC_TEMP_FILTER, ADC_FAST_OVERSAMPLE or ADC_FAST_FILTER
+  #endif
+  #if ADC_TEMP_OVERSAMPLE < 0 || ADC_TEMP_OVERSAMPLE > 7 || ADC_FAST_OVERSAMPLE < 0 || ADC_FAST_OVERSAMPLE > 7
+    #error CONFLICT ERROR: ADC_TEMP_OVERSAMPLE and ADC_FAST_OVERSAMPLE must be from 0 to 7.
+  #endif
+  #if ADC_TEMP_FILTER < 1 || ADC_FAST_FILTER < 1
+    #error CONFLICT ERROR: ADC_TEMP_FILTER and ADC_FAST_FILTER must be at least 1.
+  #endif
+#endif
 #if ENABLED(PIDTEMPBED)
+  #if !HAS_TEMP_BED
+    #error DEPENDENCY ERROR: PIDTEMPBED requires a TEMP_SENSOR_BED
+  #endif
   #if DISABLED(DEFAULT_bedKp)
     #error DEPENDENCY ERROR: Missing setting DEFAULT_bedKp
   #endif
@@ -251,6 +300,9 @@
   #endif
 #endif
 #if ENABLED(PIDTEMPCHAMBER)
+  #if !HAS_TEMP_CHAMBER
+    #error DEPENDENCY ERROR: PIDTEMPCHAMBER requires a TEMP_SENSOR_CHAMBER
+  #endif
   #if DISABLED(DEFAULT_chamberKp)
     #error DEPENDENCY ERROR: Missing setting DEFAULT_chamberKp
   #endif
@@ -263,6 +315,9 @@
 
 #endif
 #if ENABLED(PIDTEMPCOOLER)
+  #if !HAS_TEMP_COOLER
+    #error DEPENDENCY ERROR: PIDTEMPCOOLER requires a TEMP_SENSOR_COOLER
+  #endif
   #if DISABLED(DEFAULT_coolerKp)
     #error DEPENDENCY ERROR: Missing setting DEFAULT_coolerKp
   #endif
@@ -914,6 +969,24 @@ static_assert(1 >= 0
   #if ENABLED(SD_SETTINGS) && DISABLED(SD_CFG_SECONDS)
     #error DEPENDENCY ERROR: Missing setting SD_CFG_SECONDS
   #endif
+  #if ENABLED(SD_READ_AHEAD) && (SD_READ_AHEAD < 1 || (SD_READ_AHEAD & (SD_READ_AHEAD - 1)))
+    #error CONFLICT ERROR: SD_READ_AHEAD must be a power of 2.
+  #endif
+  #if ENABLED(SD_SPI_DMA)
+    #if DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_LINUX)
+      #error CONFLICT ERROR: SD_SPI_DMA requires an Arduino Due.
+    #elif ENABLED(DUE_SOFTWARE_SPI)
+      #error CONFLICT ERROR: SD_SPI_DMA requires the SD card on the hardware SPI.
+    #elif ENABLED(HEATER_0_USES_MAX6675)
+      #error "CONFLICT ERROR: SD_SPI_DMA can't share the SPI with the MAX6675."
+    #elif MB(ALLIGATOR) || MB(ALLIGATOR_V3) || ENABLED(SPI_EEPROM)
+      #error "CONFLICT ERROR: SD_SPI_DMA can't share the SPI with the DAC and the EEPROM of the board."
+    #elif ENABLED(HAVE_TMCDRIVER) || ENABLED(HAVE_TMC2130) || ENABLED(HAVE_L6470DRIVER)
+      #error "CONFLICT ERROR: SD_SPI_DMA can't share the SPI with the SPI stepper drivers."
+    #elif HAS_DIGIPOTSS
+      #error "CONFLICT ERROR: SD_SPI_DMA can't share the SPI with the digipot."
+    #endif
+  #endif
 #endif
 #if ENABLED(SHOW_BOOTSCREEN)
   #if DISABLED(STRING_SPLASH_LINE1)
@@ -1246,6 +1319,10 @@ static_assert(1 >= 0
 #endif
 #if DISABLED(BUFSIZE)
   #error DEPENDENCY ERROR: Missing setting BUFSIZE
+#elif MAX_CMD_SIZE > 250
+  #error CONFLICT ERROR: MAX_CMD_SIZE must be 250 or less.
+#elif BUFSIZE * (MAX_CMD_SIZE + 2) > 32000
+  #error CONFLICT ERROR: BUFSIZE * (MAX_CMD_SIZE + 2) must be 32000 or less.
 #endif
 #if DISABLED(NUM_POSITON_SLOTS)
   #error DEPENDENCY ERROR: Missing setting NUM_POSITON_SLOTS
@@ -1432,6 +1509,18 @@ static_assert(1 >= 0
 #if DISABLED(DEFAULT_ZJERK)
   #error DEPENDENCY ERROR: Missing setting DEFAULT_ZJERK
 #endif
+#if ENABLED(JUNCTION_DEVIATION) && DISABLED(JUNCTION_DEVIATION_MM)
+  #error DEPENDENCY ERROR: Missing setting JUNCTION_DEVIATION_MM
+#endif
+#if ENABLED(JUNCTION_DEVIATION) && IS_KINEMATIC
+  #error "CONFLICT ERROR: JUNCTION_DEVIATION can't be used on DELTA or SCARA, the planner only knows the moves of the towers."
+#endif
+#if ENABLED(S_CURVE_ACCELERATION) && ENABLED(ARDUINO_ARCH_AVR)
+  #error CONFLICT ERROR: S_CURVE_ACCELERATION requires a 32 bit processor.
+#endif
+#if MECH(DELTA) && ENABLED(DELTA_CHORD_SEGMENTATION) && DISABLED(DELTA_CHORD_ERROR)
+  #error DEPENDENCY ERROR: Missing setting DELTA_CHORD_ERROR
+#endif
 #if DISABLED(X_HOME_BUMP_MM)
   #error DEPENDENCY ERROR: Missing setting X_HOME_BUMP_MM
 #endif
@@ -1590,6 +1679,61 @@ static_assert(1 >= 0
   #error DEPENDENCY ERROR: You have to set a valid MECHANICS.
 #endif
 
+/**
+ * Step batching of the 32 bit processors
+ */
+#if ENABLED(ARDUINO_ARCH_SAM) || ENABLED(ARDUINO_ARCH_LINUX)
+  #if MAX_STEP_LOOPS != 1 && MAX_STEP_LOOPS != 2 && MAX_STEP_LOOPS != 4 && MAX_STEP_LOOPS != 8
+    #error CONFLICT ERROR: MAX_STEP_LOOPS must be 1, 2, 4 or 8.
+  #endif
+  #if !WITHIN(STEPPER_ISR_MAX_LOAD, 10, 90)
+    #error CONFLICT ERROR: STEPPER_ISR_MAX_LOAD must be between 10 and 90.
+  #endif
+#endif
+
+/**
+ * ISR statistics
+ */
+#if ENABLED(ISR_STATISTICS)
+  #if DISABLED(ISR_STATISTICS_BUFFER)
+    #error DEPENDENCY ERROR: Missing setting ISR_STATISTICS_BUFFER
+  #elif !WITHIN(ISR_STATISTICS_BUFFER, 2, 128) || (ISR_STATISTICS_BUFFER & (ISR_STATISTICS_BUFFER - 1))
+    #error CONFLICT ERROR: ISR_STATISTICS_BUFFER must be a power of 2 between 2 and 128.
+  #endif
+#endif
+
+/**
+ * Preparsed command queue
+ */
+#if ENABLED(PREPARSED_COMMAND_QUEUE) && DISABLED(FASTER_GCODE_PARSER)
+  #error DEPENDENCY ERROR: PREPARSED_COMMAND_QUEUE requires FASTER_GCODE_PARSER.
+#endif
+
+/**
+ * Binary motion protocol
+ */
+#if ENABLED(BINARY_PROTOCOL) && DISABLED(FASTER_GCODE_PARSER)
+  #error DEPENDENCY ERROR: BINARY_PROTOCOL requires FASTER_GCODE_PARSER.
+#endif
+
+/**
+ * Host-native Linux build
+ */
+#if ENABLED(ARDUINO_ARCH_LINUX)
+  #if ENABLED(ULTRA_LCD) || ENABLED(NEXTION)
+    #error CONFLICT ERROR: The Linux HAL has no LCD. Please disable the LCD controller.
+  #endif
+  #if ENABLED(LASER)
+    #error CONFLICT ERROR: The Linux HAL does not support LASER.
+  #endif
+  #if HAS_SERVOS
+    #error CONFLICT ERROR: The Linux HAL does not support servos. Please disable ENABLE_SERVOS.
+  #endif
+  #if ENABLED(PINS_DEBUGGING)
+    #error CONFLICT ERROR: The Linux HAL does not support PINS_DEBUGGING.
+  #endif
+#endif
+
 /**
  * Two or plus Z Stepper
  */
@@ -1750,6 +1894,29 @@ static_assert(1 >= 0
   #if ENABLED(EEPROM_SETTINGS) && ENABLED(EEPROM_SD)
     #error DEPENDENCY ERROR: You have to enable SDSUPPORT to use EEPROM_SETTINGS
   #endif
+  #if ENABLED(SD_READ_AHEAD)
+    #error DEPENDENCY ERROR: You have to enable SDSUPPORT to use SD_READ_AHEAD
+  #endif
+  #if ENABLED(SD_SPI_DMA)
+    #error DEPENDENCY ERROR: You have to enable SDSUPPORT to use SD_SPI_DMA
+  #endif
+  #if ENABLED(SD_FILE_INFO_CACHE)
+    #error DEPENDENCY ERROR: You have to enable SDSUPPORT to use SD_FILE_INFO_CACHE
+  #endif
+  #if ENABLED(SD_LAYER_INDEX)
+    #error DEPENDENCY ERROR: You have to enable SDSUPPORT to use SD_LAYER_INDEX
+  #endif
+  #if ENABLED(SD_DIR_CACHE)
+    #error DEPENDENCY ERROR: You have to enable SDSUPPORT to use SD_DIR_CACHE
+  #endif
+#endif
+
+#if ENABLED(SD_DIR_CACHE_SORT) && DISABLED(SD_DIR_CACHE)
+  #error DEPENDENCY ERROR: You have to enable SD_DIR_CACHE to use SD_DIR_CACHE_SORT
+#endif
+
+#if ENABLED(SD_FILE_INFO_CACHE) && DISABLED(JSON_OUTPUT)
+  #error DEPENDENCY ERROR: You have to enable JSON_OUTPUT to use SD_FILE_INFO_CACHE
 #endif
 
 #if MECH(COREXZ) && ENABLED(Z_LATE_ENABLE)
@@ -1990,6 +2157,13 @@ static_assert(1 >= 0
       #endif
     #endif
   #endif
+  #if ENABLED(LASER_RASTER)
+    #if DISABLED(LASER_RASTER_POOL_SIZE)
+      #error DEPENDENCY ERROR: Missing setting LASER_RASTER_POOL_SIZE
+    #elif LASER_RASTER_POOL_SIZE < 1 || LASER_RASTER_POOL_SIZE > BLOCK_BUFFER_SIZE
+      #error DEPENDENCY ERROR: LASER_RASTER_POOL_SIZE must be between 1 and BLOCK_BUFFER_SIZE
+    #endif
+  #endif
 #endif
 
 #if ENABLED(FILAMENT_RUNOUT_SENSOR) && !PIN_EXISTS(FIL_RUNOUT)
@@ -1077,7 +1077,7 @@ bool SdBaseFile::open(const char* path, uint8_t oflag) {
   }
 
   // Traverse the Long Directory Name Path until we get to the LEAF (long file name)
-  while ((p = strchr(path, '/')) != NULL) {
+  while ((p = (char*)strchr(path, '/')) != NULL) {
     int8_t cb = p-path;
 
     memcpy(dname, path, cb);
@@ -1916,6 +1916,65 @@ int SdBaseFile::read(void* buf, size_t nbyte) {
 fail:
   return -1;
 }
+#if ENABLED(SD_SPI_DMA)
+//------------------------------------------------------------------------------
+/** Start the read of the whole block at the current position of the file.
+ * The data is moved by DMA, the position is advanced at once and the read
+ * is finished by Sd2Card::readBlockPoll() or by the next access to the card.
+ *
+ * \param[out] buf Pointer to the location that will receive the 512 bytes,
+ * it must be kept until the read is over.
+ *
+ * \return The value one, true, is returned for success and
+ * the value zero, false, is returned if the position is not at the start
+ * of a whole block of the file or if an error occurred.
+ */
+bool SdBaseFile::readBlockStart(void* buf) {
+  uint8_t blockOfCluster;
+  uint32_t block;  // raw device block number
+  cache_t* pc;
+
+  if (!isOpen() || !(flags_ & O_READ) || (curPosition_ & 0X1FF) || fileSize_ - curPosition_ < 512) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  blockOfCluster = vol_->blockOfCluster(curPosition_);
+  if (type_ == FAT_FILE_TYPE_ROOT_FIXED) {
+    block = vol_->rootDirStart() + (curPosition_ >> 9);
+  }
+  else {
+    if (blockOfCluster == 0) {
+      // start of new cluster
+      if (curPosition_ == 0) {
+        curCluster_ = firstCluster_;
+      }
+      else if (!vol_->fatGet(curCluster_, &curCluster_)) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+    }
+    block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
+  }
+  if (block == vol_->cacheBlockNumber()) {
+    // the cache may be newer than the card
+    pc = vol_->cacheFetch(block, SdVolume::CACHE_FOR_READ);
+    if (!pc) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    memcpy(buf, pc->data, 512);
+  }
+  else if (!vol_->sdCard()->readBlockStart(block, reinterpret_cast<uint8_t*>(buf))) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  curPosition_ += 512;
+  return true;
+
+fail:
+  return false;
+}
+#endif  // SD_SPI_DMA
 
 
 //------------------------------------------------------------------------------
@@ -2962,9 +3021,11 @@ static inline __attribute__((always_inline))
   void spiSendBlock(uint8_t token, const uint8_t* buf) {
     HAL::spiSendBlock(token, buf);
 }
-static void spiSend(const uint8_t* buf, size_t n) {
-  HAL::spiSend(buf, n);
-}
+#if DISABLED(SD_SPI_DMA)
+  static void spiSend(const uint8_t* buf, size_t n) {
+    HAL::spiSend(buf, n);
+  }
+#endif
 
 //------------------------------------------------------------------------------
 #else  // SOFTWARE_SPI
@@ -3148,6 +3209,11 @@ void Sd2Card::chipSelectHigh() {
 }
 //------------------------------------------------------------------------------
 void Sd2Card::chipSelectLow() {
+  #if ENABLED(SD_SPI_DMA)
+    // finish the block read in progress before a new access,
+    // the result is kept for readBlockPoll()
+    while (readBlockBusy()) readBlockPoll();
+  #endif
   #ifndef SOFTWARE_SPI
     spiInit(spiRate_);
   #endif  // SOFTWARE_SPI
@@ -3342,6 +3408,101 @@ bool Sd2Card::readBlock(uint32_t blockNumber, uint8_t* dst) {
   chipSelectHigh();
   return false;
 }
+#if ENABLED(SD_SPI_DMA)
+//------------------------------------------------------------------------------
+/**
+ * Start the read of a 512 byte block, the data is moved by DMA while
+ * the caller goes on. The read is advanced by readBlockPoll() and is
+ * finished before any other access to the card.
+ *
+ * \param[in] blockNumber Logical block to be read.
+ * \param[out] dst Pointer to the location that will receive the data,
+ * it must be kept until the read is over.
+ * \return The value one, true, is returned for success and
+ * the value zero, false, is returned for failure.
+ */
+bool Sd2Card::readBlockStart(uint32_t blockNumber, uint8_t* dst) {
+  SD_TRACE("RA", blockNumber);
+  // use address if not SDHC card
+  if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;
+  if (cardCommand(CMD17, blockNumber)) {
+    error(SD_CARD_ERROR_CMD17);
+    chipSelectHigh();
+    return false;
+  }
+  // chip select stays low up to the end of the read
+  asyncDst_ = dst;
+  asyncT0_ = HAL::timeInMilliseconds();
+  asyncState_ = SD_ASYNC_TOKEN;
+  return true;
+}
+//------------------------------------------------------------------------------
+/**
+ * Advance the block read started by readBlockStart(), without waiting.
+ *
+ * \return 1 when the block is read, 0 while the read is in progress
+ * and -1 if an error occurred, also when the read was finished by
+ * another access to the card.
+ */
+int8_t Sd2Card::readBlockPoll() {
+  uint16_t crc;
+  switch (asyncState_) {
+    case SD_ASYNC_IDLE:
+      return 1;
+    case SD_ASYNC_FAILED:
+      // failed while finished by another access to the card
+      asyncState_ = SD_ASYNC_IDLE;
+      return -1;
+    case SD_ASYNC_TOKEN:
+      // one poll of the start block token
+      if ((status_ = spiRec()) == 0XFF) {
+        if (((uint16_t)HAL::timeInMilliseconds() - asyncT0_) > SD_READ_TIMEOUT) {
+          error(SD_CARD_ERROR_READ_TIMEOUT);
+          goto fail;
+        }
+        return 0;
+      }
+      if (status_ != DATA_START_BLOCK) {
+        error(SD_CARD_ERROR_READ);
+        goto fail;
+      }
+      HAL::spiDmaReadStart(asyncDst_, 512);
+      asyncState_ = SD_ASYNC_DATA;
+      return 0;
+    default:  // SD_ASYNC_DATA
+      if (!HAL::spiDmaDone()) return 0;
+      crc = (spiRec() << 8) | spiRec();
+      #if ENABLED(SD_CHECK_AND_RETRY)
+        if (crc != CRC_CCITT(asyncDst_, 512)) {
+          error(SD_CARD_ERROR_READ_CRC);
+          goto fail;
+        }
+      #else
+        UNUSED(crc);
+      #endif
+      asyncState_ = SD_ASYNC_IDLE;
+      chipSelectHigh();
+      return 1;
+  }
+
+fail:
+  asyncState_ = SD_ASYNC_FAILED;
+  chipSelectHigh();
+  return -1;
+}
+//------------------------------------------------------------------------------
+/** Wait for the end of the block read started by readBlockStart().
+ *
+ * \return The value one, true, is returned for success and
+ * the value zero, false, is returned for failure.
+ */
+bool Sd2Card::readBlockWait() {
+  int8_t done;
+  while (!(done = readBlockPoll())) {}
+  asyncState_ = SD_ASYNC_IDLE;
+  return done > 0;
+}
+#endif  // SD_SPI_DMA
 //------------------------------------------------------------------------------
 /** Read one data block in a multiple block read sequence
  *
@@ -3549,8 +3710,12 @@ bool Sd2Card::writeData(uint8_t token, const uint8_t* src) {
     uint16_t crc = 0XFFFF;
   #endif  // SD_CHECK_AND_RETRY
 
-  spiSend(token);
-  spiSend(src, 512);
+  #if ENABLED(SD_SPI_DMA)
+    spiSendBlock(token, src);
+  #else
+    spiSend(token);
+    spiSend(src, 512);
+  #endif
   spiSend(crc >> 8);
   spiSend(crc & 0XFF);
 
@@ -572,6 +572,16 @@ uint8_t const SD_CARD_TYPE_SD1  = 1;
 uint8_t const SD_CARD_TYPE_SD2  = 2;
 /** High Capacity SD card */
 uint8_t const SD_CARD_TYPE_SDHC = 3;
+//------------------------------------------------------------------------------
+// states of a block read with DMA
+/** No block read pending */
+uint8_t const SD_ASYNC_IDLE  = 0;
+/** Waiting for the start block token */
+uint8_t const SD_ASYNC_TOKEN = 1;
+/** Data moved by DMA */
+uint8_t const SD_ASYNC_DATA  = 2;
+/** Read failed, not yet reported by readBlockPoll() */
+uint8_t const SD_ASYNC_FAILED = 3;
 /**
  * define SOFTWARE_SPI to use bit-bang SPI
  */
@@ -602,7 +612,11 @@ uint8_t const SD_CHIP_SELECT_PIN = SOFT_SPI_CS_PIN;
 class Sd2Card {
  public:
   /** Construct an instance of Sd2Card. */
-  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0) {}
+  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0)
+    #if ENABLED(SD_SPI_DMA)
+      , asyncState_(SD_ASYNC_IDLE)
+    #endif
+  {}
   uint32_t cardSize();
   bool erase(uint32_t firstBlock, uint32_t lastBlock);
   bool eraseSingleBlockEnable();
@@ -649,6 +663,15 @@ class Sd2Card {
   bool readCSD(csd_t* csd) {
     return readRegister(CMD9, csd);
   }
+  #if ENABLED(SD_SPI_DMA)
+    bool readBlockStart(uint32_t blockNumber, uint8_t* dst);
+    int8_t readBlockPoll();
+    bool readBlockWait();
+    /** \return true while a read started by readBlockStart() is pending. */
+    bool readBlockBusy() const {
+      return asyncState_ == SD_ASYNC_TOKEN || asyncState_ == SD_ASYNC_DATA;
+    }
+  #endif
   bool readData(uint8_t *dst);
   bool readStart(uint32_t blockNumber);
   bool readStop();
@@ -669,6 +692,11 @@ class Sd2Card {
   uint8_t spiRate_;
   uint8_t status_;
   uint8_t type_;
+  #if ENABLED(SD_SPI_DMA)
+    uint8_t asyncState_;
+    uint8_t* asyncDst_;
+    uint16_t asyncT0_;
+  #endif
   // private functions
   uint8_t cardAcmd(uint8_t cmd, uint32_t arg) {
     cardCommand(CMD55, 0);
@@ -1776,6 +1804,9 @@ class SdBaseFile {
   bool printName();
   int16_t read();
   int read(void* buf, size_t nbyte);
+  #if ENABLED(SD_SPI_DMA)
+    bool readBlockStart(void* buf);
+  #endif
   int8_t readDir(dir_t* dir, char *longfilename);
 
   static bool remove(SdBaseFile* dirFile, const char* path);
@@ -2044,7 +2075,7 @@ class SdFile : public SdBaseFile {
       void write(uint8_t b);
     #endif
 
-    int16_t write(const void* buf, uint16_t nbyte);
+    int write(const void* buf, size_t nbyte);
     void write(const char* str);
   #endif
 
@@ -32,8 +32,15 @@ CardReader::CardReader() {
   sdprinting = cardOK = saving = false;
   fileSize = 0;
   sdpos = 0;
+  #if ENABLED(SD_READ_AHEAD)
+    #if ENABLED(SD_SPI_DMA)
+      read_ahead_pending = false;
+    #endif
+    read_ahead_reset();
+  #endif
   workDirDepth = 0;
   ZERO(workDirParents);
+  DIR_CACHE_RESET();
 
   autostart_stilltocheck = true; // the SD start is delayed, because otherwise the serial cannot answer fast enough to make contact with the host software.
 
@@ -60,13 +67,21 @@ char* CardReader::createFilename(char* buffer, const dir_t& p) { // buffer > 12c
  * Dive into a folder and recurse depth-first to perform a pre-set operation lsAction:
  *   LS_Count       - Add +1 to nrFiles for every file within the parent
  *   LS_GetFilename - Get the filename of the file indexed by nrFiles
+ *   LS_Cache       - Add every file to the directory cache
  */
 void CardReader::lsDive(SdBaseFile parent, const char* const match/*=NULL*/) {
   dir_t* p;
   uint8_t cnt = 0;
+  #if ENABLED(SD_DIR_CACHE)
+    uint16_t next_index = parent.curPosition() >> 5;
+  #endif
   
   // Read the next entry from a directory
   while ((p = parent.getLongFilename(p, fileName, 0, NULL)) != NULL) {
+    #if ENABLED(SD_DIR_CACHE)
+      const uint16_t index = next_index;  // First entry of this file
+      next_index = parent.curPosition() >> 5;
+    #endif
     char pn0 = p->name[0];
     if (pn0 == DIR_NAME_FREE) break;
     if (pn0 == DIR_NAME_DELETED || pn0 == '.') continue;
@@ -88,6 +103,11 @@ void CardReader::lsDive(SdBaseFile parent, const char* const match/*=NULL*/) {
         else if (cnt == nrFiles) return;
         cnt++;
         break;
+      case LS_Cache:
+        #if ENABLED(SD_DIR_CACHE)
+          dir_cache_add(index);
+        #endif
+        break;
     }
 
   } // while readDir
@@ -97,12 +117,16 @@ void CardReader::ls()  {
   root.openRoot(fat.vol());
   root.ls(0, 0);
   workDir = root;
+  DIR_CACHE_RESET();
   curDir = &root;
 }
 
 void CardReader::initsd() {
   cardOK = false;
   if (root.isOpen()) root.close();
+  #if ENABLED(SD_LAYER_INDEX)
+    layer_close();
+  #endif
 
   #if ENABLED(SDEXTRASLOW)
     #define SPI_SPEED SPI_QUARTER_SPEED
@@ -126,6 +150,7 @@ void CardReader::initsd() {
   fat.chdir(true);
   root = *fat.vwd();
   workDir = root;
+  DIR_CACHE_RESET();
   curDir = &root;
 }
 
@@ -158,17 +183,16 @@ void CardReader::stopSDPrint(const bool store_location /*=false*/) {
 void CardReader::write_command(char* buf) {
   char* begin = buf;
   char* npos = 0;
-  char* end = buf + strlen(buf) - 1;
+  char* end = buf + strlen(buf);
 
   file.writeError = false;
-  if ((npos = strchr(buf, 'N')) != NULL) {
+  if ((npos = strchr(buf, 'N')) != NULL && strchr(npos, '*') != NULL) {
     begin = strchr(npos, ' ') + 1;
-    end = strchr(npos, '*') - 1;
+    end = strchr(npos, '*');
   }
-  end[1] = '\r';
-  end[2] = '\n';
-  end[3] = '\0';
-  file.write(begin);
+  // The next command follows in the queue, don't terminate the line in place
+  file.write(begin, end - begin);
+  file.write("\r\n");
   if (file.writeError) {
     SERIAL_LM(ER, MSG_SD_ERR_WRITE_TO_FILE);
   }
@@ -187,6 +211,119 @@ bool CardReader::write_data(const uint8_t value) {
 uint8_t CardReader::read_data() {
   return (char)get();
 }
+
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * The data from sdpos to read_ahead_pos is kept in the buffer at the
+   * file position modulo the buffer size, so a block of the file is
+   * always contiguous in the buffer and is read with a single transfer.
+   */
+  void CardReader::read_ahead_reset() {
+    #if ENABLED(SD_SPI_DMA)
+      // Drop the block on the way
+      if (read_ahead_pending) {
+        fat.card()->readBlockWait();
+        read_ahead_pending = false;
+      }
+    #endif
+    read_ahead_pos = sdpos;
+    read_ahead_index = sdpos & (SD_READ_AHEAD_SIZE - 1);
+  }
+
+  /**
+   * Read up to the end of the next block of the file, if it fits.
+   * Return false at the end of the file, when the buffer is full
+   * or on a read error.
+   *
+   * With SD_SPI_DMA a whole block is requested and moved by DMA, it
+   * is waited for only with wait, otherwise every call advances the
+   * read and it returns true when the block is in the buffer.
+   */
+  bool CardReader::read_ahead_block(const bool wait/*=true*/) {
+    #if ENABLED(SD_SPI_DMA)
+      if (read_ahead_pending) {
+        const int8_t done = wait ? (fat.card()->readBlockWait() ? 1 : -1) : fat.card()->readBlockPoll();
+        if (!done) return false;
+        read_ahead_pending = false;
+        // On an error the block is read again from read_ahead_pos
+        if (done < 0) return false;
+        read_ahead_pos += 512;
+        return true;
+      }
+    #endif
+    if (read_ahead_pos >= fileSize) return false;
+    const uint16_t count = min(512 - (read_ahead_pos & 511), fileSize - read_ahead_pos);
+    if (read_ahead_pos + count - sdpos > SD_READ_AHEAD_SIZE) return false;
+    // get() may have moved the file
+    if (file.curPosition() != read_ahead_pos && !file.seekSet(read_ahead_pos)) return false;
+    uint8_t* const dst = &read_ahead_buffer[read_ahead_pos & (SD_READ_AHEAD_SIZE - 1)];
+    #if ENABLED(SD_SPI_DMA)
+      if (count == 512 && file.readBlockStart(dst)) {
+        read_ahead_pending = true;
+        return wait && read_ahead_block(true);
+      }
+    #endif
+    if (file.read(dst, count) != count) return false;
+    read_ahead_pos += count;
+    return true;
+  }
+
+  /**
+   * Called from idle(), read one block while the buffer has room.
+   * With SD_SPI_DMA start or advance the read of a block.
+   */
+  void CardReader::read_ahead() {
+    if (sdprinting) read_ahead_block(false);
+  }
+
+  inline int16_t CardReader::next_char() {
+    if (sdpos == read_ahead_pos && !read_ahead_block()) return -1;
+    const uint8_t c = read_ahead_buffer[read_ahead_index];
+    read_ahead_index = (read_ahead_index + 1) & (SD_READ_AHEAD_SIZE - 1);
+    sdpos++;
+    return c;
+  }
+
+#else
+
+  inline int16_t CardReader::next_char() {
+    const int16_t c = file.read();
+    if (c >= 0) sdpos++;
+    return c;
+  }
+
+#endif
+
+/**
+ * Read the next line of the file printed, without its comment.
+ * The line ends at '\n', '\r', at the end of the file or at a '#' or ':'
+ * out of a comment. The char that ended it is returned in term, '\0' at
+ * the end of the file and -1 on a read error. The chars beyond size - 1
+ * are dropped. Return the length of the line.
+ */
+uint16_t CardReader::get_line(char* buf, const uint16_t size, int16_t &term) {
+  uint16_t count = 0;
+  bool comment = false;
+
+  term = '\0';
+  while (sdpos < fileSize) {
+    const int16_t n = next_char();
+    if (n < 0) {
+      term = -1;
+      break;
+    }
+    const char c = (char)n;
+    if (c == '\n' || c == '\r' || ((c == '#' || c == ':') && !comment)) {
+      term = c;
+      break;
+    }
+    if (c == ';') comment = true;
+    if (!comment && count < size - 1) buf[count++] = c;
+  }
+  buf[count] = '\0';
+  return count;
+}
     
 bool CardReader::selectFile(const char* filename, const bool silent/*=false*/) {
   const char *oldP = filename;
@@ -203,6 +340,9 @@ bool CardReader::selectFile(const char* filename, const bool silent/*=false*/) {
 
     fileSize = file.fileSize();
     sdpos = 0;
+    #if ENABLED(SD_READ_AHEAD)
+      read_ahead_reset();
+    #endif
 
     if (!silent) {
       SERIAL_MT(MSG_SD_FILE_OPENED, oldP);
@@ -218,6 +358,10 @@ bool CardReader::selectFile(const char* filename, const bool silent/*=false*/) {
       parsejson(file);
     #endif
 
+    #if ENABLED(SD_LAYER_INDEX)
+      layer_open();
+    #endif
+
     return true;
   }
   else {
@@ -230,6 +374,14 @@ void CardReader::printStatus() {
   if (cardOK) {
     SERIAL_MV(MSG_SD_PRINTING_BYTE, sdpos);
     SERIAL_EMV(MSG_SD_SLASH, fileSize);
+    #if ENABLED(SD_LAYER_INDEX)
+      if (layer_ready) {
+        SERIAL_MV(MSG_SD_LAYER, layer_current);
+        SERIAL_MV(MSG_SD_SLASH, layer_count);
+        SERIAL_MV(MSG_SD_LAYER_Z, layer_now.z, 3);
+        SERIAL_EMV(MSG_SD_TIME_LEFT, (layer_total_time - layer_time()) / 1000UL);
+      }
+    #endif
   }
   else
     SERIAL_EM(MSG_SD_NOT_PRINTING);
@@ -238,6 +390,7 @@ void CardReader::printStatus() {
 void CardReader::startWrite(char *filename, const bool silent/*=false*/) {
   if (!cardOK) return;
   file.close();
+  DIR_CACHE_RESET();
 
   if(!file.open(curDir, filename, O_CREAT | O_APPEND | O_WRITE | O_TRUNC)) {
     SERIAL_LMT(ER, MSG_SD_OPEN_FILE_FAIL, filename);
@@ -255,6 +408,7 @@ void CardReader::deleteFile(char *filename) {
   if (!cardOK) return;
   sdprinting = false;
   file.close();
+  DIR_CACHE_RESET();
   if(fat.remove(filename)) {
     SERIAL_EMT(MSG_SD_FILE_DELETED, filename);
   }
@@ -278,6 +432,7 @@ void CardReader::makeDirectory(char *filename) {
   if (!cardOK) return;
   sdprinting = false;
   file.close();
+  DIR_CACHE_RESET();
   if (fat.mkdir(filename)) {
     SERIAL_EM(MSG_SD_DIRECTORY_CREATED);
   }
@@ -291,6 +446,25 @@ void CardReader::makeDirectory(char *filename) {
  */
 void CardReader::getfilename(uint16_t nr, const char* const match/*=NULL*/) {
   curDir = &workDir;
+  #if ENABLED(SD_DIR_CACHE)
+    if (dir_cache_state == DIR_CACHE_EMPTY) dir_cache_build();
+    if (dir_cache_state == DIR_CACHE_READY) {
+      if (match != NULL) {
+        const uint16_t hash = dir_cache_hash(match);
+        for (uint16_t i = 0; i < dir_cache_count; i++) {
+          if (dir_cache[i].hash != hash) continue;
+          dir_cache_get(i);
+          if (strcasecmp(match, fileName) == 0) return;
+        }
+        fileName[0] = '\0';
+      }
+      else if (nr < dir_cache_count)
+        dir_cache_get(nr);
+      else
+        fileName[0] = '\0';
+      return;
+    }
+  #endif
   lsAction = LS_GetFilename;
   nrFiles = nr;
   curDir->rewind();
@@ -299,6 +473,10 @@ void CardReader::getfilename(uint16_t nr, const char* const match/*=NULL*/) {
 
 uint16_t CardReader::getnrfilenames() {
   curDir = &workDir;
+  #if ENABLED(SD_DIR_CACHE)
+    if (dir_cache_state == DIR_CACHE_EMPTY) dir_cache_build();
+    if (dir_cache_state == DIR_CACHE_READY) return dir_cache_count;
+  #endif
   lsAction = LS_Count;
   nrFiles = 0;
   curDir->rewind();
@@ -306,6 +484,66 @@ uint16_t CardReader::getnrfilenames() {
   return nrFiles;
 }
 
+#if ENABLED(SD_DIR_CACHE)
+
+  /**
+   * Read the working directory once into the cache. getnrfilenames() and
+   * getfilename() then don't walk the directory again until the working
+   * directory changes or a file is written, with more than SD_DIR_CACHE
+   * files they walk it as before.
+   */
+  void CardReader::dir_cache_build() {
+    dir_cache_count = 0;
+    dir_cache_state = DIR_CACHE_READY;
+    lsAction = LS_Cache;
+    workDir.rewind();
+    lsDive(workDir);
+  }
+
+  void CardReader::dir_cache_add(const uint16_t index) {
+    if (dir_cache_state != DIR_CACHE_READY) return;
+    if (dir_cache_count >= SD_DIR_CACHE) {
+      dir_cache_state = DIR_CACHE_OVERFLOW;
+      return;
+    }
+
+    dir_cache_t entry;
+    entry.index = index;
+    entry.hash = dir_cache_hash(fileName);
+    entry.isDir = filenameIsDir;
+
+    uint16_t i = dir_cache_count++;
+    #if ENABLED(SD_DIR_CACHE_SORT)
+      // Folders first, then by name, in the directory order if equal
+      strncpy(entry.name, fileName, SD_DIR_CACHE_SORT);
+      entry.name[SD_DIR_CACHE_SORT] = '\0';
+      for (; i > 0; i--) {
+        const dir_cache_t &prev = dir_cache[i - 1];
+        if (prev.isDir != entry.isDir ? prev.isDir : strncasecmp(prev.name, entry.name, SD_DIR_CACHE_SORT) <= 0) break;
+        dir_cache[i] = prev;
+      }
+    #endif
+    dir_cache[i] = entry;
+  }
+
+  /**
+   * Read the name of a file of the cache from its directory entries
+   */
+  void CardReader::dir_cache_get(const uint16_t nr) {
+    dir_t* p = NULL;
+    filenameIsDir = dir_cache[nr].isDir;
+    if (!workDir.seekSet((uint32_t)dir_cache[nr].index << 5) || !(p = workDir.getLongFilename(p, fileName, 0, NULL)))
+      fileName[0] = '\0';
+  }
+
+  uint16_t CardReader::dir_cache_hash(const char* name) {
+    uint16_t hash = 0;
+    while (*name) hash = hash * 31 + tolower(*name++);
+    return hash;
+  }
+
+#endif // SD_DIR_CACHE
+
 void CardReader::chdir(const char* relpath) {
   SdBaseFile newfile;
   SdBaseFile* parent = &root;
@@ -320,6 +558,7 @@ void CardReader::chdir(const char* relpath) {
       workDirParents[0] = *parent;
     }
     workDir = newfile;
+    DIR_CACHE_RESET();
   }
 }
 
@@ -327,6 +566,7 @@ void CardReader::updir() {
   if (workDirDepth > 0) {
     --workDirDepth;
     workDir = workDirParents[0];
+    DIR_CACHE_RESET();
     for (uint16_t d = 0; d < workDirDepth; d++)
       workDirParents[d] = workDirParents[d + 1];
   }
@@ -469,6 +709,9 @@ void CardReader::checkautostart(bool force) {
 
   autostart_stilltocheck = false;
 
+  // Don't close a file the host started to print before the check
+  if (sdprinting) return;
+
   if (!cardOK) {
     initsd();
     if (!cardOK) return; // fail
@@ -492,11 +735,13 @@ void CardReader::printingHasFinished() {
 void CardReader::setroot(bool temporary /*=false*/) {
   if (temporary) lastDir = workDir;
   workDir = root;
+  DIR_CACHE_RESET();
   curDir = &workDir;
 }
 
 void CardReader::setlast() {
   workDir = lastDir;
+  DIR_CACHE_RESET();
   curDir = &workDir;
 }
 
@@ -514,9 +759,30 @@ void CardReader::parsejson(SdBaseFile &file) {
   objectHeight      = 0.0;
   firstlayerHeight  = 0.0;
   layerHeight       = 0.0;
+  generatedBy[0]    = '\0';
 
   if (!file.isOpen()) return;
 
+  #if ENABLED(SD_FILE_INFO_CACHE)
+    SdBaseFile index;
+    file_info_t info;
+    uint32_t info_pos = 0;
+
+    memset(&info, 0, sizeof(info));
+    const bool indexed = file_key(file, info.key) && file_info_open(index);
+    if (indexed) {
+      if (file_info_find(index, info, info_pos)) {
+        objectHeight      = info.objectHeight;
+        firstlayerHeight  = info.firstlayerHeight;
+        layerHeight       = info.layerHeight;
+        filamentNeeded    = info.filamentNeeded;
+        memcpy(generatedBy, info.generatedBy, GENBY_SIZE);
+        index.close();
+        return;
+      }
+    }
+  #endif
+
   bool genByFound = false, firstlayerHeightFound = false, layerHeightFound = false, filamentNeedFound = false;
 
   #if CPU_ARCH==ARCH_AVR
@@ -556,8 +822,420 @@ void CardReader::parsejson(SdBaseFile &file) {
     if (findTotalHeight(buf, objectHeight)) break;
   }
   file.seekSet(0);
+
+  #if ENABLED(SD_FILE_INFO_CACHE)
+    if (indexed) {
+      info.objectHeight     = objectHeight;
+      info.firstlayerHeight = firstlayerHeight;
+      info.layerHeight      = layerHeight;
+      info.filamentNeeded   = filamentNeeded;
+      memcpy(info.generatedBy, generatedBy, GENBY_SIZE);
+      if (index.seekSet(info_pos)) index.write(&info, sizeof(info));
+      index.close();
+    }
+  #endif
 }
 
+#if ENABLED(SD_FILE_INFO_CACHE) || ENABLED(SD_LAYER_INDEX)
+
+  /**
+   * The fields of the directory entry of a file that tell if it changed
+   */
+  bool CardReader::file_key(SdBaseFile &file, sd_file_key_t &key) {
+    dir_t entry;
+
+    memset(&key, 0, sizeof(key));
+    if (!file.dirEntry(&entry)) return false;
+    memcpy(key.name, entry.name, sizeof(key.name));
+    key.date = entry.lastWriteDate;
+    key.time = entry.lastWriteTime;
+    key.cluster = ((uint32_t)entry.firstClusterHigh << 16) | entry.firstClusterLow;
+    key.size = entry.fileSize;
+    return true;
+  }
+
+  /**
+   * Open the folder of the file selected
+   */
+  bool CardReader::file_parent(SdBaseFile &parent) {
+    uint8_t dname[LONG_FILENAME_LENGTH + 1];
+    SdBaseFile path;
+    return path.openParentReturnFile(curDir, fileName, dname, &parent, false);
+  }
+
+#endif
+
+#if ENABLED(SD_FILE_INFO_CACHE)
+
+  /**
+   * Open the index of the folder of the file selected, it is
+   * created or started again if it's missing or of another version.
+   */
+  bool CardReader::file_info_open(SdBaseFile &index) {
+    SdBaseFile parent;
+    uint32_t version = 0;
+
+    if (!file_parent(parent)) return false;
+    if (!index.open(&parent, SD_FILE_INFO_NAME, O_CREAT | O_RDWR)) return false;
+    if (index.read(&version, sizeof(version)) == sizeof(version) && version == SD_FILE_INFO_VERSION) return true;
+
+    version = SD_FILE_INFO_VERSION;
+    if (index.truncate(0) && index.write(&version, sizeof(version)) == sizeof(version)) return true;
+    index.close();
+    return false;
+  }
+
+  /**
+   * Look for the key of info in the index. If it's there fill info and
+   * return true, else return in pos where to write the new record: the
+   * old record of the same file, the end of the index or its start
+   * when it's full.
+   */
+  bool CardReader::file_info_find(SdBaseFile &index, file_info_t &info, uint32_t &pos) {
+    file_info_t record;
+
+    pos = sizeof(uint32_t);
+    if (!index.seekSet(pos)) return false;
+    while (index.read(&record, sizeof(record)) == sizeof(record)) {
+      if (!memcmp(record.key.name, info.key.name, sizeof(info.key.name))) {
+        if (!memcmp(&record.key, &info.key, sizeof(info.key))) {
+          info = record;
+          return true;
+        }
+        return false;
+      }
+      pos += sizeof(record);
+    }
+    if (pos >= sizeof(uint32_t) + SD_FILE_INFO_RECORDS * sizeof(record) && index.truncate(sizeof(uint32_t)))
+      pos = sizeof(uint32_t);
+    return false;
+  }
+
+#endif // SD_FILE_INFO_CACHE
+
+#if ENABLED(SD_LAYER_INDEX)
+
+  /**
+   * Open the layer index NAME.Lxx of the file selected, next to it,
+   * xx the first two letters of its extension. The header keeps the
+   * key of the file, with its 8.3 name: if the index is missing or of
+   * another file start the scan that builds it, layer_idle() runs it
+   * a chunk at a time.
+   */
+  void CardReader::layer_open() {
+    SdBaseFile parent;
+    layer_header_t header;
+    char name[SHORT_FILENAME_LENGTH];
+    uint8_t n = 0;
+
+    layer_close();
+    if (!file_key(file, layer_header.key) || !file_parent(parent)) return;
+
+    for (uint8_t i = 0; i < 8 && layer_header.key.name[i] != ' '; i++) name[n++] = layer_header.key.name[i];
+    strcpy_P(name + n, PSTR(SD_LAYER_EXT));
+    n += sizeof(SD_LAYER_EXT) - 1;
+    for (uint8_t i = 8; i < 10 && layer_header.key.name[i] != ' '; i++) name[n++] = layer_header.key.name[i];
+    name[n] = '\0';
+
+    // NAME.LLL would be its own index
+    if (layer_header.key.name[8] == 'L' && layer_header.key.name[9] == 'L' && layer_header.key.name[10] == 'L') return;
+
+    if (!layerFile.open(&parent, name, O_CREAT | O_RDWR)) return;
+
+    if (layerFile.read(&header, sizeof(header)) == sizeof(header) && header.version == SD_LAYER_VERSION
+        && !memcmp(&header.key, &layer_header.key, sizeof(header.key))) {
+      layer_header = header;
+      layer_count = header.layers;
+      layer_total_time = header.time;
+      layer_ready = layer_read(0, layer_next);
+      return;
+    }
+
+    // The header gets its version when the scan is complete
+    layer_header.version = 0;
+    layer_header.layers = layer_header.unused = 0;
+    layer_header.time = 0;
+    if (!layerFile.truncate(0) || layerFile.write(&layer_header, sizeof(layer_header)) != sizeof(layer_header)) {
+      layerFile.close();
+      return;
+    }
+
+    layerSource = file;
+    if (!layerSource.seekSet(0)) {
+      layer_close();
+      return;
+    }
+    memset(&layer_scan, 0, sizeof(layer_scan));
+    layer_scan.feedrate = 1500.0f / 60.0f;
+    layer_scanning = true;
+  }
+
+  void CardReader::layer_close() {
+    layerFile.close();
+    layerSource.close();
+    layer_ready = layer_scanning = false;
+    layer_count = layer_current = 0;
+    layer_total_time = 0;
+    memset(&layer_now, 0, sizeof(layer_now));
+    memset(&layer_next, 0, sizeof(layer_next));
+  }
+
+  bool CardReader::layer_read(const uint16_t layer, layer_t &record) {
+    return layerFile.seekSet(sizeof(layer_header_t) + (uint32_t)layer * sizeof(layer_t))
+        && layerFile.read(&record, sizeof(record)) == sizeof(record);
+  }
+
+  /**
+   * Called by idle(): scan the file selected or follow the layers of the print
+   */
+  void CardReader::layer_idle() {
+    if (!cardOK || saving) return;
+    if (layer_scanning) {
+      // While printing the moves have time to spare only when the planner is full
+      if (!sdprinting || planner.is_full()) layer_scan_step();
+    }
+    else if (layer_ready && sdprinting)
+      layer_follow();
+  }
+
+  /**
+   * Keep layer_now and layer_next around sdpos, a record is read only
+   * when the print enters a new layer or sdpos is moved back.
+   */
+  void CardReader::layer_follow() {
+    if (sdpos < layer_now.offset) {
+      layer_current = 0;
+      memset(&layer_now, 0, sizeof(layer_now));
+      if (!layer_read(0, layer_next)) layer_ready = false;
+    }
+    while (layer_ready && layer_current < layer_count && sdpos >= layer_next.offset) {
+      layer_now = layer_next;
+      if (!layer_read(++layer_current, layer_next)) layer_ready = false;
+    }
+  }
+
+  /**
+   * Estimated print time at sdpos in ms, along the layer of sdpos
+   */
+  uint32_t CardReader::layer_time() {
+    if (sdpos <= layer_now.offset || layer_next.offset <= layer_now.offset) return layer_now.time;
+    if (sdpos >= layer_next.offset) return layer_next.time;
+    return layer_now.time + (uint32_t)((float)(layer_next.time - layer_now.time) * (sdpos - layer_now.offset) / (layer_next.offset - layer_now.offset));
+  }
+
+  /**
+   * Move the print to the start of a layer, 1 is the first
+   */
+  bool CardReader::layer_seek(const uint16_t layer) {
+    if (!layer_ready || !layer || layer > layer_count) return false;
+    if (!layer_read(layer - 1, layer_now) || !layer_read(layer, layer_next)) {
+      layer_ready = false;
+      return false;
+    }
+    layer_current = layer;
+    setIndex(layer_now.offset);
+    return true;
+  }
+
+  void CardReader::layer_add(const uint32_t offset, const float z, const uint32_t time) {
+    layer_t record;
+    record.offset = offset;
+    record.z = z;
+    record.time = time;
+    if (layerFile.write(&record, sizeof(record)) != sizeof(record)) layer_close();
+  }
+
+  /**
+   * Scan the next chunk of the file selected. At its end write the
+   * last record and the header, the index is then ready.
+   */
+  void CardReader::layer_scan_step() {
+    layer_scan_t &s = layer_scan;
+    uint8_t buf[SD_LAYER_SCAN_CHUNK];
+
+    const int16_t n = layerSource.read(buf, sizeof(buf));
+    if (n < 0) {
+      layer_close();
+      return;
+    }
+
+    for (int16_t i = 0; i < n && layer_scanning; i++) {
+      const char c = buf[i];
+      s.pos++;
+      if (c == '\n' || c == '\r') {
+        s.line[s.count] = '\0';
+        if (s.count) layer_scan_line();
+        s.count = 0;
+        s.comment = false;
+        s.line_pos = s.pos;
+      }
+      else if (c == ';')
+        s.comment = true;
+      else if (!s.comment && s.count < SD_LAYER_SCAN_LINE - 1)
+        s.line[s.count++] = c;
+    }
+
+    if (!layer_scanning || n == (int16_t)sizeof(buf)) return;
+
+    if (s.count) {
+      s.line[s.count] = '\0';
+      layer_scan_line();
+      if (!layer_scanning) return;
+    }
+
+    layer_add(s.pos, s.position[Z_AXIS], s.time);
+    if (!layer_scanning) return;
+    layer_header.version = SD_LAYER_VERSION;
+    layer_header.time = s.time;
+    if (!layerFile.seekSet(0) || layerFile.write(&layer_header, sizeof(layer_header)) != sizeof(layer_header) || !layerFile.sync()) {
+      layer_close();
+      return;
+    }
+
+    layerSource.close();
+    layer_scanning = false;
+    layer_count = layer_header.layers;
+    layer_total_time = layer_header.time;
+    layer_current = 0;
+    memset(&layer_now, 0, sizeof(layer_now));
+    layer_ready = layer_read(0, layer_next);
+    if (layer_ready && sdprinting) layer_follow();
+  }
+
+  /**
+   * Run a line of the scan through a model of the motion: the moves
+   * speed up from the junction speed with the acceleration of the
+   * planner, the junction speed is the speed of the last move along
+   * the new direction, no less than the jerk. The slow down is left
+   * out, the estimate is a bit short with sharp corners.
+   *
+   * A layer starts at the last Z change before an extrusion at a new Z.
+   */
+  void CardReader::layer_scan_line() {
+    layer_scan_t &s = layer_scan;
+    char *p = s.line;
+    uint16_t code = 0;
+
+    while (*p == ' ') p++;
+    if (*p == 'N' || *p == 'n') {
+      while (*p && *p != ' ') p++;
+      while (*p == ' ') p++;
+    }
+
+    const char letter = *p++ & 0xDF;
+    if (letter != 'G' && letter != 'M') return;
+    if (!NUMERIC(*p)) return;
+    while (NUMERIC(*p)) code = code * 10 + *p++ - '0';
+
+    if (letter == 'M') {
+      if (code == 82) s.relative_e = false;
+      else if (code == 83) s.relative_e = true;
+      return;
+    }
+
+    float value[XYZE], feedrate = 0, dwell = 0;
+    uint8_t seen = 0;
+    bool seen_f = false;
+
+    for (; *p; p++) {
+      const char c = (*p >= 'a' && *p <= 'z') ? *p - 32 : *p;
+      switch (c) {
+        case 'X': case 'Y': case 'Z': case 'E': {
+          const uint8_t axis = c == 'E' ? E_AXIS : c - 'X';
+          value[axis] = GCodeParser::parse_float(p + 1);
+          SBI(seen, axis);
+        } break;
+        case 'F': feedrate = GCodeParser::parse_float(p + 1); seen_f = true; break;
+        case 'P': dwell = GCodeParser::parse_float(p + 1); break;
+        case 'S': dwell = GCodeParser::parse_float(p + 1) * 1000.0f; break;
+      }
+    }
+
+    float t = 0;
+
+    switch (code) {
+      case 0: case 1: case 2: case 3: {
+        float target[XYZE], delta[XYZE], d = 0;
+        LOOP_XYZE(i) {
+          const bool relative = s.relative || (i == E_AXIS && s.relative_e);
+          target[i] = TEST(seen, i) ? value[i] + (relative ? s.position[i] : 0) : s.position[i];
+          delta[i] = target[i] - s.position[i];
+        }
+        if (seen_f && feedrate > 0) s.feedrate = feedrate / 60.0f;
+
+        if (delta[Z_AXIS]) {
+          s.z_pos = s.line_pos;
+          s.z_time = s.time;
+        }
+        if (delta[E_AXIS] > 0 && (delta[X_AXIS] || delta[Y_AXIS]) && (!layer_header.layers || target[Z_AXIS] != s.layer_z)) {
+          layer_add(s.z_pos, target[Z_AXIS], s.z_time);
+          if (!layer_scanning) return;
+          layer_header.layers++;
+          s.layer_z = target[Z_AXIS];
+        }
+
+        LOOP_XYZ(i) d += sq(delta[i]);
+        d = SQRT(d);
+        const bool cartesian = d > 0.00001f;
+        if (!cartesian) d = FABS(delta[E_AXIS]);
+
+        if (d > 0) {
+          float v = s.feedrate;
+          LOOP_XYZE(i) if (delta[i]) NOMORE(v, Mechanics.max_feedrate_mm_s[i] * d / FABS(delta[i]));
+
+          const float accel = !cartesian ? Mechanics.retract_acceleration[0] : delta[E_AXIS] > 0 ? Mechanics.acceleration : Mechanics.travel_acceleration;
+          float v0;
+          if (cartesian) {
+            float cos_theta = 0;
+            LOOP_XYZ(i) cos_theta += s.unit[i] * delta[i] / d;
+            v0 = max(min(s.speed, v) * cos_theta, min(v, Mechanics.max_jerk[X_AXIS]));
+          }
+          else
+            v0 = min(v, Mechanics.max_jerk[E_AXIS]);
+
+          const float accel_distance = (sq(v) - sq(v0)) / (2.0f * accel);
+          float exit_speed;
+          if (accel_distance >= d) {
+            exit_speed = SQRT(sq(v0) + 2.0f * accel * d);
+            t = (exit_speed - v0) / accel;
+          }
+          else {
+            exit_speed = v;
+            t = (v - v0) / accel + (d - accel_distance) / v;
+          }
+
+          s.speed = cartesian ? exit_speed : 0;
+          LOOP_XYZ(i) s.unit[i] = cartesian ? delta[i] / d : 0;
+        }
+        COPY_ARRAY(s.position, target);
+      } break;
+
+      case 4: t = dwell * 0.001f; break;
+
+      case 28:
+        LOOP_XYZ(i) if (!seen || TEST(seen, i)) s.position[i] = 0;
+        s.speed = 0;
+        break;
+
+      case 90: s.relative = false; break;
+      case 91: s.relative = true; break;
+
+      case 92:
+        LOOP_XYZE(i) if (TEST(seen, i)) s.position[i] = value[i];
+        break;
+    }
+
+    // Whole ms to the time, the rest is kept for the next line
+    if (t > 0) {
+      s.rest += t * 1000.0f;
+      const uint32_t ms = s.rest;
+      s.time += ms;
+      s.rest -= ms;
+    }
+  }
+
+#endif // SD_LAYER_INDEX
+
 void CardReader::printEscapeChars(const char* s) {
   for (unsigned int i = 0; i < strlen(s); ++i) {
     switch (s[i]) {
@@ -33,7 +33,79 @@
   #define SHORT_FILENAME_LENGTH 14
   #define GENBY_SIZE 16
 
-  enum LsAction { LS_Count, LS_GetFilename };
+  #if ENABLED(SD_FILE_INFO_CACHE) || ENABLED(SD_LAYER_INDEX)
+    // Fields of the directory entry that change with the file
+    typedef struct {
+      uint8_t   name[11];         // 8.3 name of the directory entry
+      uint8_t   unused;
+      uint16_t  date, time;       // Last write
+      uint32_t  cluster, size;
+    } sd_file_key_t;
+  #endif
+
+  #if ENABLED(SD_FILE_INFO_CACHE)
+    #define SD_FILE_INFO_NAME     "INFO.IDX"
+    #define SD_FILE_INFO_VERSION  0x31494B4DUL  // "MKI1"
+    #define SD_FILE_INFO_RECORDS  128           // The index starts again when full
+
+    // A record of the index of a folder
+    typedef struct {
+      sd_file_key_t key;
+      float objectHeight, firstlayerHeight, layerHeight, filamentNeeded;
+      char generatedBy[GENBY_SIZE];
+    } file_info_t;
+  #endif
+
+  #if ENABLED(SD_LAYER_INDEX)
+    #define SD_LAYER_EXT          ".L"          // And the first two letters of the extension of the file
+    #define SD_LAYER_VERSION      0x314C4B4DUL  // "MKL1"
+    #define SD_LAYER_SCAN_CHUNK   64            // Bytes scanned by a call of layer_idle
+    #define SD_LAYER_SCAN_LINE    64            // Longer lines are cut, they are comments
+
+    // The layer index file is the header and a record for every layer,
+    // the last record is the end of the file
+    typedef struct {
+      uint32_t version;           // 0 until the scan is complete
+      sd_file_key_t key;
+      uint16_t layers, unused;
+      uint32_t time;              // Estimated print time in ms
+    } layer_header_t;
+
+    typedef struct {
+      uint32_t offset;            // File position of the first line of the layer
+      float    z;
+      uint32_t time;              // Estimated print time at the start of the layer in ms
+    } layer_t;
+
+    // State of the scan of the file selected
+    typedef struct {
+      uint32_t pos, line_pos, z_pos, z_time, time;
+      float position[XYZE], feedrate, speed, unit[XYZ], rest, layer_z;
+      bool relative, relative_e, comment;
+      uint8_t count;
+      char line[SD_LAYER_SCAN_LINE];
+    } layer_scan_t;
+  #endif
+
+  enum LsAction { LS_Count, LS_GetFilename, LS_Cache };
+
+  #if ENABLED(SD_DIR_CACHE)
+    // A file or folder of the working directory
+    typedef struct {
+      uint16_t  index;            // First directory entry, with the long name ones
+      uint16_t  hash;             // Of the long name, to look for a name
+      bool      isDir;
+      #if ENABLED(SD_DIR_CACHE_SORT)
+        char    name[SD_DIR_CACHE_SORT + 1];  // Start of the long name, the sort key
+      #endif
+    } dir_cache_t;
+
+    enum DirCacheState { DIR_CACHE_EMPTY, DIR_CACHE_READY, DIR_CACHE_OVERFLOW };
+
+    #define DIR_CACHE_RESET() (dir_cache_state = DIR_CACHE_EMPTY)
+  #else
+    #define DIR_CACHE_RESET() NOOP
+  #endif
 
   #include "SDFat.h"
 
@@ -87,12 +159,35 @@
 
     uint16_t getnrfilenames();
 
+    uint16_t get_line(char* buf, const uint16_t size, int16_t &term);
+
+    #if ENABLED(SD_READ_AHEAD)
+      void read_ahead();
+    #endif
+
+    #if ENABLED(SD_LAYER_INDEX)
+      void layer_idle();
+      uint32_t layer_time();
+      bool layer_seek(const uint16_t layer);
+    #endif
+
     FORCE_INLINE void pauseSDPrint() { sdprinting = false; }
-    FORCE_INLINE void setIndex(uint32_t newpos) { sdpos = newpos; file.seekSet(sdpos); }
+    FORCE_INLINE void setIndex(uint32_t newpos) {
+      sdpos = newpos;
+      file.seekSet(sdpos);
+      #if ENABLED(SD_READ_AHEAD)
+        read_ahead_reset();
+      #endif
+    }
     FORCE_INLINE bool isFileOpen() { return file.isOpen(); }
     FORCE_INLINE bool eof() { return sdpos >= fileSize; }
     FORCE_INLINE int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
-    FORCE_INLINE uint8_t percentDone() { return (isFileOpen() && fileSize) ? sdpos / ((fileSize + 99) / 100) : 0; }
+    FORCE_INLINE uint8_t percentDone() {
+      #if ENABLED(SD_LAYER_INDEX)
+        if (layer_ready && layer_total_time) return isFileOpen() ? layer_time() / ((layer_total_time + 99) / 100) : 0;
+      #endif
+      return (isFileOpen() && fileSize) ? sdpos / ((fileSize + 99) / 100) : 0;
+    }
     FORCE_INLINE char* getWorkDirName() { workDir.getFilename(fileName); return fileName; }
 
     //files init.g on the sd card are performed in a row
@@ -106,6 +201,13 @@
     char tempLongFilename[LONG_FILENAME_LENGTH + 1];
     char generatedBy[GENBY_SIZE];
 
+    #if ENABLED(SD_LAYER_INDEX)
+      bool layer_ready;           // The layer index of the file selected is complete
+      uint16_t layer_count,       // Layers of the file selected
+               layer_current;     // Layer of sdpos, 0 before the first
+      uint32_t layer_total_time;  // Estimated print time in ms
+    #endif
+
     static void printEscapeChars(const char* s);
 
   private:
@@ -123,6 +225,53 @@
     bool findLayerHeight(char* buf, float &layerHeight);
     bool findFilamentNeed(char* buf, float &filament);
     bool findTotalHeight(char* buf, float &objectHeight);
+    #if ENABLED(SD_FILE_INFO_CACHE) || ENABLED(SD_LAYER_INDEX)
+      bool file_key(SdBaseFile &file, sd_file_key_t &key);
+      bool file_parent(SdBaseFile &parent);
+    #endif
+    #if ENABLED(SD_FILE_INFO_CACHE)
+      bool file_info_open(SdBaseFile &index);
+      bool file_info_find(SdBaseFile &index, file_info_t &info, uint32_t &pos);
+    #endif
+
+    #if ENABLED(SD_READ_AHEAD)
+      #define SD_READ_AHEAD_SIZE (SD_READ_AHEAD * 512)
+      uint8_t read_ahead_buffer[SD_READ_AHEAD_SIZE];
+      uint32_t read_ahead_pos;    // File position of the end of the data read ahead
+      uint16_t read_ahead_index;  // Buffer index of sdpos
+      #if ENABLED(SD_SPI_DMA)
+        bool read_ahead_pending;  // A block is on the way to read_ahead_pos
+      #endif
+      void read_ahead_reset();
+      bool read_ahead_block(const bool wait=true);
+    #endif
+    int16_t next_char();
+
+    #if ENABLED(SD_DIR_CACHE)
+      dir_cache_t dir_cache[SD_DIR_CACHE];
+      uint16_t dir_cache_count;
+      DirCacheState dir_cache_state;
+      void dir_cache_build();
+      void dir_cache_add(const uint16_t index);
+      void dir_cache_get(const uint16_t nr);
+      static uint16_t dir_cache_hash(const char* name);
+    #endif
+
+    #if ENABLED(SD_LAYER_INDEX)
+      SdBaseFile layerFile,       // Index of the file selected
+                 layerSource;     // File scanned
+      layer_t layer_now, layer_next;
+      layer_header_t layer_header;
+      layer_scan_t layer_scan;
+      bool layer_scanning;
+      void layer_open();
+      void layer_close();
+      bool layer_read(const uint16_t layer, layer_t &record);
+      void layer_follow();
+      void layer_scan_step();
+      void layer_scan_line();
+      void layer_add(const uint32_t offset, const float z, const uint32_t time);
+    #endif
   };
 
   extern CardReader card;
@@ -25,217 +25,263 @@
  */
 
 #include "../../base.h"
-
-#if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
-  static void* heater_ttbl_map[2] = {(void*)HEATER_0_TEMPTABLE, (void*)HEATER_1_TEMPTABLE };
-  static uint8_t heater_ttbllen_map[2] = { HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN };
-#elif HAS_TEMP_HOTEND
-  static void* heater_ttbl_map[HOTENDS] = ARRAY_BY_HOTENDS_N((void*)HEATER_0_TEMPTABLE, (void*)HEATER_1_TEMPTABLE, (void*)HEATER_2_TEMPTABLE, (void*)HEATER_3_TEMPTABLE);
-  static uint8_t heater_ttbllen_map[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN, HEATER_2_TEMPTABLE_LEN, HEATER_3_TEMPTABLE_LEN);
-#endif
+#include "thermistortable/thermistortable_dense.h"
 
 Temperature thermalManager;
 
-// public:
-#if HAS_TEMP_HOTEND
-  float   Temperature::current_temperature[HOTENDS]     = { 0.0 };
-  int16_t Temperature::current_temperature_raw[HOTENDS] = { 0 },
-          Temperature::target_temperature[HOTENDS]      = { 0 };
+/**
+ * Heater descriptors
+ *
+ * Everything that differs between the hotends, the bed, the chamber and the
+ * cooler, in the order of Temperature::heaters: the sensor and its table,
+ * the limits, the control and the protections.
+ */
+enum HeaterControl : uint8_t { HEATER_BANG_BANG, HEATER_LIMIT_SWITCHING, HEATER_PID };
+
+typedef struct {
+  int8_t          type;         // TEMP_SENSOR_x: thermistor table, -1 AD595, -2 MAX6675, -3 MAX31855, 0 none
+  const short     (*table)[2];  // NULL if not a thermistor
+  uint8_t         table_len;
+  const int16_t*  dense;
+} sensor_data_t;
+
+typedef struct {
+  sensor_data_t   sensor;
+  int16_t         mintemp, maxtemp,           // Celsius
+                  raw_lo, raw_hi;             // Raw values at the lowest and the highest temperature
+  HeaterControl   control;
+  uint8_t         hysteresis;                 // HEATER_LIMIT_SWITCHING band
+  uint16_t        check_interval;             // ms between bang-bang checks, 0 at every call
+  bool            cooler;                     // The power lowers the temperature
+  uint8_t         power_min, power_max;
+  uint16_t        tr_period;                  // Thermal runaway, 0 if not protected
+  uint8_t         tr_hysteresis;
+  uint16_t        watch_period;               // Heating watch, 0 if not watched
+  uint8_t         watch_increase, watch_hysteresis;
+} heater_data_t;
+
+// Heaters without a sensor have no limits
+#ifndef HEATER_0_MINTEMP
+  #define HEATER_0_MINTEMP 0
 #endif
-
-#if HAS_TEMP_BED
-  float   Temperature::current_temperature_bed          = 0.0;
-  int16_t Temperature::current_temperature_bed_raw      = 0,
-          Temperature::target_temperature_bed           = 0;
+#ifndef HEATER_0_MAXTEMP
+  #define HEATER_0_MAXTEMP 16383
 #endif
-
-#if HAS_TEMP_CHAMBER
-  float   Temperature::current_temperature_chamber      = 0.0;
-  int16_t Temperature::target_temperature_chamber       = 0,
-          Temperature::current_temperature_chamber_raw  = 0;
+#ifndef HEATER_1_MINTEMP
+  #define HEATER_1_MINTEMP 0
 #endif
-
-#if HAS_TEMP_COOLER
-  float   Temperature::current_temperature_cooler     = 0.0;
-  int16_t Temperature::target_temperature_cooler      = 0,
-          Temperature::current_temperature_cooler_raw = 0;
+#ifndef HEATER_1_MAXTEMP
+  #define HEATER_1_MAXTEMP 16383
 #endif
-
-#if ENABLED(ARDUINO_ARCH_SAM) && !MB(RADDS)
-  float   Temperature::current_temperature_mcu  = 0.0,
-          Temperature::highest_temperature_mcu  = 0.0,
-          Temperature::lowest_temperature_mcu   = 4096.0,
-          Temperature::alarm_temperature_mcu    = 80.0;
-  int16_t Temperature::current_temperature_mcu_raw;
+#ifndef HEATER_2_MINTEMP
+  #define HEATER_2_MINTEMP 0
 #endif
-
-#if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
-  float Temperature::redundant_temperature = 0.0;
+#ifndef HEATER_2_MAXTEMP
+  #define HEATER_2_MAXTEMP 16383
 #endif
-
-#if HAS_TEMP_HOTEND
-  uint8_t Temperature::soft_pwm[HOTENDS];
+#ifndef HEATER_3_MINTEMP
+  #define HEATER_3_MINTEMP 0
 #endif
-#if HAS_TEMP_BED
-  uint8_t Temperature::soft_pwm_bed;
-#endif
-#if HAS_TEMP_CHAMBER
-  uint8_t Temperature::soft_pwm_chamber;
-#endif
-#if HAS_TEMP_COOLER
-  uint8_t Temperature::soft_pwm_cooler;
+#ifndef HEATER_3_MAXTEMP
+  #define HEATER_3_MAXTEMP 16383
 #endif
 
-#if ENABLED(PIDTEMP)
-  float Temperature::Kp[HOTENDS],
-        Temperature::Ki[HOTENDS],
-        Temperature::Kd[HOTENDS],
-        Temperature::Kc[HOTENDS];
+// Thermocouples have no table
+#ifndef BEDTEMPTABLE
+  #define BEDTEMPTABLE          NULL
+  #define BEDTEMPTABLE_LEN      0
+  #define BEDDENSETABLE         NULL
 #endif
-
-#if ENABLED(PIDTEMPBED)
-  float Temperature::bedKp = DEFAULT_bedKp,
-        Temperature::bedKi = DEFAULT_bedKi,
-        Temperature::bedKd = DEFAULT_bedKd;
+#ifndef CHAMBERTEMPTABLE
+  #define CHAMBERTEMPTABLE      NULL
+  #define CHAMBERTEMPTABLE_LEN  0
+  #define CHAMBERDENSETABLE     NULL
 #endif
-
-#if ENABLED(PIDTEMPCHAMBER)
-  float Temperature::chamberKp = DEFAULT_chamberKp,
-        Temperature::chamberKi = DEFAULT_chamberKi,
-        Temperature::chamberKd = DEFAULT_chamberKd;
+#ifndef COOLERTEMPTABLE
+  #define COOLERTEMPTABLE       NULL
+  #define COOLERTEMPTABLE_LEN   0
+  #define COOLERDENSETABLE      NULL
 #endif
 
-#if ENABLED(PIDTEMPCOOLER)
-  float Temperature::coolerKp = DEFAULT_coolerKp,
-        Temperature::coolerKi = DEFAULT_coolerKi,
-        Temperature::coolerKd = DEFAULT_coolerKd;
+#if ENABLED(PIDTEMP)
+  #define HOTEND_CONTROL  HEATER_PID, 0, 0
+#else
+  #define HOTEND_CONTROL  HEATER_BANG_BANG, 0, 0
 #endif
-
-#if ENABLED(BABYSTEPPING)
-  volatile int Temperature::babystepsTodo[XYZ] = { 0 };
+#if ENABLED(THERMAL_PROTECTION_HOTENDS)
+  #define HOTEND_TR       THERMAL_PROTECTION_PERIOD, THERMAL_PROTECTION_HYSTERESIS
+#else
+  #define HOTEND_TR       0, 0
 #endif
-
 #if WATCH_HOTENDS
-  uint16_t Temperature::watch_target_temp[HOTENDS] = { 0 };
-  millis_t Temperature::watch_heater_next_ms[HOTENDS] = { 0 };
-#endif
-
-#if WATCH_THE_BED
-  uint16_t Temperature::watch_target_bed_temp = 0;
-  millis_t Temperature::watch_bed_next_ms = 0;
+  #define HOTEND_WATCH    WATCH_TEMP_PERIOD, WATCH_TEMP_INCREASE, TEMP_HYSTERESIS
+#else
+  #define HOTEND_WATCH    0, 0, 0
 #endif
 
-#if WATCH_THE_CHAMBER
-  uint16_t Temperature::watch_target_temp_chamber = 0;
-  millis_t Temperature::watch_chamber_next_ms = 0;
-#endif
+#define HOTEND_DATA(N) { \
+  { TEMP_SENSOR_##N, HEATER_##N##_TEMPTABLE, HEATER_##N##_TEMPTABLE_LEN, HEATER_##N##_DENSETABLE }, \
+  HEATER_##N##_MINTEMP, HEATER_##N##_MAXTEMP, HEATER_##N##_RAW_LO_TEMP, HEATER_##N##_RAW_HI_TEMP, \
+  HOTEND_CONTROL, false, PID_MIN, PID_MAX, HOTEND_TR, HOTEND_WATCH \
+}
 
-#if WATCH_THE_COOLER
-  uint16_t Temperature::watch_target_temp_cooler = 0;
-  millis_t Temperature::watch_cooler_next_ms = 0;
+#if HAS_TEMP_BED
+  #if ENABLED(PIDTEMPBED)
+    #define BED_CONTROL HEATER_PID, 0, 0
+  #elif ENABLED(BED_LIMIT_SWITCHING)
+    #define BED_CONTROL HEATER_LIMIT_SWITCHING, BED_HYSTERESIS, BED_CHECK_INTERVAL
+  #else
+    #define BED_CONTROL HEATER_BANG_BANG, 0, BED_CHECK_INTERVAL
+  #endif
+  #if HAS_THERMALLY_PROTECTED_BED
+    #define BED_TR      THERMAL_PROTECTION_BED_PERIOD, THERMAL_PROTECTION_BED_HYSTERESIS
+  #else
+    #define BED_TR      0, 0
+  #endif
+  #if WATCH_THE_BED
+    #define BED_WATCH   WATCH_BED_TEMP_PERIOD, WATCH_BED_TEMP_INCREASE, TEMP_BED_HYSTERESIS
+  #else
+    #define BED_WATCH   0, 0, 0
+  #endif
+  #define BED_DATA , { \
+    { TEMP_SENSOR_BED, BEDTEMPTABLE, BEDTEMPTABLE_LEN, BEDDENSETABLE }, \
+    BED_MINTEMP, BED_MAXTEMP, HEATER_BED_RAW_LO_TEMP, HEATER_BED_RAW_HI_TEMP, \
+    BED_CONTROL, false, MIN_BED_POWER, MAX_BED_POWER, BED_TR, BED_WATCH \
+  }
+#else
+  #define BED_DATA
 #endif
 
-#if HAS_TEMP_HOTEND && ENABLED(PREVENT_COLD_EXTRUSION)
-  bool Temperature::allow_cold_extrude = false;
-  int16_t Temperature::extrude_min_temp = EXTRUDE_MINTEMP;
+#if HAS_TEMP_CHAMBER
+  #if ENABLED(PIDTEMPCHAMBER)
+    #define CHAMBER_CONTROL HEATER_PID, 0, 0
+  #elif ENABLED(CHAMBER_LIMIT_SWITCHING)
+    #define CHAMBER_CONTROL HEATER_LIMIT_SWITCHING, CHAMBER_HYSTERESIS, CHAMBER_CHECK_INTERVAL
+  #else
+    #define CHAMBER_CONTROL HEATER_BANG_BANG, 0, CHAMBER_CHECK_INTERVAL
+  #endif
+  #if HAS_THERMALLY_PROTECTED_CHAMBER
+    #define CHAMBER_TR      THERMAL_PROTECTION_CHAMBER_PERIOD, THERMAL_PROTECTION_CHAMBER_HYSTERESIS
+  #else
+    #define CHAMBER_TR      0, 0
+  #endif
+  #if WATCH_THE_CHAMBER
+    #define CHAMBER_WATCH   WATCH_CHAMBER_TEMP_PERIOD, WATCH_CHAMBER_TEMP_INCREASE, TEMP_CHAMBER_HYSTERESIS
+  #else
+    #define CHAMBER_WATCH   0, 0, 0
+  #endif
+  #define CHAMBER_DATA , { \
+    { TEMP_SENSOR_CHAMBER, CHAMBERTEMPTABLE, CHAMBERTEMPTABLE_LEN, CHAMBERDENSETABLE }, \
+    CHAMBER_MINTEMP, CHAMBER_MAXTEMP, HEATER_CHAMBER_RAW_LO_TEMP, HEATER_CHAMBER_RAW_HI_TEMP, \
+    CHAMBER_CONTROL, false, MIN_CHAMBER_POWER, MAX_CHAMBER_POWER, CHAMBER_TR, CHAMBER_WATCH \
+  }
+#else
+  #define CHAMBER_DATA
 #endif
 
-// private:
-
-#if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
-  int Temperature::redundant_temperature_raw = 0;
-  float Temperature::redundant_temperature = 0.0;
+#if HAS_TEMP_COOLER
+  #if ENABLED(PIDTEMPCOOLER)
+    #define COOLER_CONTROL  HEATER_PID, 0, 0
+  #elif ENABLED(COOLER_LIMIT_SWITCHING)
+    #define COOLER_CONTROL  HEATER_LIMIT_SWITCHING, COOLER_HYSTERESIS, COOLER_CHECK_INTERVAL
+  #else
+    #define COOLER_CONTROL  HEATER_BANG_BANG, 0, COOLER_CHECK_INTERVAL
+  #endif
+  #if HAS_THERMALLY_PROTECTED_COOLER
+    #define COOLER_TR       THERMAL_PROTECTION_COOLER_PERIOD, THERMAL_PROTECTION_COOLER_HYSTERESIS
+  #else
+    #define COOLER_TR       0, 0
+  #endif
+  #if WATCH_THE_COOLER
+    #define COOLER_WATCH    WATCH_TEMP_COOLER_PERIOD, WATCH_TEMP_COOLER_DECREASE, TEMP_COOLER_HYSTERESIS
+  #else
+    #define COOLER_WATCH    0, 0, 0
+  #endif
+  #define COOLER_DATA , { \
+    { TEMP_SENSOR_COOLER, COOLERTEMPTABLE, COOLERTEMPTABLE_LEN, COOLERDENSETABLE }, \
+    COOLER_MINTEMP, COOLER_MAXTEMP, COOLER_RAW_LO_TEMP, COOLER_RAW_HI_TEMP, \
+    COOLER_CONTROL, true, MIN_COOLER_POWER, MAX_COOLER_POWER, COOLER_TR, COOLER_WATCH \
+  }
+#else
+  #define COOLER_DATA
 #endif
 
-#if ENABLED(PIDTEMP)
-  float Temperature::temp_iState[HOTENDS] = { 0 },
-        Temperature::temp_dState[HOTENDS][4] = { 0 },
-        Temperature::temp_iState_min[HOTENDS] = { 0 },
-        Temperature::temp_iState_max[HOTENDS] = { 0 },
-        Temperature::pid_error[HOTENDS];
-
-  #if ENABLED(PID_ADD_EXTRUSION_RATE)
-    float Temperature::cTerm[HOTENDS];
-    long Temperature::last_e_position;
-    long Temperature::lpq[LPQ_MAX_LEN];
-    int Temperature::lpq_ptr = 0;
+static const heater_data_t heater_data[HEATER_COUNT] = {
+  #if HOTENDS > 0
+    HOTEND_DATA(0)
+    #if HOTENDS > 1
+      , HOTEND_DATA(1)
+      #if HOTENDS > 2
+        , HOTEND_DATA(2)
+        #if HOTENDS > 3
+          , HOTEND_DATA(3)
+        #endif
+      #endif
+    #endif
   #endif
+  BED_DATA CHAMBER_DATA COOLER_DATA
+};
 
-  uint8_t Temperature::pid_pointer[HOTENDS] = { 0 };
+#if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
+  static const sensor_data_t redundant_sensor = { TEMP_SENSOR_1, HEATER_1_TEMPTABLE, HEATER_1_TEMPTABLE_LEN, HEATER_1_DENSETABLE };
 #endif
 
-#if ENABLED(PIDTEMPBED)
-  float Temperature::temp_iState_bed = 0,
-        Temperature::temp_dState_bed[4] = { 0 },
-        Temperature::temp_iState_bed_min,
-        Temperature::temp_iState_bed_max,
-        Temperature::pid_error_bed;
-
-  uint8_t Temperature::pid_pointer_bed = 0;
-#else
-  millis_t Temperature::next_bed_check_ms;
-#endif
+/**
+ * Fixed point temperature control
+ *
+ * The temperatures are in 1/TEMP_FIXED_SCALE degrees, the P and the D terms
+ * in 1/2^PID_SHIFT and the I term in 1/2^PID_I_SHIFT of the PWM output.
+ * The D term is taken over the last 3 periods. The extrusion rate term
+ * takes Kc per step of the extruder in 1/2^PID_C_SHIFT of the PWM output.
+ */
+#define TEMP_FIXED_SCALE      THERMISTOR_DENSE_SCALE
+#define PID_SHIFT             8
+#define PID_I_SHIFT           20
+#define PID_D_MAX_DELTA       (128 * (TEMP_FIXED_SCALE))
+#define PID_P_FIXED(Kp)       (int32_t)((Kp) * (1L << PID_SHIFT) / (TEMP_FIXED_SCALE) + 0.5)
+#define PID_I_FIXED(Ki)       (int32_t)((Ki) * (PID_dT) * (1L << PID_I_SHIFT) / (TEMP_FIXED_SCALE) + 0.5)
+#define PID_D_FIXED(Kd)       (int32_t)((Kd) / (3 * (PID_dT)) * (1L << PID_SHIFT) / (TEMP_FIXED_SCALE) + 0.5)
+#define PID_C_SHIFT           16
+#define PID_C_FIXED(Kc, mm)   (int32_t)((Kc) * (mm) * (1L << PID_C_SHIFT) + 0.5)
+
+#define AD595_FIXED_GAIN      (int32_t)(((HAL_VOLTAGE_PIN) * 100.0 / 1024.0) * (TEMP_SENSOR_AD595_GAIN) * (TEMP_FIXED_SCALE) * 256)
+#define AD595_FIXED_OFFSET    (int16_t)((TEMP_SENSOR_AD595_OFFSET) * (TEMP_FIXED_SCALE))
 
-#if ENABLED(PIDTEMPCHAMBER)
-  float Temperature::temp_iState_chamber = 0,
-        Temperature::temp_dState_chamber[4] = { 0 },
-        Temperature::temp_iState_chamber_min,
-        Temperature::temp_iState_chamber_max,
-        Temperature::pid_error_chamber;
+// public:
+heater_t Temperature::heaters[HEATER_COUNT];
 
-  uint8_t Temperature::pid_pointer_chamber = 0;
-#else
-  millis_t Temperature::next_chamber_check_ms;
+#if ENABLED(ARDUINO_ARCH_SAM) && !MB(RADDS)
+  float   Temperature::current_temperature_mcu  = 0.0,
+          Temperature::highest_temperature_mcu  = 0.0,
+          Temperature::lowest_temperature_mcu   = 4096.0,
+          Temperature::alarm_temperature_mcu    = 80.0;
+  int16_t Temperature::current_temperature_mcu_raw;
 #endif
 
-#if ENABLED(PIDTEMPCOOLER)
-  float Temperature::temp_iState_cooler = 0,
-        Temperature::temp_dState_cooler[4] = { 0 },
-        Temperature::temp_iState_cooler_min,
-        Temperature::temp_iState_cooler_max,
-        Temperature::pid_error_cooler;
-
-  uint8_t Temperature::pid_pointer_cooler = 0;
-#else
-  millis_t Temperature::next_cooler_check_ms;
+#if ENABLED(BABYSTEPPING)
+  volatile int Temperature::babystepsTodo[XYZ] = { 0 };
 #endif
 
-// Init min and max temp with extreme values to prevent false errors during startup
-int16_t Temperature::minttemp_raw[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_RAW_LO_TEMP , HEATER_1_RAW_LO_TEMP , HEATER_2_RAW_LO_TEMP, HEATER_3_RAW_LO_TEMP),
-        Temperature::maxttemp_raw[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_RAW_HI_TEMP , HEATER_1_RAW_HI_TEMP , HEATER_2_RAW_HI_TEMP, HEATER_3_RAW_HI_TEMP),
-        Temperature::minttemp[HOTENDS] = ARRAY_BY_HOTENDS(0),
-        Temperature::maxttemp[HOTENDS] = ARRAY_BY_HOTENDS(16383);
-
-#if ENABLED(MAX_CONSECUTIVE_LOW_TEMPERATURE_ERROR_ALLOWED)
-  uint8_t Temperature::consecutive_low_temperature_error[HOTENDS] = { 0 };
-  #if HAS_TEMP_BED
-    uint8_t Temperature::consecutive_bed_low_temperature_error = 0;
-  #endif
+#if HAS_TEMP_HOTEND && ENABLED(PREVENT_COLD_EXTRUSION)
+  bool Temperature::allow_cold_extrude = false;
+  int16_t Temperature::extrude_min_temp = EXTRUDE_MINTEMP;
 #endif
 
-#if ENABLED(MILLISECONDS_PREHEAT_TIME)
-  millis_t Temperature::preheat_end_time[HOTENDS] = { 0 };
-#endif
+// private:
 
-#if ENABLED(BED_MINTEMP)
-  int16_t Temperature::bed_minttemp_raw = HEATER_BED_RAW_LO_TEMP;
+#if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
+  int Temperature::redundant_temperature_raw = 0;
+  float Temperature::redundant_temperature = 0.0;
 #endif
 
-#if ENABLED(BED_MAXTEMP)
-  int16_t Temperature::bed_maxttemp_raw = HEATER_BED_RAW_HI_TEMP;
+#if HAS(PID_HEATING) || HAS(PID_COOLING)
+  volatile bool Temperature::pid_autotuning = false;
 #endif
 
-#if ENABLED(CHAMBER_MINTEMP)
-  int16_t Temperature::chamber_minttemp_raw = HEATER_CHAMBER_RAW_LO_TEMP;
-#endif
-#if ENABLED(CHAMBER_MAXTEMP)
-  int16_t Temperature::chamber_maxttemp_raw = HEATER_CHAMBER_RAW_HI_TEMP;
-#endif
-#if ENABLED(COOLER_MINTEMP)
-  int16_t Temperature::cooler_minttemp_raw = COOLER_RAW_LO_TEMP;
-#endif
-#if ENABLED(COOLER_MAXTEMP)
-  int16_t Temperature::cooler_maxttemp_raw = COOLER_RAW_HI_TEMP;
+#if ENABLED(PIDTEMP) && ENABLED(PID_ADD_EXTRUSION_RATE)
+  long Temperature::last_e_position;
+  long Temperature::lpq[LPQ_MAX_LEN];
+  int Temperature::lpq_ptr = 0;
 #endif
 
 #if ENABLED(FILAMENT_SENSOR)
@@ -255,18 +301,9 @@ int16_t Temperature::minttemp_raw[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_RAW_LO_
   int Temperature::current_raw_filwidth = 0;  //Holds measured filament diameter - one extruder only
 #endif
 
-#if ENABLED(ADVANCED_PAUSE_FEATURE)
-  millis_t Temperature::heater_idle_timeout_ms[HOTENDS] = { 0 };
-  bool Temperature::heater_idle_timeout_exceeded[HOTENDS] = { false };
-  #if HAS_TEMP_BED
-    millis_t Temperature::bed_idle_timeout_ms = 0;
-    bool Temperature::bed_idle_timeout_exceeded = false;
-  #endif
-#endif
-
 #if HAS(PID_HEATING) || HAS(PID_COOLING)
 
-  void Temperature::PID_autotune(const float temp, const int temp_controller, int ncycles, bool storeValues/*=false*/) {
+  void Temperature::PID_autotune(const float temp, const int temp_controller, int ncycles, bool storeValues/*=false*/, bool model/*=false*/) {
 
     float currentTemp = 0.0;
     int cycles = 0;
@@ -288,24 +325,68 @@ int16_t Temperature::minttemp_raw[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_RAW_LO_
       next_auto_fan_check_ms = temp_ms + 2500UL;
     #endif
 
-    if (temp_controller >=
-      #if ENABLED(PIDTEMP)
-        HOTENDS
-      #else
-        0
+    // The hotends are 0 and up, the bed -1, the chamber -2 and the cooler -3
+    uint8_t h;
+    switch (temp_controller) {
+      #if HAS_TEMP_BED
+        case -1: h = BED_INDEX; break;
+      #endif
+      #if HAS_TEMP_CHAMBER
+        case -2: h = CHAMBER_INDEX; break;
       #endif
-      #if HASNT(TEMP_BED) && HASNT(TEMP_COOLER)
-        || temp_controller < 0
-      #elif HASNT(TEMP_BED)
-        || (temp_controller == -1 && temp_controller < -3)
-      #elif HASNT(TEMP_COOLER)
-        || temp_controller < -2 
+      #if HAS_TEMP_COOLER
+        case -3: h = COOLER_INDEX; break;
+      #endif
+      default: h = temp_controller; break;
+    }
+
+    if (temp_controller < -3 || h >= HEATER_COUNT
+      #if DISABLED(PIDTEMP)
+        || temp_controller >= 0
       #endif
     ) {
       SERIAL_LM(ER, MSG_PID_BAD_TEMP_CONTROLLER_NUM);
       return;
     }
 
+    const heater_data_t &data = heater_data[h];
+    heater_t &heater = heaters[h];
+
+    #if ENABLED(PID_FEEDFORWARD)
+      /**
+       * The thermal model of a hotend, found from the energy balance:
+       *  - the heat loss to the ambient from the mean power of a cycle at the
+       *    target temperature, where all the power goes in the loss;
+       *  - the heat capacity from the energy taken by the heat-up at full
+       *    power, less the loss, over the temperature rise;
+       *  - with a part cooling fan the second half of the cycles runs with
+       *    the fan at full speed, the fan loss is the difference.
+       */
+      #define MODEL_AMBIENT_MAX 40
+      updateTemperaturesFromRawValues();
+      const float ambient = heater.current_temperature;
+      if (model && h >= HOTENDS) {
+        SERIAL_LM(ER, MSG_MODEL_HOTEND_ONLY);
+        model = false;
+      }
+      else if (model && ambient > MODEL_AMBIENT_MAX) {
+        SERIAL_LM(ER, MSG_MODEL_TOO_HOT);
+        model = false;
+      }
+      float heatup_time = 0, heatup_loss = 0, heatup_temp = ambient,
+            cycle_power = 0, cycle_loss = 0,
+            ambient_loss = 0, cycle_ambient_loss = 0;
+      millis_t model_ms = temp_ms;
+      #if FAN_COUNT > 0
+        const int16_t old_fan_speed = fanSpeeds[0];
+        if (model) fanSpeeds[0] = 0;
+        // The PID is tuned by the cycles without the fan, the model adds the fan loss
+        float fan_off_Kp = 0, fan_off_Ki = 0, fan_off_Kd = 0;
+      #endif
+    #else
+      UNUSED(model);
+    #endif
+
     SERIAL_EM(MSG_PID_AUTOTUNE_START);
     if (temp_controller == -1) {
       SERIAL_MSG("BED");
@@ -331,28 +412,11 @@ int16_t Temperature::minttemp_raw[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_RAW_LO_
       disable_all_coolers(); // switch off all coolers.
     #endif
 
-    #if HAS_TEMP_BED
-      if (temp_controller == -1) {
-        pidMax = MAX_BED_POWER;
-        soft_pwm_bed = (pidMax);
-      }
-    #endif
-    #if HAS_TEMP_CHAMBER
-      if (temp_controller == -2) {
-        pidMax = MAX_CHAMBER_POWER;
-        soft_pwm_chamber = (pidMax);
-      }
-    #endif
-    #if HAS_TEMP_COOLER
-      if (temp_controller == -3) {
-        pidMax = MAX_COOLER_POWER;
-        soft_pwm_cooler = (pidMax);
-      }
-    #endif
-    if (temp_controller >= 0) {
-      pidMax = PID_MAX;
-      soft_pwm[temp_controller] = (pidMax);
-    }
+    // Stop temp_controller_isr() driving the heaters
+    pid_autotuning = true;
+
+    pidMax = data.power_max;
+    heater.soft_pwm = pidMax;
 
     bias = pidMax >> 1;
     d = pidMax >> 1;
@@ -365,24 +429,24 @@ int16_t Temperature::minttemp_raw[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_RAW_LO_
       updateTemperaturesFromRawValues();
       millis_t ms = millis();
 
-      #if HAS_TEMP_BED
-        if (temp_controller == -1)
-          currentTemp = current_temperature_bed;
-      #endif
-      #if HAS_TEMP_CHAMBER
-        if (temp_controller == -2)
-          currentTemp = current_temperature_chamber;
-      #endif
-      #if HAS_TEMP_COOLER
-        if (temp_controller == -3)
-        currentTemp = current_temperature_cooler;
-      #endif
-      if (temp_controller >= 0)
-        currentTemp = current_temperature[temp_controller];
+      currentTemp = heater.current_temperature;
 
       NOLESS(maxTemp, currentTemp);
       NOMORE(minTemp, currentTemp);
 
+      #if ENABLED(PID_FEEDFORWARD)
+        if (model) {
+          const float dt = (ms - model_ms) * 0.001f, rise = currentTemp - ambient;
+          model_ms = ms;
+          if (heating && cycles == 0) {
+            heatup_time += dt;
+            heatup_loss += rise * dt;
+          }
+          cycle_power += heater.soft_pwm * dt;
+          cycle_loss += rise * dt;
+        }
+      #endif
+
       #if HAS_AUTO_FAN
         if (ELAPSED(ms, next_auto_fan_check_ms)) {
           checkExtruderAutoFans();
@@ -394,29 +458,18 @@ int16_t Temperature::minttemp_raw[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_RAW_LO_
         if (ELAPSED(ms, t2 + 2500UL)) {
           heating = false;
 
-          #if HAS_TEMP_BED
-            if (temp_controller == -1)
-              soft_pwm_bed = (bias - d);
-          #endif
-          #if HAS_TEMP_CHAMBER
-            if (temp_controller == -2)
-              soft_pwm_chamber = (bias - d);
-          #endif
-          #if HAS_TEMP_COOLER
-            if (temp_controller == -3)
-              soft_pwm_cooler = (bias - d);
+          heater.soft_pwm = (bias - d);
+
+          #if ENABLED(PID_FEEDFORWARD)
+            if (cycles == 0) heatup_temp = currentTemp;
           #endif
-          if (temp_controller >= 0)
-            soft_pwm[temp_controller] = (bias - d);
 
           t1 = ms;
           t_high = t1 - t2;
 
-          #if HAS_TEMP_COOLER
-            if (temp_controller == -3)
-              minTemp = temp;
-            else
-          #endif
+          if (data.cooler)
+            minTemp = temp;
+          else
             maxTemp = temp;
         }
       }
@@ -426,6 +479,27 @@ int16_t Temperature::minttemp_raw[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_RAW_LO_
           heating = true;
           t2 = ms;
           t_low = t2 - t1;
+
+          #if ENABLED(PID_FEEDFORWARD)
+            if (model) {
+              // A cycle begins and ends with the heater going on at the target
+              if (cycles > 0 && cycle_loss > 0)
+                cycle_ambient_loss = heater.heater_power * cycle_power / (255.0f * cycle_loss);
+              cycle_power = cycle_loss = 0;
+              #if FAN_COUNT > 0
+                if (cycles == ncycles / 2) {
+                  ambient_loss = cycle_ambient_loss;
+                  fan_off_Kp = workKp;
+                  fan_off_Ki = workKi;
+                  fan_off_Kd = workKd;
+                  fanSpeeds[0] = 255;
+                  // Start again from the whole power range, the fan takes a lot more
+                  bias = d = pidMax >> 1;
+                }
+              #endif
+            }
+          #endif
+
           if (cycles > 0) {
 
             bias += (d * (t_high - t_low)) / (t_low + t_high);
@@ -452,46 +526,27 @@ int16_t Temperature::minttemp_raw[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_RAW_LO_
             }
           }
 
-          #if ENABLED(PIDTEMP)
-            if (temp_controller >= 0)
-              soft_pwm[temp_controller] = (bias + d);
-          #endif
-
-          #if ENABLED(PIDTEMPBED)
-            if (temp_controller == -1)
-              soft_pwm_bed = (bias + d);
-          #endif
-
-          #if ENABLED(PIDTEMPCHAMBER)
-            if (temp_controller == -2)
-              soft_pwm_chamber = (bias + d);
-          #endif
-
-          #if ENABLED(PIDTEMPCOOLER)
-            if (temp_controller == -3)
-              soft_pwm_cooler = (bias + d);
-          #endif
+          if (data.control == HEATER_PID)
+            heater.soft_pwm = (bias + d);
 
           cycles++;
 
-          #if HAS_TEMP_COOLER
-            if (temp_controller == -3)
-              maxTemp = temp;
-            else
-          #endif
+          if (data.cooler)
+            maxTemp = temp;
+          else
             minTemp = temp;
         }
       }
 
       #define MAX_OVERSHOOT_PID_AUTOTUNE 40
-      if (currentTemp > temp + MAX_OVERSHOOT_PID_AUTOTUNE && temp_controller >= -2) {
+      if (currentTemp > temp + MAX_OVERSHOOT_PID_AUTOTUNE && !data.cooler) {
         SERIAL_LM(ER, MSG_PID_TEMP_TOO_HIGH);
-        return;
+        break;
+      }
+      else if (currentTemp < temp + MAX_OVERSHOOT_PID_AUTOTUNE && data.cooler) {
+        SERIAL_LM(ER, MSG_PID_TEMP_TOO_LOW);
+        break;
       }
-      else if (currentTemp < temp + MAX_OVERSHOOT_PID_AUTOTUNE && temp_controller < -2) {
-		    SERIAL_LM(ER, MSG_PID_TEMP_TOO_LOW);
-		    return;
-		  }
 
       // Every 1 seconds...
       if (ELAPSED(ms, temp_ms + 1000UL)) {
@@ -514,54 +569,65 @@ int16_t Temperature::minttemp_raw[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_RAW_LO_
       // Over 2 minutes?
       if (((ms - t1) + (ms - t2)) > (10L * 60L * 1000L * 2L)) {
         SERIAL_EM(MSG_PID_TIMEOUT);
-        return;
+        break;
       }
       if (cycles > ncycles) {
         SERIAL_EM(MSG_PID_AUTOTUNE_FINISHED);
 
-        #if ENABLED(PIDTEMP)
+        #if ENABLED(PID_FEEDFORWARD) && FAN_COUNT > 0
+          if (model && fan_off_Kp > 0) {
+            workKp = fan_off_Kp;
+            workKi = fan_off_Ki;
+            workKd = fan_off_Kd;
+          }
+        #endif
+
+        if (data.control == HEATER_PID) {
           if (temp_controller >= 0) {
             SERIAL_MV(MSG_KP, workKp);
             SERIAL_MV(MSG_KI, workKi);
             SERIAL_EMV(MSG_KD, workKd);
-            if (storeValues) {
-              PID_PARAM(Kp, temp_controller) = workKp;
-              PID_PARAM(Ki, temp_controller) = workKi;
-              PID_PARAM(Kd, temp_controller) = workKd;
-              updatePID();
-            }
           }
-        #endif
-
-        #if ENABLED(PIDTEMPBED)
-          if (temp_controller == -1) {
-            SERIAL_EMV("#define DEFAULT_bedKp ", workKp);
-            SERIAL_EMV("#define DEFAULT_bedKi ", workKi);
-            SERIAL_EMV("#define DEFAULT_bedKd ", workKd);
-            if (storeValues) {
-              bedKp = workKp;
-              bedKi = workKi;
-              bedKd = workKd;
-              updatePID();
-            }
+          else {
+            const char * const name = temp_controller == -1 ? PSTR("bed") : temp_controller == -2 ? PSTR("chamber") : PSTR("cooler");
+            SERIAL_MSG("#define DEFAULT_"); SERIAL_PS(name); SERIAL_EMV("Kp ", workKp);
+            SERIAL_MSG("#define DEFAULT_"); SERIAL_PS(name); SERIAL_EMV("Ki ", workKi);
+            SERIAL_MSG("#define DEFAULT_"); SERIAL_PS(name); SERIAL_EMV("Kd ", workKd);
           }
-        #endif
+          if (storeValues) {
+            PID_PARAM(Kp, h) = workKp;
+            PID_PARAM(Ki, h) = workKi;
+            PID_PARAM(Kd, h) = workKd;
+            updatePID();
+          }
+        }
 
-        #if ENABLED(PIDTEMPCOOLER)
-          if (temp_controller == -3) {
-            SERIAL_EMV("#define DEFAULT_coolerKp ", workKp);
-            SERIAL_EMV("#define DEFAULT_coolerKi ", workKi);
-            SERIAL_EMV("#define DEFAULT_coolerKd ", workKd);
+        #if ENABLED(PID_FEEDFORWARD)
+          if (model) {
+            #if FAN_COUNT > 0
+              float fan_loss = cycle_ambient_loss - ambient_loss;
+              NOLESS(fan_loss, 0);
+            #else
+              const float fan_loss = heater.fan_loss;
+              ambient_loss = cycle_ambient_loss;
+            #endif
+            const float heat_capacity = (heater.heater_power * pidMax * heatup_time / 255.0f - ambient_loss * heatup_loss) / (heatup_temp - ambient);
+            SERIAL_EM(MSG_MODEL_FINISHED);
+            SERIAL_SMV(ECHO, "  M307 H", h);
+            SERIAL_MV(" C", heat_capacity);
+            SERIAL_MV(" A", ambient_loss, 4);
+            SERIAL_MV(" F", fan_loss, 4);
+            SERIAL_EMV(" R", ambient);
             if (storeValues) {
-              coolerKp = workKp;
-              coolerKi = workKi;
-              coolerKd = workKd;
-              updatePID();
+              heater.heat_capacity = heat_capacity;
+              heater.ambient_loss = ambient_loss;
+              heater.fan_loss = fan_loss;
+              heater.ambient_temp = ambient;
             }
           }
         #endif
 
-        return;
+        break;
       }
     }
 
@@ -570,6 +636,12 @@ int16_t Temperature::minttemp_raw[HOTENDS] = ARRAY_BY_HOTENDS_N(HEATER_0_RAW_LO_
     #if HAS_TEMP_COOLER
       disable_all_coolers();
     #endif
+
+    #if ENABLED(PID_FEEDFORWARD) && FAN_COUNT > 0
+      fanSpeeds[0] = old_fan_speed;
+    #endif
+
+    pid_autotuning = false;
   }
 
 #endif // HAS_PID_HEATING
@@ -582,29 +654,38 @@ Temperature::Temperature() { }
 
 void Temperature::updatePID() {
 
-  #if ENABLED(PIDTEMP)
-    HOTEND_LOOP() {
-      temp_iState_min[HOTEND_INDEX] = (float)PID_MIN * 10.0f / PID_PARAM(Ki, HOTEND_INDEX);
-      temp_iState_max[HOTEND_INDEX] = (float)PID_MAX * 10.0f / PID_PARAM(Ki, HOTEND_INDEX);
+  #if HAS(PID_HEATING) || HAS(PID_COOLING)
+    HEATER_LOOP() {
+      const heater_data_t &data = heater_data[h];
+      if (data.control != HEATER_PID) continue;
+      heater_t &heater = heaters[h];
+      const int32_t Kp_fixed = PID_P_FIXED(heater.Kp),
+                    Ki_fixed = PID_I_FIXED(heater.Ki),
+                    Kd_fixed = PID_D_FIXED(heater.Kd);
+      int32_t power_min = data.power_min, power_max = data.power_max;
+      #if ENABLED(PID_FEEDFORWARD)
+        // The model gives the power, the I term only corrects what it misses:
+        // with all the power range it winds up on heat-up and on a fan or flow step
+        if (h < HOTENDS) {
+          power_min = -(FEEDFORWARD_I_RANGE);
+          power_max = FEEDFORWARD_I_RANGE;
+        }
+      #endif
+      #if ENABLED(PIDTEMP) && ENABLED(PID_ADD_EXTRUSION_RATE)
+        const int32_t Kc_fixed = h < HOTENDS ? PID_C_FIXED(heater.Kc, Mechanics.steps_to_mm[E_AXIS + h]) : 0;
+      #endif
+      CRITICAL_SECTION_START
+        heater.Kp_fixed = Kp_fixed;
+        heater.Ki_fixed = Ki_fixed;
+        heater.Kd_fixed = Kd_fixed;
+        #if ENABLED(PIDTEMP) && ENABLED(PID_ADD_EXTRUSION_RATE)
+          heater.Kc_fixed = Kc_fixed;
+        #endif
+        // The I term alone can't go out of the power range
+        heater.iState_min = Ki_fixed > 0 ? (power_min * (1L << PID_I_SHIFT)) / Ki_fixed : 0;
+        heater.iState_max = Ki_fixed > 0 ? (power_max << PID_I_SHIFT) / Ki_fixed : 0;
+      CRITICAL_SECTION_END
     }
-    #if ENABLED(PID_ADD_EXTRUSION_RATE)
-      last_e_position = 0;
-    #endif
-  #endif
-
-  #if ENABLED(PIDTEMPBED)
-    temp_iState_bed_min = (float)MIN_BED_POWER * 10.0f / bedKi;
-    temp_iState_bed_max = (float)MAX_BED_POWER * 10.0f / bedKi;
-  #endif
-
-  #if ENABLED(PIDTEMPCHAMBER)
-    temp_iState_chamber_min = (float)MIN_CHAMBER_POWER * 10.0f / chamberKi;
-    temp_iState_chamber_max = (float)MAX_CHAMBER_POWER * 10.0f / chamberKi;
-  #endif
-
-  #if ENABLED(PIDTEMPCOOLER)
-    temp_iState_cooler_min = (float)MIN_COOLER_POWER * 10.0f / coolerKi;
-    temp_iState_cooler_max = (float)MAX_COOLER_POWER * 10.0f / coolerKi;
   #endif
 
 }
@@ -622,7 +703,7 @@ void Temperature::updatePID() {
     uint8_t fanState = 0;
  
     HOTEND_LOOP() {
-      if (current_temperature[h] > HOTEND_AUTO_FAN_TEMPERATURE)
+      if (heaters[h].current_temperature > HOTEND_AUTO_FAN_TEMPERATURE)
         SBI(fanState, fanBit[h]);
     }
  
@@ -644,23 +725,23 @@ void Temperature::updatePID() {
 //
 // Temperature Error Handlers
 //
-void Temperature::_temp_error(const int8_t tc, const char * const serial_msg, const char * const lcd_msg) {
+void Temperature::_temp_error(const uint8_t h, const char * const serial_msg, const char * const lcd_msg) {
   static bool killed = false;
   if (IsRunning()) {
     SERIAL_ST(ER, serial_msg);
     SERIAL_MSG(MSG_STOPPED_HEATER);
-    if (tc >= 0)
-      SERIAL_EV((int)tc);
+    if (h < HOTENDS)
+      SERIAL_EV((int)h);
     #if HAS_TEMP_BED
-      else if (tc == -1)
+      else if (h == BED_INDEX)
         SERIAL_EM(MSG_HEATER_BED);
     #endif
     #if HAS_TEMP_CHAMBER
-      else if (tc == -2)
+      else if (h == CHAMBER_INDEX)
         SERIAL_EM(MSG_HEATER_CHAMBER);
     #endif
     #if HAS_TEMP_COOLER
-      else if (tc == -3)
+      else if (h == COOLER_INDEX)
         SERIAL_EM(MSG_HEATER_COOLER);
     #endif
   }
@@ -680,66 +761,72 @@ void Temperature::_temp_error(const int8_t tc, const char * const serial_msg, co
   #endif
 }
 
-void Temperature::max_temp_error(const int8_t h) {
+void Temperature::max_temp_error(const uint8_t h) {
+  const char * lcd_msg = PSTR(MSG_ERR_MAXTEMP);
   #if HAS_TEMP_BED
-    _temp_error(h, PSTR(MSG_T_MAXTEMP), h >= 0 ? PSTR(MSG_ERR_MAXTEMP) : PSTR(MSG_ERR_MAXTEMP_BED));
-  #else
-    _temp_error(HOTEND_INDEX, PSTR(MSG_T_MAXTEMP), PSTR(MSG_ERR_MAXTEMP));
-    #if HOTENDS <= 1
-      UNUSED(h);
-    #endif
+    if (h == BED_INDEX) lcd_msg = PSTR(MSG_ERR_MAXTEMP_BED);
+  #endif
+  #if HAS_TEMP_CHAMBER
+    if (h == CHAMBER_INDEX) lcd_msg = PSTR(MSG_ERR_MAXTEMP_CHAMBER);
   #endif
+  #if HAS_TEMP_COOLER
+    if (h == COOLER_INDEX) lcd_msg = PSTR(MSG_ERR_MAXTEMP_COOLER);
+  #endif
+  _temp_error(h, PSTR(MSG_T_MAXTEMP), lcd_msg);
 }
-void Temperature::min_temp_error(const int8_t h) {
+void Temperature::min_temp_error(const uint8_t h) {
+  const char * lcd_msg = PSTR(MSG_ERR_MINTEMP);
   #if HAS_TEMP_BED
-    _temp_error(h, PSTR(MSG_T_MINTEMP), h >= 0 ? PSTR(MSG_ERR_MINTEMP) : PSTR(MSG_ERR_MINTEMP_BED));
-  #else
-    _temp_error(HOTEND_INDEX, PSTR(MSG_T_MINTEMP), PSTR(MSG_ERR_MINTEMP));
-    #if HOTENDS <= 1
-      UNUSED(h);
-    #endif
+    if (h == BED_INDEX) lcd_msg = PSTR(MSG_ERR_MINTEMP_BED);
+  #endif
+  #if HAS_TEMP_CHAMBER
+    if (h == CHAMBER_INDEX) lcd_msg = PSTR(MSG_ERR_MINTEMP_CHAMBER);
   #endif
+  #if HAS_TEMP_COOLER
+    if (h == COOLER_INDEX) lcd_msg = PSTR(MSG_ERR_MINTEMP_COOLER);
+  #endif
+  _temp_error(h, PSTR(MSG_T_MINTEMP), lcd_msg);
 }
 
-uint8_t Temperature::get_pid_output(const int8_t h) {
+uint8_t Temperature::get_pid_output(const uint8_t h) {
   #if HOTENDS <= 1
-    UNUSED(h);
-    #define _HOTEND_TEST  true
+    #define _HOTEND_TEST  h == 0
   #else
     #define _HOTEND_TEST  h == active_extruder
   #endif
 
   uint8_t pid_output = 0;
 
-  #if ENABLED(PIDTEMP)
+  #if HAS(PID_HEATING) || HAS(PID_COOLING)
+
+    const heater_data_t &data = heater_data[h];
+    heater_t &heater = heaters[h];
+
+    // The cooler is off below its minimum temperature
+    if (data.cooler && heater.target_temperature < data.mintemp) return 0;
+
     #if DISABLED(PID_OPENLOOP)
-      temp_dState[HOTEND_INDEX][pid_pointer[HOTEND_INDEX]++] = current_temperature[HOTEND_INDEX];
-      pid_pointer[HOTEND_INDEX] &= 3;
-      float error = target_temperature[HOTEND_INDEX] - current_temperature[HOTEND_INDEX];
-      #if ENABLED(ADVANCED_PAUSE_FEATURE)
-        if (heater_idle_timeout_exceeded[HOTEND_INDEX]) {
-          pid_output = 0;
-          temp_iState[HOTEND_INDEX] = 0;
-        }
-        else
-      #endif
-      if (error > PID_FUNCTIONAL_RANGE) {
-        pid_output = PID_MAX;
+      const int16_t temperature = heater.current_temperature_fixed;
+      heater.dState[heater.pid_pointer++] = temperature;
+      heater.pid_pointer &= 3;
+      const int32_t error = (int32_t)heater.target_temperature * (TEMP_FIXED_SCALE) - temperature;
+      if (error > (PID_FUNCTIONAL_RANGE) * (TEMP_FIXED_SCALE)) {
+        pid_output = data.power_max;
       }
-      else if (error < -(PID_FUNCTIONAL_RANGE) || target_temperature[HOTEND_INDEX] == 0) {
+      else if (error < -(PID_FUNCTIONAL_RANGE) * (TEMP_FIXED_SCALE) || heater.target_temperature == 0) {
         pid_output = 0;
       }
       else {
-        float pidTerm = PID_PARAM(Kp, HOTEND_INDEX) * error;
-        temp_iState[HOTEND_INDEX] = constrain(temp_iState[HOTEND_INDEX] + error, temp_iState_min[HOTEND_INDEX], temp_iState_max[HOTEND_INDEX]);
-        pidTerm += PID_PARAM(Ki, HOTEND_INDEX) * temp_iState[HOTEND_INDEX] * 0.1; // 0.1 = 10Hz
-        float dgain = PID_PARAM(Kd, HOTEND_INDEX) * (temp_dState[HOTEND_INDEX][pid_pointer[HOTEND_INDEX]] - current_temperature[HOTEND_INDEX]) * 3.333f;
-        pidTerm += dgain;
-
-        #if ENABLED(PID_ADD_EXTRUSION_RATE)
-          cTerm[HOTEND_INDEX] = 0;
+        heater.iState = constrain(heater.iState + error, heater.iState_min, heater.iState_max);
+        // Temperature change over the last 3 periods, a faster one is a bad reading
+        const int32_t dTemp = constrain((int32_t)heater.dState[heater.pid_pointer] - temperature, -PID_D_MAX_DELTA, PID_D_MAX_DELTA);
+        int32_t pidTerm = heater.Kp_fixed * error
+                        + ((heater.Ki_fixed * heater.iState) >> (PID_I_SHIFT - PID_SHIFT))
+                        + heater.Kd_fixed * dTemp;
+
+        #if ENABLED(PIDTEMP) && ENABLED(PID_ADD_EXTRUSION_RATE)
           if (_HOTEND_TEST) {
-            long e_position = stepper.position(E_AXIS);
+            const long e_position = stepper.position_e_isr();
             if (e_position > last_e_position) {
               lpq[lpq_ptr] = e_position - last_e_position;
               last_e_position = e_position;
@@ -748,157 +835,55 @@ uint8_t Temperature::get_pid_output(const int8_t h) {
               lpq[lpq_ptr] = 0;
             }
             if (++lpq_ptr >= lpq_len) lpq_ptr = 0;
-            cTerm[HOTEND_INDEX] = (lpq[lpq_ptr] * Mechanics.steps_to_mm[E_AXIS]) * PID_PARAM(Kc, HOTEND_INDEX);
-            pidTerm += cTerm[HOTEND_INDEX];
+            pidTerm += (lpq[lpq_ptr] * heater.Kc_fixed) >> (PID_C_SHIFT - PID_SHIFT);
           }
         #endif // PID_ADD_EXTRUSION_RATE
 
-        pid_output = constrain((int)pidTerm, 0, PID_MAX);
+        #if ENABLED(PID_FEEDFORWARD)
+          if (h < HOTENDS) pidTerm += (int32_t)heater.feedforward << PID_SHIFT;
+        #endif
+
+        pid_output = constrain(pidTerm >> PID_SHIFT, 0, data.power_max);
 
       }
     #else
-      pid_output = constrain((int)target_temperature[HOTEND_INDEX], 0, PID_MAX);
+      pid_output = constrain((int)heater.target_temperature, 0, data.power_max);
     #endif // PID_OPENLOOP
 
-    #if ENABLED(PID_DEBUG)
-      SERIAL_SMV(ECHO, MSG_PID_DEBUG, HOTEND_INDEX);
-      SERIAL_MV(MSG_PID_DEBUG_INPUT, current_temperature[HOTEND_INDEX]);
-      SERIAL_EMV(MSG_PID_DEBUG_OUTPUT, pid_output);
-    #endif // PID_DEBUG
-
-  #elif HAS_TEMP_HOTEND /* PID off and have Hotend*/
-    #if ENABLED(ADVANCED_PAUSE_FEATURE)
-      if (heater_idle_timeout_exceeded[HOTEND_INDEX])
-        pid_output = 0;
-      else
-    #endif
-    pid_output = (current_temperature[HOTEND_INDEX] < target_temperature[HOTEND_INDEX]) ? PID_MAX : 0;
+  #else
+    UNUSED(h);
   #endif
 
   return pid_output;
 }
 
-#if ENABLED(PIDTEMPBED)
-  uint8_t Temperature::get_pid_output_bed() {
-    uint8_t pid_output = 0;
-    #if DISABLED(PID_OPENLOOP)
-      temp_dState_bed[pid_pointer_bed++] = current_temperature_bed;
-      pid_pointer_bed &= 3;
-      float error = target_temperature_bed - current_temperature_bed;
-      #if ENABLED(ADVANCED_PAUSE_FEATURE)
-        if (bed_idle_timeout_exceeded) {
-          pid_output = 0;
-          temp_iState_bed = 0;
-        }
-        else
-      #endif
-      if (error > PID_FUNCTIONAL_RANGE) {
-        pid_output = MAX_BED_POWER;
-      }
-      else if (error < -(PID_FUNCTIONAL_RANGE) || target_temperature_bed == 0) {
-        pid_output = 0;
-      }
-      else {
-        float pidTerm = bedKp * error;
-        temp_iState_bed = constrain(temp_iState_bed + error, temp_iState_bed_min, temp_iState_bed_max);
-        pidTerm += bedKi * temp_iState_bed * 0.1;
-        float dgain = bedKd * (temp_dState_bed[pid_pointer_bed] - current_temperature_bed) * 3.333f;
-        pidTerm += dgain;
-
-        pid_output = constrain((int)pidTerm, 0, MAX_BED_POWER);
-      }
-    #else
-      pid_output = constrain((int)target_temperature_bed, 0, MAX_BED_POWER);
-    #endif // PID_OPENLOOP
+#if ENABLED(PID_FEEDFORWARD)
 
-    #if ENABLED(PID_BED_DEBUG)
-      SERIAL_SM(DEB ," PID_BED_DEBUG ");
-      SERIAL_MV(MSG_PID_DEBUG_INPUT, current_temperature_bed);
-      SERIAL_EMV(MSG_PID_DEBUG_OUTPUT, pid_output);
-    #endif //PID_BED_DEBUG
-
-    return pid_output;
-  }
-#endif //PIDTEMPBED
-
-#if ENABLED(PIDTEMPCHAMBER)
-  uint8_t Temperature::get_pid_output_chamber() {
-    uint8_t pid_output;
-
-    #if DISABLED(PID_OPENLOOP)
-      temp_dState_chamber[pid_pointer_chamber++] = current_temperature_chamber;
-      pid_pointer_chamber &= 3;
-      float error = target_temperature_chamber - current_temperature_chamber;
-      if (error > PID_FUNCTIONAL_RANGE) {
-        pid_output = MAX_CHAMBER_POWER;
-      }
-      else if (error < -(PID_FUNCTIONAL_RANGE) || target_temperature_chamber == 0) {
-        pid_output = 0;
-      }
-      else {
-        float pidTerm = chamberKp * error;
-        temp_iState_chamber = constrain(temp_iState_chamber + error, temp_iState_chamber_min, temp_iState_chamber_max);
-        pidTerm += chamberKi * temp_iState_chamber * 0.1;
-        float dgain = chamberKd * (temp_dState_chamber[pid_pointer_chamber] - current_temperature_chamber) * 3.333f;
-        pidTerm += dgain;
-
-        pid_output = constrain((int)pidTerm, 0, MAX_CHAMBER_POWER);
-      }
-    #else
-      pid_output = constrain((int)target_temperature_chamber, 0, MAX_CHAMBER_POWER);
-    #endif // PID_OPENLOOP
-
-    #if ENABLED(PID_CHAMBER_DEBUG)
-      SERIAL_SM(DEB ," PID_CHAMBER_DEBUG ");
-      SERIAL_MV(MSG_PID_DEBUG_INPUT, current_temperature_chamber);
-      SERIAL_EMV(MSG_PID_DEBUG_OUTPUT, pid_output);
-    #endif // PID_CHAMBER_DEBUG
-
-    return pid_output;
-  }
-#endif
+  /**
+   * The power the thermal model of the hotend h says it needs at the
+   * target temperature: the loss to the ambient, to the part cooling fan
+   * and to the filament extruded by the next FEEDFORWARD_LOOKAHEAD ms of
+   * planned moves. Taken from the planner the heater gets the power before
+   * the filament starts to take the heat away, not after the sensor sees it.
+   */
+  uint8_t Temperature::get_feedforward_output(const uint8_t h) {
+    const heater_t &heater = heaters[h];
 
-#if ENABLED(PIDTEMPCOOLER)
-  uint8_t Temperature::get_pid_output_cooler() {
-    uint8_t pid_output;
+    if (!heater.target_temperature || heater.heater_power <= 0) return 0;
 
-    // We need this cause 0 is lower than our current temperature probably.
-    if (target_temperature_cooler < COOLER_MINTEMP)
-      return 0.0;
+    const float delta = heater.target_temperature - heater.ambient_temp;
+    if (delta <= 0) return 0;
 
-    #if DISABLED(PID_OPENLOOP)
-      temp_dState_cooler[pid_pointer_cooler++] = current_temperature_cooler;
-      pid_pointer_cooler &= 3;
-      float error = target_temperature_cooler - current_temperature_cooler;
-      if (error > PID_FUNCTIONAL_RANGE) {
-        pid_output = MAX_COOLER_POWER;
-      }
-      else if (error < -(PID_FUNCTIONAL_RANGE) || target_temperature_cooler == 0) {
-        pid_output = 0;
-      }
-      else {
-        float pidTerm = coolerKp * error;
-        temp_iState_cooler = constrain(temp_iState_cooler + error, temp_iState_cooler_min, temp_iState_cooler_max);
-        pidTerm += coolerKi * temp_iState_cooler * 0.1;
-        float dgain = coolerKd * (temp_dState_cooler[pid_pointer_cooler] - current_temperature_cooler) * 3.333f;
-        pidTerm += dgain;
-
-        pid_output = constrain((int)pidTerm, 0, MAX_COOLER_POWER);
-      }
-    #else
-      pid_output = constrain((int)target_temperature_cooler, 0, MAX_COOLER_POWER);
-    #endif // PID_OPENLOOP
-
-    #if ENABLED(PID_COOLER_DEBUG)
-      SERIAL_SM(DEB ," PID_COOLER_DEBUG ");
-      SERIAL_MV(MSG_PID_DEBUG_INPUT, current_temperature_cooler);
-      SERIAL_EMV(MSG_PID_DEBUG_OUTPUT, pid_output);
-    #endif //PID_COOLER_DEBUG
+    float loss = heater.ambient_loss + heater.filament_heat * planner.extrusion_rate(h, (FEEDFORWARD_LOOKAHEAD) * 0.001f);
+    #if FAN_COUNT > 0
+      loss += heater.fan_loss * fanSpeeds[0] * (1.0f / 255.0f);
+    #endif
 
-    return pid_output;
+    const float power = loss * delta * 255.0f / heater.heater_power;
+    return power < heater_data[h].power_max ? (uint8_t)power : heater_data[h].power_max;
   }
 
-#endif
+#endif // PID_FEEDFORWARD
 
 /**
  * Manage heating activities for hotends, bed, chamber and cooler
@@ -908,370 +893,213 @@ uint8_t Temperature::get_pid_output(const int8_t h) {
  *  - Invoke thermal runaway protection
  *  - Manage extruder auto-fan
  *  - Apply filament width to the extrusion rate (may move)
- *  - Update the heated bed PID output value
+ *  - Update the bang-bang output of the heaters without PID,
+ *    temp_controller_isr() updates the PID ones at a fixed rate
  */
 void Temperature::manage_temp_controller() {
 
-  updateTemperaturesFromRawValues(); // also resets the watchdog
-
-  #if ENABLED(HEATER_0_USES_MAX6675)
-    if (current_temperature[0] > min(HEATER_0_MAXTEMP, MAX6675_TMAX - 1.0)) max_temp_error(0);
-    if (current_temperature[0] < max(HEATER_0_MINTEMP, MAX6675_TMIN + .01)) min_temp_error(0);
-  #endif
-
-  #if WATCH_HOTENDS || WATCH_THE_BED || WATCH_THE_CHAMBER || WATCH_THE_COOLER || DISABLED(PIDTEMPBED) || DISABLED(PIDTEMPCHAMBER) || DISABLED(PIDTEMPCOOLER) || HAS_AUTO_FAN
-    millis_t ms = millis();
-  #endif
-
-  #if HAS_TEMP_HOTEND
-
-    HOTEND_LOOP() {
-
-      #if ENABLED(ADVANCED_PAUSE_FEATURE)
-        if (!heater_idle_timeout_exceeded[h] && heater_idle_timeout_ms[h] && ELAPSED(ms, heater_idle_timeout_ms[h]))
-          heater_idle_timeout_exceeded[h] = true;
-      #endif
-
-      #if ENABLED(THERMAL_PROTECTION_HOTENDS)
-        // Check for thermal runaway
-        thermal_runaway_protection(&thermal_runaway_state_machine[h], &thermal_runaway_timer[h], current_temperature[h], target_temperature[h], h, THERMAL_PROTECTION_PERIOD, THERMAL_PROTECTION_HYSTERESIS);
-      #endif
-
-      soft_pwm[h] = (current_temperature[h] > minttemp[h] || is_preheating(h)) && current_temperature[h] < maxttemp[h] ? (int)get_pid_output(h) : 0;
-
-      #if WATCH_HOTENDS
-        // Make sure temperature is increasing
-        if (watch_heater_next_ms[h] && ELAPSED(ms, watch_heater_next_ms[h])) {
-          if (degHotend(h) < watch_target_temp[h])
-            _temp_error(h, PSTR(MSG_T_HEATING_FAILED), PSTR(MSG_HEATING_FAILED_LCD));
-          else
-            start_watching_heater(h); // Start again if the target is still far off
-        }
-      #endif
-
-      #if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
-        // Make sure measured temperatures are close together
-        if (FABS(current_temperature[0] - redundant_temperature) > MAX_REDUNDANT_TEMP_SENSOR_DIFF) {
-          _temp_error(0, PSTR(MSG_REDUNDANCY), PSTR(MSG_ERR_REDUNDANT_TEMP));
-        }
-      #endif
-
-    } // HOTEND_LOOP
-
-  #endif
-
-  #if HAS_AUTO_FAN
-    if (ELAPSED(ms, next_auto_fan_check_ms)) { // only need to check fan state very infrequently
-      checkExtruderAutoFans();
-      next_auto_fan_check_ms = ms + 2500UL;
-    }
-  #endif
-
-  // Control the extruder rate based on the width sensor
-  #if ENABLED(FILAMENT_SENSOR)
-    if (filament_sensor) {
-      meas_shift_index = filwidth_delay_index[0] - meas_delay_cm;
-      if (meas_shift_index < 0) meas_shift_index += MAX_MEASUREMENT_DELAY + 1;  //loop around buffer if needed
-      meas_shift_index = constrain(meas_shift_index, 0, MAX_MEASUREMENT_DELAY);
-
-      // Get the delayed info and add 100 to reconstitute to a percent of
-      // the nominal filament diameter then square it to get an area
-      const float vmroot = measurement_delay[meas_shift_index] * 0.01 + 1.0;
-      volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM] = vmroot <= 0.1 ? 0.01 : sq(vmroot);
-    }
-  #endif // FILAMENT_SENSOR
-
-  #if WATCH_THE_BED
-    // Make sure temperature is increasing
-    if (watch_bed_next_ms && ELAPSED(ms, watch_bed_next_ms)) {
-      if (degBed() < watch_target_bed_temp)
-        _temp_error(-1, PSTR(MSG_T_HEATING_FAILED), PSTR(MSG_HEATING_FAILED_LCD));
-      else
-        start_watching_bed();
-    }
-  #endif
-
-  #if HAS_TEMP_BED && DISABLED(PIDTEMPBED)
-    if (PENDING(ms, next_bed_check_ms)) return;
-    next_bed_check_ms = ms + BED_CHECK_INTERVAL;
-  #endif
-
-  #if HAS_TEMP_CHAMBER && DISABLED(PIDTEMPCHAMBER)
-    if (PENDING(ms, next_chamber_check_ms)) return;
-    next_chamber_check_ms = ms + CHAMBER_CHECK_INTERVAL;
-  #endif
-
-  #if HAS_TEMP_COOLER && DISABLED(PIDTEMPCOOLER)
-    if (PENDING(ms, next_cooler_check_ms)) return;
-    next_cooler_check_ms = ms + COOLER_CHECK_INTERVAL;
-  #endif
-
-  #if HAS_TEMP_BED
-
-    #if ENABLED(ADVANCED_PAUSE_FEATURE)
-      if (!bed_idle_timeout_exceeded && bed_idle_timeout_ms && ELAPSED(ms, bed_idle_timeout_ms))
-        bed_idle_timeout_exceeded = true;
-    #endif
-
-    #if ENABLED(THERMAL_PROTECTION_BED)
-      thermal_runaway_protection(&thermal_runaway_bed_state_machine, &thermal_runaway_bed_timer, current_temperature_bed, target_temperature_bed, -1, THERMAL_PROTECTION_BED_PERIOD, THERMAL_PROTECTION_BED_HYSTERESIS);
-    #endif
-
-    #if ENABLED(ADVANCED_PAUSE_FEATURE)
-      if (bed_idle_timeout_exceeded) {
-        soft_pwm_bed = 0;
-
-        #if DISABLED(PIDTEMPBED)
-          WRITE_HEATER_BED(LOW);
-        #endif
-      }
-      else
-    #endif
-    {
-
-      #if ENABLED(PIDTEMPBED)
-        soft_pwm_bed = WITHIN(current_temperature_bed, BED_MINTEMP, BED_MAXTEMP) ? (int)get_pid_output_bed() : 0;
-      #elif ENABLED(BED_LIMIT_SWITCHING)
-        // Check if temperature is within the correct band
-        if (WITHIN(current_temperature_bed, BED_MINTEMP, BED_MAXTEMP)) {
-          if (current_temperature_bed >= target_temperature_bed + BED_HYSTERESIS)
-            soft_pwm_bed = 0;
-          else if (current_temperature_bed <= target_temperature_bed - (BED_HYSTERESIS))
-            soft_pwm_bed = MAX_BED_POWER >> 1;
-        }
-        else {
-          soft_pwm_bed = 0;
-          WRITE_HEATER_BED(LOW);
-        }
-      #else // !PIDTEMPBED && !BED_LIMIT_SWITCHING
-        // Check if temperature is within the correct range
-        if (WITHIN(current_temperature_bed, BED_MINTEMP, BED_MAXTEMP)) {
-          soft_pwm_bed = current_temperature_bed < target_temperature_bed ? MAX_BED_POWER : 0;
-        }
-        else {
-          soft_pwm_bed = 0;
-          WRITE_HEATER_BED(LOW);
-        }
-      #endif
-    }
-  #endif // HAS_TEMP_BED
-
-  #if HAS_TEMP_CHAMBER
-    #if ENABLED(THERMAL_PROTECTION_CHAMBER)
-      thermal_runaway_protection(&thermal_runaway_chamber_state_machine, &thermal_runaway_chamber_timer, current_temperature_chamber, target_temperature_chamber, -1, THERMAL_PROTECTION_CHAMBER_PERIOD, THERMAL_PROTECTION_CHAMBER_HYSTERESIS);
-    #endif
-
-    #if ENABLED(PIDTEMPCHAMBER)
-      soft_pwm_chamber = WITHIN(current_temperature_chamber, CHAMBER_MINTEMP, CHAMBER_MAXTEMP) ? (int)get_pid_output_chamber() : 0;
+  updateTemperaturesFromRawValues(); // also resets the watchdog
 
-    #elif ENABLED(CHAMBER_LIMIT_SWITCHING)
-      // Check if temperature is within the correct band
-      if (WITHIN(current_temperature_chamber, CHAMBER_MINTEMP, CHAMBER_MAXTEMP)) {
-        if (current_temperature_chamber >= target_temperature_chamber + CHAMBER_HYSTERESIS)
-          soft_pwm_chamber = 0;
-        else if (current_temperature_chamber <= target_temperature_chamber - CHAMBER_HYSTERESIS)
-          soft_pwm_chamber = MAX_CHAMBER_POWER >> 1;
-      }
-      else {
-        soft_pwm_chamber = 0;
-        WRITE_HEATER_CHAMBER(LOW);
-      }
-    #else // !PIDTEMPCHAMBER && !CHAMBER_LIMIT_SWITCHING
-      // Check if temperature is within the correct range
-      if (WITHIN(current_temperature_chamber, CHAMBER_MINTEMP, CHAMBER_MAXTEMP)) {
-        soft_pwm_chamber = current_temperature_chamber < target_temperature_chamber ? MAX_CHAMBER_POWER : 0;
-      }
-      else {
-        soft_pwm_chamber = 0;
-        WRITE_HEATER_CHAMBER(LOW);
-      }
-    #endif
-  #endif // HAS_TEMP_CHAMBER
+  #if ENABLED(HEATER_0_USES_MAX6675)
+    if (heaters[0].current_temperature > min(HEATER_0_MAXTEMP, MAX6675_TMAX - 1.0)) max_temp_error(0);
+    if (heaters[0].current_temperature < max(HEATER_0_MINTEMP, MAX6675_TMIN + .01)) min_temp_error(0);
+  #endif
 
-  #if HAS_TEMP_COOLER
-    #if ENABLED(THERMAL_PROTECTION_COOLER)
-      thermal_runaway_protection(&thermal_runaway_cooler_state_machine, &thermal_runaway_cooler_timer, current_temperature_cooler, target_temperature_cooler, -2, THERMAL_PROTECTION_COOLER_PERIOD, THERMAL_PROTECTION_COOLER_HYSTERESIS);
-    #endif
+  #if ENABLED(ADVANCED_PAUSE_FEATURE) || WATCH_THE_HEATERS || HAS_HEATER_CHECK_INTERVAL || HAS_AUTO_FAN
+    const millis_t ms = millis();
+  #endif
 
-    #if ENABLED(PIDTEMPCOOLER)
-      soft_pwm_cooler = WITHIN(current_temperature_cooler, COOLER_MINTEMP, COOLER_MAXTEMP) ? (int)get_pid_output_cooler() : 0;
+  HEATER_LOOP() {
+    const heater_data_t &data = heater_data[h];
+    heater_t &heater = heaters[h];
 
-    #elif ENABLED(COOLER_LIMIT_SWITCHING)
-      // Check if temperature is within the correct band
-      if (WITHIN(current_temperature_cooler, COOLER_MINTEMP, COOLER_MAXTEMP)) {
-        if (current_temperature_cooler >= target_temperature_cooler + COOLER_HYSTERESIS)
-          soft_pwm_cooler = MAX_COOLER_POWER >> 1;
-        else if (current_temperature_cooler <= target_temperature_cooler - COOLER_HYSTERESIS)
-          soft_pwm_cooler = 0;
-      }
-      else { 
-        soft_pwm_cooler = 0;
-        WRITE_COOLER(LOW);
-      }
-    #else // COOLER_LIMIT_SWITCHING
-      // Check if temperature is within the correct range
-      if (WITHIN(current_temperature_cooler, COOLER_MINTEMP, COOLER_MAXTEMP)) {
-        soft_pwm_cooler = current_temperature_cooler > target_temperature_cooler ? MAX_COOLER_POWER : 0;
-      }
-      else {
-        soft_pwm_cooler = 0;
-        WRITE_COOLER(LOW);
-      }
-    #endif
-  #endif // HAS_TEMP_COOLER
-}
+    if (!data.sensor.type) continue;
 
-#define PGM_RD_W(x)   (short)pgm_read_word(&x)
+    #if ENABLED(MILLISECONDS_PREHEAT_TIME)
+      // temp_controller_isr() doesn't read the clock
+      heater.preheating = is_preheating(h);
+    #endif
 
-#if HAS_TEMP_HOTEND
+    // The cooler is driven by the same code with the temperatures negated
+    const float sign = data.cooler ? -1.0 : 1.0,
+                temperature = sign * heater.current_temperature,
+                target = sign * heater.target_temperature;
 
-  // Derived from RepRap FiveD extruder::getTemperature()
-  // For hot end temperature measurement.
-  float Temperature::analog2temp(const int raw, uint8_t h) {
+    #if ENABLED(ADVANCED_PAUSE_FEATURE)
+      if (!heater.idle_timeout_exceeded && heater.idle_timeout_ms && ELAPSED(ms, heater.idle_timeout_ms))
+        heater.idle_timeout_exceeded = true;
+    #endif
 
-    #if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
-      if (h > HOTENDS)
-    #else
-      if (h >= HOTENDS)
+    #if HAS_THERMAL_PROTECTION
+      // Check for thermal runaway
+      if (data.tr_period) thermal_runaway_protection(h);
     #endif
-      {
-        SERIAL_SV(ER, (int)h);
-        SERIAL_EM(MSG_INVALID_EXTRUDER_NUM);
-        kill(PSTR(MSG_KILLED));
-        return 0.0;
-      }
 
-    #if ENABLED(HEATER_0_USES_MAX6675)
-      if (h == 0) return 0.25 * raw;
+    #if WATCH_THE_HEATERS
+      // Make sure temperature is increasing
+      if (heater.watch_next_ms && ELAPSED(ms, heater.watch_next_ms)) {
+        if (temperature < heater.watch_target_temp)
+          _temp_error(h, PSTR(MSG_T_HEATING_FAILED), PSTR(MSG_HEATING_FAILED_LCD));
+        else
+          start_watching(h); // Start again if the target is still far off
+      }
     #endif
 
-    if (heater_ttbl_map[h] != NULL) {
-      float celsius = 0;
-      uint8_t i;
-      short(*tt)[][2] = (short(*)[][2])(heater_ttbl_map[h]);
-
-      for (i = 1; i < heater_ttbllen_map[h]; i++) {
-        if (PGM_RD_W((*tt)[i][0]) > raw) {
-          celsius = PGM_RD_W((*tt)[i - 1][1]) +
-                    (raw - PGM_RD_W((*tt)[i - 1][0])) *
-                    (float)(PGM_RD_W((*tt)[i][1]) - PGM_RD_W((*tt)[i - 1][1])) /
-                    (float)(PGM_RD_W((*tt)[i][0]) - PGM_RD_W((*tt)[i - 1][0]));
-          break;
+    if (data.control == HEATER_PID) {
+      #if ENABLED(PID_FEEDFORWARD)
+        if (h < HOTENDS) heater.feedforward = get_feedforward_output(h);
+      #endif
+      #if ENABLED(PID_DEBUG) || ENABLED(PID_BED_DEBUG) || ENABLED(PID_CHAMBER_DEBUG) || ENABLED(PID_COOLER_DEBUG)
+        if (
+          #if ENABLED(PID_DEBUG)
+            h < HOTENDS ||
+          #endif
+          #if ENABLED(PID_BED_DEBUG) && HAS_TEMP_BED
+            h == BED_INDEX ||
+          #endif
+          #if ENABLED(PID_CHAMBER_DEBUG) && HAS_TEMP_CHAMBER
+            h == CHAMBER_INDEX ||
+          #endif
+          #if ENABLED(PID_COOLER_DEBUG) && HAS_TEMP_COOLER
+            h == COOLER_INDEX ||
+          #endif
+          false
+        ) {
+          SERIAL_SMV(ECHO, MSG_PID_DEBUG, (int)h);
+          SERIAL_MV(MSG_PID_DEBUG_INPUT, heater.current_temperature);
+          SERIAL_EMV(MSG_PID_DEBUG_OUTPUT, heater.soft_pwm);
         }
+      #endif // PID_DEBUG
+      continue;
+    }
+
+    #if HAS_HEATER_CHECK_INTERVAL
+      if (data.check_interval) {
+        if (PENDING(ms, heater.next_check_ms)) continue;
+        heater.next_check_ms = ms + data.check_interval;
       }
+    #endif
 
-      // Overflow: Set to last value in the table
-      if (i == heater_ttbllen_map[h]) celsius = PGM_RD_W((*tt)[i - 1][1]);
+    #if ENABLED(ADVANCED_PAUSE_FEATURE)
+      if (heater.idle_timeout_exceeded) {
+        heater.soft_pwm = 0;
+        continue;
+      }
+    #endif
 
-      return celsius;
+    // Check if temperature is within the correct range
+    if ((heater.current_temperature < data.mintemp && !is_preheating(h)) || heater.current_temperature > data.maxtemp) {
+      heater.soft_pwm = 0;
+      continue;
     }
 
-    #if HEATER_USES_AD595
-      return ((raw * (((HAL_VOLTAGE_PIN) * 100.0) / 1024.0)) * ad595_gain[h]) + ad595_offset[h];
-    #else
-      return 0;
-    #endif
-  }
+    switch (data.control) {
+      case HEATER_LIMIT_SWITCHING:
+        // Check if temperature is within the correct band
+        if (temperature >= target + data.hysteresis)
+          heater.soft_pwm = 0;
+        else if (temperature <= target - data.hysteresis)
+          heater.soft_pwm = data.power_max >> 1;
+        break;
+      default:
+        heater.soft_pwm = temperature < target ? data.power_max : 0;
+        break;
+    }
 
-#endif
+  } // HEATER_LOOP
 
-#if HAS_TEMP_BED
+  #if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
+    // Make sure measured temperatures are close together
+    if (FABS(heaters[0].current_temperature - redundant_temperature) > MAX_REDUNDANT_TEMP_SENSOR_DIFF)
+      _temp_error(0, PSTR(MSG_REDUNDANCY), PSTR(MSG_ERR_REDUNDANT_TEMP));
+  #endif
 
-  // Derived from RepRap FiveD extruder::getTemperature()
-  // For bed temperature measurement.
-  float Temperature::analog2tempBed(const int raw) {
-    #if ENABLED(BED_USES_THERMISTOR)
-      float celsius = 0;
-      byte i;
-
-      for (i = 1; i < BEDTEMPTABLE_LEN; i++) {
-        if (PGM_RD_W(BEDTEMPTABLE[i][0]) > raw) {
-          celsius  = PGM_RD_W(BEDTEMPTABLE[i - 1][1]) +
-                     (raw - PGM_RD_W(BEDTEMPTABLE[i - 1][0])) *
-                     (float)(PGM_RD_W(BEDTEMPTABLE[i][1]) - PGM_RD_W(BEDTEMPTABLE[i - 1][1])) /
-                     (float)(PGM_RD_W(BEDTEMPTABLE[i][0]) - PGM_RD_W(BEDTEMPTABLE[i - 1][0]));
-          break;
-        }
-      }
+  #if HAS_AUTO_FAN
+    if (ELAPSED(ms, next_auto_fan_check_ms)) { // only need to check fan state very infrequently
+      checkExtruderAutoFans();
+      next_auto_fan_check_ms = ms + 2500UL;
+    }
+  #endif
 
-      // Overflow: Set to last value in the table
-      if (i == BEDTEMPTABLE_LEN) celsius = PGM_RD_W(BEDTEMPTABLE[i - 1][1]);
+  // Control the extruder rate based on the width sensor
+  #if ENABLED(FILAMENT_SENSOR)
+    if (filament_sensor) {
+      meas_shift_index = filwidth_delay_index[0] - meas_delay_cm;
+      if (meas_shift_index < 0) meas_shift_index += MAX_MEASUREMENT_DELAY + 1;  //loop around buffer if needed
+      meas_shift_index = constrain(meas_shift_index, 0, MAX_MEASUREMENT_DELAY);
 
-      return celsius;
+      // Get the delayed info and add 100 to reconstitute to a percent of
+      // the nominal filament diameter then square it to get an area
+      const float vmroot = measurement_delay[meas_shift_index] * 0.01 + 1.0;
+      volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM] = vmroot <= 0.1 ? 0.01 : sq(vmroot);
+    }
+  #endif // FILAMENT_SENSOR
 
-    #elif ENABLED(BED_USES_AD595)
-      return ((raw * (((HAL_VOLTAGE_PIN) * 100.0) / 1024.0)) * TEMP_SENSOR_AD595_GAIN) + TEMP_SENSOR_AD595_OFFSET;
-    #else
-      UNUSED(raw);
-      return 0;
-    #endif
-  }
+}
 
-#endif
+// Derived from RepRap FiveD extruder::getTemperature()
+static int16_t sensor2fixed(const sensor_data_t &sensor, const int raw) {
+  if (sensor.table)
+    return thermistor2fixed(sensor.table, sensor.table_len, sensor.dense, raw);
+  if (sensor.type == -1) // AD595
+    return ((int32_t)raw * AD595_FIXED_GAIN >> 8) + AD595_FIXED_OFFSET;
+  if (sensor.type < -1) // MAX6675 and MAX31855, 0.25 degrees
+    return raw * ((TEMP_FIXED_SCALE) / 4);
+  return 0;
+}
 
-#if HAS_TEMP_CHAMBER
+static float sensor2temp(const sensor_data_t &sensor, const int raw) {
+  return sensor2fixed(sensor, raw) * (1.0 / (TEMP_FIXED_SCALE));
+}
 
-  float Temperature::analog2tempChamber(const int raw) { 
-    #if ENABLED(CHAMBER_USES_THERMISTOR)
-      float celsius = 0;
-      byte i;
-
-      for (i = 1; i < CHAMBERTEMPTABLE_LEN; i++) {
-        if (PGM_RD_W(CHAMBERTEMPTABLE[i][0]) > raw) {
-          celsius  = PGM_RD_W(CHAMBERTEMPTABLE[i - 1][1]) +
-                     (raw - PGM_RD_W(CHAMBERTEMPTABLE[i - 1][0])) *
-                     (float)(PGM_RD_W(CHAMBERTEMPTABLE[i][1]) - PGM_RD_W(CHAMBERTEMPTABLE[i - 1][1])) /
-                     (float)(PGM_RD_W(CHAMBERTEMPTABLE[i][0]) - PGM_RD_W(CHAMBERTEMPTABLE[i - 1][0]));
-          break;
-        }
-      }
+float Temperature::analog2temp(const int raw, const uint8_t h) {
+  return sensor2temp(heater_data[h].sensor, raw);
+}
 
-      // Overflow: Set to last value in the table
-      if (i == CHAMBERTEMPTABLE_LEN) celsius = PGM_RD_W(CHAMBERTEMPTABLE[i - 1][1]);
+/**
+ * The fixed rate part of the temperature control.
+ * The temperatures are converted here with integer math and the PID
+ * heaters are updated every PID_dT, however busy the main loop is.
+ * The safety checks stay in manage_temp_controller().
+ */
+void Temperature::temp_controller_isr() {
 
-      return celsius;
+  HEATER_LOOP()
+    heaters[h].current_temperature_fixed = sensor2fixed(heater_data[h].sensor, heaters[h].current_temperature_raw);
 
-    #elif ENABLED(CHAMBER_USES_AD595)
-      return ((raw * (((HAL_VOLTAGE_PIN) * 100.0) / 1024.0)) * TEMP_SENSOR_AD595_GAIN) + TEMP_SENSOR_AD595_OFFSET;
-    #else
-      UNUSED(raw);
-      return 0;
-    #endif
-  }
+  #if HAS(PID_HEATING) || HAS(PID_COOLING)
 
-#endif
+    if (pid_autotuning) return;
 
-#if HAS_TEMP_COOLER
+    HEATER_LOOP() {
+      const heater_data_t &data = heater_data[h];
+      if (data.control != HEATER_PID || !data.sensor.type) continue;
+      heater_t &heater = heaters[h];
 
-  float Temperature::analog2tempCooler(const int raw) { 
-    #if ENABLED(COOLER_USES_THERMISTOR)
-      float celsius = 0;
-      byte i;
-
-      for (i = 1; i < COOLERTEMPTABLE_LEN; i++) {
-        if (PGM_RD_W(COOLERTEMPTABLE[i][0]) > raw) {
-          celsius  = PGM_RD_W(COOLERTEMPTABLE[i - 1][1]) +
-                     (raw - PGM_RD_W(COOLERTEMPTABLE[i - 1][0])) *
-                     (float)(PGM_RD_W(COOLERTEMPTABLE[i][1]) - PGM_RD_W(COOLERTEMPTABLE[i - 1][1])) /
-                     (float)(PGM_RD_W(COOLERTEMPTABLE[i][0]) - PGM_RD_W(COOLERTEMPTABLE[i - 1][0]));
-          break;
+      #if ENABLED(ADVANCED_PAUSE_FEATURE)
+        if (heater.idle_timeout_exceeded) {
+          heater.soft_pwm = 0;
+          heater.iState = 0;
+          continue;
         }
-      }
-
-      // Overflow: Set to last value in the table
-      if (i == COOLERTEMPTABLE_LEN) celsius = PGM_RD_W(COOLERTEMPTABLE[i - 1][1]);
+      #endif
 
-      return celsius;
+      #if ENABLED(MILLISECONDS_PREHEAT_TIME)
+        const bool preheating = heater.preheating;
+      #else
+        constexpr bool preheating = false;
+      #endif
 
-    #elif ENABLED(COOLER_USES_AD595)
-      return ((raw * (((HAL_VOLTAGE_PIN) * 100.0) / 1024.0)) * TEMP_SENSOR_AD595_GAIN) + TEMP_SENSOR_AD595_OFFSET;
-    #else
-      UNUSED(raw);
-      return 0;
-    #endif
-  }
+      // Check if temperature is within the correct range
+      const int32_t temperature = heater.current_temperature_fixed;
+      if ((temperature < (int32_t)data.mintemp * (TEMP_FIXED_SCALE) && !preheating) || temperature > (int32_t)data.maxtemp * (TEMP_FIXED_SCALE))
+        heater.soft_pwm = 0;
+      else
+        heater.soft_pwm = get_pid_output(h);
+    }
 
-#endif
+  #endif
+}
 
 #if ENABLED(ARDUINO_ARCH_SAM) && !MB(RADDS)
 
@@ -1290,24 +1118,18 @@ void Temperature::manage_temp_controller() {
  */
 void Temperature::updateTemperaturesFromRawValues() {
   #if ENABLED(HEATER_0_USES_MAX6675)
-    current_temperature_raw[0] = read_max6675();
-  #endif
-  #if HAS_TEMP_HOTEND
-    HOTEND_LOOP()
-      current_temperature[h] = analog2temp(current_temperature_raw[h], h);
-  #endif
-  #if HAS_TEMP_BED
-    current_temperature_bed = analog2tempBed(current_temperature_bed_raw);
-  #endif
-  #if HAS_TEMP_CHAMBER
-    current_temperature_chamber = analog2tempChamber(current_temperature_chamber_raw);
-  #endif
-  #if HAS_TEMP_COOLER
-    current_temperature_cooler = analog2tempCooler(current_temperature_cooler_raw);
-  #endif
+    heaters[0].current_temperature_raw = read_max6675();
+  #endif
+  // Converted by temp_controller_isr()
+  HEATER_LOOP() {
+    CRITICAL_SECTION_START
+      const int16_t temperature = heaters[h].current_temperature_fixed;
+    CRITICAL_SECTION_END
+    heaters[h].current_temperature = temperature * (1.0 / (TEMP_FIXED_SCALE));
+  }
 
   #if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
-    redundant_temperature = analog2temp(redundant_temperature_raw, 1);
+    redundant_temperature = sensor2temp(redundant_sensor, redundant_temperature_raw);
   #endif
   #if ENABLED(FILAMENT_SENSOR)
     filament_width_meas = analog2widthFil();
@@ -1410,8 +1232,11 @@ void Temperature::init() {
     MCUCR = _BV(JTD);
   #endif
 
-  // Finish init of mult hotend arrays
-  HOTEND_LOOP() maxttemp[h] = maxttemp[0];
+  // Start from the raw limits of the thermistor tables
+  HEATER_LOOP() {
+    heaters[h].mintemp_raw = heater_data[h].raw_lo;
+    heaters[h].maxtemp_raw = heater_data[h].raw_hi;
+  }
 
   #if ENABLED(PIDTEMP) && ENABLED(PID_ADD_EXTRUSION_RATE)
     last_e_position = 0;
@@ -1489,268 +1314,92 @@ void Temperature::init() {
   // Wait for temperature measurement to settle
   HAL::delayMilliseconds(250);
 
-  #define TEMP_MIN_ROUTINE(NR) \
-    minttemp[NR] = HEATER_ ##NR## _MINTEMP; \
-    while (analog2temp(minttemp_raw[NR], NR) < HEATER_ ##NR## _MINTEMP) { \
-      if (HEATER_ ##NR## _RAW_LO_TEMP < HEATER_ ##NR## _RAW_HI_TEMP) \
-        minttemp_raw[NR] += OVERSAMPLENR; \
-      else \
-        minttemp_raw[NR] -= OVERSAMPLENR; \
-    }
-  #define TEMP_MAX_ROUTINE(NR) \
-    maxttemp[NR] = HEATER_ ##NR## _MAXTEMP; \
-    while (analog2temp(maxttemp_raw[NR], NR) > HEATER_ ##NR## _MAXTEMP) { \
-      if (HEATER_ ##NR## _RAW_LO_TEMP < HEATER_ ##NR## _RAW_HI_TEMP) \
-        maxttemp_raw[NR] -= OVERSAMPLENR; \
-      else \
-        maxttemp_raw[NR] += OVERSAMPLENR; \
-    }
-
-  #if HOTENDS > 0
-    #if ENABLED(HEATER_0_MINTEMP)
-      TEMP_MIN_ROUTINE(0);
-    #endif
-    #if ENABLED(HEATER_0_MAXTEMP)
-      TEMP_MAX_ROUTINE(0);
-    #endif
-    #if HOTENDS > 1
-      #if ENABLED(HEATER_1_MINTEMP)
-        TEMP_MIN_ROUTINE(1);
-      #endif
-      #if ENABLED(HEATER_1_MAXTEMP)
-        TEMP_MAX_ROUTINE(1);
-      #endif
-      #if HOTENDS > 2
-        #if ENABLED(HEATER_2_MINTEMP)
-          TEMP_MIN_ROUTINE(2);
-        #endif
-        #if ENABLED(HEATER_2_MAXTEMP)
-          TEMP_MAX_ROUTINE(2);
-        #endif
-        #if HOTENDS > 3
-          #if ENABLED(HEATER_3_MINTEMP)
-            TEMP_MIN_ROUTINE(3);
-          #endif
-          #if ENABLED(HEATER_3_MAXTEMP)
-            TEMP_MAX_ROUTINE(3);
-          #endif
-        #endif // HOTENDS > 3
-      #endif // HOTENDS > 2
-    #endif // HOTENDS > 1
-  #endif // HOTENDS > 0
-
-  #if ENABLED(BED_MINTEMP)
-    while(analog2tempBed(bed_minttemp_raw) < BED_MINTEMP) {
-      #if HEATER_BED_RAW_LO_TEMP < HEATER_BED_RAW_HI_TEMP
-        bed_minttemp_raw += OVERSAMPLENR;
-      #else
-        bed_minttemp_raw -= OVERSAMPLENR;
-      #endif
-    }
-  #endif // BED_MINTEMP
-  #if ENABLED(BED_MAXTEMP)
-    while(analog2tempBed(bed_maxttemp_raw) > BED_MAXTEMP) {
-      #if HEATER_BED_RAW_LO_TEMP < HEATER_BED_RAW_HI_TEMP
-        bed_maxttemp_raw -= OVERSAMPLENR;
-      #else
-        bed_maxttemp_raw += OVERSAMPLENR;
-      #endif
-    }
-  #endif // BED_MAXTEMP
-
-  #if ENABLED(CHAMBER_MINTEMP)
-    while(analog2tempChamber(chamber_minttemp_raw) < CHAMBER_MINTEMP) {
-      #if CHAMBER_RAW_LO_TEMP < HEATER_CHAMBER_RAW_HI_TEMP
-        chamber_minttemp_raw += OVERSAMPLENR;
-      #else
-        chamber_minttemp_raw -= OVERSAMPLENR;
-      #endif
-    }
-  #endif // CHAMBER_MINTEMP
-  #if ENABLED(CHAMBER_MAXTEMP)
-    while(analog2tempChamber(chamber_maxttemp_raw) > CHAMBER_MAXTEMP) {
-      #if CHAMBER_RAW_LO_TEMP < CHAMBER_RAW_HI_TEMP
-        chamber_maxttemp_raw -= OVERSAMPLENR;
-      #else
-        chamber_maxttemp_raw += OVERSAMPLENR;
-      #endif
-    }
-  #endif // BED_MAXTEMP
-
-  #if ENABLED(COOLER_MINTEMP)
-    while(analog2tempCooler(cooler_minttemp_raw) < COOLER_MINTEMP) {
-      #if COOLER_RAW_LO_TEMP < HEATER_COOLER_RAW_HI_TEMP
-        cooler_minttemp_raw += OVERSAMPLENR;
-      #else
-        cooler_minttemp_raw -= OVERSAMPLENR;
-      #endif
-    }
-  #endif // COOLER_MINTEMP
-  #if ENABLED(COOLER_MAXTEMP)
-    while(analog2tempCooler(cooler_maxttemp_raw) > COOLER_MAXTEMP) {
-      #if COOLER_RAW_LO_TEMP < COOLER_RAW_HI_TEMP
-        cooler_maxttemp_raw -= OVERSAMPLENR;
-      #else
-        cooler_maxttemp_raw += OVERSAMPLENR;
-      #endif
-    }
-  #endif // COOLER_MAXTEMP
-}
-
-#if WATCH_HOTENDS
-  /**
-   * Start Heating Sanity Check for hotends that are below
-   * their target temperature by a configurable margin.
-   * This is called when the temperature is set. (M104, M109)
-   */
-  void Temperature::start_watching_heater(uint8_t h) {
-    #if HOTENDS <= 1
-      UNUSED(h);
-    #endif
-    if (degHotend(HOTEND_INDEX) < degTargetHotend(HOTEND_INDEX) - (WATCH_TEMP_INCREASE + TEMP_HYSTERESIS + 1)) {
-      watch_target_temp[HOTEND_INDEX] = degHotend(HOTEND_INDEX) + WATCH_TEMP_INCREASE;
-      watch_heater_next_ms[HOTEND_INDEX] = millis() + (WATCH_TEMP_PERIOD) * 1000UL;
-    }
-    else
-      watch_heater_next_ms[HOTEND_INDEX] = 0;
-  }
-#endif
-
-#if WATCH_THE_BED
-  /**
-   * Start Heating Sanity Check for hotends that are below
-   * their target temperature by a configurable margin.
-   * This is called when the temperature is set. (M140, M190)
-   */
-  void Temperature::start_watching_bed() {
-    if (degBed() < degTargetBed() - (WATCH_BED_TEMP_INCREASE + TEMP_BED_HYSTERESIS + 1)) {
-      watch_target_bed_temp = degBed() + WATCH_BED_TEMP_INCREASE;
-      watch_bed_next_ms = millis() + (WATCH_BED_TEMP_PERIOD) * 1000UL;
-    }
-    else
-      watch_bed_next_ms = 0;
-  }
-#endif
-
-#if WATCH_THE_CHAMBER
-  /**
-   * Start Cooling Sanity Check for chamber that are below
-   * their target temperature by a configurable margin.
-   * This is called when the temperature is set. (M141)
-   */
-  void Temperature::start_watching_chamber() {
-    if (degCooler() > degTargetCooler() - (WATCH_TEMP_CHAMBER_DECREASE - TEMP_CHAMBER_HYSTERESIS - 1)) {
-      watch_target_temp_chamber = degChamber() - WATCH_CHAMBER_TEMP_DECREASE;
-      watch_chamber_next_ms = millis() + WATCH_TEMP_CHAMBER_PERIOD * 1000UL;
-    }
-    else
-      watch_chamber_next_ms = 0;
+  // Find the raw values of the Celsius limits
+  HEATER_LOOP() {
+    const heater_data_t &data = heater_data[h];
+    if (!data.sensor.table) continue;
+    const int16_t step = data.raw_lo < data.raw_hi ? OVERSAMPLENR : -OVERSAMPLENR;
+    while (analog2temp(heaters[h].mintemp_raw, h) < data.mintemp) heaters[h].mintemp_raw += step;
+    while (analog2temp(heaters[h].maxtemp_raw, h) > data.maxtemp) heaters[h].maxtemp_raw -= step;
   }
-#endif
+}
 
-#if WATCH_THE_COOLER
+#if WATCH_THE_HEATERS
   /**
-   * Start Cooling Sanity Check for hotends that are below
-   * their target temperature by a configurable margin.
-   * This is called when the temperature is set. (M142)
+   * Start Heating Sanity Check for heaters that are below
+   * their target temperature by a configurable margin,
+   * or for the cooler above it.
+   * This is called when the temperature is set. (M104, M109, M140, M190, M141, M142)
    */
-  void Temperature::start_watching_cooler() {
-    if (degCooler() > degTargetCooler() - (WATCH_TEMP_COOLER_DECREASE - TEMP_COOLER_HYSTERESIS - 1)) {
-      watch_target_temp_cooler = degCooler() - WATCH_COOLER_TEMP_DECREASE;
-      watch_cooler_next_ms = millis() + WATCH_TEMP_COOLER_PERIOD * 1000UL;
+  void Temperature::start_watching(const uint8_t h) {
+    const heater_data_t &data = heater_data[h];
+    heater_t &heater = heaters[h];
+    const float sign = data.cooler ? -1.0 : 1.0;
+    if (data.watch_period && sign * heater.current_temperature < sign * heater.target_temperature - (data.watch_increase + data.watch_hysteresis + 1)) {
+      heater.watch_target_temp = sign * heater.current_temperature + data.watch_increase;
+      heater.watch_next_ms = millis() + data.watch_period * 1000UL;
     }
     else
-      watch_cooler_next_ms = 0;
+      heater.watch_next_ms = 0;
   }
 #endif
 
-#if ENABLED(THERMAL_PROTECTION_HOTENDS) || ENABLED(THERMAL_PROTECTION_BED) || ENABLED(THERMAL_PROTECTION_CHAMBER) || ENABLED(THERMAL_PROTECTION_COOLER)
-
-  #if ENABLED(THERMAL_PROTECTION_HOTENDS)
-    Temperature::TRState Temperature::thermal_runaway_state_machine[HOTENDS] = { TRInactive };
-    millis_t Temperature::thermal_runaway_timer[HOTENDS] = { 0 };
-  #endif
-
-  #if HAS_THERMALLY_PROTECTED_BED
-    Temperature::TRState Temperature::thermal_runaway_bed_state_machine = TRInactive;
-    millis_t Temperature::thermal_runaway_bed_timer;
-  #endif
-
-  #if ENABLED(THERMAL_PROTECTION_CHAMBER) && HAS_TEMP_CHAMBER
-    Temperature::TRState Temperature::thermal_runaway_chamber_state_machine = TRReset;
-    millis_t Temperature::thermal_runaway_chamber_timer;
-  #endif
+#if HAS_THERMAL_PROTECTION
 
-  #if ENABLED(THERMAL_PROTECTION_COOLER) && HAS_TEMP_COOLER
-    Temperature::TRState Temperature::thermal_runaway_cooler_state_machine = TRReset;
-    millis_t Temperature::thermal_runaway_cooler_timer;
-  #endif
+  void Temperature::thermal_runaway_protection(const uint8_t h) {
 
-  void Temperature::thermal_runaway_protection(Temperature::TRState* state, millis_t* timer, float temperature, float target_temperature, int temp_controller_id, int period_seconds, int hysteresis_degc) {
+    const heater_data_t &data = heater_data[h];
+    heater_t &heater = heaters[h];
 
-    static float tr_target_temperature[HOTENDS + 3] = { 0.0 };
+    // The cooler runs away when it gets warmer
+    const float sign = data.cooler ? -1.0 : 1.0,
+                temperature = sign * heater.current_temperature;
 
     /*
-        SERIAL_MSG("Thermal Thermal Runaway Running. Heater ID: ");
-        if (temp_controller_id < 0) SERIAL_MSG("bed"); else SERIAL_VAL(temp_controller_id);
-        SERIAL_MV(" ;  State:", *state);
-        SERIAL_MV(" ;  Timer:", *timer);
-        SERIAL_MV(" ;  Temperature:", temperature);
-        SERIAL_EMV(" ;  Target Temp:", target_temperature);
+        SERIAL_MV("Thermal Thermal Runaway Running. Heater ID: ", (int)h);
+        SERIAL_MV(" ;  State:", heater.tr_state);
+        SERIAL_MV(" ;  Timer:", heater.tr_timer);
+        SERIAL_MV(" ;  Temperature:", heater.current_temperature);
+        SERIAL_EMV(" ;  Target Temp:", heater.target_temperature);
     */
 
-    int temp_controller_index;
-
-    if (temp_controller_id >= 0)
-      temp_controller_index = temp_controller_id;
-    else if (temp_controller_id == -1)
-      temp_controller_index = HOTENDS; // BED
-    else if (temp_controller_id == -2)
-      temp_controller_index = HOTENDS + 1; // CHAMBER
-    else
-      temp_controller_index = HOTENDS + 2; // COOLER
-
     #if ENABLED(ADVANCED_PAUSE_FEATURE)
       // If the heater idle timeout expires, restart
-      if (temp_controller_id >= 0 && heater_idle_timeout_exceeded[temp_controller_id]) {
-        *state = TRInactive;
-        tr_target_temperature[temp_controller_index] = 0;
+      if (heater.idle_timeout_exceeded) {
+        heater.tr_state = TRInactive;
+        heater.tr_target_temperature = 0;
       }
-      #if HAS_TEMP_BED
-        else if (heater_id == -1 && bed_idle_timeout_exceeded) {
-          *state = TRInactive;
-          tr_target_temperature[temp_controller_index] = 0;
-        }
-      #endif
       else
     #endif
     // If the target temperature changes, restart
-    if (tr_target_temperature[temp_controller_index] != target_temperature) {
-      tr_target_temperature[temp_controller_index] = target_temperature;
-      *state = target_temperature > 0 ? TRFirstHeating : TRInactive;
+    if (heater.tr_target_temperature != heater.target_temperature) {
+      heater.tr_target_temperature = heater.target_temperature;
+      heater.tr_state = heater.target_temperature > 0 ? TRFirstHeating : TRInactive;
     }
 
-    switch (*state) {
+    const float target = sign * heater.tr_target_temperature;
+
+    switch (heater.tr_state) {
       // Inactive state waits for a target temperature to be set
       case TRInactive: break;
       // When first heating, wait for the temperature to be reached then go to Stable state
       case TRFirstHeating:
-        if (temperature < tr_target_temperature[temp_controller_index]) break;
-        *state = TRStable;
+        if (temperature < target) break;
+        heater.tr_state = TRStable;
       // While the temperature is stable watch for a bad temperature
       case TRStable:
-        if (temperature >= tr_target_temperature[temp_controller_index] - hysteresis_degc) {
-          *timer = millis() + period_seconds * 1000UL;
+        if (temperature >= target - data.tr_hysteresis) {
+          heater.tr_timer = millis() + data.tr_period * 1000UL;
           break;
         }
-        else if (PENDING(millis(), *timer)) break;
-        *state = TRRunaway;
+        else if (PENDING(millis(), heater.tr_timer)) break;
+        heater.tr_state = TRRunaway;
       case TRRunaway:
-        _temp_error(temp_controller_id, PSTR(MSG_T_THERMAL_RUNAWAY), PSTR(MSG_THERMAL_RUNAWAY));
+        _temp_error(h, PSTR(MSG_T_THERMAL_RUNAWAY), PSTR(MSG_THERMAL_RUNAWAY));
     }
   }
 
-#endif // THERMAL_PROTECTION_HOTENDS || THERMAL_PROTECTION_BED
+#endif // HAS_THERMAL_PROTECTION
 
 void Temperature::disable_all_heaters() {
 
@@ -1758,59 +1407,34 @@ void Temperature::disable_all_heaters() {
     planner.autotemp_enabled = false;
   #endif
 
-  #if HAS_TEMP_HOTEND
-    HOTEND_LOOP() setTargetHotend(0, h);
-  #endif
-  #if HAS_TEMP_BED
-    setTargetBed(0);
-  #endif
-  #if HAS_TEMP_CHAMBER
-    setTargetChamber(0);
-  #endif
+  // The cooler is the last heater and is disabled by disable_all_coolers()
+  for (uint8_t h = 0; h < _COOLER_INDEX; h++) {
+    heaters[h].target_temperature = 0;
+    heaters[h].soft_pwm = 0;
+  }
 
   // If all heaters go down then for sure our print job has stopped
   print_job_counter.stop();
 
-  #define DISABLE_HEATER(NR) { \
-    setTargetHotend(0, NR); \
-    soft_pwm[NR] = 0; \
-    WRITE_HEATER_ ##NR (LOW); \
-  }
-
   #if HAS_TEMP_HOTEND
-
-    target_temperature[0] = 0;
-    soft_pwm[0] = 0;
-    WRITE_HEATER_0P(LOW); // Should HEATERS_PARALLEL apply here? Then change to DISABLE_HEATER(0)
-
+    WRITE_HEATER_0P(LOW); // Should HEATERS_PARALLEL apply here? Then change to WRITE_HEATER_0(LOW)
     #if HOTENDS > 1 && HAS_TEMP_1
-      DISABLE_HEATER(1);
+      WRITE_HEATER_1(LOW);
     #endif
-
     #if HOTENDS > 2 && HAS_TEMP_2
-      DISABLE_HEATER(2);
+      WRITE_HEATER_2(LOW);
     #endif
-
     #if HOTENDS > 3 && HAS_TEMP_3
-      DISABLE_HEATER(3);
+      WRITE_HEATER_3(LOW);
     #endif
-
   #endif
 
-  #if HAS_TEMP_BED
-    target_temperature_bed = 0;
-    soft_pwm_bed = 0;
-    #if HAS_HEATER_BED
-      WRITE_HEATER_BED(LOW);
-    #endif
+  #if HAS_TEMP_BED && HAS_HEATER_BED
+    WRITE_HEATER_BED(LOW);
   #endif
 
-  #if HAS_TEMP_CHAMBER
-    target_temperature_chamber = 0;
-    soft_pwm_chamber = 0;
-    #if HAS_HEATER_CHAMBER
-      WRITE_HEATER_CHAMBER(LOW);
-    #endif
+  #if HAS_TEMP_CHAMBER && HAS_HEATER_CHAMBER
+    WRITE_HEATER_CHAMBER(LOW);
   #endif
 }
 
@@ -1826,12 +1450,9 @@ void Temperature::disable_all_heaters() {
       laser_extinguish();
     #endif
 
-    #if HAS_TEMP_COOLER
-      target_temperature_cooler = 0;
-      soft_pwm_chamber = 0;
-      #if HAS_COOLER && !ENABLED(FAST_PWM_COOLER)
-        WRITE_COOLER(LOW);
-      #endif
+    heaters[COOLER_INDEX].soft_pwm = 0;
+    #if HAS_COOLER && !ENABLED(FAST_PWM_COOLER)
+      WRITE_COOLER(LOW);
     #endif
   }
 #endif
@@ -1931,138 +1552,75 @@ void Temperature::disable_all_heaters() {
 
 void Temperature::set_current_temp_raw() {
 
+  #if ENABLED(ADC_DMA)
+    // Take the values only when the ADC interrupt published new ones
+    int16_t adc_values[ANALOG_INPUTS];
+    if (!HAL::analogReadValues(adc_values)) return;
+    #define ANALOG_INPUT_VALUE(I) adc_values[I]
+  #else
+    #define ANALOG_INPUT_VALUE(I) HAL::AnalogInputValues[I]
+  #endif
+
   #if HAS_TEMP_HOTEND
-    current_temperature_raw[0] = HAL::AnalogInputValues[HOT0_SENSOR_INDEX];
+    heaters[0].current_temperature_raw = ANALOG_INPUT_VALUE(HOT0_SENSOR_INDEX);
   #endif
   #if HAS_TEMP_1
     #if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
-      redundant_temperature_raw = HAL::AnalogInputValues[HOT1_SENSOR_INDEX];
+      redundant_temperature_raw = ANALOG_INPUT_VALUE(HOT1_SENSOR_INDEX);
     #else
-      current_temperature_raw[1] = HAL::AnalogInputValues[HOT1_SENSOR_INDEX];
+      heaters[1].current_temperature_raw = ANALOG_INPUT_VALUE(HOT1_SENSOR_INDEX);
     #endif
     #if HAS_TEMP_2
-      current_temperature_raw[2] = HAL::AnalogInputValues[HOT2_SENSOR_INDEX];
+      heaters[2].current_temperature_raw = ANALOG_INPUT_VALUE(HOT2_SENSOR_INDEX);
       #if HAS_TEMP_3
-        current_temperature_raw[3] = HAL::AnalogInputValues[HOT3_SENSOR_INDEX];
+        heaters[3].current_temperature_raw = ANALOG_INPUT_VALUE(HOT3_SENSOR_INDEX);
       #endif
     #endif
   #endif
 
   #if HAS_TEMP_BED
-    current_temperature_bed_raw = HAL::AnalogInputValues[BED_SENSOR_INDEX];
+    heaters[BED_INDEX].current_temperature_raw = ANALOG_INPUT_VALUE(BED_SENSOR_INDEX);
   #endif
   #if HAS_TEMP_CHAMBER
-    current_temperature_chamber_raw = HAL::AnalogInputValues[CHAMBER_SENSOR_INDEX];
+    heaters[CHAMBER_INDEX].current_temperature_raw = ANALOG_INPUT_VALUE(CHAMBER_SENSOR_INDEX);
   #endif
   #if HAS_TEMP_COOLER
-    current_temperature_cooler_raw = HAL::AnalogInputValues[COOLER_SENSOR_INDEX];
+    heaters[COOLER_INDEX].current_temperature_raw = ANALOG_INPUT_VALUE(COOLER_SENSOR_INDEX);
   #endif
 
   #if HAS_POWER_CONSUMPTION_SENSOR
-    current_raw_powconsumption = HAL::AnalogInputValues[POWER_SENSOR_INDEX];
+    current_raw_powconsumption = ANALOG_INPUT_VALUE(POWER_SENSOR_INDEX);
   #endif
 
   #if ENABLED(ARDUINO_ARCH_SAM) && !MB(RADDS)
-    current_temperature_mcu_raw = HAL::AnalogInputValues[MCU_SENSOR_INDEX];
+    current_temperature_mcu_raw = ANALOG_INPUT_VALUE(MCU_SENSOR_INDEX);
   #endif
 
-  #if HAS_TEMP_HOTEND
-
-    int constexpr temp_dir[] = {
-      #if ENABLED(HEATER_0_USES_MAX6675)
-         0
-      #elif HEATER_0_RAW_LO_TEMP > HEATER_0_RAW_HI_TEMP
-        -1
-      #else
-         1
-      #endif
-      #if HAS_TEMP_1 && HOTENDS > 1
-        #if HEATER_1_RAW_LO_TEMP > HEATER_1_RAW_HI_TEMP
-          , -1
-        #else
-          ,  1
-        #endif
-      #endif
-      #if HAS_TEMP_2 && HOTENDS > 2
-        #if HEATER_2_RAW_LO_TEMP > HEATER_2_RAW_HI_TEMP
-          , -1
-        #else
-          ,  1
-        #endif
-      #endif
-      #if HAS_TEMP_3 && HOTENDS > 3
-        #if HEATER_3_RAW_LO_TEMP > HEATER_3_RAW_HI_TEMP
-          , -1
-        #else
-          ,  1
-        #endif
-      #endif
-    };
-
-    for (uint8_t h = 0; h < COUNT(temp_dir); h++) {
-      const int16_t tdir = temp_dir[h], rawtemp = current_temperature_raw[h] * tdir;
-      if (rawtemp > maxttemp_raw[h] * tdir && target_temperature[h] > 0) max_temp_error(h);
-      if (rawtemp < minttemp_raw[h] * tdir && !is_preheating(h) && target_temperature[h] > 0) {
-        #if ENABLED(MAX_CONSECUTIVE_LOW_TEMPERATURE_ERROR_ALLOWED)
-          if (++consecutive_low_temperature_error[h] >= MAX_CONSECUTIVE_LOW_TEMPERATURE_ERROR_ALLOWED)
-        #endif
-            min_temp_error(h);
-      }
-      #if ENABLED(MAX_CONSECUTIVE_LOW_TEMPERATURE_ERROR_ALLOWED)
-        else
-          consecutive_low_temperature_error[h] = 0;
-      #endif
-    }
-
+  #if ENABLED(HEATER_0_USES_MAX6675)
+    #define FIRST_ANALOG_HEATER 1
+  #else
+    #define FIRST_ANALOG_HEATER 0
   #endif
 
-  #if HAS_TEMP_BED
+  // Check the raw values against the limits, the thermocouples are checked in manage_temp_controller()
+  for (uint8_t h = FIRST_ANALOG_HEATER; h < HEATER_COUNT; h++) {
+    const heater_data_t &data = heater_data[h];
+    heater_t &heater = heaters[h];
+    if (!data.sensor.type) continue;
 
-    #if HEATER_BED_RAW_LO_TEMP > HEATER_BED_RAW_HI_TEMP
-      #define GEBED <=
-    #else
-      #define GEBED >=
-    #endif
-    if (current_temperature_bed_raw GEBED bed_maxttemp_raw) max_temp_error(-1);
-    if (bed_minttemp_raw GEBED current_temperature_bed_raw && target_temperature_bed > 0) {
+    const int16_t tdir = data.raw_lo > data.raw_hi ? -1 : 1,
+                  rawtemp = heater.current_temperature_raw * tdir;
+    if (rawtemp > heater.maxtemp_raw * tdir) max_temp_error(h);
+    if (rawtemp < heater.mintemp_raw * tdir && !is_preheating(h) && heater.target_temperature > 0) {
       #if ENABLED(MAX_CONSECUTIVE_LOW_TEMPERATURE_ERROR_ALLOWED)
-        if (++consecutive_bed_low_temperature_error >= MAX_CONSECUTIVE_LOW_TEMPERATURE_ERROR_ALLOWED)
+        if (++heater.consecutive_low_temperature_error >= MAX_CONSECUTIVE_LOW_TEMPERATURE_ERROR_ALLOWED)
       #endif
-          min_temp_error(-1);
+          min_temp_error(h);
     }
     #if ENABLED(MAX_CONSECUTIVE_LOW_TEMPERATURE_ERROR_ALLOWED)
       else
-        consecutive_bed_low_temperature_error = 0;
-    #endif
-
-  #endif
-
-  #if HAS_TEMP_CHAMBER
-
-    #if HEATER_CHAMBER_RAW_LO_TEMP > HEATER_CHAMBER_RAW_HI_TEMP
-      #define GECHAMBER <=
-    #else
-      #define GECHAMBER >=
-    #endif
-    if (current_temperature_chamber_raw GECHAMBER chamber_maxttemp_raw)
-      _temp_error(-2, PSTR(MSG_T_MAXTEMP), PSTR(MSG_ERR_MAXTEMP_CHAMBER));
-    if (chamber_minttemp_raw GECHAMBER current_temperature_chamber_raw && target_temperature_chamber > 0)
-      _temp_error(-2, PSTR(MSG_T_MINTEMP), PSTR(MSG_ERR_MINTEMP_CHAMBER));
-
-  #endif
-
-  #if HAS_TEMP_COOLER
-
-    #if COOLER_RAW_LO_TEMP > COOLER_RAW_HI_TEMP
-      #define GECOOLER <=
-    #else
-      #define GECOOLER >=
+        heater.consecutive_low_temperature_error = 0;
     #endif
-    if (current_temperature_cooler_raw GECOOLER cooler_maxttemp_raw)
-      _temp_error(-3, PSTR(MSG_T_MAXTEMP), PSTR(MSG_ERR_MAXTEMP_COOLER));
-    if (cooler_minttemp_raw GECOOLER current_temperature_cooler_raw && target_temperature_cooler > 0)
-      _temp_error(-3, PSTR(MSG_T_MINTEMP), PSTR(MSG_ERR_MINTEMP_COOLER));
-
-  #endif
+  }
 
 }
@@ -39,6 +39,111 @@
   #define EXTRUDER_IDX  active_extruder
 #endif
 
+/**
+ * Heater indexes
+ * The hotends come first, then the bed, the chamber and the cooler
+ * if they have a temperature sensor.
+ */
+#if HAS_TEMP_BED
+  #define BED_INDEX       HOTENDS
+  #define _CHAMBER_INDEX  (HOTENDS + 1)
+#else
+  #define _CHAMBER_INDEX  HOTENDS
+#endif
+#if HAS_TEMP_CHAMBER
+  #define CHAMBER_INDEX   _CHAMBER_INDEX
+  #define _COOLER_INDEX   (_CHAMBER_INDEX + 1)
+#else
+  #define _COOLER_INDEX   _CHAMBER_INDEX
+#endif
+#if HAS_TEMP_COOLER
+  #define COOLER_INDEX    _COOLER_INDEX
+  #define HEATER_COUNT    (_COOLER_INDEX + 1)
+#else
+  #define HEATER_COUNT    _COOLER_INDEX
+#endif
+
+#define HEATER_LOOP() for (uint8_t h = 0; h < HEATER_COUNT; h++)
+
+// The HAL temperature ISR runs temp_controller_isr() every 390 ticks, about 100ms
+#define PID_dT (390.0 / (TEMP_TIMER_FREQUENCY))
+
+// Bang-bang controlled bed, chamber or cooler, checked every *_CHECK_INTERVAL
+#define HAS_HEATER_CHECK_INTERVAL ((HAS_TEMP_BED && DISABLED(PIDTEMPBED)) || (HAS_TEMP_CHAMBER && DISABLED(PIDTEMPCHAMBER)) || (HAS_TEMP_COOLER && DISABLED(PIDTEMPCOOLER)))
+
+#if HAS_THERMAL_PROTECTION
+  typedef enum TRState { TRInactive, TRFirstHeating, TRStable, TRRunaway } TRstate;
+#endif
+
+/**
+ * Heater state
+ * The controller runs the same code for every heater, what differs
+ * between hotends, bed, chamber and cooler is in heater_data of temperature.cpp.
+ */
+typedef struct {
+  float     current_temperature;
+  int16_t   current_temperature_raw,
+            current_temperature_fixed,  // 1/16 degrees, converted by temp_controller_isr()
+            target_temperature;
+  uint8_t   soft_pwm;
+
+  #if HAS(PID_HEATING) || HAS(PID_COOLING)
+    float   Kp, Ki, Kd, Kc;
+    // Fixed point gains found by updatePID() and state of temp_controller_isr()
+    int32_t Kp_fixed, Ki_fixed, Kd_fixed,
+            iState, iState_min, iState_max;
+    int16_t dState[4];
+    uint8_t pid_pointer;
+    #if ENABLED(PIDTEMP) && ENABLED(PID_ADD_EXTRUSION_RATE)
+      int32_t Kc_fixed;     // Kc per step of the extruder, found by updatePID()
+    #endif
+  #endif
+
+  #if ENABLED(PID_FEEDFORWARD)
+    // Thermal model of a hotend, found by PID_autotune() or set by M307
+    float   heater_power,   // W at full power
+            heat_capacity,  // J/K
+            ambient_loss,   // W/K
+            fan_loss,       // W/K more with the part cooling fan at full speed
+            filament_heat,  // J/K per mm of filament
+            ambient_temp;   // C
+    uint8_t feedforward;    // Power the model predicts, added to the PID output by temp_controller_isr()
+  #endif
+
+  // Found from the Celsius limits in Temperature::init()
+  int16_t   mintemp_raw,
+            maxtemp_raw;
+
+  #if ENABLED(MAX_CONSECUTIVE_LOW_TEMPERATURE_ERROR_ALLOWED)
+    uint8_t consecutive_low_temperature_error;
+  #endif
+
+  #if HAS_HEATER_CHECK_INTERVAL
+    millis_t next_check_ms;
+  #endif
+
+  #if ENABLED(MILLISECONDS_PREHEAT_TIME)
+    millis_t preheat_end_time;
+    bool     preheating;  // is_preheating() for temp_controller_isr(), updated by manage_temp_controller()
+  #endif
+
+  #if WATCH_THE_HEATERS
+    int16_t   watch_target_temp;  // Negated for the cooler
+    millis_t  watch_next_ms;
+  #endif
+
+  #if HAS_THERMAL_PROTECTION
+    TRState   tr_state;
+    millis_t  tr_timer;
+    int16_t   tr_target_temperature;
+  #endif
+
+  #if ENABLED(ADVANCED_PAUSE_FEATURE)
+    millis_t  idle_timeout_ms;
+    bool      idle_timeout_exceeded;
+  #endif
+} heater_t;
+
 class Temperature {
 
   public:
@@ -46,34 +151,8 @@ class Temperature {
     #if ENABLED(FILAMENT_SENSOR)
       static int16_t    current_raw_filwidth;  // Holds measured filament diameter - one extruder only
     #endif
-    
-    #if HAS_TEMP_HOTEND
-      static float      current_temperature[HOTENDS];
-      static int16_t    current_temperature_raw[HOTENDS],
-                        target_temperature[HOTENDS];
-      static uint8_t    soft_pwm[HOTENDS];
-    #endif
-    
-    #if HAS_TEMP_BED
-      static float    current_temperature_bed;
-      static int16_t  current_temperature_bed_raw,
-                      target_temperature_bed;
-      static uint8_t  soft_pwm_bed;
-    #endif
 
-    #if HAS_TEMP_CHAMBER
-      static float    current_temperature_chamber;
-      static int16_t  target_temperature_chamber,
-                      current_temperature_chamber_raw;
-      static uint8_t  soft_pwm_chamber;
-    #endif
-
-    #if HAS_TEMP_COOLER
-      static float    current_temperature_cooler;
-      static int16_t  target_temperature_cooler,
-                      current_temperature_cooler_raw;
-      static uint8_t  soft_pwm_cooler;
-    #endif
+    static heater_t heaters[HEATER_COUNT];
 
     #if ENABLED(ARDUINO_ARCH_SAM) && !MB(RADDS)
       static float    current_temperature_mcu,
@@ -91,49 +170,14 @@ class Temperature {
       static float    redundant_temperature;
     #endif
 
-    #if ENABLED(PIDTEMP) || ENABLED(PIDTEMPBED) || ENABLED(PIDTEMPCHAMBER) || ENABLED(PIDTEMPCOOLER)
-
-      static float Kp[HOTENDS], Ki[HOTENDS], Kd[HOTENDS], Kc[HOTENDS];
-      #define PID_PARAM(param, h) Temperature::param[h]
-
-    #endif
-
-    #if ENABLED(PIDTEMPBED)
-      static float bedKp, bedKi, bedKd;
-    #endif
-
-    #if ENABLED(PIDTEMPCHAMBER)
-      static float chamberKp, chamberKi, chamberKd;
-    #endif
-
-    #if ENABLED(PIDTEMPCOOLER)
-      static float coolerKp, coolerKi, coolerKd;
+    #if HAS(PID_HEATING) || HAS(PID_COOLING)
+      #define PID_PARAM(param, h) Temperature::heaters[h].param
     #endif
 
     #if ENABLED(BABYSTEPPING)
       static volatile int babystepsTodo[3];
     #endif
 
-    #if WATCH_HOTENDS
-      static uint16_t watch_target_temp[HOTENDS];
-      static millis_t watch_heater_next_ms[HOTENDS];
-    #endif
-
-    #if WATCH_THE_BED
-      static uint16_t watch_target_bed_temp;
-      static millis_t watch_bed_next_ms;
-    #endif
-
-    #if WATCH_THE_CHAMBER
-      static uint16_t watch_target_temp_chamber = 0;
-      static millis_t watch_chamber_next_ms = 0;
-    #endif
-
-    #if WATCH_THE_COOLER
-      static uint16_t watch_target_temp_cooler = 0;
-      static millis_t watch_cooler_next_ms = 0;
-    #endif
-
     #if HAS_EXTRUDERS && ENABLED(PREVENT_COLD_EXTRUSION)
       static bool allow_cold_extrude;
       static int16_t extrude_min_temp;
@@ -151,101 +195,16 @@ class Temperature {
 
     #if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
       static int redundant_temperature_raw;
-      static float redundant_temperature;
-    #endif
-
-    #if ENABLED(PIDTEMP)
-      static float  temp_iState[HOTENDS],
-                    temp_dState[HOTENDS][4],
-                    temp_iState_min[HOTENDS],
-                    temp_iState_max[HOTENDS],
-                    pid_error[HOTENDS];
-
-      #if ENABLED(PID_ADD_EXTRUSION_RATE)
-        static float cTerm[HOTENDS];
-        static long last_e_position;
-        static long lpq[LPQ_MAX_LEN];
-        static int lpq_ptr;
-      #endif
-
-      static uint8_t pid_pointer[HOTENDS];
-    #endif
-
-    #if ENABLED(PIDTEMPBED)
-      static float  temp_iState_bed,
-                    temp_dState_bed[4],
-                    temp_iState_bed_min,
-                    temp_iState_bed_max,
-                    pid_error_bed;
-
-      static uint8_t pid_pointer_bed;
-    #else
-      static millis_t next_bed_check_ms;
-    #endif
-
-    #if ENABLED(PIDTEMPCHAMBER)
-      static float  temp_iState_chamber,
-                    temp_dState_chamber[4],
-                    temp_iState_chamber_min,
-                    temp_iState_chamber_max,
-                    pid_error_chamber;
-
-      static uint8_t pid_pointer_chamber;
-    #else
-      static millis_t next_chamber_check_ms;
-    #endif
-
-    #if ENABLED(PIDTEMPCOOLER)
-      static float  temp_iState_cooler,
-                    temp_dState_cooler[4],
-                    temp_iState_cooler_min,
-                    temp_iState_cooler_max,
-                    pid_error_cooler;
-
-      static uint8_t pid_pointer_cooler;
-    #else
-      static millis_t next_cooler_check_ms;
-    #endif
-
-    // Init min and max temp with extreme values to prevent false errors during startup
-    static int16_t  minttemp_raw[HOTENDS],
-                    maxttemp_raw[HOTENDS],
-                    minttemp[HOTENDS],
-                    maxttemp[HOTENDS];
-
-    #if ENABLED(MAX_CONSECUTIVE_LOW_TEMPERATURE_ERROR_ALLOWED)
-      static uint8_t consecutive_low_temperature_error[HOTENDS];
-      #if HAS_TEMP_BED
-        static uint8_t consecutive_bed_low_temperature_error;
-      #endif
-    #endif
-
-    #if ENABLED(MILLISECONDS_PREHEAT_TIME)
-      static millis_t preheat_end_time[HOTENDS];
-    #endif
-
-    #if ENABLED(BED_MINTEMP)
-      static int16_t bed_minttemp_raw;
-    #endif
-
-    #if ENABLED(BED_MAXTEMP)
-      static int16_t bed_maxttemp_raw;
-    #endif
-
-    #if ENABLED(CHAMBER_MINTEMP)
-      static int16_t chamber_minttemp_raw;
     #endif
 
-    #if ENABLED(CHAMBER_MAXTEMP)
-      static int16_t chamber_maxttemp_raw;
-    #endif
-
-    #if ENABLED(COOLER_MINTEMP)
-      static int16_t cooler_minttemp_raw;
+    #if HAS(PID_HEATING) || HAS(PID_COOLING)
+      static volatile bool pid_autotuning;  // PID_autotune drives the output
     #endif
 
-    #if ENABLED(COOLER_MAXTEMP)
-      static int16_t cooler_maxttemp_raw;
+    #if ENABLED(PIDTEMP) && ENABLED(PID_ADD_EXTRUSION_RATE)
+      static long last_e_position;
+      static long lpq[LPQ_MAX_LEN];
+      static int lpq_ptr;
     #endif
 
     #if ENABLED(FILAMENT_SENSOR)
@@ -256,15 +215,6 @@ class Temperature {
       static millis_t next_auto_fan_check_ms;
     #endif
 
-    #if ENABLED(ADVANCED_PAUSE_FEATURE)
-      static millis_t heater_idle_timeout_ms[HOTENDS];
-      static bool heater_idle_timeout_exceeded[HOTENDS];
-      #if HAS_TEMP_BED
-        static millis_t bed_idle_timeout_ms;
-        static bool bed_idle_timeout_exceeded;
-      #endif
-    #endif
-
   public:
 
     /**
@@ -278,18 +228,7 @@ class Temperature {
     /**
      * Static (class) methods
      */
-    #if HAS_TEMP_HOTEND
-      static float analog2temp(const int raw, uint8_t h);
-    #endif
-    #if HAS_TEMP_BED
-      static float analog2tempBed(const int raw);
-    #endif
-    #if HAS_TEMP_CHAMBER
-      static float analog2tempChamber(const int raw);
-    #endif
-    #if HAS_TEMP_COOLER
-      static float analog2tempCooler(const int raw);
-    #endif
+    static float analog2temp(const int raw, const uint8_t h);
     #if ENABLED(ARDUINO_ARCH_SAM) && !MB(RADDS)
       static float analog2tempMCU(const int raw);
     #endif
@@ -299,37 +238,35 @@ class Temperature {
      */
     static void set_current_temp_raw();
 
+    /**
+     * Called from the Temperature ISR every PID_dT to convert
+     * the temperatures and update the output of the PID heaters
+     */
+    static void temp_controller_isr();
+
     /**
      * Call periodically to manage temp controller
+     * (safety checks and the heaters without PID)
      */
     static void manage_temp_controller();
 
     /**
      * Preheating hotends
      */
-    #if HAS_TEMP_HOTEND
-      #if ENABLED(MILLISECONDS_PREHEAT_TIME)
-        static bool is_preheating(uint8_t h) {
-          #if HOTENDS <= 1
-            UNUSED(h);
-          #endif
-          return preheat_end_time[HOTEND_INDEX] && PENDING(millis(), preheat_end_time[HOTEND_INDEX]);
-        }
-        static void start_preheat_time(uint8_t h) {
-          #if HOTENDS <= 1
-            UNUSED(h);
-          #endif
-          preheat_end_time[HOTEND_INDEX] = millis() + MILLISECONDS_PREHEAT_TIME;
-        }
-        static void reset_preheat_time(uint8_t h) {
-          #if HOTENDS <= 1
-            UNUSED(h);
-          #endif
-          preheat_end_time[HOTEND_INDEX] = 0;
-        }
-      #else
-        #define is_preheating(n) (false)
-      #endif
+    #if ENABLED(MILLISECONDS_PREHEAT_TIME)
+      static bool is_preheating(const uint8_t h) {
+        return heaters[h].preheat_end_time && PENDING(millis(), heaters[h].preheat_end_time);
+      }
+      static void start_preheat_time(const uint8_t h) {
+        heaters[h].preheat_end_time = millis() + MILLISECONDS_PREHEAT_TIME;
+        heaters[h].preheating = true;
+      }
+      static void reset_preheat_time(const uint8_t h) {
+        heaters[h].preheat_end_time = 0;
+        heaters[h].preheating = false;
+      }
+    #else
+      #define is_preheating(n) (false)
     #endif
 
     #if HAS_FILAMENT_SENSOR
@@ -356,7 +293,7 @@ class Temperature {
         #if HOTENDS <= 1
           UNUSED(h);
         #endif
-        return current_temperature[HOTEND_INDEX];
+        return heaters[HOTEND_INDEX].current_temperature;
       }
     #else
       static float degHotend(uint8_t h) {
@@ -365,15 +302,15 @@ class Temperature {
       }
     #endif
     #if HAS_TEMP_BED
-      static float degBed() { return current_temperature_bed; }
+      static float degBed() { return heaters[BED_INDEX].current_temperature; }
     #else
       static float degBed() { return 0.0; }
     #endif
     #if HAS_TEMP_CHAMBER
-      static float degChamber() { return current_temperature_chamber; }
+      static float degChamber() { return heaters[CHAMBER_INDEX].current_temperature; }
     #endif
     #if HAS_TEMP_COOLER
-      static float degCooler() { return current_temperature_cooler; }
+      static float degCooler() { return heaters[COOLER_INDEX].current_temperature; }
     #endif
 
     #if ENABLED(SHOW_TEMP_ADC_VALUES)
@@ -382,17 +319,17 @@ class Temperature {
           #if HOTENDS <= 1
             UNUSED(h);
           #endif
-          return current_temperature_raw[HOTEND_INDEX];
+          return heaters[HOTEND_INDEX].current_temperature_raw;
         }
       #endif
       #if HAS_TEMP_BED
-        static int16_t rawBedTemp() { return current_temperature_bed_raw; }
+        static int16_t rawBedTemp() { return heaters[BED_INDEX].current_temperature_raw; }
       #endif
       #if HAS_TEMP_CHAMBER
-        static int16_t rawChamberTemp() { return current_temperature_chamber_raw; }
+        static int16_t rawChamberTemp() { return heaters[CHAMBER_INDEX].current_temperature_raw; }
       #endif
       #if HAS_TEMP_COOLER
-        static int16_t rawCoolerTemp() { return current_temperature_cooler_raw; }
+        static int16_t rawCoolerTemp() { return heaters[COOLER_INDEX].current_temperature_raw; }
       #endif
       #if ENABLED(ARDUINO_ARCH_SAM) && !MB(RADDS)
         static float rawMCUTemp() { return current_temperature_mcu_raw; }
@@ -404,7 +341,7 @@ class Temperature {
         #if HOTENDS <= 1
           UNUSED(h);
         #endif
-        return target_temperature[HOTEND_INDEX];
+        return heaters[HOTEND_INDEX].target_temperature;
       }
     #else
       static int16_t degTargetHotend(uint8_t h) {
@@ -413,28 +350,31 @@ class Temperature {
       }
     #endif
     #if HAS_TEMP_BED
-      static int16_t degTargetBed() { return target_temperature_bed; }
+      static int16_t degTargetBed() { return heaters[BED_INDEX].target_temperature; }
     #else
       static int16_t degTargetBed() { return 0; }
     #endif
     #if HAS_TEMP_CHAMBER
-      static int16_t degTargetChamber() { return target_temperature_chamber; }
+      static int16_t degTargetChamber() { return heaters[CHAMBER_INDEX].target_temperature; }
     #endif
     #if HAS_TEMP_COOLER
-      static int16_t degTargetCooler() { return target_temperature_cooler; }
+      static int16_t degTargetCooler() { return heaters[COOLER_INDEX].target_temperature; }
     #endif
 
+    #if WATCH_THE_HEATERS
+      static void start_watching(const uint8_t h);
+    #endif
     #if WATCH_HOTENDS
-      static void start_watching_heater(uint8_t h = 0);
+      static void start_watching_heater(uint8_t h = 0) { start_watching(h); }
     #endif
     #if WATCH_THE_BED
-      static void start_watching_bed();
+      static void start_watching_bed() { start_watching(BED_INDEX); }
     #endif
     #if WATCH_THE_CHAMBER
-      void start_watching_chamber();
+      static void start_watching_chamber() { start_watching(CHAMBER_INDEX); }
     #endif
     #if WATCH_THE_COOLER
-      void start_watching_cooler();
+      static void start_watching_cooler() { start_watching(COOLER_INDEX); }
     #endif
 
     #if HAS_TEMP_HOTEND
@@ -445,10 +385,10 @@ class Temperature {
         #if ENABLED(MILLISECONDS_PREHEAT_TIME)
           if (celsius == 0)
             reset_preheat_time(HOTEND_INDEX);
-          else if (target_temperature[HOTEND_INDEX] == 0)
+          else if (heaters[HOTEND_INDEX].target_temperature == 0)
             start_preheat_time(HOTEND_INDEX);
         #endif
-        target_temperature[HOTEND_INDEX] = celsius;
+        heaters[HOTEND_INDEX].target_temperature = celsius;
         #if WATCH_HOTENDS
           start_watching_heater(HOTEND_INDEX);
         #endif
@@ -457,9 +397,9 @@ class Temperature {
     #if HAS_TEMP_BED
       static void setTargetBed(const int16_t celsius) {
         #if ENABLED(BED_MAXTEMP)
-          target_temperature_bed = min(celsius, BED_MAXTEMP);
+          heaters[BED_INDEX].target_temperature = min(celsius, BED_MAXTEMP);
         #else
-          target_temperature_bed = celsius;
+          heaters[BED_INDEX].target_temperature = celsius;
         #endif
         #if WATCH_THE_BED
           start_watching_bed();
@@ -469,9 +409,9 @@ class Temperature {
     #if HAS_TEMP_CHAMBER
       static void setTargetChamber(const int16_t celsius) {
         #if ENABLED(CHAMBER_MAXTEMP)
-          target_temperature_chamber = min(celsius, CHAMBER_MAXTEMP);
+          heaters[CHAMBER_INDEX].target_temperature = min(celsius, CHAMBER_MAXTEMP);
         #else
-          target_temperature_chamber = celsius;
+          heaters[CHAMBER_INDEX].target_temperature = celsius;
         #endif
         #if WATCH_THE_CHAMBER
           start_watching_chamber();
@@ -481,9 +421,9 @@ class Temperature {
     #if HAS_TEMP_COOLER
       static void setTargetCooler(const int16_t celsius) {
         #if ENABLED(COOLER_MAXTEMP)
-          target_temperature_cooler = min(celsius, COOLER_MAXTEMP);
+          heaters[COOLER_INDEX].target_temperature = min(celsius, COOLER_MAXTEMP);
         #else
-          target_temperature_cooler = celsius;
+          heaters[COOLER_INDEX].target_temperature = celsius;
         #endif
         #if WATCH_THE_COOLER
           start_watching_cooler();
@@ -491,12 +431,15 @@ class Temperature {
       }
     #endif
 
+    static bool isHeating(const uint8_t h) { return heaters[h].target_temperature > heaters[h].current_temperature; }
+    static bool isCooling(const uint8_t h) { return heaters[h].target_temperature < heaters[h].current_temperature; }
+
     #if HAS_TEMP_HOTEND
       static bool isHeatingHotend(uint8_t h) {
         #if HOTENDS <= 1
           UNUSED(h);
         #endif
-        return target_temperature[HOTEND_INDEX] > current_temperature[HOTEND_INDEX];
+        return isHeating(HOTEND_INDEX);
       }
     #else
       static bool isHeatingHotend(uint8_t h) {
@@ -505,15 +448,15 @@ class Temperature {
       }
     #endif
     #if HAS_TEMP_BED
-      static bool isHeatingBed() { return target_temperature_bed > current_temperature_bed; }
+      static bool isHeatingBed() { return isHeating(BED_INDEX); }
     #else
       static bool isHeatingBed() { return false; }
     #endif
     #if HAS_TEMP_CHAMBER
-      static bool isHeatingChamber() { return target_temperature_chamber > current_temperature_chamber; }
+      static bool isHeatingChamber() { return isHeating(CHAMBER_INDEX); }
     #endif
     #if HAS_TEMP_COOLER
-      static bool isHeatingCooler() { return target_temperature_cooler > current_temperature_cooler; } 
+      static bool isHeatingCooler() { return isHeating(COOLER_INDEX); }
     #endif
 
     #if HAS_TEMP_HOTEND
@@ -521,37 +464,37 @@ class Temperature {
         #if HOTENDS <= 1
           UNUSED(h);
         #endif
-        return target_temperature[HOTEND_INDEX] < current_temperature[HOTEND_INDEX];
+        return isCooling(HOTEND_INDEX);
       }
     #endif
     #if HAS_TEMP_BED
-      static bool isCoolingBed() { return target_temperature_bed < current_temperature_bed; }
+      static bool isCoolingBed() { return isCooling(BED_INDEX); }
     #endif
     #if HAS_TEMP_CHAMBER
-      static bool isCoolingChamber() { return target_temperature_chamber < current_temperature_chamber; }
+      static bool isCoolingChamber() { return isCooling(CHAMBER_INDEX); }
     #endif
     #if HAS_TEMP_COOLER
-      static bool isCoolingCooler() { return target_temperature_cooler < current_temperature_cooler; } 
+      static bool isCoolingCooler() { return isCooling(COOLER_INDEX); }
     #endif
 
     /**
      * The software PWM power
      */
     #if HAS_TEMP_HOTEND
-      static int getHeaterPower(int h) { return soft_pwm[h]; }
+      static int getHeaterPower(int h) { return heaters[h].soft_pwm; }
     #endif
     #if HAS_TEMP_BED
-      static int getBedPower() { return soft_pwm_bed; }
+      static int getBedPower() { return heaters[BED_INDEX].soft_pwm; }
     #endif
     #if HAS_TEMP_CHAMBER
-      static int getChamberPower() { return soft_pwm_chamber; }
+      static int getChamberPower() { return heaters[CHAMBER_INDEX].soft_pwm; }
     #endif
     #if HAS_TEMP_COOLER
       static int getCoolerPower() {
         #if ENABLED(FAST_PWM_COOLER)
           return fast_pwm_cooler;
         #else
-          return soft_pwm_cooler;
+          return heaters[COOLER_INDEX].soft_pwm;
         #endif
       }
       static uint8_t getPwmCooler(bool soft);
@@ -573,9 +516,10 @@ class Temperature {
 
     /**
      * Perform auto-tuning for hotend, bed, chamber or cooler in response to M303
+     * With PID_FEEDFORWARD a hotend can find its thermal model as well
      */
     #if HAS(PID_HEATING) || HAS(PID_COOLING)
-      static void PID_autotune(const float temp, const int temp_controller, int ncycles, bool storeValues=false);
+      static void PID_autotune(const float temp, const int temp_controller, int ncycles, bool storeValues=false, bool model=false);
     #endif
 
     /**
@@ -618,49 +562,44 @@ class Temperature {
     #endif // BABYSTEPPING
 
     #if ENABLED(ADVANCED_PAUSE_FEATURE)
+      static void start_idle_timer(const uint8_t h, const millis_t timeout_ms) {
+        heaters[h].idle_timeout_ms = millis() + timeout_ms;
+        heaters[h].idle_timeout_exceeded = false;
+      }
+
+      static void reset_idle_timer(const uint8_t h) {
+        heaters[h].idle_timeout_ms = 0;
+        heaters[h].idle_timeout_exceeded = false;
+        #if WATCH_THE_HEATERS
+          start_watching(h);
+        #endif
+      }
+
       static void start_heater_idle_timer(uint8_t h, millis_t timeout_ms) {
         #if HOTENDS == 1
           UNUSED(h);
         #endif
-        heater_idle_timeout_ms[HOTEND_INDEX] = millis() + timeout_ms;
-        heater_idle_timeout_exceeded[HOTEND_INDEX] = false;
+        start_idle_timer(HOTEND_INDEX, timeout_ms);
       }
 
       static void reset_heater_idle_timer(uint8_t h) {
         #if HOTENDS == 1
           UNUSED(h);
         #endif
-        heater_idle_timeout_ms[HOTEND_INDEX] = 0;
-        heater_idle_timeout_exceeded[HOTEND_INDEX] = false;
-        #if WATCH_HOTENDS
-          start_watching_heater(HOTEND_INDEX);
-        #endif
+        reset_idle_timer(HOTEND_INDEX);
       }
 
       static bool is_heater_idle(uint8_t h) {
         #if HOTENDS == 1
           UNUSED(h);
         #endif
-        return heater_idle_timeout_exceeded[HOTEND_INDEX];
+        return heaters[HOTEND_INDEX].idle_timeout_exceeded;
       }
 
       #if HAS_TEMP_BED
-        static void start_bed_idle_timer(millis_t timeout_ms) {
-          bed_idle_timeout_ms = millis() + timeout_ms;
-          bed_idle_timeout_exceeded = false;
-        }
-
-        static void reset_bed_idle_timer() {
-          bed_idle_timeout_ms = 0;
-          bed_idle_timeout_exceeded = false;
-          #if WATCH_THE_BED
-            start_watching_bed();
-          #endif
-        }
-
-        static bool is_bed_idle() {
-          return bed_idle_timeout_exceeded;
-        }
+        static void start_bed_idle_timer(millis_t timeout_ms) { start_idle_timer(BED_INDEX, timeout_ms); }
+        static void reset_bed_idle_timer() { reset_idle_timer(BED_INDEX); }
+        static bool is_bed_idle() { return heaters[BED_INDEX].idle_timeout_exceeded; }
       #endif
     #endif
 
@@ -674,52 +613,20 @@ class Temperature {
 
     static void checkExtruderAutoFans();
 
-    static uint8_t get_pid_output(const int8_t h);
+    static uint8_t get_pid_output(const uint8_t h);
 
-    #if ENABLED(PIDTEMPBED)
-      static uint8_t get_pid_output_bed();
+    #if ENABLED(PID_FEEDFORWARD)
+      static uint8_t get_feedforward_output(const uint8_t h);
     #endif
 
-    #if ENABLED(PIDTEMPCHAMBER)
-      static uint8_t get_pid_output_chamber();
-    #endif
+    static void _temp_error(const uint8_t h, const char * const serial_msg, const char * const lcd_msg);
+    static void min_temp_error(const uint8_t h);
+    static void max_temp_error(const uint8_t h);
 
-    #if ENABLED(PIDTEMPCOOLER)
-      static uint8_t get_pid_output_cooler();
+    #if HAS_THERMAL_PROTECTION
+      static void thermal_runaway_protection(const uint8_t h);
     #endif
 
-    static void _temp_error(const int8_t tc, const char * const serial_msg, const char * const lcd_msg);
-    static void min_temp_error(const int8_t h);
-    static void max_temp_error(const int8_t h);
-
-    #if ENABLED(THERMAL_PROTECTION_HOTENDS) || ENABLED(THERMAL_PROTECTION_BED) || ENABLED(THERMAL_PROTECTION_COOLER)
-
-      typedef enum TRState { TRInactive, TRFirstHeating, TRStable, TRRunaway } TRstate;
-
-      static void thermal_runaway_protection(TRState* state, millis_t* timer, float temperature, float target_temperature, int temp_controller_id, int period_seconds, int hysteresis_degc);
-
-      #if ENABLED(THERMAL_PROTECTION_HOTENDS)
-        static TRState thermal_runaway_state_machine[HOTENDS];
-        static millis_t thermal_runaway_timer[HOTENDS];
-      #endif
-
-      #if HAS_THERMALLY_PROTECTED_BED
-        static TRState thermal_runaway_bed_state_machine;
-        static millis_t thermal_runaway_bed_timer;
-      #endif
-
-      #if ENABLED(THERMAL_PROTECTION_CHAMBER) && HAS_TEMP_CHAMBER
-        static TRState thermal_runaway_chamber_state_machine = TRReset;
-        static millis_t thermal_runaway_chamber_timer;
-      #endif
-
-      #if ENABLED(THERMAL_PROTECTION_COOLER) && HAS_TEMP_COOLER
-        static TRState thermal_runaway_cooler_state_machine = TRReset;
-        static millis_t thermal_runaway_cooler_timer;
-      #endif
-
-    #endif // THERMAL_PROTECTION
-
     #if HAS_POWER_CONSUMPTION_SENSOR
       int current_raw_powconsumption;
       static unsigned long raw_powconsumption_value;
@@ -0,0 +1,208 @@
+/**
+ * MK4duo 3D Printer Firmware
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 - 2017 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Dense thermistor tables
+ *
+ * For every thermistor in use, the temperature at each raw value of
+ * the ADC (0 - 1023) in 1/THERMISTOR_DENSE_SCALE degrees, computed
+ * by the compiler from its temptable with the same linear interpolation
+ * as the table scan. Converting a reading is then one table read and
+ * one multiply. Included only by temperature.cpp.
+ */
+
+#ifndef THERMISTORTABLE_DENSE_H_
+#define THERMISTORTABLE_DENSE_H_
+
+#define THERMISTOR_DENSE_SIZE   1024
+#define THERMISTOR_DENSE_SCALE  16
+
+#define THERMISTOR_DENSE_MAX    (32767.0 / (THERMISTOR_DENSE_SCALE))
+
+// Temperature of the raw value in a temptable, searching from row i.
+// Two rows with the same raw value (e.g. 17.5 and 17.9 in table 66)
+// make the scan return an infinity, here it is the largest temperature.
+constexpr float tt_interpolate(const short (*tt)[2], const uint8_t len, const int raw, const uint8_t i) {
+  return i >= len ? tt[len - 1][1]
+       : tt[i][0] <= raw ? tt_interpolate(tt, len, raw, i + 1)
+       : tt[i][0] == tt[i - 1][0] ? ((raw - tt[i - 1][0]) * (tt[i][1] - tt[i - 1][1]) < 0 ? -THERMISTOR_DENSE_MAX : THERMISTOR_DENSE_MAX)
+       : tt[i - 1][1] + (raw - tt[i - 1][0]) * (float)(tt[i][1] - tt[i - 1][1]) / (float)(tt[i][0] - tt[i - 1][0]);
+}
+
+constexpr int16_t tt_round(const float t) {
+  return t >= 32767 ? 32767 : t <= -32767 ? -32767 : t < 0 ? (int16_t)(t - 0.5) : (int16_t)(t + 0.5);
+}
+
+#define _TT_D1(T,N)     tt_round(tt_interpolate(T, COUNT(T), N, 1) * (THERMISTOR_DENSE_SCALE))
+#define _TT_D4(T,N)     _TT_D1(T,N), _TT_D1(T,N+1), _TT_D1(T,N+2), _TT_D1(T,N+3)
+#define _TT_D16(T,N)    _TT_D4(T,N), _TT_D4(T,N+4), _TT_D4(T,N+8), _TT_D4(T,N+12)
+#define _TT_D64(T,N)    _TT_D16(T,N), _TT_D16(T,N+16), _TT_D16(T,N+32), _TT_D16(T,N+48)
+#define _TT_D256(T,N)   _TT_D64(T,N), _TT_D64(T,N+64), _TT_D64(T,N+128), _TT_D64(T,N+192)
+#define _TT_D1024(T)    _TT_D256(T,0), _TT_D256(T,256), _TT_D256(T,512), _TT_D256(T,768)
+
+#define TT_DENSE_TABLE(_N) const int16_t densetable_ ## _N[THERMISTOR_DENSE_SIZE] PROGMEM = { _TT_D1024(temptable_ ## _N) }
+
+#if ANY_THERMISTOR_IS(1)
+  TT_DENSE_TABLE(1);
+#endif
+#if ANY_THERMISTOR_IS(2)
+  TT_DENSE_TABLE(2);
+#endif
+#if ANY_THERMISTOR_IS(3)
+  TT_DENSE_TABLE(3);
+#endif
+#if ANY_THERMISTOR_IS(4)
+  TT_DENSE_TABLE(4);
+#endif
+#if ANY_THERMISTOR_IS(5)
+  TT_DENSE_TABLE(5);
+#endif
+#if ANY_THERMISTOR_IS(6)
+  TT_DENSE_TABLE(6);
+#endif
+#if ANY_THERMISTOR_IS(7)
+  TT_DENSE_TABLE(7);
+#endif
+#if ANY_THERMISTOR_IS(71)
+  TT_DENSE_TABLE(71);
+#endif
+#if ANY_THERMISTOR_IS(8)
+  TT_DENSE_TABLE(8);
+#endif
+#if ANY_THERMISTOR_IS(9)
+  TT_DENSE_TABLE(9);
+#endif
+#if ANY_THERMISTOR_IS(10)
+  TT_DENSE_TABLE(10);
+#endif
+#if ANY_THERMISTOR_IS(11)
+  TT_DENSE_TABLE(11);
+#endif
+#if ANY_THERMISTOR_IS(13)
+  TT_DENSE_TABLE(13);
+#endif
+#if ANY_THERMISTOR_IS(20)
+  TT_DENSE_TABLE(20);
+#endif
+#if ANY_THERMISTOR_IS(51)
+  TT_DENSE_TABLE(51);
+#endif
+#if ANY_THERMISTOR_IS(52)
+  TT_DENSE_TABLE(52);
+#endif
+#if ANY_THERMISTOR_IS(55)
+  TT_DENSE_TABLE(55);
+#endif
+#if ANY_THERMISTOR_IS(60)
+  TT_DENSE_TABLE(60);
+#endif
+#if ANY_THERMISTOR_IS(66)
+  TT_DENSE_TABLE(66);
+#endif
+#if ANY_THERMISTOR_IS(12)
+  TT_DENSE_TABLE(12);
+#endif
+#if ANY_THERMISTOR_IS(70)
+  TT_DENSE_TABLE(70);
+#endif
+#if ANY_THERMISTOR_IS(110)
+  TT_DENSE_TABLE(110);
+#endif
+#if ANY_THERMISTOR_IS(147)
+  TT_DENSE_TABLE(147);
+#endif
+#if ANY_THERMISTOR_IS(1010)
+  TT_DENSE_TABLE(1010);
+#endif
+#if ANY_THERMISTOR_IS(1047)
+  TT_DENSE_TABLE(1047);
+#endif
+#if ANY_THERMISTOR_IS(998)
+  TT_DENSE_TABLE(998);
+#endif
+#if ANY_THERMISTOR_IS(999)
+  TT_DENSE_TABLE(999);
+#endif
+
+#define _TT_DENSE_NAME(_N) densetable_ ## _N
+#define TT_DENSE_NAME(_N) _TT_DENSE_NAME(_N)
+
+#ifdef THERMISTORHEATER_0
+  #define HEATER_0_DENSETABLE TT_DENSE_NAME(THERMISTORHEATER_0)
+#else
+  #define HEATER_0_DENSETABLE NULL
+#endif
+#ifdef THERMISTORHEATER_1
+  #define HEATER_1_DENSETABLE TT_DENSE_NAME(THERMISTORHEATER_1)
+#else
+  #define HEATER_1_DENSETABLE NULL
+#endif
+#ifdef THERMISTORHEATER_2
+  #define HEATER_2_DENSETABLE TT_DENSE_NAME(THERMISTORHEATER_2)
+#else
+  #define HEATER_2_DENSETABLE NULL
+#endif
+#ifdef THERMISTORHEATER_3
+  #define HEATER_3_DENSETABLE TT_DENSE_NAME(THERMISTORHEATER_3)
+#else
+  #define HEATER_3_DENSETABLE NULL
+#endif
+#ifdef THERMISTORBED
+  #define BEDDENSETABLE TT_DENSE_NAME(THERMISTORBED)
+#endif
+#ifdef THERMISTORCHAMBER
+  #define CHAMBERDENSETABLE TT_DENSE_NAME(THERMISTORCHAMBER)
+#endif
+#ifdef THERMISTORCOOLER
+  #define COOLERDENSETABLE TT_DENSE_NAME(THERMISTORCOOLER)
+#endif
+
+/**
+ * Temperature of a thermistor reading.
+ * Raw values outside of the dense table are looked up in the temptable.
+ */
+inline float thermistor2temp(const short (*tt)[2], const uint8_t len, const int16_t* dense, const int raw) {
+  if (WITHIN(raw, 0, THERMISTOR_DENSE_SIZE - 1))
+    return (int16_t)pgm_read_word(&dense[raw]) * (1.0 / (THERMISTOR_DENSE_SCALE));
+
+  // Overflow: Set to last value in the table
+  if (raw >= (short)pgm_read_word(&tt[len - 1][0])) return (short)pgm_read_word(&tt[len - 1][1]);
+
+  uint8_t i = 1;
+  while (i < len - 1 && (short)pgm_read_word(&tt[i][0]) <= raw) i++;
+  return (short)pgm_read_word(&tt[i - 1][1]) +
+         (raw - (short)pgm_read_word(&tt[i - 1][0])) *
+         (float)((short)pgm_read_word(&tt[i][1]) - (short)pgm_read_word(&tt[i - 1][1])) /
+         (float)((short)pgm_read_word(&tt[i][0]) - (short)pgm_read_word(&tt[i - 1][0]));
+}
+
+/**
+ * Temperature of a thermistor reading in 1/THERMISTOR_DENSE_SCALE degrees,
+ * without floating point in the range of the dense table.
+ */
+inline int16_t thermistor2fixed(const short (*tt)[2], const uint8_t len, const int16_t* dense, const int raw) {
+  if (WITHIN(raw, 0, THERMISTOR_DENSE_SIZE - 1))
+    return (int16_t)pgm_read_word(&dense[raw]);
+  return tt_round(thermistor2temp(tt, len, dense, raw) * (THERMISTOR_DENSE_SCALE));
+}
+
+#endif // THERMISTORTABLE_DENSE_H_
@@ -52,7 +52,7 @@
 
 #define TEST_BYTE ((char) 0xE5)
 
-extern char command_queue[BUFSIZE][MAX_CMD_SIZE];
+extern char command_queue[COMMAND_QUEUE_SIZE];
 
 extern char* __brkval;
 extern size_t  __heap_start, __heap_end, __flp;
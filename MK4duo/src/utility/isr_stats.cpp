@@ -0,0 +1,106 @@
+/**
+ * MK4duo 3D Printer Firmware
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 - 2017 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "../../base.h"
+
+#if ENABLED(ISR_STATISTICS)
+
+  #include "isr_stats.h"
+
+  ISRStats isrStats;
+
+  isr_stat_t        ISRStats::stat[ISR_STAT_COUNT];
+  isr_sample_t      ISRStats::samples[ISR_STATISTICS_BUFFER];
+  volatile uint8_t  ISRStats::sample_index  = 0;
+  volatile bool     ISRStats::frozen        = false;
+
+  static millis_t   start_ms = 0;
+
+  void ISRStats::reset() {
+    CRITICAL_SECTION_START
+      for (uint8_t i = 0; i < ISR_STAT_COUNT; i++) {
+        stat[i].min_cycles = 0xFFFFFFFF;
+        stat[i].max_cycles = stat[i].count = 0;
+        stat[i].total_cycles = 0;
+      }
+    CRITICAL_SECTION_END
+    start_ms = millis();
+  }
+
+  static void report_stat(const char * const name, const isr_stat_t &s) {
+    SERIAL_STR(ECHO);
+    SERIAL_PS(name);
+    SERIAL_MV(" calls:", s.count);
+    if (s.count) {
+      SERIAL_MV(" min:", s.min_cycles);
+      SERIAL_MV(" avg:", (float)s.total_cycles / s.count, 1);
+      SERIAL_MV(" max:", s.max_cycles);
+      SERIAL_MV(" max(us):", (float)s.max_cycles / (CYCLES_PER_US), 1);
+    }
+    SERIAL_EOL();
+  }
+
+  /**
+   * Report the cycles per invocation of every ISR since the last reset
+   * and the share of the CPU time they took.
+   */
+  void ISRStats::report() {
+    isr_stat_t copy[ISR_STAT_COUNT];
+
+    CRITICAL_SECTION_START
+      for (uint8_t i = 0; i < ISR_STAT_COUNT; i++) copy[i] = stat[i];
+    CRITICAL_SECTION_END
+
+    const millis_t elapsed_ms = millis() - start_ms;
+
+    report_stat(PSTR("Stepper ISR"), copy[ISR_STEPPER]);
+    #if ENABLED(ADVANCE) || ENABLED(LIN_ADVANCE)
+      report_stat(PSTR("Advance ISR"), copy[ISR_ADVANCE]);
+    #endif
+    report_stat(PSTR("Temperature ISR"), copy[ISR_TEMPERATURE]);
+    report_stat(PSTR("Step lateness"), copy[ISR_STEP_LATENESS]);
+
+    if (elapsed_ms) {
+      const float total_cycles = (float)(copy[ISR_STEPPER].total_cycles + copy[ISR_ADVANCE].total_cycles + copy[ISR_TEMPERATURE].total_cycles);
+      SERIAL_SMV(ECHO, "ISR load(%):", total_cycles * 100.0 / ((float)elapsed_ms * 1000.0 * (CYCLES_PER_US)), 2);
+      SERIAL_EMV(" time(ms):", elapsed_ms);
+    }
+  }
+
+  /**
+   * Print the last ISR_STATISTICS_BUFFER stepper timer interrupts,
+   * oldest first: lateness and cycles of the ISR.
+   */
+  void ISRStats::dump() {
+    frozen = true;
+    const uint8_t first = sample_index;
+    for (uint8_t i = 0; i < ISR_STATISTICS_BUFFER; i++) {
+      const isr_sample_t &sample = samples[(first + i) & (ISR_STATISTICS_BUFFER - 1)];
+      SERIAL_SMV(ECHO, "ISR sample:", i);
+      SERIAL_MV(" lateness:", sample.lateness);
+      SERIAL_EMV(" cycles:", sample.cycles);
+    }
+    frozen = false;
+  }
+
+#endif // ISR_STATISTICS
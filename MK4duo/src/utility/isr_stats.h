@@ -0,0 +1,97 @@
+/**
+ * MK4duo 3D Printer Firmware
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 - 2017 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * ISR statistics
+ *
+ * Cycles spent in every invocation of the stepper, advance and
+ * temperature ISRs and how late the stepper ISR started after its
+ * compare match. The last steps are also kept in a ring buffer.
+ * See M130.
+ */
+
+#ifndef ISR_STATS_H
+  #define ISR_STATS_H
+
+  #if ENABLED(ISR_STATISTICS)
+
+    enum ISRStatEnum {
+      ISR_STEPPER,
+      ISR_ADVANCE,
+      ISR_TEMPERATURE,
+      ISR_STEP_LATENESS,
+      ISR_STAT_COUNT
+    };
+
+    typedef struct {
+      uint32_t  min_cycles,
+                max_cycles,
+                count;
+      uint64_t  total_cycles;
+    } isr_stat_t;
+
+    typedef struct {
+      uint32_t  lateness,   // Cycles from the compare match to the ISR
+                cycles;     // Cycles of the whole stepper timer ISR
+    } isr_sample_t;
+
+    class ISRStats {
+
+      public: /** Public Function */
+
+        static void record(const ISRStatEnum isr, const uint32_t cycles) {
+          isr_stat_t &s = stat[isr];
+          if (cycles < s.min_cycles) s.min_cycles = cycles;
+          if (cycles > s.max_cycles) s.max_cycles = cycles;
+          s.total_cycles += cycles;
+          s.count++;
+        }
+
+        // Called at the end of the stepper timer ISR
+        static void step_timer(const uint32_t lateness, const uint32_t cycles) {
+          record(ISR_STEP_LATENESS, lateness);
+          if (frozen) return;
+          isr_sample_t &sample = samples[sample_index];
+          sample.lateness = lateness;
+          sample.cycles = cycles;
+          sample_index = (sample_index + 1) & (ISR_STATISTICS_BUFFER - 1);
+        }
+
+        static void reset();
+        static void report();
+        static void dump();
+
+      private: /** Private Parameters */
+
+        static isr_stat_t stat[ISR_STAT_COUNT];
+        static isr_sample_t samples[ISR_STATISTICS_BUFFER];
+        static volatile uint8_t sample_index;
+        static volatile bool frozen;
+
+    };
+
+    extern ISRStats isrStats;
+
+  #endif // ISR_STATISTICS
+
+#endif // ISR_STATS_H
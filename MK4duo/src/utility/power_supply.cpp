@@ -65,12 +65,12 @@
       HOTEND_LOOP() if (autoFanSpeeds[h] > 0) return true;
     #endif
 
-    HOTEND_LOOP() if (thermalManager.target_temperature[h] > 0) return true;
+    HOTEND_LOOP() if (thermalManager.heaters[h].target_temperature > 0) return true;
 
-    if (thermalManager.target_temperature_bed > 0) return true;
+    if (thermalManager.heaters[BED_INDEX].target_temperature > 0) return true;
 
     #if HAS_TEMP_CHAMBER
-      if (thermalManager.target_temperature_chamber > 0) return true;
+      if (thermalManager.heaters[CHAMBER_INDEX].target_temperature > 0) return true;
     #endif
 
     return false;